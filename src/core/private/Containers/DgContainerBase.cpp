@@ -1,4 +1,5 @@
 #include "impl/DgContainerBase.h"
+#include "DgMemoryRegistry.h"
 
 
 #define ARRAY_SIZE(a) sizeof(a) / sizeof(*a)
@@ -33,7 +34,9 @@ namespace Dg
   //--------------------------------------------------------------------------------
   //	@	ContainerBase::ContainerBase()
   //--------------------------------------------------------------------------------
-  ContainerBase::ContainerBase() : m_poolSizeIndex(0)
+  ContainerBase::ContainerBase() 
+    : m_poolSizeIndex(0)
+    , m_pMemoryRecord(nullptr)
   {
   }
 
@@ -42,12 +45,15 @@ namespace Dg
   //--------------------------------------------------------------------------------
   ContainerBase::~ContainerBase()
   {
+    clear_memory_tag();
   }
 
   //--------------------------------------------------------------------------------
   //	@	ContainerBase::ContainerBase()
   //--------------------------------------------------------------------------------
-  ContainerBase::ContainerBase(size_t a_nItems) : m_poolSizeIndex(0)
+  ContainerBase::ContainerBase(size_t a_nItems) 
+    : m_poolSizeIndex(0)
+    , m_pMemoryRecord(nullptr)
   {
     pool_size(a_nItems);
   }
@@ -57,6 +63,7 @@ namespace Dg
   //--------------------------------------------------------------------------------
   ContainerBase::ContainerBase(ContainerBase const & a_other) 
     : m_poolSizeIndex(a_other.m_poolSizeIndex)
+    , m_pMemoryRecord(nullptr)
   {
   }
 
@@ -74,6 +81,7 @@ namespace Dg
   //--------------------------------------------------------------------------------
   ContainerBase::ContainerBase(ContainerBase && a_other)
     : m_poolSizeIndex(a_other.m_poolSizeIndex)
+    , m_pMemoryRecord(nullptr)
   {
   }
 
@@ -123,4 +131,37 @@ namespace Dg
     m_poolSizeIndex++;
     return pool_size();
   }
+
+  //--------------------------------------------------------------------------------
+  //	@	ContainerBase::set_memory_tag()
+  //--------------------------------------------------------------------------------
+  void ContainerBase::set_memory_tag(char const * a_name)
+  {
+    clear_memory_tag();
+    m_pMemoryRecord = MemoryRegistry::Register(a_name);
+
+    //The first report is the starting point, not a growth
+    ReportMemory();
+    m_pMemoryRecord->nGrowths = 0;
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	ContainerBase::clear_memory_tag()
+  //--------------------------------------------------------------------------------
+  void ContainerBase::clear_memory_tag()
+  {
+    if (m_pMemoryRecord != nullptr)
+    {
+      MemoryRegistry::Unregister(m_pMemoryRecord);
+      m_pMemoryRecord = nullptr;
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	ContainerBase::memory_tag()
+  //--------------------------------------------------------------------------------
+  char const * ContainerBase::memory_tag() const
+  {
+    return (m_pMemoryRecord == nullptr) ? nullptr : m_pMemoryRecord->name.c_str();
+  }
 }
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+
+#include "DgMemoryRegistry.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //Function statics so the registry outlives containers in other
+    //translation units that are destroyed at exit.
+    static std::mutex & RegistryMutex()
+    {
+      static std::mutex * s_pMutex = new std::mutex();
+      return *s_pMutex;
+    }
+
+    static std::vector<MemoryRecord *> & Records()
+    {
+      static std::vector<MemoryRecord *> * s_pRecords = new std::vector<MemoryRecord *>();
+      return *s_pRecords;
+    }
+
+    static int64_t Now()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static void StoreMax(std::atomic<size_t> & a_max, size_t a_val)
+    {
+      if (a_val > a_max.load(std::memory_order_relaxed))
+        a_max.store(a_val, std::memory_order_relaxed);
+    }
+
+    static ContainerMemoryStats ToStats(MemoryRecord const & a_record)
+    {
+      ContainerMemoryStats result;
+      result.name = a_record.name;
+      result.nContainers = 1;
+      result.reservedBytes = a_record.reservedBytes.load(std::memory_order_relaxed);
+      result.peakReservedBytes = a_record.peakReservedBytes.load(std::memory_order_relaxed);
+      result.usedBytes = a_record.usedBytes.load(std::memory_order_relaxed);
+      result.nItems = a_record.nItems.load(std::memory_order_relaxed);
+      result.peakItems = a_record.peakItems.load(std::memory_order_relaxed);
+      result.nGrowths = a_record.nGrowths.load(std::memory_order_relaxed);
+      result.reallocSeconds = double(a_record.reallocNanoseconds.load(std::memory_order_relaxed)) * 1.0e-9;
+      return result;
+    }
+
+    static void AppendEscaped(std::string & a_out, std::string const & a_str)
+    {
+      for (char c : a_str)
+      {
+        switch (c)
+        {
+          case '"': a_out += "\\\""; break;
+          case '\\': a_out += "\\\\"; break;
+          case '\n': a_out += "\\n"; break;
+          case '\r': a_out += "\\r"; break;
+          case '\t': a_out += "\\t"; break;
+          default:
+          {
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+              char buf[8];
+              snprintf(buf, sizeof(buf), "\\u%04x", c);
+              a_out += buf;
+            }
+            else
+              a_out += c;
+          }
+        }
+      }
+    }
+
+    void UpdateMemoryRecord(MemoryRecord * a_pRecord,
+                            size_t a_reservedBytes,
+                            size_t a_usedBytes,
+                            size_t a_nItems)
+    {
+      size_t oldReserved = a_pRecord->reservedBytes.load(std::memory_order_relaxed);
+      if (a_reservedBytes > oldReserved)
+        a_pRecord->nGrowths.fetch_add(1, std::memory_order_relaxed);
+
+      a_pRecord->reservedBytes.store(a_reservedBytes, std::memory_order_relaxed);
+      a_pRecord->usedBytes.store(a_usedBytes, std::memory_order_relaxed);
+      a_pRecord->nItems.store(a_nItems, std::memory_order_relaxed);
+      StoreMax(a_pRecord->peakReservedBytes, a_reservedBytes);
+      StoreMax(a_pRecord->peakItems, a_nItems);
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	MemoryRegistry::Register()
+  //--------------------------------------------------------------------------------
+  impl::MemoryRecord * MemoryRegistry::Register(char const * a_name)
+  {
+    impl::MemoryRecord * pRecord = new impl::MemoryRecord();
+    pRecord->name = (a_name == nullptr) ? "" : a_name;
+    pRecord->reservedBytes = 0;
+    pRecord->peakReservedBytes = 0;
+    pRecord->usedBytes = 0;
+    pRecord->nItems = 0;
+    pRecord->peakItems = 0;
+    pRecord->nGrowths = 0;
+    pRecord->reallocNanoseconds = 0;
+
+    std::lock_guard<std::mutex> lock(impl::RegistryMutex());
+    impl::Records().push_back(pRecord);
+    return pRecord;
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	MemoryRegistry::Unregister()
+  //--------------------------------------------------------------------------------
+  void MemoryRegistry::Unregister(impl::MemoryRecord * a_pRecord)
+  {
+    {
+      std::lock_guard<std::mutex> lock(impl::RegistryMutex());
+      std::vector<impl::MemoryRecord *> & records = impl::Records();
+      auto it = std::find(records.begin(), records.end(), a_pRecord);
+      if (it != records.end())
+      {
+        *it = records.back();
+        records.pop_back();
+      }
+    }
+    delete a_pRecord;
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	MemoryRegistry::GetStats()
+  //--------------------------------------------------------------------------------
+  std::vector<ContainerMemoryStats> MemoryRegistry::GetStats()
+  {
+    std::vector<ContainerMemoryStats> result;
+    std::lock_guard<std::mutex> lock(impl::RegistryMutex());
+    for (impl::MemoryRecord const * pRecord : impl::Records())
+      result.push_back(impl::ToStats(*pRecord));
+    return result;
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	MemoryRegistry::GetStatsByTag()
+  //--------------------------------------------------------------------------------
+  std::vector<ContainerMemoryStats> MemoryRegistry::GetStatsByTag()
+  {
+    std::map<std::string, ContainerMemoryStats> byTag;
+    for (ContainerMemoryStats const & stats : GetStats())
+    {
+      auto it = byTag.find(stats.name);
+      if (it == byTag.end())
+      {
+        byTag.insert(std::make_pair(stats.name, stats));
+        continue;
+      }
+
+      ContainerMemoryStats & total = it->second;
+      total.nContainers += stats.nContainers;
+      total.reservedBytes += stats.reservedBytes;
+      total.peakReservedBytes += stats.peakReservedBytes;
+      total.usedBytes += stats.usedBytes;
+      total.nItems += stats.nItems;
+      total.peakItems += stats.peakItems;
+      total.nGrowths += stats.nGrowths;
+      total.reallocSeconds += stats.reallocSeconds;
+    }
+
+    std::vector<ContainerMemoryStats> result;
+    for (auto const & kv : byTag)
+      result.push_back(kv.second);
+    return result;
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	MemoryRegistry::TotalReservedBytes()
+  //--------------------------------------------------------------------------------
+  size_t MemoryRegistry::TotalReservedBytes()
+  {
+    size_t result = 0;
+    std::lock_guard<std::mutex> lock(impl::RegistryMutex());
+    for (impl::MemoryRecord const * pRecord : impl::Records())
+      result += pRecord->reservedBytes.load(std::memory_order_relaxed);
+    return result;
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	MemoryRegistry::TotalUsedBytes()
+  //--------------------------------------------------------------------------------
+  size_t MemoryRegistry::TotalUsedBytes()
+  {
+    size_t result = 0;
+    std::lock_guard<std::mutex> lock(impl::RegistryMutex());
+    for (impl::MemoryRecord const * pRecord : impl::Records())
+      result += pRecord->usedBytes.load(std::memory_order_relaxed);
+    return result;
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	MemoryRegistry::ToJSON()
+  //--------------------------------------------------------------------------------
+  std::string MemoryRegistry::ToJSON()
+  {
+    std::vector<ContainerMemoryStats> stats = GetStatsByTag();
+    std::sort(stats.begin(), stats.end(),
+      [](ContainerMemoryStats const & a, ContainerMemoryStats const & b)
+      {
+        return a.reservedBytes > b.reservedBytes;
+      });
+
+    size_t totalReserved = 0;
+    size_t totalUsed = 0;
+    for (ContainerMemoryStats const & s : stats)
+    {
+      totalReserved += s.reservedBytes;
+      totalUsed += s.usedBytes;
+    }
+
+    char buf[512];
+    std::string result("{\n");
+    snprintf(buf, sizeof(buf), "  \"totalReservedBytes\": %llu,\n  \"totalUsedBytes\": %llu,\n  \"tags\": [",
+             (unsigned long long)totalReserved, (unsigned long long)totalUsed);
+    result += buf;
+
+    for (size_t i = 0; i < stats.size(); i++)
+    {
+      ContainerMemoryStats const & s = stats[i];
+      result += (i == 0) ? "\n" : ",\n";
+      result += "    {\"name\": \"";
+      impl::AppendEscaped(result, s.name);
+      snprintf(buf, sizeof(buf),
+               "\", \"containers\": %llu, \"reservedBytes\": %llu, \"peakReservedBytes\": %llu, "
+               "\"usedBytes\": %llu, \"items\": %llu, \"peakItems\": %llu, "
+               "\"growths\": %llu, \"reallocSeconds\": %.6f}",
+               (unsigned long long)s.nContainers,
+               (unsigned long long)s.reservedBytes,
+               (unsigned long long)s.peakReservedBytes,
+               (unsigned long long)s.usedBytes,
+               (unsigned long long)s.nItems,
+               (unsigned long long)s.peakItems,
+               (unsigned long long)s.nGrowths,
+               s.reallocSeconds);
+      result += buf;
+    }
+
+    result += stats.empty() ? "]\n}\n" : "\n  ]\n}\n";
+    return result;
+  }
+
+  //--------------------------------------------------------------------------------
+  //	@	ContainerBase::ReallocTimer
+  //--------------------------------------------------------------------------------
+  ContainerBase::ReallocTimer::ReallocTimer(ContainerBase const & a_container)
+    : m_pRecord(a_container.m_pMemoryRecord)
+    , m_start(0)
+  {
+    if (m_pRecord != nullptr)
+      m_start = impl::Now();
+  }
+
+  ContainerBase::ReallocTimer::~ReallocTimer()
+  {
+    if (m_pRecord != nullptr)
+      m_pRecord->reallocNanoseconds.fetch_add(impl::Now() - m_start, std::memory_order_relaxed);
+  }
+}
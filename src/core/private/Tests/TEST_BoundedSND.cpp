@@ -1,8 +1,97 @@
 #include "TestHarness.h"
+#include <cmath>
+#include <vector>
 #include "DgBoundedSND.h"
 
-
+//--------------------------------------------------------------------------------
+//	BoundedSND Table
+//--------------------------------------------------------------------------------
 TEST(Stack_BoundedSND, creation_BoundedSND)
 {
+  CHECK(Dg::impl::InverseNormalCDF(0.5) == 0.0);
+  CHECK(std::abs(Dg::impl::InverseNormalCDF(0.975) - 1.959963984540054) < 1.0e-12);
+  CHECK(std::abs(Dg::impl::InverseNormalCDF(1.0e-10) + 6.361340902404056) < 1.0e-9);
+  CHECK(std::abs(Dg::impl::InverseNormalCDF(1.0e-12) + 7.034483825301132) < 1.0e-9);
+  CHECK(std::abs(Dg::impl::InverseNormalCDF(1.0e-30) + 11.464024688443615) < 1.0e-9);
+  CHECK(std::abs(Dg::impl::InverseNormalCDF(0.3) + 0.5244005127080409) < 1.0e-12);
+
+  double values[101];
+  CHECK(Dg::Init(2.0, 0.5, 1.0, 4.0, 101, values) == Dg::Err_None);
+  CHECK(values[0] == 1.0);
+  CHECK(values[100] == 4.0);
+
+  bool good = true;
+  for (int i = 1; i < 101; i++)
+    good = good && (values[i] >= values[i - 1]);
+  CHECK(good);
+
+  //Median of the bounded distribution
+  double pl = Dg::impl::NormalCDF(-2.0);
+  double pu = Dg::impl::NormalCDF(4.0);
+  double median = 2.0 + 0.5 * Dg::impl::InverseNormalCDF(0.5 * (pl + pu));
+  CHECK(std::abs(values[50] - median) < 1.0e-12);
+
+  CHECK(Dg::Init(0.0, 1.0, 1.0, -1.0, 101, values) == Dg::Err_OutOfBounds);
+  CHECK(Dg::Init(0.0, 0.0, -1.0, 1.0, 101, values) == Dg::Err_OutOfBounds);
+  CHECK(Dg::Init(0.0, 1.0, -1.0, 1.0, 1, values) == Dg::Err_OutOfBounds);
+}
+
+
+//--------------------------------------------------------------------------------
+//	BoundedNormalSampler
+//--------------------------------------------------------------------------------
+TEST(Stack_BoundedNormalSampler, creation_BoundedNormalSampler)
+{
+  Dg::BoundedNormalSampler<float> sampler;
+  CHECK(!sampler.IsInitialised());
+  CHECK(sampler.Init(0.0f, 1.0f, 1.0f, -1.0f) == Dg::Err_OutOfBounds);
+  CHECK(!sampler.IsInitialised());
+
+  CHECK(sampler.Init(1.0f, 2.0f, -3.0f, 6.0f, 4096) == Dg::Err_None);
+  CHECK(sampler.IsInitialised());
+
+  CHECK(sampler.Sample(0.0f) == -3.0f);
+  CHECK(sampler.Sample(1.0f) == 6.0f);
+  CHECK(sampler.Sample(-0.5f) == -3.0f);
+  CHECK(sampler.Sample(1.5f) == 6.0f);
+
+  //Against the exact inverse CDF
+  double pl = Dg::impl::NormalCDF(-2.0);
+  double pu = Dg::impl::NormalCDF(2.5);
+  bool good = true;
+  for (int i = 1; i < 1000; i++)
+  {
+    double u = double(i) / 1000.0;
+    double expected = 1.0 + 2.0 * Dg::impl::InverseNormalCDF(pl + u * (pu - pl));
+    good = good && std::abs(sampler.Sample(float(u)) - expected) < 1.0e-3;
+  }
+  CHECK(good);
+
+  //Batch is identical to one at a time, in place included
+  size_t const count = 1003;
+  std::vector<float> uniforms(count), out(count);
+  for (size_t i = 0; i < count; i++)
+    uniforms[i] = float(i) / float(count - 1);
+
+  sampler.Sample(uniforms.data(), out.data(), count, 2);
+  good = true;
+  float prev = -3.0f;
+  for (size_t i = 0; i < count; i++)
+  {
+    good = good && (out[i] == sampler.Sample(uniforms[i]));
+    good = good && (out[i] >= prev) && (out[i] <= 6.0f);
+    prev = out[i];
+  }
+  CHECK(good);
+
+  std::vector<float> inPlace(uniforms);
+  sampler.Sample(inPlace.data(), inPlace.data(), count);
+  CHECK(inPlace == out);
 
-}
\ No newline at end of file
+  //Sample mean of a symmetric bound is the mean
+  Dg::BoundedNormalSampler<double> symmetric(5.0, 1.5, 2.0, 8.0);
+  double sum = 0.0;
+  for (int i = 0; i < 10000; i++)
+    sum += symmetric.Sample((double(i) + 0.5) / 10000.0);
+  CHECK(std::abs(sum / 10000.0 - 5.0) < 1.0e-6);
+}
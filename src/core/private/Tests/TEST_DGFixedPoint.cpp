@@ -1,7 +1,10 @@
 #include "TestHarness.h"
+#include <cmath>
+#include <vector>
 #include "DgFixedPoint.h"
 
 typedef Dg::FixedPoint<int32_t, 24> FP_s32_24;
+typedef Dg::FixedPoint<int32_t, 16> FP_s32_16;
 
 TEST(Stack_DgFixedPoint, creation_DgFixedPoint)
 {
@@ -134,4 +137,87 @@ TEST(Stack_DgFixedPoint, creation_DgFixedPoint)
   CHECK(static_cast<double>(floor(FP_s32_24(-34.0))) == -34.0);
 
   CHECK(static_cast<double>(mod(FP_s32_24(85.5), FP_s32_24(8.125))) == 4.25);
-}
\ No newline at end of file
+}
+
+TEST(Stack_DgFixedPoint_Functions, creation_DgFixedPoint_Functions)
+{
+  //Integer-only results, so these must hold exactly on every platform
+  CHECK(static_cast<double>(sin(FP_s32_16(1.0))) == 0.8414764404296875);
+  CHECK(static_cast<double>(cos(FP_s32_16(2.5))) == -0.8011474609375);
+  CHECK(static_cast<double>(tan(FP_s32_16(-0.75))) == -0.9315948486328125);
+  CHECK(static_cast<double>(exp(FP_s32_16(2.5))) == 12.1824951171875);
+  CHECK(static_cast<double>(log(FP_s32_16(2.5))) == 0.916290283203125);
+  CHECK(static_cast<double>(sqrt(FP_s32_16(2.5))) == 1.581146240234375);
+
+  //Accuracy
+  double const ulp = 1.0 / 65536.0;
+  bool good = true;
+  for (int i = -400; i <= 400; i++)
+  {
+    double x = static_cast<double>(FP_s32_16(i * 0.0371));
+    FP_s32_16 fx(x);
+    good = good && std::abs(static_cast<double>(sin(fx)) - std::sin(x)) < 1.5 * ulp;
+    good = good && std::abs(static_cast<double>(cos(fx)) - std::cos(x)) < 1.5 * ulp;
+    if (x < 10.0)
+      good = good && std::abs(static_cast<double>(exp(fx)) - std::exp(x)) < 1.5 * ulp * (1.0 + std::exp(x));
+    if (std::abs(std::cos(x)) > 0.1)
+      good = good && std::abs(static_cast<double>(tan(fx)) - std::tan(x)) < 16.0 * ulp;
+    if (x > 0.0)
+    {
+      good = good && std::abs(static_cast<double>(log(fx)) - std::log(x)) < 1.5 * ulp;
+      good = good && std::abs(static_cast<double>(sqrt(fx)) - std::sqrt(x)) <= 0.5 * ulp;
+    }
+  }
+  CHECK(good);
+
+  //Out of range
+  CHECK(exp(FP_s32_16(20.0)) == (std::numeric_limits<FP_s32_16>::max)());
+  CHECK(exp(FP_s32_16(-20.0)) == FP_s32_16(0.0));
+  CHECK(log(FP_s32_16(0.0)) == (std::numeric_limits<FP_s32_16>::min)());
+  CHECK(sqrt(FP_s32_16(-4.0)) == FP_s32_16(0.0));
+
+  //Other formats
+  typedef Dg::FixedPoint<int16_t, 8> FP_s16_8;
+  CHECK(std::abs(static_cast<double>(sin(FP_s16_8(2.0))) - std::sin(2.0)) < 1.0 / 256.0);
+  CHECK(std::abs(static_cast<double>(log(FP_s16_8(100.0))) - std::log(100.0)) < 1.0 / 256.0);
+  CHECK(std::abs(static_cast<double>(sin(FP_s32_24(2.0))) - std::sin(2.0)) < 2.0 / 16777216.0);
+}
+
+TEST(Stack_DgFixedPoint_Arrays, creation_DgFixedPoint_Arrays)
+{
+  //Covers the 4-wide cores, more than one block, and the tail
+  size_t const count = 203;
+  std::vector<FP_s32_16> in(count), out(count);
+  for (size_t i = 0; i < count; i++)
+    in[i] = FP_s32_16(-12.0 + 0.1234 * double(i));
+
+  bool good = true;
+
+  Dg::Sin(in.data(), out.data(), count, 2);
+  for (size_t i = 0; i < count; i++)
+    good = good && (out[i] == sin(in[i]));
+
+  Dg::Cos(in.data(), out.data(), count, 2);
+  for (size_t i = 0; i < count; i++)
+    good = good && (out[i] == cos(in[i]));
+
+  Dg::Tan(in.data(), out.data(), count, 2);
+  for (size_t i = 0; i < count; i++)
+    good = good && (out[i] == tan(in[i]));
+
+  Dg::Exp(in.data(), out.data(), count, 2);
+  for (size_t i = 0; i < count; i++)
+    good = good && (out[i] == exp(in[i]));
+
+  Dg::Log(in.data(), out.data(), count, 2);
+  for (size_t i = 0; i < count; i++)
+    good = good && (out[i] == log(in[i]));
+
+  //In place
+  out = in;
+  Dg::Sin(out.data(), out.data(), count);
+  for (size_t i = 0; i < count; i++)
+    good = good && (out[i] == sin(in[i]));
+
+  CHECK(good);
+}
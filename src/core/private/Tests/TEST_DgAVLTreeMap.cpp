@@ -359,4 +359,105 @@ TEST(Stack_dg_AVLTreeMap, creation_dg_AVLTreeMap)
   //----------------------------------------------------------------------------------------
   map.clear();
   CHECK(map.empty());
-}
\ No newline at end of file
+}
+
+TEST(Stack_dg_AVLTreeMap, BuildFromSorted_dg_AVLTreeMap)
+{
+  int const nItems = 100;
+  Dg::Pair<int, int> kvs[nItems];
+  for (int i = 0; i < nItems; i++)
+    kvs[i] = {i + 1, 2 * (i + 1)};
+
+  //----------------------------------------------------------------------------------------
+  //Building
+  //----------------------------------------------------------------------------------------
+  Map map, map2;
+  map.BuildFromSorted(kvs, kvs + nItems);
+  for (int i = 0; i < nItems; i++)
+    map2.insert(kvs[i].first, kvs[i].second);
+
+  CHECK(map.size() == nItems);
+  CHECK(AreEqual(map, map2));
+
+  Map::iterator it = map.end();
+  for (int i = nItems; i > 0; i--)
+  {
+    it--;
+    CHECK(it->first == i);
+  }
+
+  //Duplicate keys keep the first occurrence
+  Dg::Pair<int, int> dups[6] = {{1, 1}, {1, 2}, {2, 3}, {3, 4}, {3, 5}, {3, 6}};
+  Map map3;
+  map3.BuildFromSorted(dups, dups + 6);
+  CHECK(map3.size() == 3);
+  CHECK(map3.at(1) == 1);
+  CHECK(map3.at(2) == 3);
+  CHECK(map3.at(3) == 4);
+
+  //The built tree must behave as any other
+  map.insert(0, 0);
+  map.insert(nItems + 1, 2 * (nItems + 1));
+  map2.insert(0, 0);
+  map2.insert(nItems + 1, 2 * (nItems + 1));
+  CHECK(AreEqual(map, map2));
+
+  for (int i = 0; i <= nItems + 1; i += 3)
+  {
+    map.erase(i);
+    map2.erase(i);
+  }
+  CHECK(AreEqual(map, map2));
+
+  map.BuildFromSorted(kvs, kvs);
+  CHECK(map.empty());
+  CHECK(map.begin() == map.end());
+
+  //----------------------------------------------------------------------------------------
+  //Parallel building
+  //----------------------------------------------------------------------------------------
+  int const nLarge = 100000;
+  Dg::Pair<int, int> * pLarge = new Dg::Pair<int, int>[nLarge];
+  for (int i = 0; i < nLarge; i++)
+    pLarge[i] = {i, -i};
+
+  map.BuildFromSorted(pLarge, pLarge + nLarge);
+  map2.BuildFromSortedParallel(pLarge, pLarge + nLarge, 4);
+  CHECK(map2.size() == nLarge);
+  CHECK(AreEqual(map, map2));
+  CHECK(map2.find(nLarge / 3)->second == -(nLarge / 3));
+  delete[] pLarge;
+
+  //----------------------------------------------------------------------------------------
+  //Merging
+  //----------------------------------------------------------------------------------------
+  Map evens, odds, all;
+  for (int i = 0; i < nItems; i++)
+  {
+    if (i % 2 == 0)
+      evens.insert(i, i);
+    else
+      odds.insert(i, i);
+    all.insert(i, i);
+  }
+
+  evens.Merge(odds);
+  CHECK(AreEqual(evens, all));
+
+  //Values already in the map are kept
+  Map other;
+  other.insert(5, -1);
+  other.insert(nItems, nItems);
+  all.Merge(other);
+  all.insert(nItems + 1, nItems + 1);
+  CHECK(all.size() == nItems + 2);
+  CHECK(all.at(5) == 5);
+  CHECK(all.at(nItems) == nItems);
+
+  int value = 0;
+  for (auto kv : all)
+  {
+    CHECK(kv.first == value);
+    value++;
+  }
+}
@@ -0,0 +1,139 @@
+#include "TestHarness.h"
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "DgBitmapIDManager.h"
+
+template<typename Manager>
+static bool CompareWithSet(int a_lower, int a_upper)
+{
+  Manager idm(a_lower, a_upper);
+  std::set<int> used;
+  bool good = true;
+  unsigned seed = 12345;
+
+  for (int i = 0; i < 20000; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    int val = a_lower + int((seed >> 8) % unsigned(a_upper - a_lower + 3)) - 1;
+    switch ((seed >> 4) % 4)
+    {
+      case 0:
+      {
+        int id = idm.GetID();
+        if (used.size() == size_t(a_upper - a_lower + 1))
+        {
+          good = good && (id == 0);
+        }
+        else
+        {
+          good = good && (id >= a_lower && id <= a_upper && used.count(id) == 0);
+          used.insert(id);
+        }
+        break;
+      }
+      case 1:
+      {
+        idm.ReturnID(val);
+        used.erase(val);
+        break;
+      }
+      case 2:
+      {
+        bool inRange = (val >= a_lower && val <= a_upper);
+        bool expected = inRange && used.count(val) == 0;
+        good = good && (idm.MarkAsUsed(val) == expected);
+        if (expected)
+          used.insert(val);
+        break;
+      }
+      default:
+      {
+        good = good && (idm.IsUsed(val) == (used.count(val) != 0));
+      }
+    }
+  }
+  return good;
+}
+
+TEST(Stack_DgBitmapIDManager, creation_DgBitmapIDManager)
+{
+  Dg::BitmapIDManager<int> idm(1, 11);
+  for (int i = 1; i <= 11; ++i)
+  {
+    CHECK(idm.GetID() == i);
+  }
+  CHECK(idm.GetID() == 0);
+
+  idm.ReturnID(4);
+  idm.ReturnID(2);
+  CHECK(!idm.IsUsed(2));
+  CHECK(idm.IsUsed(3));
+  CHECK(!idm.IsUsed(0));
+  CHECK(!idm.IsUsed(40));
+  CHECK(idm.GetID() == 2);
+  CHECK(idm.GetID() == 4);
+
+  CHECK(!idm.MarkAsUsed(-4));
+  CHECK(!idm.MarkAsUsed(40));
+  CHECK(!idm.MarkAsUsed(5));
+  idm.ReturnID(5);
+  CHECK(idm.MarkAsUsed(5));
+
+  CHECK(CompareWithSet<Dg::BitmapIDManager<int>>(1, 100));
+  CHECK(CompareWithSet<Dg::BitmapIDManager<int>>(-50, 5000));
+  CHECK(CompareWithSet<Dg::BitmapIDManager<int>>(7, 300000));
+  CHECK(CompareWithSet<Dg::ConcurrentIDManager<int>>(1, 100));
+  CHECK(CompareWithSet<Dg::ConcurrentIDManager<int>>(-50, 5000));
+}
+
+TEST(Stack_DgConcurrentIDManager, creation_DgConcurrentIDManager)
+{
+  int const nIDs = 100000;
+  unsigned const nThreads = 4;
+  Dg::ConcurrentIDManager<int> idm(1, nIDs);
+
+  //Threads churn through IDs, then each takes a share of the whole range.
+  std::vector<std::vector<int>> taken(nThreads);
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < nThreads; t++)
+  {
+    threads.push_back(std::thread([&idm, &taken, t]()
+    {
+      std::vector<int> ids;
+      for (int round = 0; round < 50; round++)
+      {
+        for (int i = 0; i < 500; i++)
+          ids.push_back(idm.GetID());
+        for (size_t i = 0; i < ids.size(); i += 2)
+          idm.ReturnID(ids[i]);
+        std::vector<int> kept;
+        for (size_t i = 1; i < ids.size(); i += 2)
+          kept.push_back(ids[i]);
+        ids.swap(kept);
+      }
+      for (int id : ids)
+        idm.ReturnID(id);
+
+      for (int i = 0; i < nIDs / int(nThreads); i++)
+        taken[t].push_back(idm.GetID());
+    }));
+  }
+  for (auto & thread : threads)
+    thread.join();
+
+  std::vector<char> seen(nIDs + 1, 0);
+  bool good = true;
+  for (auto const & ids : taken)
+  {
+    for (int id : ids)
+    {
+      good = good && id >= 1 && id <= nIDs && seen[id] == 0;
+      if (id >= 1 && id <= nIDs)
+        seen[id] = 1;
+    }
+  }
+  CHECK(good);
+  CHECK(idm.GetID() == 0);
+}
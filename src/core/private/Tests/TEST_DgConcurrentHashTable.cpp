@@ -0,0 +1,118 @@
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "TestHarness.h"
+#include "DgConcurrentHashTable.h"
+
+namespace
+{
+  std::atomic<int> g_retired(0);
+
+  struct CountRetired
+  {
+    void operator()(int &&) const { g_retired++; }
+  };
+}
+
+TEST(Stack_dg_ConcurrentHashTable, creation_dg_ConcurrentHashTable)
+{
+  Dg::ConcurrentHashTable<int, int, Dg::Hash<int>, CountRetired> table;
+  g_retired = 0;
+
+  CHECK(table.empty());
+  CHECK(table.insert(1, 10));
+  CHECK(!table.insert(1, 20));
+  CHECK(table.contains(1));
+  CHECK(!table.contains(2));
+
+  int value = 0;
+  CHECK(table.find(1, value));
+  CHECK(value == 10);
+  CHECK(!table.find(2, value));
+
+  CHECK(!table.upsert(1, 30));
+  CHECK(table.find(1, value));
+  CHECK(value == 30);
+  CHECK(g_retired == 1);
+
+  CHECK(table.upsert(2, 40));
+  CHECK(table.size() == 2);
+
+  CHECK(table.erase(1));
+  CHECK(!table.erase(1));
+  CHECK(g_retired == 2);
+  CHECK(table.size() == 1);
+
+  table.clear();
+  CHECK(table.empty());
+  CHECK(g_retired == 3);
+
+  //Values left in the table are retired when it is destroyed
+  {
+    Dg::ConcurrentHashTable<int, int, Dg::Hash<int>, CountRetired> table2;
+    for (int i = 0; i < 100; i++)
+      table2.insert(i, i);
+  }
+  CHECK(g_retired == 103);
+}
+
+TEST(Stack_dg_ConcurrentHashTable, threads_dg_ConcurrentHashTable)
+{
+  int const nThreads = 8;
+  int const nPerThread = 20000;
+
+  Dg::ConcurrentHashTable<int, int> table;
+  table.reserve(nThreads * nPerThread);
+
+  //Writers on disjoint key ranges, with readers running alongside
+  std::atomic<bool> done(false);
+  std::atomic<int> badReads(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; t++)
+  {
+    threads.push_back(std::thread([&table, t]()
+    {
+      for (int i = 0; i < nPerThread; i++)
+        table.insert(t * nPerThread + i, i);
+      for (int i = 0; i < nPerThread; i += 2)
+        table.erase(t * nPerThread + i);
+      for (int i = 1; i < nPerThread; i += 2)
+        table.upsert(t * nPerThread + i, -i);
+    }));
+  }
+
+  std::thread reader([&]()
+  {
+    while (!done)
+    {
+      for (int k = 0; k < nThreads * nPerThread; k += 97)
+      {
+        int value;
+        if (table.find(k, value))
+        {
+          int i = k % nPerThread;
+          if (value != i && value != -i)
+            badReads++;
+        }
+      }
+    }
+  });
+
+  for (auto & t : threads)
+    t.join();
+  done = true;
+  reader.join();
+
+  CHECK(badReads == 0);
+  CHECK(table.size() == nThreads * nPerThread / 2);
+
+  int nBad = 0;
+  table.ForEach([&nBad](int a_key, int a_value)
+  {
+    int i = a_key % nPerThread;
+    if (i % 2 == 0 || a_value != -i)
+      nBad++;
+  });
+  CHECK(nBad == 0);
+}
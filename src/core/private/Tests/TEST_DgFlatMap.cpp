@@ -0,0 +1,125 @@
+#include "TestHarness.h"
+#include <map>
+#include <random>
+#include <vector>
+
+#include "DgFlatMap.h"
+#include "DgPair.h"
+
+typedef Dg::FlatMap<int, int> Map;
+
+TEST(Stack_DgFlatMap, creation_DgFlatMap)
+{
+  Map map(32);
+  CHECK(map.empty());
+  CHECK(map.find(3) == map.end());
+
+  map.insert(5, 50);
+  map.insert(1, 10);
+  map.insert(3, 30);
+  CHECK(map.insert(3, 99)->second == 30);
+  map[4] = 40;
+
+  CHECK(map.size() == 4);
+  CHECK(map.at(1) == 10);
+  CHECK(map.find(4)->second == 40);
+  try {map.at(2); CHECK(false);} catch (std::out_of_range const &) {}
+
+  //Iteration is in key order, in both the sorted and memory order iterators
+  int keys[4] = {1, 3, 4, 5};
+  int i = 0;
+  for (auto it = map.begin_rand(); it != map.end_rand(); it++, i++)
+    CHECK(it->first == keys[i] && (*it).second == keys[i] * 10);
+  CHECK(map.keys()[2] == 4 && map.values()[2] == 40);
+
+  Map::iterator it = map.erase(map.find(3));
+  CHECK(it->first == 4);
+  map.erase(5);
+  map.erase(7);
+  CHECK(map.size() == 2);
+
+  Map copy(map);
+  map.clear();
+  CHECK(map.empty() && copy.size() == 2);
+  map = std::move(copy);
+  CHECK(map.at(4) == 40);
+}
+
+TEST(Stack_DgFlatMap_Random, creation_DgFlatMap_Random)
+{
+  //Sizes either side of the linear search cut-off
+  std::mt19937 rng(7);
+  for (int range : {20, 100, 2000})
+  {
+    Map map;
+    Dg::FlatMap<double, int> dmap;
+    std::map<int, int> ref;
+    bool ok = true;
+    for (int i = 0; i < 5000; i++)
+    {
+      int key = static_cast<int>(rng() % range) - range / 2;
+      int val = static_cast<int>(rng());
+      switch (rng() % 3)
+      {
+        case 0:
+        case 1:
+          map.insert(key, val);
+          dmap.insert(key, val);
+          ref.insert(std::make_pair(key, val));
+          break;
+        default:
+          map.erase(key);
+          dmap.erase(key);
+          ref.erase(key);
+      }
+
+      int probe = static_cast<int>(rng() % (range + 2)) - range / 2 - 1;
+      auto it = ref.find(probe);
+      auto mit = map.find(probe);
+      auto dit = dmap.find(probe);
+      if (it == ref.end())
+        ok = ok && mit == map.end() && dit == dmap.end();
+      else
+        ok = ok && mit != map.end() && mit->second == it->second && dit->second == it->second;
+    }
+    ok = ok && map.size() == ref.size();
+
+    auto it = ref.begin();
+    for (auto mit = map.cbegin(); ok && mit != map.cend(); ++mit, ++it)
+      ok = mit->first == it->first && mit->second == it->second;
+    CHECK(ok);
+  }
+}
+
+TEST(Stack_DgFlatMap_Bulk, creation_DgFlatMap_Bulk)
+{
+  typedef Dg::Pair<int, int> KV;
+  Map map;
+  map.insert(4, 0);
+  map.insert(10, 0);
+
+  //Unsorted, with repeats. Existing keys and first occurrences win.
+  std::vector<KV> items = {{7, 1}, {4, 1}, {1, 1}, {7, 2}, {12, 1}, {-3, 1}, {1, 2}};
+  map.InsertRange(items.begin(), items.end());
+
+  int keys[7] = {-3, 1, 4, 7, 10, 12};
+  int vals[7] = {1, 1, 0, 1, 0, 1};
+  CHECK(map.size() == 6);
+  bool ok = true;
+  for (size_t i = 0; i < map.size(); i++)
+    ok = ok && map.keys()[i] == keys[i] && map.values()[i] == vals[i];
+  CHECK(ok);
+
+  std::vector<KV> sorted = {{0, 5}, {0, 6}, {4, 5}, {20, 5}};
+  Map other;
+  other.BuildFromSorted(sorted.begin(), sorted.end());
+  CHECK(other.size() == 3 && other.at(0) == 5);
+
+  map.Merge(other);
+  CHECK(map.size() == 8);
+  CHECK(map.at(0) == 5 && map.at(4) == 0 && map.at(20) == 5);
+  ok = true;
+  for (size_t i = 1; i < map.size(); i++)
+    ok = ok && map.keys()[i - 1] < map.keys()[i];
+  CHECK(ok);
+}
@@ -1,4 +1,6 @@
 #include "TestHarness.h"
+#include <vector>
+
 #include "DgHyperArray.h"
 
 TEST(Stack_DgHyperArray, creation_DgHyperArray)
@@ -161,4 +163,138 @@ TEST(Stack_DgHyperArrayCompare, creation_DgHyperArrayCompare)
 
   ary.fill<3>(3, {2, 2, 2});
   CHECK(ary(2, 2, 2) == 3);
-}
\ No newline at end of file
+}
+
+template<typename Layout>
+static bool CheckLayout(size_t x, size_t y, size_t z)
+{
+  Dg::HyperArray<int, 3, Layout> ary({x, y, z});
+
+  //Every element must map to its own slot in storage
+  std::vector<char> used(ary.storage_length(), 0);
+  bool good = (ary.size() == x * y * z) && (ary.storage_length() >= ary.size());
+  for (size_t i = 0; i < x; i++)
+  {
+    for (size_t j = 0; j < y; j++)
+    {
+      for (size_t k = 0; k < z; k++)
+      {
+        size_t ind = ary.rawIndex(i, j, k);
+        good = good && (ind < used.size()) && (used[ind] == 0);
+        if (ind < used.size())
+          used[ind] = 1;
+        ary(i, j, k) = int(i * 10000 + j * 100 + k);
+      }
+    }
+  }
+
+  Dg::HyperArray<int, 3, Layout> ary1(ary);
+  for (size_t i = 0; i < x; i++)
+    for (size_t j = 0; j < y; j++)
+      for (size_t k = 0; k < z; k++)
+        good = good && (ary1.at(i, j, k) == int(i * 10000 + j * 100 + k));
+
+  return good;
+}
+
+TEST(Stack_DgHyperArrayLayout, creation_DgHyperArrayLayout)
+{
+  CHECK(CheckLayout<Dg::RowMajorLayout>(5, 7, 3));
+  CHECK(CheckLayout<Dg::TiledLayout<4>>(5, 7, 3));
+  CHECK(CheckLayout<Dg::TiledLayout<1>>(5, 7, 3));
+  CHECK(CheckLayout<Dg::MortonLayout>(5, 7, 3));
+  CHECK(CheckLayout<Dg::MortonLayout>(1, 33, 2));
+
+  //Neighbours along the first dimension are close in tiled and Morton layouts
+  Dg::HyperArray<float, 3, Dg::TiledLayout<8>> tiled({64, 64, 64});
+  CHECK(tiled.rawIndex(1, 0, 0) - tiled.rawIndex(0, 0, 0) == 64);
+  CHECK(tiled.rawIndex(0, 0, 1) - tiled.rawIndex(0, 0, 0) == 1);
+  CHECK(tiled.rawIndex(8, 0, 0) == 8 * 8 * 8 * 8 * 8);
+
+  Dg::HyperArray<float, 3, Dg::MortonLayout> morton({4, 4, 4});
+  CHECK(morton.storage_length() == 64);
+  CHECK(morton.rawIndex(0, 0, 1) == 1);
+  CHECK(morton.rawIndex(0, 1, 0) == 2);
+  CHECK(morton.rawIndex(1, 0, 0) == 4);
+  CHECK(morton.rawIndex(1, 1, 1) == 7);
+  CHECK(morton.rawIndex(0, 0, 2) == 8);
+
+  Dg::HyperArray<int, 2, Dg::MortonLayout> ary({2, 2});
+  ary.fill(3);
+  ary.fill<1>(1, {1});
+  CHECK(ary(0, 0) == 3);
+  CHECK(ary(0, 1) == 3);
+  CHECK(ary(1, 0) == 1);
+  CHECK(ary(1, 1) == 1);
+  CHECK(ary.compare<1>({0}, {1}) == false);
+}
+
+TEST(Stack_DgHyperArrayView, creation_DgHyperArrayView)
+{
+  Dg::HyperArray<int, 3> ary({4, 5, 6});
+  for (size_t i = 0; i < 4; i++)
+    for (size_t j = 0; j < 5; j++)
+      for (size_t k = 0; k < 6; k++)
+        ary(i, j, k) = int(i * 100 + j * 10 + k);
+
+  Dg::HyperArrayView<int, 3> view = ary.View();
+  CHECK(view.IsContiguous());
+  CHECK(view.size() == 120);
+  CHECK(&view(1, 2, 3) == &ary(1, 2, 3));
+
+  //Sub-views refer to the same elements
+  Dg::HyperArrayView<int, 3> sub = view.SubView({1, 1, 0}, {2, 3, 3}, {1, 1, 2});
+  CHECK(!sub.IsContiguous());
+  CHECK(sub.length(2) == 3);
+  CHECK(sub(0, 0, 0) == 110);
+  CHECK(sub(1, 2, 2) == 234);
+  sub(1, 2, 2) = -1;
+  CHECK(ary(2, 3, 4) == -1);
+
+  try {view.SubView({1, 1, 0}, {2, 3, 4}, {1, 1, 2}); CHECK(false);} catch (std::out_of_range const &) {}
+  try {sub.at(2, 0, 0); CHECK(false);} catch (std::out_of_range const &) {}
+
+  //Slices
+  Dg::HyperArrayView<int, 2> slice = view.Slice<1>(2);
+  CHECK(slice.length(0) == 4);
+  CHECK(slice.length(1) == 6);
+  CHECK(slice(3, 5) == 325);
+
+  Dg::HyperArrayView<int const, 1> row = ary.View().Slice<0>(3).Slice<1>(4);
+  CHECK(row.length(0) == 5);
+  CHECK(row(2) == 324);
+}
+
+TEST(Stack_DgHyperArrayAlgorithms, creation_DgHyperArrayAlgorithms)
+{
+  size_t const x = 40;
+  size_t const y = 30;
+  size_t const z = 50;
+
+  for (unsigned nThreads = 1; nThreads <= 4; nThreads++)
+  {
+    Dg::HyperArray<int, 3> ary({x, y, z});
+    Dg::Fill(ary, 1, nThreads);
+    CHECK(Dg::Reduce(ary, 0, [](int a, int b) {return a + b;}, nThreads) == int(x * y * z));
+
+    Dg::ForEachIndex(ary, [](std::array<size_t, 3> const & a_ind, int & a_elem)
+    {
+      a_elem = int(a_ind[0] * 10000 + a_ind[1] * 100 + a_ind[2]);
+    }, nThreads);
+    CHECK(ary(39, 29, 49) == 392949);
+    CHECK(Dg::Reduce(ary, 0, [](int a, int b) {return a > b ? a : b;}, nThreads) == 392949);
+
+    //Work on a block, through a view
+    Dg::HyperArrayView<int, 3> block = ary.View().SubView({10, 10, 10}, {20, 10, 10});
+    Dg::Transform(block, [](int a_val) {return -a_val;}, nThreads);
+    CHECK(ary(10, 10, 10) == -101010);
+    CHECK(ary(29, 19, 19) == -291919);
+    CHECK(ary(30, 19, 19) == 301919);
+
+    Dg::HyperArray<double, 3, Dg::TiledLayout<4>> tiled({20, 10, 10});
+    Dg::Transform(Dg::HyperArrayView<int const, 3>(block), tiled, [](int a_val) {return double(a_val) * 0.5;}, nThreads);
+    CHECK(tiled(0, 0, 0) == -101010 * 0.5);
+    CHECK(tiled(19, 9, 9) == -291919 * 0.5);
+    CHECK(Dg::Reduce(tiled, 0.0, [](double a, double b) {return a + b;}, nThreads) < 0.0);
+  }
+}
@@ -0,0 +1,137 @@
+#include "TestHarness.h"
+#include <map>
+#include <random>
+#include <vector>
+
+#include "DgIndexedHeap.h"
+
+typedef Dg::IndexedHeap<int, double> Heap;
+
+TEST(Stack_DgIndexedHeap, creation_DgIndexedHeap)
+{
+  Heap heap;
+  CHECK(heap.empty());
+  CHECK(!heap.contains(0));
+
+  Heap::Handle h5 = heap.push(5.0, 50);
+  Heap::Handle h1 = heap.push(1.0, 10);
+  Heap::Handle h3 = heap.push(3.0, 30);
+  CHECK(heap.size() == 3);
+  CHECK(heap.top() == 10 && heap.top_priority() == 1.0 && heap.top_handle() == h1);
+
+  //Decrease and increase key
+  heap.update(h5, 0.5);
+  CHECK(heap.top() == 50);
+  heap.update(h5, 9.0);
+  CHECK(heap.top() == 10);
+  CHECK(heap.priority(h5) == 9.0);
+
+  heap.erase(h3);
+  CHECK(!heap.contains(h3) && heap.contains(h5));
+  try {heap.at(h3); CHECK(false);} catch (std::out_of_range const &) {}
+
+  //A reused slot does not revive the old handle
+  Heap::Handle h7 = heap.push(7.0, 70);
+  CHECK(h7 != h3 && heap.contains(h7) && !heap.contains(h3));
+  CHECK(!heap.erase(h3) && !heap.update(h3, 0.0));
+  CHECK(heap.size() == 3 && heap.top() == 10);
+  CHECK(heap.erase(h7) && !heap.contains(h7));
+
+  heap[h1] = 11;
+  CHECK(heap.at(h1) == 11);
+
+  Heap copy(heap);
+  heap.pop();
+  CHECK(heap.top() == 50);
+  heap.pop();
+  CHECK(heap.empty());
+
+  CHECK(copy.size() == 2 && copy.top() == 11);
+  heap = std::move(copy);
+  CHECK(heap.size() == 2 && heap[h5] == 50);
+
+  heap.clear();
+  Heap::Handle h2 = heap.push(2.0, 20);
+  CHECK(!heap.contains(h1) && !heap.contains(h5) && heap.contains(h2));
+}
+
+TEST(Stack_DgIndexedHeap_Random, creation_DgIndexedHeap_Random)
+{
+  std::mt19937 rng(11);
+  Heap heap(16);
+  std::map<Heap::Handle, int> live;  //handle -> priority
+  bool ok = true;
+
+  for (int i = 0; i < 20000; i++)
+  {
+    int priority = static_cast<int>(rng() % 1000);
+    switch (rng() % 5)
+    {
+      case 0:
+      case 1:
+      {
+        Heap::Handle h = heap.push(priority, priority);
+        ok = ok && live.find(h) == live.end();
+        live[h] = priority;
+        break;
+      }
+      case 2:
+      {
+        if (live.empty())
+          break;
+        auto it = live.begin();
+        std::advance(it, rng() % live.size());
+        heap.update(it->first, priority);
+        heap[it->first] = priority;
+        it->second = priority;
+        break;
+      }
+      case 3:
+      {
+        if (live.empty())
+          break;
+        auto it = live.begin();
+        std::advance(it, rng() % live.size());
+        heap.erase(it->first);
+        live.erase(it);
+        break;
+      }
+      default:
+      {
+        if (live.empty())
+          break;
+        int smallest = 1000;
+        for (auto const & kv : live)
+          smallest = kv.second < smallest ? kv.second : smallest;
+        ok = ok && heap.top_priority() == smallest && heap.top() == smallest;
+        live.erase(heap.top_handle());
+        heap.pop();
+      }
+    }
+    ok = ok && heap.size() == live.size();
+  }
+  CHECK(ok);
+
+  //Bulk push, large enough to rebuild the heap
+  std::vector<double> priorities;
+  std::vector<int> values;
+  for (int i = 0; i < 5000; i++)
+  {
+    priorities.push_back(static_cast<double>(rng() % 100000));
+    values.push_back(static_cast<int>(priorities.back()));
+  }
+  std::vector<Heap::Handle> handles(priorities.size());
+  heap.PushN(priorities.data(), values.data(), priorities.size(), handles.data());
+  for (size_t i = 0; ok && i < handles.size(); i++)
+    ok = heap[handles[i]] == values[i] && heap.priority(handles[i]) == priorities[i];
+  CHECK(ok);
+
+  double last = -1.0;
+  while (!heap.empty())
+  {
+    ok = ok && heap.top_priority() >= last && heap.top() == static_cast<int>(heap.top_priority());
+    last = heap.top_priority();
+    heap.pop();
+  }
+  CHECK(ok);
+}
@@ -1,4 +1,5 @@
 #include "TestHarness.h"
+#include <vector>
 #include "DgMask.h"
 
 
@@ -9,10 +10,11 @@ TEST(Stack_DgMask, creation_DgMask)
   Dg::Mask<9> mask9;
   Dg::Mask<26> mask26;
 
-  CHECK(sizeof(mask7) == 1);
-  CHECK(sizeof(mask8) == 1);
-  CHECK(sizeof(mask9) == 2);
-  CHECK(sizeof(mask26) == 4);
+  CHECK(sizeof(mask7) == 8);
+  CHECK(sizeof(mask8) == 8);
+  CHECK(sizeof(mask9) == 8);
+  CHECK(sizeof(mask26) == 8);
+  CHECK(sizeof(Dg::Mask<65>) == 16);
 
   for (int i = 0; i < 26; i++)
   {
@@ -47,4 +49,76 @@ TEST(Stack_DgMask, creation_DgMask)
   CHECK(!mask26.IsOn(9));
   CHECK(!mask26.IsOn(20));
   CHECK(!mask26.IsOn(25));
-}
\ No newline at end of file
+}
+
+TEST(Stack_DgMask_Bulk, creation_DgMask_Bulk)
+{
+  Dg::Mask<300> a, b;
+  for (size_t i = 0; i < 300; i += 3)
+    a.SetOn(i);
+  for (size_t i = 0; i < 300; i += 5)
+    b.SetOn(i);
+
+  CHECK(a.Count() == 100);
+  CHECK(b.Count() == 60);
+  CHECK((a & b).Count() == 20);
+  CHECK((a | b).Count() == 140);
+  CHECK((a ^ b).Count() == 120);
+  CHECK(Dg::Mask<300>(a).AndNot(b).Count() == 80);
+
+  //Bits past the end stay off
+  CHECK((~a).Count() == 200);
+  Dg::Mask<300> all;
+  all.SetAllOn();
+  CHECK(all.Count() == 300);
+  CHECK((all ^ a) == ~a);
+
+  std::vector<size_t> visited;
+  (a & b).ForEachSetBit([&visited](size_t a_index) {visited.push_back(a_index);});
+  bool ok = visited.size() == 20;
+  for (size_t i = 0; ok && i < visited.size(); i++)
+    ok = visited[i] == i * 15;
+  CHECK(ok);
+
+  all.SetAllOff();
+  CHECK(all.None());
+  all.Toggle(299);
+  CHECK(all.Any() && all.IsOn(299));
+}
+
+TEST(Stack_DgDynamicMask, creation_DgDynamicMask)
+{
+  Dg::DynamicMask empty;
+  CHECK(empty.size() == 0 && empty.Count() == 0 && empty.None());
+
+  Dg::DynamicMask a(100000), b(100000, true);
+  CHECK(b.Count() == 100000);
+  CHECK(a.None());
+
+  a.SetOn(0);
+  a.SetOn(64);
+  a.SetOn(99999);
+  CHECK((a & b) == a);
+  CHECK((~a).Count() == 99997);
+  b.AndNot(a);
+  CHECK(b.Count() == 99997 && !b.IsOn(64));
+
+  size_t sum = 0;
+  a.ForEachSetBit([&sum](size_t a_index) {sum += a_index;});
+  CHECK(sum == 64 + 99999);
+
+  //Growing leaves new bits off, shrinking drops bits
+  a.resize(100001);
+  CHECK(a.Count() == 3 && !a.IsOn(100000));
+  a.resize(65);
+  CHECK(a.Count() == 2);
+  a.resize(64);
+  CHECK(a.Count() == 1);
+
+  Dg::DynamicMask c(a);
+  CHECK(c == a);
+  c.SetOff(0);
+  CHECK(c != a && c.None());
+
+  try {a |= b; CHECK(false);} catch (std::length_error const &) {}
+}
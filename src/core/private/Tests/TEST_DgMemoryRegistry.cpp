@@ -0,0 +1,114 @@
+#include <string>
+
+#include "TestHarness.h"
+#include "DgMemoryRegistry.h"
+#include "DgDynamicArray.h"
+#include "DgDoublyLinkedList.h"
+#include "DgAVLTreeMap.h"
+
+namespace
+{
+  bool FindStats(char const * a_name, Dg::ContainerMemoryStats & a_out)
+  {
+    std::vector<Dg::ContainerMemoryStats> stats = Dg::MemoryRegistry::GetStatsByTag();
+    for (auto const & s : stats)
+    {
+      if (s.name == a_name)
+      {
+        a_out = s;
+        return true;
+      }
+    }
+    return false;
+  }
+}
+
+TEST(Stack_DgMemoryRegistry, Tracking_DgMemoryRegistry)
+{
+  Dg::ContainerMemoryStats stats;
+
+  {
+    //Untagged containers are not tracked
+    Dg::DynamicArray<int> untagged;
+    untagged.push_back(1);
+    CHECK(untagged.memory_tag() == nullptr);
+
+    Dg::DynamicArray<int> arr;
+    arr.set_memory_tag("test_array");
+    CHECK(std::string(arr.memory_tag()) == "test_array");
+    CHECK(FindStats("test_array", stats));
+    CHECK(stats.nItems == 0);
+    CHECK(stats.reservedBytes == arr.pool_size() * sizeof(int));
+    CHECK(stats.nGrowths == 0);
+
+    for (int i = 0; i < 1000; i++)
+      arr.push_back(i);
+
+    CHECK(FindStats("test_array", stats));
+    CHECK(stats.nItems == 1000);
+    CHECK(stats.usedBytes == 1000 * sizeof(int));
+    CHECK(stats.reservedBytes == arr.pool_size() * sizeof(int));
+    CHECK(stats.reservedBytes >= stats.usedBytes);
+    CHECK(stats.nGrowths > 0);
+    CHECK(stats.reallocSeconds >= 0.0);
+
+    for (int i = 0; i < 900; i++)
+      arr.pop_back();
+
+    CHECK(FindStats("test_array", stats));
+    CHECK(stats.nItems == 100);
+    CHECK(stats.peakItems == 1000);
+    CHECK(stats.peakReservedBytes == stats.reservedBytes);
+
+    //Copies are not tagged
+    Dg::DynamicArray<int> arrCopy(arr);
+    CHECK(arrCopy.memory_tag() == nullptr);
+
+    //Several containers under one tag
+    Dg::DoublyLinkedList<int> list0;
+    Dg::DoublyLinkedList<int, true> list1;
+    list0.set_memory_tag("test_lists");
+    list1.set_memory_tag("test_lists");
+    for (int i = 0; i < 500; i++)
+    {
+      list0.push_back(i);
+      list1.push_back(i);
+    }
+
+    CHECK(FindStats("test_lists", stats));
+    CHECK(stats.nContainers == 2);
+    CHECK(stats.nItems == 1000);
+
+    list1.clear();
+    list1.shrink();
+    CHECK(FindStats("test_lists", stats));
+    CHECK(stats.nItems == 500);
+
+    Dg::AVLTreeMap<int, int> map;
+    map.set_memory_tag("test_map");
+    for (int i = 0; i < 100; i++)
+      map.insert(i, i);
+    for (int i = 0; i < 50; i++)
+      map.erase(i);
+    CHECK(FindStats("test_map", stats));
+    CHECK(stats.nItems == 50);
+
+    //Renaming
+    map.set_memory_tag("test_map_renamed");
+    CHECK(!FindStats("test_map", stats));
+    CHECK(FindStats("test_map_renamed", stats));
+    CHECK(stats.nItems == 50);
+
+    std::string json = Dg::MemoryRegistry::ToJSON();
+    CHECK(json.find("\"name\": \"test_array\"") != std::string::npos);
+    CHECK(json.find("\"name\": \"test_lists\"") != std::string::npos);
+    CHECK(json.find("\"totalReservedBytes\"") != std::string::npos);
+
+    CHECK(Dg::MemoryRegistry::TotalReservedBytes() >= Dg::MemoryRegistry::TotalUsedBytes());
+  }
+
+  //Destroyed containers leave the registry
+  CHECK(!FindStats("test_array", stats));
+  CHECK(!FindStats("test_lists", stats));
+  CHECK(!FindStats("test_map_renamed", stats));
+}
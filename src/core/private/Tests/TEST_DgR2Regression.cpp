@@ -1,8 +1,14 @@
+#include <random>
+#include <cmath>
+
 #include "TestHarness.h"
 #include "DgR2Regression.h"
 
 typedef Dg::R2::Vector<float> vec2;
 typedef Dg::R2::Line<float> line;
+typedef Dg::R2::Vector<double> vec2d;
+typedef Dg::R2::LineFitAccumulator<double> accd;
+typedef Dg::R2::LineFitAccumulator<float> accf;
 
 TEST(Stack_DgR2Regression, DgR2Regression)
 {
@@ -13,4 +19,144 @@ TEST(Stack_DgR2Regression, DgR2Regression)
 
 
   line l = Dg::R2::LineOfBestFit(points, 4);
-}
\ No newline at end of file
+
+  //Slope Sxy / Sxx = 2.9875 / 2.1875
+  CHECK(std::abs(l.Origin().x() - 1.875f) < 1.0e-5f);
+  CHECK(std::abs(l.Origin().y() - 3.675f) < 1.0e-5f);
+  CHECK(std::abs(l.Direction().y() / l.Direction().x() - 2.9875f / 2.1875f) < 1.0e-5f);
+}
+
+TEST(Stack_DgR2Regression_Accumulator, DgR2Regression_Accumulator)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> noise(-0.1, 0.1);
+
+  size_t const n = 1000;
+  std::vector<vec2d> points(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    double x = double(i) * 0.01;
+    points[i] = vec2d(x, 2.0 - 0.5 * x + noise(gen), 1.0);
+  }
+
+  //Two pass reference
+  double mx = 0.0, my = 0.0;
+  for (size_t i = 0; i < n; i++)
+  {
+    mx += points[i].x();
+    my += points[i].y();
+  }
+  mx /= double(n);
+  my /= double(n);
+  double sxx = 0.0, sxy = 0.0, syy = 0.0;
+  for (size_t i = 0; i < n; i++)
+  {
+    double dx = points[i].x() - mx;
+    double dy = points[i].y() - my;
+    sxx += dx * dx;
+    sxy += dx * dy;
+    syy += dy * dy;
+  }
+  sxx /= double(n);
+  sxy /= double(n);
+  syy /= double(n);
+
+  accd a;
+  for (size_t i = 0; i < n; i++)
+    a.Add(points[i]);
+
+  double xx, xy, yy;
+  a.GetCovariance(xx, xy, yy);
+  CHECK(a.Count() == n);
+  CHECK(std::abs(a.Centroid().x() - mx) < 1.0e-12);
+  CHECK(std::abs(a.Centroid().y() - my) < 1.0e-12);
+  CHECK(std::abs(xx - sxx) < 1.0e-12);
+  CHECK(std::abs(xy - sxy) < 1.0e-12);
+  CHECK(std::abs(yy - syy) < 1.0e-12);
+
+  Dg::R2::Line<double> l = a.GetLine();
+  CHECK(std::abs(l.Direction().y() / l.Direction().x() - sxy / sxx) < 1.0e-12);
+  CHECK(std::abs(l.Direction().y() / l.Direction().x() + 0.5) < 0.01);
+
+  Dg::R2::Line<double> pl = a.GetPrincipalLine();
+  CHECK(std::abs(pl.Direction().y() / pl.Direction().x() + 0.5) < 0.01);
+
+  //Merging two halves matches the single pass
+  accd b, c;
+  for (size_t i = 0; i < n / 3; i++)
+    b.Add(points[i]);
+  for (size_t i = n / 3; i < n; i++)
+    c.Add(points[i]);
+  b.Merge(c);
+  b.GetCovariance(xx, xy, yy);
+  CHECK(b.Count() == n);
+  CHECK(std::abs(xx - sxx) < 1.0e-12);
+  CHECK(std::abs(xy - sxy) < 1.0e-12);
+  CHECK(std::abs(yy - syy) < 1.0e-12);
+
+  //Removing points undoes adding them
+  for (size_t i = n / 3; i < n; i++)
+    b.Remove(points[i]);
+  accd d;
+  for (size_t i = 0; i < n / 3; i++)
+    d.Add(points[i]);
+  double xx2, xy2, yy2;
+  b.GetCovariance(xx, xy, yy);
+  d.GetCovariance(xx2, xy2, yy2);
+  CHECK(b.Count() == n / 3);
+  CHECK(std::abs(b.Centroid().x() - d.Centroid().x()) < 1.0e-10);
+  CHECK(std::abs(xx - xx2) < 1.0e-10);
+  CHECK(std::abs(xy - xy2) < 1.0e-10);
+  CHECK(std::abs(yy - yy2) < 1.0e-10);
+
+  //Array add, single and multi threaded
+  for (unsigned t = 1; t <= 3; t++)
+  {
+    accd e;
+    e.Add(points.data(), n, t);
+    e.GetCovariance(xx, xy, yy);
+    CHECK(e.Count() == n);
+    CHECK(std::abs(e.Centroid().y() - my) < 1.0e-12);
+    CHECK(std::abs(xx - sxx) < 1.0e-12);
+    CHECK(std::abs(xy - sxy) < 1.0e-12);
+    CHECK(std::abs(yy - syy) < 1.0e-12);
+  }
+
+  //Removing the last point empties the accumulator
+  accd f;
+  f.Add(points[0]);
+  f.Remove(points[0]);
+  CHECK(f.Count() == 0);
+}
+
+TEST(Stack_DgR2Regression_Precision, DgR2Regression_Precision)
+{
+  //Points far from the origin. Naive sums of squares lose everything in
+  //float; the accumulator keeps the variance to a few digits.
+  size_t const n = 10000;
+  std::vector<vec2> points(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    float t = float(i % 100) * 0.01f;
+    points[i] = vec2(10000.0f + t, 10000.0f + 2.0f * t, 1.0f);
+  }
+
+  //Var of t over 0, 0.01, ... 0.99
+  double const expected = (100.0 * 100.0 - 1.0) / 12.0 * 1.0e-4;
+
+  accf a;
+  for (size_t i = 0; i < n; i++)
+    a.Add(points[i]);
+  float xx, xy, yy;
+  a.GetCovariance(xx, xy, yy);
+  CHECK(std::abs(xx - expected) < 1.0e-3 * expected);
+  CHECK(std::abs(xy - 2.0 * expected) < 2.0e-3 * expected);
+  CHECK(std::abs(yy - 4.0 * expected) < 4.0e-3 * expected);
+
+  accf b;
+  b.Add(points.data(), n, 2);
+  b.GetCovariance(xx, xy, yy);
+  CHECK(std::abs(xx - expected) < 1.0e-3 * expected);
+  CHECK(std::abs(xy - 2.0 * expected) < 2.0e-3 * expected);
+  CHECK(std::abs(yy - 4.0 * expected) < 4.0e-3 * expected);
+}
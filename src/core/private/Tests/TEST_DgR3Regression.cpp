@@ -0,0 +1,110 @@
+#include <random>
+#include <cmath>
+
+#include "TestHarness.h"
+#include "DgR3Regression.h"
+
+typedef double Real;
+typedef Dg::R3::Vector<Real>  vec;
+typedef Dg::R3::PlaneFitAccumulator<Real> acc;
+
+TEST(Stack_DgR3Regression, DgR3Regression)
+{
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<Real> uniform(-1.0, 1.0);
+
+  //Points spread over the plane through c with normal n, long along u
+  vec n(1.0, 2.0, 2.0, 0.0);
+  n.Normalize();
+  vec u(2.0, -2.0, 1.0, 0.0);
+  u.Normalize();
+  vec v = n.Cross(u);
+  vec c(10.0, -4.0, 3.0, 1.0);
+
+  size_t const count = 2000;
+  std::vector<vec> points(count);
+  for (size_t i = 0; i < count; i++)
+    points[i] = c + 5.0 * uniform(gen) * u + 1.0 * uniform(gen) * v + 0.001 * uniform(gen) * n;
+
+  acc a;
+  for (size_t i = 0; i < count; i++)
+    a.Add(points[i]);
+  CHECK(a.Count() == count);
+
+  vec axes[3];
+  Real variances[3];
+  a.GetPrincipalAxes(axes, variances);
+  CHECK(variances[0] > variances[1] && variances[1] > variances[2]);
+  CHECK(std::abs(std::abs(axes[0].Dot(u)) - 1.0) < 1.0e-4);
+  CHECK(std::abs(std::abs(axes[1].Dot(v)) - 1.0) < 1.0e-4);
+  CHECK(std::abs(std::abs(axes[2].Dot(n)) - 1.0) < 1.0e-8);
+  CHECK(std::abs(axes[0].Dot(axes[1])) < 1.0e-12);
+  CHECK(std::abs(axes[0].Dot(axes[2])) < 1.0e-12);
+  CHECK(std::abs(axes[1].Dot(axes[2])) < 1.0e-12);
+
+  //Uniform over [-a, a] has variance a^2 / 3
+  CHECK(std::abs(variances[0] - 25.0 / 3.0) < 0.5);
+  CHECK(std::abs(variances[1] - 1.0 / 3.0) < 0.05);
+
+  Dg::R3::Plane<Real> plane = a.GetPlane();
+  CHECK(std::abs(std::abs(plane.Normal().Dot(n)) - 1.0) < 1.0e-8);
+  CHECK(std::abs(plane.Distance(c)) < 1.0e-3);
+
+  Dg::R3::Line<Real> line = a.GetLine();
+  CHECK(std::abs(std::abs(line.Direction().Dot(u)) - 1.0) < 1.0e-4);
+
+  //Merge, remove and array add agree with the single pass
+  acc b, d;
+  for (size_t i = 0; i < count / 2; i++)
+    b.Add(points[i]);
+  for (size_t i = count / 2; i < count; i++)
+    d.Add(points[i]);
+  b.Merge(d);
+
+  acc e;
+  e.Add(points.data(), count, 3);
+
+  vec axesB[3], axesE[3];
+  Real variancesB[3], variancesE[3];
+  b.GetPrincipalAxes(axesB, variancesB);
+  e.GetPrincipalAxes(axesE, variancesE);
+  for (int i = 0; i < 3; i++)
+  {
+    CHECK(std::abs(variancesB[i] - variances[i]) < 1.0e-10);
+    CHECK(std::abs(variancesE[i] - variances[i]) < 1.0e-10);
+  }
+  CHECK(Dg::R3::Distance(b.Centroid(), a.Centroid()) < 1.0e-10);
+  CHECK(Dg::R3::Distance(e.Centroid(), a.Centroid()) < 1.0e-10);
+
+  for (size_t i = count / 2; i < count; i++)
+    b.Remove(points[i]);
+  acc f;
+  for (size_t i = 0; i < count / 2; i++)
+    f.Add(points[i]);
+  b.GetPrincipalAxes(axesB, variancesB);
+  f.GetPrincipalAxes(axesE, variancesE);
+  CHECK(b.Count() == count / 2);
+  for (int i = 0; i < 3; i++)
+    CHECK(std::abs(variancesB[i] - variancesE[i]) < 1.0e-8);
+}
+
+TEST(Stack_DgR3Regression_Degenerate, DgR3Regression_Degenerate)
+{
+  //Diagonal covariance; axes come back sorted
+  vec points[6] = {vec(3.0, 0.0, 0.0, 1.0), vec(-3.0, 0.0, 0.0, 1.0),
+                   vec(0.0, 0.0, 2.0, 1.0), vec(0.0, 0.0, -2.0, 1.0),
+                   vec(0.0, 1.0, 0.0, 1.0), vec(0.0, -1.0, 0.0, 1.0)};
+  acc a;
+  a.Add(points, 6, 1);
+
+  vec axes[3];
+  Real variances[3];
+  a.GetPrincipalAxes(axes, variances);
+  CHECK(std::abs(variances[0] - 3.0) < 1.0e-12);
+  CHECK(std::abs(variances[1] - 4.0 / 3.0) < 1.0e-12);
+  CHECK(std::abs(variances[2] - 1.0 / 3.0) < 1.0e-12);
+  CHECK(std::abs(std::abs(axes[0].x()) - 1.0) < 1.0e-12);
+  CHECK(std::abs(std::abs(axes[1].z()) - 1.0) < 1.0e-12);
+  CHECK(std::abs(std::abs(axes[2].y()) - 1.0) < 1.0e-12);
+  CHECK(axes[0].w() == 0.0);
+}
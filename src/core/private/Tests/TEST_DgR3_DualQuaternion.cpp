@@ -0,0 +1,163 @@
+#include "TestHarness.h"
+#include <vector>
+#include "DgR3Vector.h"
+#include "DgR3Quaternion.h"
+#include "DgR3VQS.h"
+#include "DgR3DualQuaternion.h"
+
+typedef Dg::R3::Quaternion<double>      quat;
+typedef Dg::R3::Vector<double>          vec4;
+typedef Dg::R3::VQS<double>             VQS;
+typedef Dg::R3::DualQuaternion<double>  DQ;
+
+typedef Dg::R3::Quaternion<float>       quatf;
+typedef Dg::R3::Vector<float>           vec4f;
+typedef Dg::R3::DualQuaternion<float>   DQf;
+typedef Dg::R3::SkinInfluences<float>   Influencesf;
+
+//--------------------------------------------------------------------------------
+//	DualQuaternion Construction
+//--------------------------------------------------------------------------------
+TEST(Stack_DualQuaternion_Construction, creation_DualQuaternion_Construction)
+{
+  vec4 v(23.4, -84.2, 0.2134, 0.0);
+  quat q;
+  q.SetRotation(2.45, 0.8354, -1.345, Dg::EulerOrder::XYX);
+
+  DQ dq0;
+  CHECK(dq0.GetRotation() == quat());
+  CHECK(dq0.GetTranslation() == vec4::ZeroVector());
+
+  DQ dq1(q, v);
+  CHECK(dq1.GetRotation() == q);
+  CHECK(dq1.GetTranslation() == v);
+  CHECK(dq1 != dq0);
+
+  VQS vqs(v, q, 1.0);
+  DQ dq2(vqs);
+  CHECK(dq2 == dq1);
+  CHECK(dq2.GetVQS() == vqs);
+
+  dq2.Identity();
+  CHECK(dq2 == dq0);
+
+  dq2.Set(vqs);
+  CHECK(dq2 == dq1);
+
+  DQ dq3(q);
+  CHECK(dq3.GetTranslation() == vec4::ZeroVector());
+
+  dq3 = dq1 * 3.0;
+  dq3.Normalize();
+  CHECK(dq3 == dq1);
+}
+
+
+//--------------------------------------------------------------------------------
+//	DualQuaternion Transform
+//--------------------------------------------------------------------------------
+TEST(Stack_DualQuaternion_Transform, creation_DualQuaternion_Transform)
+{
+  vec4 v0(23.4, -84.2, 0.2134, 0.0), v1(-1.5, 3.25, 9.0, 0.0);
+  quat q0, q1;
+  q0.SetRotation(2.45, 0.8354, -1.345, Dg::EulerOrder::XYX);
+  q1.SetRotation(-0.3, 1.2, 0.75, Dg::EulerOrder::ZYX);
+
+  VQS vqs0(v0, q0, 1.0), vqs1(v1, q1, 1.0);
+  DQ dq0(vqs0), dq1(vqs1);
+
+  vec4 p(3.5, -2.0, 7.25, 1.0), n(0.0, 1.0, 0.0, 0.0);
+  CHECK(dq0.TransformPoint(p) == vqs0.TransformPoint(p));
+  CHECK(dq0.TransformVector(n) == vqs0.TransformVector(n));
+
+  //Concatenation is left to right, as with VQS
+  DQ dq01 = dq0 * dq1;
+  VQS vqs01 = vqs0 * vqs1;
+  CHECK(dq01.TransformPoint(p) == vqs01.TransformPoint(p));
+  CHECK(dq01.GetVQS() == vqs01);
+
+  DQ dq2(dq0);
+  dq2 *= dq1;
+  CHECK(dq2 == dq01);
+
+  CHECK(dq0.GetInverse().TransformPoint(dq0.TransformPoint(p)) == p);
+  CHECK((dq0 * dq0.GetInverse()).GetTranslation() == vec4::ZeroVector());
+}
+
+
+//--------------------------------------------------------------------------------
+//	DualQuaternion Skinning
+//--------------------------------------------------------------------------------
+TEST(Stack_DualQuaternion_Skinning, creation_DualQuaternion_Skinning)
+{
+  size_t const nBones = 6;
+  std::vector<DQf> palette(nBones);
+  for (size_t i = 0; i < nBones; i++)
+  {
+    quatf q;
+    q.SetRotation(0.4f * float(i), -0.3f * float(i), 0.7f, Dg::EulerOrder::ZYX);
+    palette[i].Set(q, vec4f(float(i), -2.0f * float(i), 0.5f, 0.0f));
+  }
+
+  //Covers the 4-wide blocks and the tail
+  size_t const count = 103;
+  std::vector<Influencesf> influences(count);
+  std::vector<vec4f> points(count), normals(count), pOut(count), nOut(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    float w[4] = {1.0f, 0.5f * float(i % 3), 0.25f * float(i % 5), 0.0f};
+    float sum = w[0] + w[1] + w[2] + w[3];
+    for (int k = 0; k < 4; k++)
+    {
+      influences[i].bones[k] = uint32_t((i + k * 2) % nBones);
+      influences[i].weights[k] = w[k] / sum;
+    }
+    points[i] = vec4f(0.1f * float(i), 2.0f - 0.05f * float(i), 1.5f, 1.0f);
+    normals[i] = vec4f(0.0f, 0.6f, 0.8f, 0.0f);
+  }
+
+  //Single full-weight influence is the bone transform
+  influences[5].weights[0] = 1.0f;
+  influences[5].weights[1] = influences[5].weights[2] = influences[5].weights[3] = 0.0f;
+
+  //A zero weighted sum leaves the vertex alone
+  for (int k = 0; k < 4; k++)
+    influences[6].weights[k] = 0.0f;
+
+  Dg::R3::SkinVertices(palette.data(), influences.data(), points.data(), pOut.data(),
+                       normals.data(), nOut.data(), count, 2);
+
+  bool good = true;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (i == 6)
+      continue;
+
+    DQf const & dq0 = palette[influences[i].bones[0]];
+    DQf blend;
+    blend = dq0 * 0.0f;
+    for (int k = 0; k < 4; k++)
+    {
+      DQf const & dq = palette[influences[i].bones[k]];
+      float w = influences[i].weights[k];
+      if (Dg::R3::Dot(dq0.GetReal(), dq.GetReal()) < 0.0f)
+        w = -w;
+      blend += dq * w;
+    }
+    blend.Normalize();
+    good = good && (pOut[i] == blend.TransformPoint(points[i]));
+    good = good && (nOut[i] == blend.TransformVector(normals[i]));
+  }
+  CHECK(good);
+  CHECK(pOut[5] == palette[influences[5].bones[0]].TransformPoint(points[5]));
+  CHECK(pOut[6] == points[6] && nOut[6] == normals[6]);
+
+  //In place, without normals
+  std::vector<vec4f> inPlace(points);
+  Dg::R3::SkinVertices(palette.data(), influences.data(), inPlace.data(), inPlace.data(),
+                       (vec4f const *)nullptr, (vec4f *)nullptr, count);
+  good = true;
+  for (size_t i = 0; i < count; i++)
+    good = good && (inPlace[i] == pOut[i]);
+  CHECK(good);
+}
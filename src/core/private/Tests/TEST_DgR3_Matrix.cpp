@@ -441,4 +441,90 @@ TEST(Stack_Matrix44_Rotation, creation_Matrix44_Rotation)
 
   CHECK(q0.Rotate(v) == v * m0);
 
-}
\ No newline at end of file
+}
+
+//--------------------------------------------------------------------------------
+//	Matrix Kernels
+//--------------------------------------------------------------------------------
+static bool AreClose(float a_val, double a_ref, double a_tol)
+{
+  return fabs(static_cast<double>(a_val) - a_ref) < a_tol;
+}
+
+TEST(Stack_Matrix44_Kernels, creation_Matrix44_Kernels)
+{
+  //float operations may take the SIMD path, double always takes the scalar one
+  typedef Dg::R3::Matrix<double> mat44d;
+  typedef Dg::R3::Vector<double> vec3d;
+
+  mat44 ms, mr, mt;
+  ms.Scaling(vec3({ 1.34f, 0.39f, 4.3f, 0.0f }));
+  mr.Rotation(0.234f, -1.49f, 2.457f, Dg::EulerOrder::ZXY);
+  mt.Translation(vec3({ 2.3f, 5.24f, -12.9f, 0.0f }));
+
+  mat44 m0 = ms * mr * mt;
+  mat44 m1 = mr * mt * ms;
+  mat44d m0d, m1d;
+  for (size_t i = 0; i < 16; i++)
+  {
+    m0d[i] = m0[i];
+    m1d[i] = m1[i];
+  }
+
+  mat44 m2 = m0 * m1;
+  mat44d m2d = m0d * m1d;
+  for (size_t i = 0; i < 16; i++)
+    CHECK(AreClose(m2[i], m2d[i], 1.0e-3));
+
+  mat44 m3 = m0;
+  m3 *= m1;
+  CHECK(m3 == m2);
+
+  mat44 mT = Transpose(m0);
+  mat44d mTd = Transpose(m0d);
+  for (size_t i = 0; i < 16; i++)
+    CHECK(mT[i] == static_cast<float>(mTd[i]));
+  mT.Transpose();
+  CHECK(mT == m0);
+
+  vec3 v(1.34f, -8.834f, -9.38f, 1.0f);
+  vec3 u(-0.3f, 2.5f, 7.1f, 0.0f);
+  vec3d vd(v[0], v[1], v[2], v[3]);
+  vec3d ud(u[0], u[1], u[2], u[3]);
+
+  vec3 vt = v * m0;
+  vec3d vtd = vd * m0d;
+  for (size_t i = 0; i < 4; i++)
+    CHECK(AreClose(vt[i], vtd[i], 1.0e-4));
+
+  CHECK(AreClose(v.Dot(u), vd.Dot(ud), 1.0e-4));
+  CHECK(AreClose(v.Length(), vd.Length(), 1.0e-4));
+
+  vec3 c = v.Cross(u);
+  vec3d cd = vd.Cross(ud);
+  for (size_t i = 0; i < 4; i++)
+    CHECK(AreClose(c[i], cd[i], 1.0e-4));
+  CHECK(c[3] == 0.0f);
+
+  v.Normalize();
+  CHECK(v.IsUnit());
+  vec3 z = vec3::ZeroVector();
+  z.Normalize();
+  CHECK(z == vec3::xAxis());
+
+  //The inverse must undo the transform, not just invert back to itself
+  mat44 mi = m0.GetAffineInverse();
+  mat44d mid = m0d.GetAffineInverse();
+  CHECK((m0 * mi).IsIdentity());
+  CHECK((m0d * mid).IsIdentity());
+  for (size_t i = 0; i < 16; i++)
+    CHECK(AreClose(mi[i], mid[i], 1.0e-4));
+
+  mi = m0;
+  mi.SetAffineInverse();
+  CHECK((mi * m0).IsIdentity());
+
+  mat44 singular;
+  singular.Scaling(0.0f);
+  CHECK(singular.GetAffineInverse().IsIdentity());
+}
@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "TestHarness.h"
 #include "DgR3Vector.h"
 #include "DgR3Quaternion.h"
@@ -314,6 +316,96 @@ TEST(Stack_Quaternion_Slerp, creation_Quaternion_Slerp)
 }
 
 
+//-------------------------------------------------------------------------------
+//		Batch s/lerp and pose blending
+//-------------------------------------------------------------------------------
+TEST(Stack_Quaternion_Batch, creation_Quaternion_Batch)
+{
+  //Covers the 4-wide blocks, the tail, and pairs more than 90 degrees apart
+  size_t const count = 103;
+  std::vector<quat> q0(count), q1(count), out(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    q0[i].SetRotation(0.03f * float(i), -0.02f * float(i), 0.5f, Dg::EulerOrder::ZYX);
+    q1[i].SetRotation(-0.5f, 0.05f * float(i), 0.01f * float(i), Dg::EulerOrder::XYZ);
+  }
+  q1[7] = -q0[7];
+  q1[8] = q0[8];
+
+  float ts[3] = {0.0f, 0.37f, 1.0f};
+  for (int k = 0; k < 3; k++)
+  {
+    Dg::R3::Slerp(out.data(), q0.data(), q1.data(), ts[k], count, 2);
+    bool good = true;
+    for (size_t i = 0; i < count; i++)
+    {
+      quat expected;
+      Dg::R3::Slerp(expected, q0[i], q1[i], ts[k]);
+      good = good && (out[i] == expected);
+    }
+    CHECK(good);
+
+    Dg::R3::ApproxSlerp(out.data(), q0.data(), q1.data(), ts[k], count, 2);
+    good = true;
+    for (size_t i = 0; i < count; i++)
+    {
+      quat expected;
+      Dg::R3::ApproxSlerp(expected, q0[i], q1[i], ts[k]);
+      good = good && (out[i] == expected);
+    }
+    CHECK(good);
+  }
+
+  //ApproxSlerp stays close to slerp once normalised
+  Dg::R3::ApproxSlerp(out.data(), q0.data(), q1.data(), 0.37f, count);
+  bool close = true;
+  for (size_t i = 0; i < count; i++)
+  {
+    quat expected;
+    Dg::R3::Slerp(expected, q0[i], q1[i], 0.37f);
+    out[i].Normalize();
+    close = close && std::abs(Dg::R3::Dot(out[i], expected)) > 0.999f;
+  }
+  CHECK(close);
+
+  //Two pose blend is a normalised lerp on the shorter path
+  quat const * poses[3] = {q0.data(), q1.data(), out.data()};
+  float weights[3] = {0.75f, 0.25f, 0.0f};
+  Dg::R3::BlendPoses(out.data(), poses, weights, 3, count, 2);
+  bool good = true;
+  for (size_t i = 0; i < count; i++)
+  {
+    quat expected;
+    Dg::R3::Lerp(expected, q0[i], q1[i], 0.25f);
+    expected.Normalize();
+    good = good && std::abs(Dg::R3::Dot(out[i], expected)) > 0.9999f && Dg::AreEqual(out[i].Norm(), 1.0f);
+  }
+  CHECK(good);
+
+  //Opposite halves of the same rotation cancel, giving the identity
+  quat neg = -q0[3];
+  quat const * cancel[2] = {&q0[3], &neg};
+  float half[2] = {0.5f, -0.5f};
+  quat id;
+  Dg::R3::BlendPoses(&id, cancel, half, 2, 1);
+  CHECK(id.IsIdentity());
+
+  //More poses than fit on the stack
+  quat const * many[20];
+  float manyWeights[20];
+  for (int p = 0; p < 20; p++)
+  {
+    many[p] = q1.data();
+    manyWeights[p] = 0.05f;
+  }
+  Dg::R3::BlendPoses(out.data(), many, manyWeights, 20, count);
+  good = true;
+  for (size_t i = 0; i < count; i++)
+    good = good && std::abs(Dg::R3::Dot(out[i], q1[i])) > 0.9999f;
+  CHECK(good);
+}
+
+
 //-------------------------------------------------------------------------------
 //		Get matrix
 //-------------------------------------------------------------------------------
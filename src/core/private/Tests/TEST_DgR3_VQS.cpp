@@ -1,4 +1,5 @@
 #include "TestHarness.h"
+#include <vector>
 #include "DgR3Vector.h"
 #include "DgR3Quaternion.h"
 #include "DgR3Matrix.h"
@@ -94,4 +95,57 @@ TEST(Stack_VQS_VectorTransform, creation_VQS_VectorTransform)
 
   CHECK(result_VQS == result_M);
 
-}
\ No newline at end of file
+}
+
+//--------------------------------------------------------------------------------
+//	VQS Batch transforms
+//--------------------------------------------------------------------------------
+TEST(Stack_VQS_BatchTransform, creation_VQS_BatchTransform)
+{
+  typedef Dg::R3::Vector<float> vec4f;
+
+  Dg::R3::Quaternion<float> q;
+  q.SetRotation(0.45f, -1.2f, 2.1f, Dg::EulerOrder::ZYX);
+  Dg::R3::VQS<float> vqs(vec4f(4.0f, -2.5f, 1.9f, 0.0f), q, 1.5f);
+  Dg::R3::Matrix<float> m;
+  vqs.GetMatrix(m);
+
+  //Odd count so every path, including the tail, is used. The large count
+  //is split over threads.
+  size_t const counts[2] = { 37, 50000 };
+  for (size_t c = 0; c < 2; c++)
+  {
+    size_t n = counts[c];
+    std::vector<vec4f> in(n), out(n);
+    for (size_t i = 0; i < n; i++)
+      in[i].Set(float(i % 17) - 8.0f, float(i % 5) * 0.5f, -float(i % 11), (i % 2) ? 1.0f : 0.0f);
+
+    bool good = true;
+
+    vqs.TransformPoints(in.data(), out.data(), n, 4);
+    for (size_t i = 0; i < n; i++)
+      good = good && (out[i] == vqs.TransformPoint(in[i]));
+
+    vqs.TransformVectors(in.data(), out.data(), n, 4);
+    for (size_t i = 0; i < n; i++)
+      good = good && (out[i] == vqs.TransformVector(in[i]));
+
+    q.Rotate(in.data(), out.data(), n, 4);
+    for (size_t i = 0; i < n; i++)
+      good = good && (out[i] == q.Rotate(in[i]));
+
+    m.Transform(in.data(), out.data(), n, 4);
+    for (size_t i = 0; i < n; i++)
+      good = good && (out[i] == in[i] * m);
+
+    //In place
+    out = in;
+    vqs.TransformPoints(out.data(), out.data(), n, 4);
+    for (size_t i = 0; i < n; i++)
+      good = good && (out[i] == vqs.TransformPoint(in[i]));
+
+    CHECK(good);
+  }
+
+  vqs.TransformPoints(nullptr, nullptr, 0);
+}
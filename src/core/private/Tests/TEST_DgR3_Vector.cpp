@@ -165,4 +165,15 @@ TEST(Stack_Vector4_Other, creation_Vector4_Other)
   CHECK(v0 == vec3(1.0f, 0.0f, 0.0f, 0.0f));
   CHECK(v1 == vec3(0.0f, 1.0f, 0.0f, 0.0f));
   CHECK(v2 == vec3(0.0f, 0.0f, 1.0f, 0.0f));
+
+  // Arithmetic results are vectors ///////////////////////
+
+  vec3 a(1.0f, 2.0f, 3.0f, 0.0f);
+  vec3 b(0.0f, 1.0f, 0.0f, 0.0f);
+  vec3 c(1.0f, 0.0f, 0.0f, 0.0f);
+  CHECK(Dg::Dot(-a, b) == -2.0f);
+  CHECK((a - b).Dot(c) == 1.0f);
+  CHECK((a - b - a).Length() == 1.0f);
+  CHECK((b + c).Cross(c) == vec3(0.0f, 0.0f, -1.0f, 0.0f));
+  CHECK(a * 2.0 - b / 2.0f == vec3(2.0f, 3.5f, 6.0f, 0.0f));
 }
\ No newline at end of file
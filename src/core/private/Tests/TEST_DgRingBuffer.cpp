@@ -0,0 +1,167 @@
+#include "TestHarness.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DgRingBuffer.h"
+
+TEST(Stack_DgRingBuffer_SPSC, creation_DgRingBuffer_SPSC)
+{
+  Dg::SPSCRingBuffer<std::string> buf(5);
+  CHECK(buf.capacity() == 8);
+  CHECK(buf.empty());
+
+  std::string str;
+  CHECK(!buf.TryPop(str));
+
+  for (int i = 0; i < 8; i++)
+    CHECK(buf.TryPush(std::to_string(i)));
+  CHECK(!buf.TryPush(std::string("full")));
+  CHECK(buf.size() == 8);
+
+  CHECK(buf.TryPop(str));
+  CHECK(str == "0");
+
+  //Batches are cut short when there is not enough room
+  std::string items[3] = {"a", "b", "c"};
+  CHECK(buf.TryPushN(items, 3) == 1);
+
+  std::string out[16];
+  CHECK(buf.TryPopN(out, 16) == 8);
+  CHECK(out[0] == "1");
+  CHECK(out[6] == "7");
+  CHECK(out[7] == "a");
+  CHECK(buf.empty());
+
+  //Wrap around, leaving items behind for the destructor
+  CHECK(buf.TryPushN(items, 3) == 3);
+  CHECK(buf.TryPopN(out, 2) == 2);
+  CHECK(out[1] == "b");
+  CHECK(buf.TryPushN(items, 3) == 3);
+  CHECK(buf.size() == 4);
+}
+
+TEST(Stack_DgRingBuffer_SPSC_threaded, creation_DgRingBuffer_SPSC_threaded)
+{
+  unsigned const nItems = 100000;
+  Dg::SPSCRingBuffer<unsigned> buf(64);
+
+  std::thread producer([&buf, nItems]()
+  {
+    unsigned batch[7];
+    unsigned next = 0;
+    while (next < nItems)
+    {
+      if (next % 3 == 0)
+      {
+        buf.Push(next++);
+        continue;
+      }
+      unsigned n = 0;
+      for (; n < 7 && next + n < nItems; n++)
+        batch[n] = next + n;
+      next += (unsigned)buf.TryPushN(batch, n);
+    }
+  });
+
+  bool inOrder = true;
+  unsigned expected = 0;
+  unsigned out[16];
+  while (expected < nItems)
+  {
+    if (expected % 2 == 0)
+    {
+      unsigned val = 0;
+      buf.Pop(val);
+      inOrder = inOrder && val == expected++;
+      continue;
+    }
+    size_t n = buf.TryPopN(out, 16);
+    for (size_t i = 0; i < n; i++)
+      inOrder = inOrder && out[i] == expected++;
+  }
+  producer.join();
+
+  CHECK(inOrder);
+  CHECK(buf.empty());
+}
+
+TEST(Stack_DgRingBuffer_MPSC, creation_DgRingBuffer_MPSC)
+{
+  Dg::MPSCRingBuffer<std::string> buf(4);
+  CHECK(buf.capacity() == 4);
+
+  std::string items[3] = {"a", "b", "c"};
+  CHECK(buf.TryPushN(items, 3) == 3);
+  CHECK(buf.TryPushN(items, 3) == 1);
+  CHECK(!buf.TryPush(std::string("full")));
+
+  std::string str;
+  CHECK(buf.TryPop(str));
+  CHECK(str == "a");
+  CHECK(buf.TryPush(std::string("d")));
+
+  std::string out[8];
+  CHECK(buf.TryPopN(out, 8) == 4);
+  CHECK(out[0] == "b");
+  CHECK(out[2] == "a");
+  CHECK(out[3] == "d");
+  CHECK(!buf.TryPop(str));
+
+  CHECK(buf.TryPushN(items, 2) == 2);
+}
+
+TEST(Stack_DgRingBuffer_MPSC_threaded, creation_DgRingBuffer_MPSC_threaded)
+{
+  unsigned const nProducers = 4;
+  unsigned const nPerProducer = 50000;
+  Dg::MPSCRingBuffer<unsigned> buf(128);
+
+  //Each item is (producer << 24) | sequence
+  std::vector<std::thread> producers;
+  for (unsigned p = 0; p < nProducers; p++)
+  {
+    producers.push_back(std::thread([&buf, p, nPerProducer]()
+    {
+      unsigned batch[5];
+      unsigned next = 0;
+      while (next < nPerProducer)
+      {
+        if (next % 2 == 0)
+        {
+          buf.Push((p << 24) | next++);
+          continue;
+        }
+        unsigned n = 0;
+        for (; n < 5 && next + n < nPerProducer; n++)
+          batch[n] = (p << 24) | (next + n);
+        next += (unsigned)buf.TryPushN(batch, n);
+      }
+    }));
+  }
+
+  std::vector<unsigned> expected(nProducers, 0);
+  bool inOrder = true;
+  unsigned out[32];
+  for (unsigned received = 0; received < nProducers * nPerProducer;)
+  {
+    size_t n = buf.TryPopN(out, 32);
+    if (n == 0)
+    {
+      buf.Pop(out[0]);
+      n = 1;
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+      unsigned p = out[i] >> 24;
+      inOrder = inOrder && p < nProducers && (out[i] & 0xFFFFFF) == expected[p]++;
+    }
+    received += (unsigned)n;
+  }
+
+  for (auto & t : producers)
+    t.join();
+
+  CHECK(inOrder);
+  CHECK(buf.empty());
+}
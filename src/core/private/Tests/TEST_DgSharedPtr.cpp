@@ -1,4 +1,7 @@
 #include "TestHarness.h"
+#include <thread>
+#include <vector>
+
 #include "Dg_shared_ptr.h"
 
 TEST(Stack_DgSharedPtr, creation_DgSharedPtr)
@@ -12,4 +15,105 @@ TEST(Stack_DgSharedPtr, creation_DgSharedPtr)
   int i = *p1;
 
   CHECK(i == a);
-}
\ No newline at end of file
+}
+
+namespace
+{
+  struct Counted
+  {
+    Counted(int a_val) : val(a_val) { s_alive++; }
+    ~Counted() { s_alive--; }
+    int val;
+    static int s_alive;
+  };
+  int Counted::s_alive = 0;
+
+  struct Derived : public Counted
+  {
+    Derived(int a_val) : Counted(a_val) {}
+  };
+
+  struct Node : public Dg::RefCounted<Node, Dg::AtomicRefCount>
+  {
+    Node(int a_val) : val(a_val) { s_alive++; }
+    ~Node() { s_alive--; }
+    int val;
+    static int s_alive;
+  };
+  int Node::s_alive = 0;
+}
+
+TEST(Stack_DgMakeShared, creation_DgMakeShared)
+{
+  {
+    Dg::shared_ptr<Counted> empty;
+    CHECK(!empty);
+    CHECK(empty.use_count() == 0);
+
+    Dg::shared_ptr<Counted> p0 = Dg::make_shared<Counted>(3);
+    CHECK(Counted::s_alive == 1);
+    CHECK(p0->val == 3);
+    CHECK(p0.use_count() == 1);
+
+    Dg::shared_ptr<Counted> p1(p0);
+    empty = p1;
+    CHECK(p0.use_count() == 3);
+    CHECK(empty == p0);
+
+    Dg::shared_ptr<Counted> p2(std::move(p1));
+    CHECK(!p1);
+    CHECK(p2.use_count() == 3);
+
+    p0.reset();
+    empty.reset();
+    CHECK(Counted::s_alive == 1);
+
+    Dg::shared_ptr<Counted> base(Dg::make_shared<Derived>(7));
+    CHECK(base->val == 7);
+    CHECK(Counted::s_alive == 2);
+
+    Dg::shared_ptr<Counted> raw(new Counted(9));
+    CHECK(raw.use_count() == 1);
+  }
+  CHECK(Counted::s_alive == 0);
+
+  //Copies made and dropped across threads
+  {
+    auto p = Dg::make_shared<Counted, Dg::AtomicRefCount>(5);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+      threads.push_back(std::thread([p]()
+      {
+        for (int i = 0; i < 10000; i++)
+        {
+          Dg::shared_ptr<Counted, Dg::DefaultDeleter<Counted>, Dg::AtomicRefCount> copy(p);
+          (void)copy;
+        }
+      }));
+    }
+    for (auto & thread : threads)
+      thread.join();
+    CHECK(p.use_count() == 1);
+  }
+  CHECK(Counted::s_alive == 0);
+}
+
+TEST(Stack_DgIntrusivePtr, creation_DgIntrusivePtr)
+{
+  {
+    Dg::intrusive_ptr<Node> p0(new Node(4));
+    CHECK(p0->ref_count() == 1);
+    Dg::intrusive_ptr<Node> p1 = p0;
+    CHECK(p0->ref_count() == 2);
+
+    //The count travels with the object, so a raw pointer can be re-wrapped
+    Dg::intrusive_ptr<Node> p2(p1.get());
+    CHECK(p0->ref_count() == 3);
+    p1.reset();
+    p0 = Dg::intrusive_ptr<Node>();
+    CHECK(Node::s_alive == 1);
+    CHECK(p2->val == 4);
+  }
+  CHECK(Node::s_alive == 0);
+}
@@ -0,0 +1,114 @@
+#include "TestHarness.h"
+#include <map>
+#include <vector>
+
+#include "DgSlotMap.h"
+
+TEST(Stack_DgSlotMap, creation_DgSlotMap)
+{
+  Dg::SlotMap<int> map;
+  CHECK(map.empty());
+  CHECK(!map.contains(Dg::SlotMap<int>::InvalidHandle));
+
+  uint32_t h0 = map.insert(10);
+  uint32_t h1 = map.insert(11);
+  uint32_t h2 = map.emplace(12);
+
+  CHECK(map.size() == 3);
+  CHECK(map[h0] == 10);
+  CHECK(map.at(h1) == 11);
+  CHECK(*map.find(h2) == 12);
+
+  //Erased handles go stale, even once the slot is reused
+  CHECK(map.erase(h1));
+  CHECK(!map.erase(h1));
+  CHECK(map.find(h1) == nullptr);
+  try {map.at(h1); CHECK(false);} catch (std::out_of_range const &) {}
+
+  uint32_t h3 = map.insert(13);
+  CHECK(h3 != h1);
+  CHECK((h3 & 0xFFFFF) == (h1 & 0xFFFFF));
+  CHECK(!map.contains(h1));
+  CHECK(map[h3] == 13);
+
+  //Values stay packed
+  int sum = 0;
+  for (int val : map)
+    sum += val;
+  CHECK(sum == 10 + 12 + 13);
+  for (size_t i = 0; i < map.size(); i++)
+    CHECK(map[map.handle_at(i)] == map.data()[i]);
+
+  Dg::SlotMap<int> map1(map);
+  map.clear();
+  CHECK(map.empty());
+  CHECK(!map.contains(h0));
+  CHECK(map1.size() == 3);
+  CHECK(map1[h0] == 10);
+  CHECK(map1[h3] == 13);
+
+  Dg::SlotMap<int> map2(std::move(map1));
+  CHECK(map1.empty());
+  CHECK(map2[h2] == 12);
+
+  //Inserting a value held by the map as it grows
+  uint32_t h4 = map2.insert(14);
+  while (map2.size() < map2.pool_size())
+    map2.insert(0);
+  uint32_t h5 = map2.insert(map2[h4]);
+  CHECK(map2[h5] == 14 && map2[h4] == 14 && map2[h2] == 12);
+}
+
+TEST(Stack_DgSlotMapRandom, creation_DgSlotMapRandom)
+{
+  Dg::SlotMap<int, uint64_t> map;
+  std::map<uint64_t, int> reference;
+  std::vector<uint64_t> stale;
+  unsigned seed = 42;
+  bool good = true;
+
+  for (int i = 0; i < 20000; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    if ((seed >> 16) % 3 != 0 || reference.empty())
+    {
+      int val = i;
+      uint64_t h = map.insert(val);
+      good = good && reference.count(h) == 0;
+      reference[h] = val;
+    }
+    else
+    {
+      auto it = reference.begin();
+      std::advance(it, (seed >> 8) % reference.size());
+      good = good && map.erase(it->first);
+      stale.push_back(it->first);
+      reference.erase(it);
+    }
+  }
+
+  good = good && (map.size() == reference.size());
+  for (auto const & kv : reference)
+    good = good && map.contains(kv.first) && map[kv.first] == kv.second;
+  for (uint64_t h : stale)
+    good = good && !map.contains(h);
+  CHECK(good);
+}
+
+TEST(Stack_DgSlotMapRetire, creation_DgSlotMapRetire)
+{
+  //4 bits of generation: a slot can be filled 8 times before it is retired
+  Dg::SlotMap<int, uint8_t, 4> map;
+  uint8_t first = map.insert(0);
+  uint8_t h = first;
+  for (int i = 0; i < 7; i++)
+  {
+    map.erase(h);
+    h = map.insert(i);
+    CHECK((h & 0xF) == (first & 0xF));
+  }
+  map.erase(h);
+  h = map.insert(100);
+  CHECK((h & 0xF) != (first & 0xF));
+  CHECK(map[h] == 100);
+}
@@ -1,4 +1,6 @@
 #include "TestHarness.h"
+#include <vector>
+
 #include "DgVariableArray2D.h"
 
 TEST(Stack_DgVariableArray2D, creation_DgVariableArray2D)
@@ -67,4 +69,104 @@ TEST(Stack_DgVariableArray2D, creation_DgVariableArray2D)
   CHECK(arr2(4, 2) == 12);
   CHECK(arr2(4, 3) == 13);
   CHECK(arr2(4, 4) == 14);
-}
\ No newline at end of file
+}
+
+TEST(Stack_DgVariableArray2D, BuildFromPairs_DgVariableArray2D)
+{
+  size_t const nRows = 37;
+  size_t const nValues = 200000;
+
+  std::vector<size_t> rows(nValues);
+  std::vector<int> values(nValues);
+  for (size_t i = 0; i < nValues; i++)
+  {
+    rows[i] = (i * 7919) % nRows;
+    values[i] = int(i);
+  }
+
+  for (unsigned nThreads = 1; nThreads <= 4; nThreads++)
+  {
+    Dg::VariableArray2D<int> arr;
+    arr.BuildFromPairs(nRows, rows.data(), values.data(), nValues, nThreads);
+
+    CHECK(arr.rows() == nRows);
+    CHECK(arr.elements() == nValues);
+
+    //Rows are packed in order and keep the input order
+    bool good = true;
+    size_t start = 0;
+    for (size_t r = 0; r < nRows; r++)
+    {
+      good = good && (arr.row(r) == arr.data() + start);
+      for (size_t e = 1; e < arr.elements(r); e++)
+        good = good && (arr(r, e - 1) < arr(r, e));
+      for (size_t e = 0; e < arr.elements(r); e++)
+        good = good && (rows[arr(r, e)] == r);
+      start += arr.elements(r);
+    }
+    CHECK(good);
+  }
+
+  Dg::VariableArray2D<int> arr;
+  size_t badRows[2] = {0, 5};
+  int badValues[2] = {1, 2};
+  bool threw = false;
+  try
+  {
+    arr.BuildFromPairs(3, badRows, badValues, 2);
+  }
+  catch (std::out_of_range const &)
+  {
+    threw = true;
+  }
+  CHECK(threw);
+  CHECK(arr.rows() == 0);
+}
+
+TEST(Stack_DgVariableArray2D, resize_row_DgVariableArray2D)
+{
+  Dg::VariableArray2D<int> arr;
+
+  int x0[3] = {0, 1, 2};
+  int x1[2] = {3, 4};
+  int x2[4] = {5, 6, 7, 8};
+
+  arr.push_back(x0, 3);
+  arr.push_back(x1, 2);
+  arr.push_back(x2, 4);
+
+  //Last row grows in place
+  arr.resize_row(2, 6, 42);
+  CHECK(arr.elements(2) == 6);
+  CHECK(arr(2, 3) == 8);
+  CHECK(arr(2, 5) == 42);
+  CHECK(arr.row(2) == arr.data() + 5);
+
+  //Shrink in place
+  arr.resize_row(0, 1);
+  CHECK(arr.elements(0) == 1);
+  CHECK(arr(0, 0) == 0);
+  CHECK(arr(1, 1) == 4);
+
+  //Middle row is moved
+  arr.resize_row(1, 4, -1);
+  CHECK(arr.elements(1) == 4);
+  CHECK(arr(1, 0) == 3);
+  CHECK(arr(1, 1) == 4);
+  CHECK(arr(1, 3) == -1);
+  CHECK(arr.elements() == 11);
+
+  arr.compact();
+  CHECK(arr.row(1) == arr.data() + 1);
+  CHECK(arr.row(2) == arr.data() + 5);
+  CHECK(arr(0, 0) == 0);
+  CHECK(arr(1, 2) == -1);
+  CHECK(arr(2, 0) == 5);
+  CHECK(arr(2, 5) == 42);
+
+  Dg::VariableArray2D<int> arr1(arr);
+  arr.resize_row(2, 0);
+  CHECK(arr.elements(2) == 0);
+  CHECK(arr1.elements(2) == 6);
+  CHECK(arr1.at(2, 5) == 42);
+}
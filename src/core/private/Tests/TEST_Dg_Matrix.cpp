@@ -176,4 +176,74 @@ TEST(Stack_DgMatrix_Methods, creation_DgMatrix_Methods)
 
   CHECK(Dg::AreEqual(md.Determinant(), 413.81));
 
-}
\ No newline at end of file
+}
+
+//--------------------------------------------------------------------------------
+//	Matrix Expressions
+//--------------------------------------------------------------------------------
+TEST(Stack_DgMatrix_Expressions, creation_DgMatrix_Expressions)
+{
+  static_assert(sizeof(Dg::Matrix<4, 4, float>) == 16 * sizeof(float), "Expression base must not add storage");
+
+  mat34 a, b, c;
+  for (int i = 0; i < 12; i++)
+  {
+    a[i] = double(i);
+    b[i] = double(2 * i + 1);
+    c[i] = double(12 - i);
+  }
+
+  mat34 r = a * 3.0 + b - c;
+  for (int i = 0; i < 12; i++)
+    CHECK(r[i] == 3.0 * a[i] + b[i] - c[i]);
+
+  r = 0.5 * (a - b) / 2.0;
+  for (int i = 0; i < 12; i++)
+    CHECK(r[i] == 0.5 * (a[i] - b[i]) / 2.0);
+
+  r = -(a + b);
+  for (int i = 0; i < 12; i++)
+    CHECK(r[i] == -(a[i] + b[i]));
+
+  r = a;
+  r += b * 2.0;
+  r -= c;
+  for (int i = 0; i < 12; i++)
+    CHECK(r[i] == a[i] + 2.0 * b[i] - c[i]);
+
+  //The destination is also an operand
+  r = a;
+  r = b - r * 2.0;
+  for (int i = 0; i < 12; i++)
+    CHECK(r[i] == b[i] - 2.0 * a[i]);
+
+  CHECK(a + b == b + a);
+  CHECK(a - b != b - a);
+
+  mat43 d;
+  for (int i = 0; i < 12; i++)
+    d[i] = double(i % 5) - 2.0;
+
+  mat33 p0 = (a + b) * (d * 2.0);
+  mat34 s = a + b;
+  mat43 t = d * 2.0;
+  mat33 p1 = s * t;
+  CHECK(p0 == p1);
+
+  Dg::Matrix<2, 2, float> f;
+  f[0] = 1.0f; f[1] = 2.0f; f[2] = 3.0f; f[3] = 4.0f;
+  Dg::Matrix<2, 2, float> g = f * 2.0 + 2.0 * f;
+  for (int i = 0; i < 4; i++)
+    CHECK(g[i] == 4.0f * f[i]);
+
+  //Free functions take expressions
+  CHECK(Dg::AreEqual(Dg::Dot(a - b, c), Dg::Dot(mat34(a - b), c)));
+  mat43 at = Dg::Transpose(a + b);
+  CHECK(at == Dg::Transpose(s));
+
+  mat22 h, hInv;
+  h[0] = 2.0; h[1] = 1.0; h[2] = 1.0; h[3] = 3.0;
+  CHECK(Dg::Inverse(h + h, hInv));
+  mat22 id = hInv * (h * 2.0);
+  CHECK(Dg::AreEqual(id[0], 1.0) && Dg::AreEqual(id[3], 1.0) && Dg::IsZero(id[1]));
+}
@@ -0,0 +1,177 @@
+#include "TestHarness.h"
+#include "DgMatrixDecomposition.h"
+
+typedef Dg::Matrix<4, 4, double>    mat44;
+typedef Dg::Matrix<9, 9, double>    mat99;
+typedef Dg::Matrix<12, 12, double>  mat1212;
+typedef Dg::Matrix<12, 9, double>   mat129;
+typedef Dg::Matrix<12, 1, double>   mat121;
+typedef Dg::Matrix<9, 1, double>    mat91;
+typedef Dg::Matrix<3, 3, double>    mat33;
+
+typedef Dg::LUDecomposition<4, double>        lu44;
+typedef Dg::LUDecomposition<12, double>       lu1212;
+typedef Dg::CholeskyDecomposition<9, double>  chol99;
+typedef Dg::QRDecomposition<12, 9, double>    qr129;
+
+//Deterministic, well conditioned test data
+template<size_t M, size_t N>
+static void Fill(Dg::Matrix<M, N, double> & a_mat, unsigned a_seed)
+{
+  for (size_t i = 0; i < M * N; i++)
+  {
+    a_seed = a_seed * 1103515245u + 12345u;
+    a_mat[i] = double((a_seed >> 16) % 2001) / 1000.0 - 1.0;
+  }
+}
+
+template<size_t M, size_t N>
+static bool AreClose(Dg::Matrix<M, N, double> const & a_m0, Dg::Matrix<M, N, double> const & a_m1, double a_tol)
+{
+  for (size_t i = 0; i < M * N; i++)
+  {
+    if (std::abs(a_m0[i] - a_m1[i]) > a_tol)
+      return false;
+  }
+  return true;
+}
+
+//--------------------------------------------------------------------------------
+//	Determinant and inverse
+//--------------------------------------------------------------------------------
+TEST(Stack_DgMatrixDecomposition_Determinant, creation_DgMatrixDecomposition_Determinant)
+{
+  //Triangular matrix with its rows shuffled, so the determinant is known
+  Dg::Matrix<6, 6, double> tri;
+  tri.Zero();
+  double expected = 1.0;
+  for (size_t i = 0; i < 6; i++)
+  {
+    for (size_t j = i; j < 6; j++)
+      tri(i, j) = double(i + 2 * j) * 0.25 + 1.0;
+    expected *= tri(i, i);
+  }
+
+  Dg::Matrix<6, 6, double> shuffled;
+  size_t order[6] = {3, 0, 4, 1, 5, 2}; //Two 3-cycles, so an even permutation
+  for (size_t i = 0; i < 6; i++)
+  {
+    Dg::Matrix<1, 6, double> row;
+    tri.GetRow(order[i], row);
+    shuffled.SetRow(i, row);
+  }
+  CHECK(std::abs(shuffled.Determinant() - expected) < 1.0e-9 * std::abs(expected));
+
+  mat33 m3;
+  Fill(m3, 7);
+  Dg::LUDecomposition<3, double> lu3(m3);
+  CHECK(std::abs(lu3.Determinant() - m3.Determinant()) < 1.0e-12);
+
+  mat44 m4, m4Inv, I;
+  Fill(m4, 11);
+  I.Identity();
+  CHECK(Dg::Inverse(m4, m4Inv));
+  CHECK(AreClose(mat44(m4 * m4Inv), I, 1.0e-12));
+
+  mat33 m3Inv, I3;
+  I3.Identity();
+  CHECK(Dg::Inverse(m3, m3Inv));
+  CHECK(AreClose(mat33(m3 * m3Inv), I3, 1.0e-12));
+
+  //Singular: last row is the sum of the first two
+  mat44 s = m4;
+  for (size_t j = 0; j < 4; j++)
+    s(3, j) = s(0, j) + s(1, j);
+  mat44 sInv = I;
+  CHECK(!Dg::Inverse(s, sInv));
+  CHECK(sInv == I);
+  CHECK(s.Determinant() == 0.0);
+  CHECK(lu44(s).IsSingular());
+}
+
+//--------------------------------------------------------------------------------
+//	Linear solves
+//--------------------------------------------------------------------------------
+TEST(Stack_DgMatrixDecomposition_Solve, creation_DgMatrixDecomposition_Solve)
+{
+  mat1212 A;
+  Fill(A, 3);
+  mat121 x, b, xSolved;
+  Fill(x, 5);
+  b = A * x;
+
+  CHECK(Dg::Solve(A, b, xSolved));
+  CHECK(AreClose(xSolved, x, 1.0e-10));
+
+  //X may be B
+  mat121 bx = b;
+  CHECK(lu1212(A).Solve(bx, bx));
+  CHECK(AreClose(bx, x, 1.0e-10));
+
+  //Symmetric positive definite: J^T J + I
+  mat129 J;
+  Fill(J, 9);
+  mat99 N = Dg::Transpose(J) * J;
+  for (size_t i = 0; i < 9; i++)
+    N(i, i) += 1.0;
+
+  mat91 y, c, yChol, yLU;
+  Fill(y, 13);
+  c = N * y;
+
+  chol99 chol(N);
+  CHECK(chol.IsPositiveDefinite());
+  CHECK(chol.Solve(c, yChol));
+  CHECK(AreClose(yChol, y, 1.0e-10));
+  CHECK(AreClose(mat99(chol.GetL() * Dg::Transpose(chol.GetL())), N, 1.0e-10));
+  CHECK(std::abs(chol.Determinant() - N.Determinant()) < 1.0e-8 * std::abs(N.Determinant()));
+
+  CHECK(Dg::Solve(N, c, yLU));
+  CHECK(AreClose(yLU, y, 1.0e-10));
+
+  mat99 notPD = N;
+  notPD(4, 4) = -1.0;
+  CHECK(!chol99(notPD).IsPositiveDefinite());
+}
+
+//--------------------------------------------------------------------------------
+//	QR
+//--------------------------------------------------------------------------------
+TEST(Stack_DgMatrixDecomposition_QR, creation_DgMatrixDecomposition_QR)
+{
+  mat129 A;
+  Fill(A, 17);
+
+  qr129 qr(A);
+  CHECK(qr.IsFullRank());
+
+  mat129 Q;
+  mat99 R, I;
+  qr.GetQ(Q);
+  qr.GetR(R);
+  I.Identity();
+  CHECK(AreClose(mat129(Q * R), A, 1.0e-12));
+  CHECK(AreClose(mat99(Dg::Transpose(Q) * Q), I, 1.0e-12));
+  for (size_t i = 0; i < 9; i++)
+    for (size_t j = 0; j < i; j++)
+      CHECK(R(i, j) == 0.0);
+
+  //Least squares agrees with the normal equations
+  mat121 b;
+  Fill(b, 19);
+  mat91 xQR, xNormal;
+  CHECK(qr.Solve(b, xQR));
+
+  mat99 AtA = Dg::Transpose(A) * A;
+  mat91 Atb = Dg::Transpose(A) * b;
+  CHECK(chol99(AtA).Solve(Atb, xNormal));
+  CHECK(AreClose(xQR, xNormal, 1.0e-9));
+
+  //Rank deficient: column 3 duplicates column 0
+  mat129 D = A;
+  for (size_t i = 0; i < 12; i++)
+    D(i, 3) = D(i, 0);
+  qr129 qrD(D);
+  CHECK(!qrD.IsFullRank());
+  CHECK(!qrD.Solve(b, xQR));
+}
@@ -173,4 +173,110 @@ TEST(Stack_DgDoublyLinkedList, creation_DgDoublyLinkedList)
   CHECK(newlst3.size() == 0);
   newlst3 = dglst;
   CHECK(CheckState(lst, newlst3));
+}
+
+TEST(Stack_DgDoublyLinkedList, Chunked_DgDoublyLinkedList)
+{
+  typedef Dg::DoublyLinkedList<t, true> DgChunkedList;
+
+  DgChunkedList dglst(64);
+  list          lst;
+
+  //Element addresses must not change as the list grows
+  dglst.push_back(-1);
+  lst.push_back(-1);
+  t * pFirst = &dglst.front();
+
+  for (t i = 0; i < 10000; ++i)
+  {
+    if (i % 2 == 0)
+    {
+      dglst.push_back(i);
+      lst.push_back(i);
+    }
+    else
+    {
+      dglst.push_front(i);
+      lst.push_front(i);
+    }
+  }
+  CHECK(*pFirst == -1);
+
+  DgChunkedList::iterator dgit = dglst.begin();
+  list::iterator lit = lst.begin();
+  while (lit != lst.end())
+  {
+    CHECK(*lit == *dgit);
+    lit++;
+    dgit++;
+  }
+  CHECK(dgit == dglst.end());
+
+  //Erase most elements, shrink, then check the remaining ones are intact.
+  //Values from 1000 on are all erased, which empties the chunks they
+  //were allocated from.
+  dgit = dglst.begin();
+  lit = lst.begin();
+  int count = 0;
+  while (lit != lst.end())
+  {
+    if (*lit != -1 && (*lit >= 1000 || (count++ % 10) != 0))
+    {
+      dgit = dglst.erase(dgit);
+      lit = lst.erase(lit);
+    }
+    else
+    {
+      ++dgit;
+      ++lit;
+    }
+  }
+  size_t capacity = dglst.capacity();
+  dglst.shrink();
+  CHECK(dglst.capacity() < capacity / 4);
+  CHECK(dglst.capacity() >= dglst.size());
+  CHECK(*pFirst == -1);
+  CHECK(dglst.size() == lst.size());
+
+  dgit = dglst.begin();
+  for (lit = lst.begin(); lit != lst.end(); ++lit, ++dgit)
+    CHECK(*lit == *dgit);
+
+  //Reuse freed slots
+  for (t i = 0; i < 5000; ++i)
+  {
+    dglst.insert(dglst.begin(), i);
+    lst.insert(lst.begin(), i);
+  }
+  CHECK(*pFirst == -1);
+
+  DgChunkedList copy(dglst);
+  DgChunkedList moved(std::move(copy));
+  DgChunkedList assigned;
+  assigned.push_back(3);
+  assigned = moved;
+  dgit = assigned.begin();
+  for (lit = lst.begin(); lit != lst.end(); ++lit, ++dgit)
+    CHECK(*lit == *dgit);
+  CHECK(assigned.back() == lst.back());
+
+  dglst.clear();
+  dglst.shrink();
+  CHECK(dglst.capacity() == 0);
+  CHECK(dglst.empty());
+  CHECK(dglst.begin() == dglst.end());
+  dglst.push_back(4);
+  CHECK(dglst.front() == 4);
+
+  //Non-chunked lists shrink too
+  DgList small;
+  for (t i = 0; i < 1000; ++i)
+    small.push_back(i);
+  for (t i = 0; i < 990; ++i)
+    small.pop_front();
+  small.shrink();
+  CHECK(small.capacity() < 1000);
+  CHECK(small.size() == 10);
+  CHECK(small.front() == 990);
+  CHECK(small.back() == 999);
 }
\ No newline at end of file
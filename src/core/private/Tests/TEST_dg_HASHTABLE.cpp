@@ -1,225 +1,206 @@
-//#include <list>
-//#include <iostream>
-//
-//#include "TestHarness.h"
-//#include "DgOpenHashTable.h"
-//
-//typedef unsigned Key;
-//
-//int g_constructors = 0;
-//int g_copyConstructors = 0;
-//int g_assignments = 0;
-//int g_destructors = 0;
-//
-//class C
-//{
-//public:
-//
-//  C() : m(0) { g_constructors++; }
-//  C(int a) : m(a) { g_constructors++; }
-//  ~C() { g_destructors++; }
-//  C(C const & a) : m(a.m) { g_copyConstructors++; }
-//  C & operator=(C const & a) 
-//  { 
-//    m = a.m;
-//    g_assignments++; 
-//    return *this;
-//  }
-//
-//  bool operator==(C const & a) const { return a.m == m; }
-//  bool operator!=(C const & a) const { return a.m != m; }
-//
-//  int m;
-//};
-//
-//int HaveSameItems(Dg::OpenHashTable<Key, C> ht0, Dg::OpenHashTable<Key, C> ht1)
-//{
-//  if (ht0.Size() != ht1.Size())
-//  {
-//    return __LINE__;
-//  }
-//
-//  Dg::OpenHashTable<Key, C>::iterator it0 = ht0.Begin();
-//  Dg::OpenHashTable<Key, C>::iterator it1 = ht1.Begin();
-//  while (it0 != ht0.End())
-//  {
-//    if (*it0 != *it1)
-//    {
-//      return __LINE__;
-//    }
-//    it0++;
-//    it1++;
-//  }
-//  return 0;
-//}
-//
-//
-//int Compare(Dg::OpenHashTable<Key, C> a_ht, std::list<C> a_list)
-//{
-//  //Check sizes
-//  if (a_ht.Size() != a_list.size())
-//  {
-//    return __LINE__;
-//  }
-//
-//  //Have same items?
-//  std::list<C>::iterator l_it = a_list.begin();
-//  for (l_it; l_it != a_list.end(); ++l_it)
-//  {
-//    if (!a_ht.At(l_it->m))
-//    {
-//      return __LINE__;
-//    }
-//  }
-//
-//  //Make sure elments match, use interator++
-//  std::list<C> newList(a_list);
-//  Dg::OpenHashTable<Key, C>::iterator it = a_ht.Begin();
-//  for(it; it != a_ht.End(); it++)
-//  {
-//    std::list<C>::iterator l_it = std::find(newList.begin(), newList.end(), *it);
-//    if (l_it == newList.end())
-//    {
-//      return __LINE__;
-//    }
-//    newList.erase(l_it);
-//  }
-//  if (newList.size() != 0)
-//  {
-//    return __LINE__;
-//  }
-//
-//  //Make sure elments match, use iterator--
-//  newList = a_list;
-//  it = a_ht.End();
-//  it--;
-//  for (it; it != a_ht.End(); it--)
-//  {
-//    std::list<C>::iterator l_it = std::find(newList.begin(), newList.end(), *it);
-//    if (l_it == newList.end())
-//    {
-//      return __LINE__;
-//    }
-//    newList.erase(l_it);
-//  }
-//  if (newList.size() != 0)
-//  {
-//    return __LINE__;
-//  }
-//
-//  //Make sure elments match, use const_interator++
-//  newList = a_list;
-//  Dg::OpenHashTable<Key, C>::const_iterator cit = a_ht.CBegin();
-//  for (cit; cit != a_ht.CEnd(); cit++)
-//  {
-//    std::list<C>::iterator l_it = std::find(newList.begin(), newList.end(), *cit);
-//    if (l_it == newList.end())
-//    {
-//      return __LINE__;
-//    }
-//    newList.erase(l_it);
-//  }
-//  if (newList.size() != 0)
-//  {
-//    return __LINE__;
-//  }
-//
-//  //Make sure elments match, use const_iterator--
-//  newList = a_list;
-//  cit = a_ht.CEnd();
-//  for (cit; --cit != a_ht.CEnd() ;)
-//  {
-//    std::list<C>::iterator l_it = std::find(newList.begin(), newList.end(), *cit);
-//    if (l_it == newList.end())
-//    {
-//      return __LINE__;
-//    }
-//    newList.erase(l_it);
-//  }
-//  if (newList.size() != 0)
-//  {
-//    return __LINE__;
-//  }
-//
-//  //Construction
-//  Dg::OpenHashTable<Key, C> newHT(a_ht);
-//  if (newHT.PoolSlotsWasted()) return __LINE__;
-//  int res = HaveSameItems(a_ht, newHT);
-//  if (res != 0) return res;
-//
-//  newHT = a_ht;
-//  if (newHT.PoolSlotsWasted()) return __LINE__;
-//  res = HaveSameItems(a_ht, newHT);
-//  if (res != 0) return res;
-//
-//  Dg::OpenHashTable<Key, C> moved(std::move(newHT));
-//  if (moved.PoolSlotsWasted()) return __LINE__;
-//  res = HaveSameItems(a_ht, moved);
-//  if (res != 0) return res;
-//  res = HaveSameItems(a_ht, newHT);
-//  if (res == 0) return res;
-//
-//  newHT = moved;
-//  if (newHT.PoolSlotsWasted()) return __LINE__;
-//  moved = std::move(newHT);
-//  if (moved.PoolSlotsWasted()) return __LINE__;
-//  res = HaveSameItems(a_ht, moved);
-//  if (res != 0) return res;
-//  res = HaveSameItems(a_ht, newHT);
-//  if (res == 0) return res;
-//
-//  return 0;
-//}
-//
-//int AddNewItem(Key k, Dg::OpenHashTable<Key, C> & a_ht, std::list<C> & a_list)
-//{
-//  if (a_ht.At(k))
-//  {
-//    return __LINE__;
-//  }
-//
-//  float oldLF = a_ht.LoadFactor();
-//  float nItems = float(a_ht.Size());
-//  float oldBucketCount = float(a_ht.BucketCount());
-//  float maxLF = float(a_ht.MaxLoadFactor());
-//  size_t oldSize = a_ht.Size();
-//  bool shouldRehash = ((nItems + 1.0f) / oldBucketCount) > maxLF;
-//
-//  //Insert dummy
-//  a_ht.Insert(k, C(-1));
-//  if (a_ht.PoolSlotsWasted()) return __LINE__;
-//
-//  if (a_ht.Size() != oldSize + 1) return __LINE__;
-//  if (!a_ht.At(k)) return __LINE__;
-//  if (a_ht.At(k)->m != -1) return __LINE__;
-//  if (a_ht.InsertNoOverwrite(k, C(k))->m != -1) return __LINE__;
-//  if (a_ht.PoolSlotsWasted()) return __LINE__;
-//
-//  a_ht.Erase(k);
-//  if (a_ht.Size() != oldSize) return __LINE__;
-//  if (a_ht.At(k)) return __LINE__;
-//
-//  //Insert real
-//  a_ht.Insert(k, C(k));
-//  if (!a_ht.At(k)) return __LINE__;
-//  if (a_ht.At(k)->m != k) return __LINE__;
-//  if (a_ht.PoolSlotsWasted()) return __LINE__;
-//  if (shouldRehash && a_ht.BucketCount() <= oldBucketCount) return __LINE__;
-//
-//  a_list.push_back(C(k));
-//  return 0;
-//}
-//
-//TEST(Stack_dg_HashTable, creation_dg_HashTable)
-//{
-//  Dg::OpenHashTable<Key, C> ht;
-//  std::list<C> lst;
-//  int failLine = 0;
-//  for (int i = 0; i < 100; ++i)
-//  {
-//    failLine = AddNewItem(i, ht, lst);
-//    CHECK(failLine == 0);
-//  }
-//  failLine = Compare(ht, lst);
-//  CHECK(failLine == 0);
-//}
\ No newline at end of file
+#include <unordered_map>
+#include <string>
+#include <cstdlib>
+
+#include "TestHarness.h"
+#include "DgOpenHashTable.h"
+
+namespace
+{
+  int g_liveObjects = 0;
+
+  class C
+  {
+  public:
+
+    C() : m(0) { g_liveObjects++; }
+    C(int a) : m(a) { g_liveObjects++; }
+    ~C() { g_liveObjects--; }
+    C(C const & a) : m(a.m) { g_liveObjects++; }
+    C & operator=(C const & a)
+    {
+      m = a.m;
+      return *this;
+    }
+
+    bool operator==(C const & a) const { return a.m == m; }
+    bool operator!=(C const & a) const { return a.m != m; }
+
+    int m;
+  };
+
+  //Sends every key to the same bucket
+  struct BadHasher
+  {
+    size_t operator()(int) const { return 0; }
+  };
+
+  template<typename Table, typename Map>
+  bool AreEqual(Table const & a_table, Map const & a_map)
+  {
+    if (a_table.size() != a_map.size())
+      return false;
+
+    size_t count = 0;
+    for (auto it = a_table.cbegin(); it != a_table.cend(); it++)
+    {
+      auto mit = a_map.find(it->first);
+      if (mit == a_map.end() || mit->second != it->second)
+        return false;
+      count++;
+    }
+    return count == a_map.size();
+  }
+}
+
+TEST(Stack_dg_OpenHashTable, creation_dg_OpenHashTable)
+{
+  typedef Dg::OpenHashTable<int, C> Table;
+  {
+    Table table;
+    std::unordered_map<int, C> reference;
+
+    CHECK(table.empty());
+    CHECK(table.begin() == table.end());
+
+    //----------------------------------------------------------------------------------------
+    //Insertion
+    //----------------------------------------------------------------------------------------
+    for (int i = 0; i < 1000; i++)
+    {
+      int key = rand() % 2000;
+      table.insert(key, C(key * 2));
+      reference.insert(std::pair<int, C>(key, C(key * 2)));
+    }
+    CHECK(AreEqual(table, reference));
+
+    //Existing keys are not overwritten by insert
+    int key = reference.begin()->first;
+    Table::iterator it = table.insert(key, C(-1));
+    CHECK(it->first == key);
+    CHECK(it->second.m == key * 2);
+
+    //----------------------------------------------------------------------------------------
+    //Copy/move
+    //----------------------------------------------------------------------------------------
+    Table table2(table);
+    CHECK(AreEqual(table2, reference));
+    Table table3;
+    table3 = table2;
+    CHECK(AreEqual(table3, reference));
+    Table table4(std::move(table3));
+    CHECK(AreEqual(table4, reference));
+    table2.clear();
+    CHECK(table2.empty());
+    table2 = std::move(table4);
+    CHECK(AreEqual(table2, reference));
+
+    //----------------------------------------------------------------------------------------
+    //Accessing/searching
+    //----------------------------------------------------------------------------------------
+    Table const & crtable(table);
+    for (int i = -10; i < 2010; i++)
+    {
+      bool inRef = reference.find(i) != reference.end();
+      CHECK((crtable.find(i) != crtable.cend()) == inRef);
+      if (inRef)
+      {
+        CHECK(crtable.at(i).m == i * 2);
+        table.at(i) = C(i * 3);
+        CHECK(table[i].m == i * 3);
+        reference[i] = C(i * 3);
+      }
+    }
+
+    bool caught = false;
+    try { crtable.at(-1); }
+    catch (std::out_of_range &) { caught = true; }
+    CHECK(caught);
+
+    //----------------------------------------------------------------------------------------
+    //Erasing
+    //----------------------------------------------------------------------------------------
+    for (int i = 0; i < 2000; i += 3)
+    {
+      table.erase(i);
+      reference.erase(i);
+    }
+    CHECK(AreEqual(table, reference));
+
+    //Erasing while iterating visits every element once
+    size_t nVisited = 0;
+    size_t nItems = table.size();
+    it = table.begin();
+    while (it != table.end())
+    {
+      nVisited++;
+      if (it->first % 2 == 0)
+      {
+        reference.erase(it->first);
+        it = table.erase(it);
+      }
+      else
+        it++;
+    }
+    CHECK(nVisited == nItems);
+    CHECK(AreEqual(table, reference));
+
+    //----------------------------------------------------------------------------------------
+    //Reserve
+    //----------------------------------------------------------------------------------------
+    table.reserve(10000);
+    CHECK(table.bucket_count() * 7 / 8 >= 10000);
+    CHECK(AreEqual(table, reference));
+    size_t nBuckets = table.bucket_count();
+    for (int i = 0; i < 10000; i++)
+      table.insert(i, C(i));
+    CHECK(table.bucket_count() == nBuckets);
+
+    table.clear();
+    CHECK(table.empty());
+    CHECK(table.begin() == table.end());
+  }
+  CHECK(g_liveObjects == 0);
+}
+
+TEST(Stack_dg_OpenHashTable, BadHasher_dg_OpenHashTable)
+{
+  //Every key collides, so the table has to keep growing to make room.
+  Dg::OpenHashTable<int, int, BadHasher> table;
+  std::unordered_map<int, int> reference;
+  for (int i = 0; i < 200; i++)
+  {
+    table.insert(i, i);
+    reference[i] = i;
+  }
+  CHECK(AreEqual(table, reference));
+
+  for (int i = 0; i < 200; i += 2)
+  {
+    table.erase(i);
+    reference.erase(i);
+  }
+  CHECK(AreEqual(table, reference));
+}
+
+TEST(Stack_dg_OpenHashTable, StringKeys_dg_OpenHashTable)
+{
+  Dg::OpenHashTable<std::string, int> table;
+  std::unordered_map<std::string, int> reference;
+
+  for (int i = 0; i < 5000; i++)
+  {
+    std::string key = "key_" + std::to_string(rand() % 3000);
+    table[key] += i;
+    reference[key] += i;
+  }
+  CHECK(AreEqual(table, reference));
+
+  for (int i = 0; i < 3000; i += 5)
+  {
+    std::string key = "key_" + std::to_string(i);
+    table.erase(key);
+    reference.erase(key);
+  }
+  CHECK(AreEqual(table, reference));
+}
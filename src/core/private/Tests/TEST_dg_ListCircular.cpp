@@ -69,4 +69,69 @@ TEST(Stack_dg_ListCircular, creation_dg_ListCircular)
   CHECK(AreSame(list, list2));
   CHECK(AreSame(list2, list3));
   CHECK(AreSame(list, list3));
-}
\ No newline at end of file
+}
+
+TEST(Stack_dg_ListCircular, Chunked_dg_ListCircular)
+{
+  typedef Dg::CircularDoublyLinkedList<t, true> DgChunkedCList;
+
+  DgChunkedCList list(32);
+  CHECK(list.empty());
+
+  list.push_back(0);
+  t * pHead = &*list.head();
+
+  for (int i = 1; i < 5000; ++i)
+    list.push_back(i);
+
+  //Growing does not move existing elements
+  CHECK(pHead == &*list.head());
+  CHECK(list.size() == 5000);
+
+  auto it = list.head();
+  for (int i = 0; i < 5000; ++i, ++it)
+    CHECK(*it == i);
+  CHECK(it == list.head());
+  CHECK(*(--list.head()) == 4999);
+
+  //Erase all odd values. Every chunk keeps live elements, so nothing is freed.
+  size_t capacity = list.capacity();
+  it = list.head();
+  for (int i = 0; i < 5000; ++i)
+  {
+    if (*it % 2 == 1)
+      it = list.erase(it);
+    else
+      ++it;
+  }
+  list.shrink();
+  CHECK(list.capacity() == capacity);
+  CHECK(list.size() == 2500);
+  CHECK(pHead == &*list.head());
+
+  it = list.head();
+  for (int i = 0; i < 2500; ++i, ++it)
+    CHECK(*it == i * 2);
+
+  DgChunkedCList list2(list);
+  DgChunkedCList list3;
+  list3.push_back(-1);
+  list3 = list2;
+  CHECK(list3.size() == 2500);
+  it = list3.head();
+  for (int i = 0; i < 2500; ++i, ++it)
+    CHECK(*it == i * 2);
+
+  //Erasing the head moves it on to the next element
+  it = list.erase(list.head());
+  CHECK(*list.head() == 2);
+  CHECK(it == list.head());
+
+  while (!list.empty())
+    list.erase(list.head());
+  list.shrink();
+  CHECK(list.capacity() == 0);
+  list.push_back(7);
+  CHECK(*list.head() == 7);
+  CHECK(list.size() == 1);
+}
@@ -1,6 +1,9 @@
 #include "TestHarness.h"
 
+#include <cmath>
+#include <vector>
 #include "dgmath.h"
+#include "DgErf.h"
 
 using namespace Dg;
 
@@ -198,4 +201,84 @@ TEST(Stack_math_ClosestSquare, creation_math_ClosestSquare)
 
   Dg::ClosestSquare<UINT>(65537, lower, upper);
   CHECK(lower == 256 && upper == 257);
-}
\ No newline at end of file
+}
+
+TEST(Stack_math_Erf, creation_math_Erf)
+{
+  //Series coefficients
+  double const * coeffs = Dg::impl::InverfCoefficients<Dg::N_C_INVERF>();
+  CHECK(coeffs[0] == 0.88622692545275801364908374167057);
+  CHECK(std::abs(coeffs[1] - 0.23201366653465452) < 1.0e-16);
+  CHECK(std::abs(coeffs[511] / 0.00036795758487917897 - 1.0) < 1.0e-12);
+  CHECK(std::abs(Dg::inverf(0.5) - 0.4769362762044699) < 1.0e-6);
+  CHECK(std::abs(Dg::inverf<double, Dg::N_C_INVERF>(0.5) - 0.4769362762044699) < 1.0e-14);
+  CHECK(std::abs(Dg::inverf<float, Dg::N_C_INVERF>(-0.9f) + 1.1630871536766740f) < 1.0e-5f);
+
+  bool good = true;
+  for (int i = -1000; i <= 1000; i++)
+  {
+    double x = i * 0.006;
+    if (x != 0.0)
+      good = good && std::abs(Dg::Erf(x) / std::erf(x) - 1.0) < 1.0e-8;
+    good = good && std::abs(Dg::Erfc(x) / std::erfc(x) - 1.0) < 1.0e-8;
+
+    double y = i * 0.000999;
+    if (y != 0.0)
+      good = good && std::abs(std::erf(Dg::InvErf(y)) / y - 1.0) < 1.0e-7;
+  }
+  CHECK(good);
+
+  CHECK(Dg::Erf(0.0) == 0.0);
+  CHECK(Dg::Erf(std::numeric_limits<double>::infinity()) == 1.0);
+  CHECK(Dg::Erfc(-std::numeric_limits<double>::infinity()) == 2.0);
+  CHECK(Dg::InvErf(0.0f) == 0.0f);
+  CHECK(Dg::InvErf(1.0) == std::numeric_limits<double>::infinity());
+  CHECK(Dg::InvErf(-1.0f) == -std::numeric_limits<float>::infinity());
+  CHECK(std::isnan(Dg::InvErf(1.5)));
+  CHECK(std::abs(std::erfc(Dg::InvErf(1.0 - 1.0e-15)) / (1.0 - (1.0 - 1.0e-15)) - 1.0) < 1.0e-5);
+}
+
+TEST(Stack_math_ErfArrays, creation_math_ErfArrays)
+{
+  //Covers the 4-wide blocks and the tail
+  size_t const count = 103;
+  std::vector<float> in(count), inUnit(count), out(count);
+  std::vector<double> inD(count), outD(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    in[i] = -4.0f + 0.08f * float(i);
+    inUnit[i] = -0.9999f + 0.0196f * float(i);
+    inD[i] = in[i];
+  }
+  in[7] = 0.0f;
+
+  bool good = true;
+
+  Dg::Erf(in.data(), out.data(), count, 2);
+  for (size_t i = 0; i < count; i++)
+    good = good && std::abs(out[i] - std::erf(double(in[i]))) <= 4.0e-7 * std::abs(std::erf(double(in[i])));
+
+  Dg::Erfc(in.data(), out.data(), count, 2);
+  for (size_t i = 0; i < count; i++)
+    good = good && std::abs(out[i] - std::erfc(double(in[i]))) <= 4.5e-7 * std::erfc(double(in[i]));
+
+  Dg::InvErf(inUnit.data(), out.data(), count, 2);
+  for (size_t i = 0; i < count; i++)
+    good = good && std::abs(out[i] - Dg::InvErf(double(inUnit[i]))) <= 2.5e-7 * std::abs(Dg::InvErf(double(inUnit[i])));
+  CHECK(good);
+
+  //Edge values
+  float edges[4] = {1.0f, -1.0f, 2.0f, std::numeric_limits<float>::quiet_NaN()};
+  Dg::InvErf(edges, edges, 4);
+  CHECK(edges[0] == std::numeric_limits<float>::infinity());
+  CHECK(edges[1] == -std::numeric_limits<float>::infinity());
+  CHECK(std::isnan(edges[2]) && std::isnan(edges[3]));
+
+  //double arrays are the scalar functions, in place included
+  outD = inD;
+  Dg::Erf(outD.data(), outD.data(), count, 2);
+  good = true;
+  for (size_t i = 0; i < count; i++)
+    good = good && (outD[i] == Dg::Erf(inD[i]));
+  CHECK(good);
+}
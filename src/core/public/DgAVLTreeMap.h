@@ -4,9 +4,14 @@
 #include <exception>
 #include <new>
 #include <cstring>
-#include <exception>
+#include <cstdlib>
+#include <stdexcept>
+#include <iterator>
+#include <thread>
+#include <utility>
 
 #include "DgPair.h"
+#include "impl/DgCompare.h"
 #include "impl/DgContainerBase.h"
 
 #ifdef DEBUG
@@ -18,12 +23,6 @@ namespace Dg
 {
   namespace impl
   {
-    template<typename T>
-    bool Less(T const & t0, T const & t1)
-    {
-      return t0 < t1;
-    }
-
     template<typename T>
     T Max(T a, T b)
     {
@@ -271,6 +270,24 @@ namespace Dg
     V const & at(K const &) const;
 
     void clear();
+
+    //Clears the map and fills it from the range [first, last), which must
+    //be sorted by the criterion. The pools are sized once and a perfectly
+    //balanced tree is linked in O(n). If a key appears more than once, the 
+    //first occurrence is kept, as with insert().
+    template<typename ForwardIt>
+    void BuildFromSorted(ForwardIt first, ForwardIt last);
+
+    //As BuildFromSorted(), but splits the work over a_nThreads threads
+    //(0 = hardware concurrency). Keys in [first, last) must be strictly 
+    //increasing. Small inputs are built on the calling thread.
+    template<typename RandomIt>
+    void BuildFromSortedParallel(RandomIt first, RandomIt last, unsigned a_nThreads = 0);
+
+    //Merges a_other into this map in O(n + m). Where a key exists in 
+    //both maps, the value in this map is kept, as with insert().
+    void Merge(AVLTreeMap const & a_other);
+
 #ifdef DEBUG
   public:
     void Print() const;
@@ -286,6 +303,19 @@ namespace Dg
     void InitDefaultNode();
     void Init(AVLTreeMap const &);
 
+    //Makes sure the pools can hold a_nItems without extending.
+    void Reserve(sizeType a_nItems);
+
+    //Links the nodes of a perfectly balanced tree over the key/values in 
+    //m_pKVs, which must hold m_nItems items in sorted order.
+    void LinkSorted(unsigned a_nThreads);
+
+    //Links the nodes associated with KVs [a_begin, a_end) into a balanced
+    //subtree, and returns its root. Subtrees are handed to new threads 
+    //while a_nThreads > 1.
+    impl::Node * LinkSorted(sizeType a_begin, sizeType a_end, 
+                            impl::Node * a_pParent, unsigned a_nThreads);
+
     //Sets a_out to the node index which references the key, or
     //if the key does not exist, the node at which the key should be
     //added
@@ -293,6 +323,7 @@ namespace Dg
 
     sizeType RawIndex(K const &) const;
     void Extend();
+    void ReportMemory() override;
     int GetBalance(impl::Node *) const;
 
     // A utility function to get height  
@@ -815,6 +846,7 @@ namespace Dg
       }
 
       Init(a_other);
+      MemoryChanged();
     }
     return *this;
   }
@@ -830,7 +862,8 @@ namespace Dg
     a_other.m_pKVs = nullptr;
     a_other.m_pNodes = nullptr;
     a_other.m_nItems = 0;
-    a_other.m_pRoot = s_nullValue;
+    a_other.m_pRoot = nullptr;
+    a_other.MemoryChanged();
   }
 
   template<typename K, typename V, bool (*Compare)(K const &, K const &)>
@@ -839,6 +872,10 @@ namespace Dg
   {
     if (this != &a_other)
     {
+      DestructAll();
+      free(m_pKVs);
+      free(m_pNodes);
+
       ContainerBase::operator=(a_other);
       m_pKVs = a_other.m_pKVs;
       m_pNodes = a_other.m_pNodes;
@@ -848,7 +885,10 @@ namespace Dg
       a_other.m_pKVs = nullptr;
       a_other.m_pNodes = nullptr;
       a_other.m_nItems = 0;
-      a_other.m_pRoot = s_nullValue;
+      a_other.m_pRoot = nullptr;
+
+      MemoryChanged();
+      a_other.MemoryChanged();
     }
     return *this;
   }
@@ -963,6 +1003,7 @@ namespace Dg
 
     impl::Node * foundNode(nullptr);
     m_pRoot = __Insert(m_pRoot, nullptr, a_key, a_data, foundNode);
+    MemoryChanged();
     return iterator(foundNode, m_pNodes + 1, m_pKVs);
   }
 
@@ -971,6 +1012,7 @@ namespace Dg
   {
     EraseData eData{nullptr, nullptr, nullptr};
     m_pRoot = __Erase<false>(m_pRoot, a_key, eData);
+    MemoryChanged();
   }
 
   template<typename K, typename V, bool (*Compare)(K const &, K const &)>
@@ -979,6 +1021,7 @@ namespace Dg
   {
     EraseData eData{nullptr, nullptr, nullptr};
     m_pRoot = __Erase<true>(m_pRoot, a_it->first, eData);
+    MemoryChanged();
     return iterator(eData.pNext, m_pNodes + 1, m_pKVs);
   }
 
@@ -1000,6 +1043,109 @@ namespace Dg
     DestructAll();
     m_nItems = 0;
     InitDefaultNode();
+    MemoryChanged();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  template<typename ForwardIt>
+  void AVLTreeMap<K, V, Compare>::BuildFromSorted(ForwardIt a_first, ForwardIt a_last)
+  {
+    clear();
+    Reserve(static_cast<sizeType>(std::distance(a_first, a_last)));
+
+    for (; a_first != a_last; ++a_first)
+    {
+      if (m_nItems > 0 && m_pKVs[m_nItems - 1].first == a_first->first)
+        continue;
+      new (&m_pKVs[m_nItems]) ValueType{a_first->first, a_first->second};
+      m_nItems++;
+    }
+
+    LinkSorted(1);
+    MemoryChanged();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  template<typename RandomIt>
+  void AVLTreeMap<K, V, Compare>::BuildFromSortedParallel(RandomIt a_first, 
+                                                          RandomIt a_last,
+                                                          unsigned a_nThreads)
+  {
+    //Below this, spawning threads costs more than it saves.
+    sizeType const minItemsPerThread = 0x4000;
+
+    sizeType nItems = static_cast<sizeType>(a_last - a_first);
+    if (a_nThreads == 0)
+      a_nThreads = std::thread::hardware_concurrency();
+    if (a_nThreads > nItems / minItemsPerThread)
+      a_nThreads = static_cast<unsigned>(nItems / minItemsPerThread);
+
+    if (a_nThreads < 2)
+    {
+      BuildFromSorted(a_first, a_last);
+      return;
+    }
+
+    clear();
+    Reserve(nItems);
+
+    ValueType * pKVs = m_pKVs;
+    auto copyRange = [pKVs, a_first](sizeType a_begin, sizeType a_end)
+    {
+      for (sizeType i = a_begin; i < a_end; i++)
+        new (&pKVs[i]) ValueType{a_first[i].first, a_first[i].second};
+    };
+
+    std::thread * pThreads = new std::thread[a_nThreads - 1];
+    sizeType chunk = nItems / a_nThreads;
+    for (unsigned t = 0; t < a_nThreads - 1; t++)
+      pThreads[t] = std::thread(copyRange, t * chunk, (t + 1) * chunk);
+    copyRange((a_nThreads - 1) * chunk, nItems);
+    for (unsigned t = 0; t < a_nThreads - 1; t++)
+      pThreads[t].join();
+    delete[] pThreads;
+
+    m_nItems = nItems;
+    LinkSorted(a_nThreads);
+    MemoryChanged();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void AVLTreeMap<K, V, Compare>::Merge(AVLTreeMap const & a_other)
+  {
+    if (a_other.empty())
+      return;
+
+    AVLTreeMap result(m_nItems + a_other.m_nItems + 1);
+    ValueType * pOut = result.m_pKVs;
+
+    const_iterator it0 = cbegin();
+    const_iterator it1 = a_other.cbegin();
+    while (it0 != cend() && it1 != a_other.cend())
+    {
+      if (Compare(it1->first, it0->first))
+      {
+        new (pOut) ValueType(*it1);
+        ++it1;
+      }
+      else
+      {
+        if (it0->first == it1->first)
+          ++it1;
+        new (pOut) ValueType(*it0);
+        ++it0;
+      }
+      pOut++;
+      result.m_nItems++;
+    }
+
+    for (; it0 != cend(); ++it0, ++pOut, result.m_nItems++)
+      new (pOut) ValueType(*it0);
+    for (; it1 != a_other.cend(); ++it1, ++pOut, result.m_nItems++)
+      new (pOut) ValueType(*it1);
+
+    result.LinkSorted(1);
+    *this = std::move(result);
   }
 
 #ifdef DEBUG
@@ -1066,6 +1212,8 @@ namespace Dg
   template<typename K, typename V, bool (*Compare)(K const &, K const &)>
   void AVLTreeMap<K, V, Compare>::InitMemory()
   {
+    ReallocTimer timer(*this);
+
     m_pNodes = static_cast<impl::Node*> (realloc(m_pNodes, pool_size() * sizeof(impl::Node)));
     if (m_pNodes == nullptr)
       throw std::bad_alloc();
@@ -1113,6 +1261,65 @@ namespace Dg
     m_pRoot->pParent = nullptr;
   }
 
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void AVLTreeMap<K, V, Compare>::Reserve(sizeType a_nItems)
+  {
+    //One extra node for the end node
+    if (pool_size() < a_nItems + 1)
+    {
+      pool_size(a_nItems + 1);
+      InitMemory();
+      InitDefaultNode();
+    }
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void AVLTreeMap<K, V, Compare>::LinkSorted(unsigned a_nThreads)
+  {
+    InitDefaultNode();
+    if (m_nItems == 0)
+      return;
+
+    m_pRoot = LinkSorted(0, m_nItems, nullptr, a_nThreads);
+
+    //The last node in the tree points to the end node
+    impl::Node * pLast = &m_pNodes[m_nItems];
+    pLast->pRight = EndNode();
+    EndNode()->pParent = pLast;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  impl::Node * 
+    AVLTreeMap<K, V, Compare>::LinkSorted(sizeType a_begin, sizeType a_end,
+                                          impl::Node * a_pParent, unsigned a_nThreads)
+  {
+    if (a_begin == a_end)
+      return nullptr;
+
+    sizeType mid = a_begin + (a_end - a_begin) / 2;
+    impl::Node * pNode = &m_pNodes[mid + 1];
+    pNode->pParent = a_pParent;
+
+    if (a_nThreads > 1)
+    {
+      unsigned nLeft = a_nThreads / 2;
+      std::thread leftThread([this, a_begin, mid, pNode, nLeft]()
+      {
+        pNode->pLeft = LinkSorted(a_begin, mid, pNode, nLeft);
+      });
+      pNode->pRight = LinkSorted(mid + 1, a_end, pNode, a_nThreads - nLeft);
+      leftThread.join();
+    }
+    else
+    {
+      pNode->pLeft = LinkSorted(a_begin, mid, pNode, 1);
+      pNode->pRight = LinkSorted(mid + 1, a_end, pNode, 1);
+    }
+
+    pNode->height = 1 + impl::Max(Height(pNode->pLeft), Height(pNode->pRight));
+    return pNode;
+  }
+
   template<typename K, typename V, bool (*Compare)(K const &, K const &)>
   bool AVLTreeMap<K, V, Compare>::KeyExists(K const & a_key, impl::Node *& a_out) const
   {
@@ -1157,6 +1364,7 @@ namespace Dg
   template<typename K, typename V, bool (*Compare)(K const &, K const &)>
   void AVLTreeMap<K, V, Compare>::Extend()
   {
+    ReallocTimer timer(*this);
     set_next_pool_size();
 
     impl::Node * oldNodes = m_pNodes;
@@ -1188,6 +1396,14 @@ namespace Dg
     }
   }
 
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void AVLTreeMap<K, V, Compare>::ReportMemory()
+  {
+    sizeType const itemBytes = sizeof(impl::Node) + sizeof(ValueType);
+    sizeType reserved = (m_pNodes == nullptr) ? 0 : pool_size() * itemBytes;
+    TrackMemory(reserved, m_nItems * itemBytes, m_nItems);
+  }
+
   template<typename K, typename V, bool (*Compare)(K const &, K const &)>
   int AVLTreeMap<K, V, Compare>::GetBalance(impl::Node * a_pNode) const
   {  
@@ -0,0 +1,543 @@
+//! @file DgBitmapIDManager.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: BitmapIDManager, ConcurrentIDManager
+
+#ifndef DGBITMAPIDMANAGER_H
+#define DGBITMAPIDMANAGER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "impl/DgBitOps.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Layout of a bitmap where every level summarises the one below: bit i
+    //! of a word at level l + 1 stands for word i of level l. Level 0 holds
+    //! one bit per ID. All levels share one array of words; the top level is
+    //! a single word.
+    class BitmapLevels
+    {
+    public:
+
+      static unsigned const s_maxLevels = 12;
+
+      BitmapLevels()
+        : m_nLevels(0)
+        , m_nBits(0)
+      {
+
+      }
+
+      //! Returns the total number of words needed.
+      size_t Init(size_t a_nBits)
+      {
+        m_nBits = a_nBits;
+        m_nLevels = 0;
+        size_t total = 0;
+        size_t nWords = (a_nBits + 63) / 64;
+        if (nWords == 0)
+          nWords = 1;
+
+        while (true)
+        {
+          m_offsets[m_nLevels] = total;
+          total += nWords;
+          m_nLevels++;
+          if (nWords == 1)
+            break;
+          nWords = (nWords + 63) / 64;
+        }
+        return total;
+      }
+
+      size_t Offset(unsigned a_level) const {return m_offsets[a_level];}
+      unsigned Top() const {return m_nLevels - 1;}
+      size_t Bits() const {return m_nBits;}
+
+      //Word holding bit a_index of level 0, and the bit itself
+      static size_t Word(size_t a_index) {return a_index >> 6;}
+      static uint64_t Bit(size_t a_index) {return uint64_t(1) << (a_index & 63);}
+
+    private:
+
+      size_t    m_offsets[s_maxLevels];
+      unsigned  m_nLevels;
+      size_t    m_nBits;
+    };
+  }
+
+  //! @ingroup DgUtility
+  //!
+  //! @class BitmapIDManager
+  //!
+  //! Serves unique IDs from a bounded range, with the same interface as
+  //! IDManager. Free IDs are kept as set bits in a hierarchical bitmap, where
+  //! each level has a bit per word of the level below saying whether that
+  //! word has any free IDs. Every operation touches one word per level, about
+  //! 4 for a million IDs, however fragmented the free IDs are. GetID() always
+  //! returns the lowest free ID.
+  //!
+  //! Memory is one bit per ID in the range, so prefer IDManager for huge,
+  //! sparsely used ranges.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename T>
+  class BitmapIDManager
+  {
+  public:
+
+    //! The default range will be simply 1
+    BitmapIDManager();
+
+    //! Construct the manager with a lower and upper limit to the ID pool
+    BitmapIDManager(T lower, T upper);
+
+    //! Initialize the ID manager with a lower and upper bound. All IDs are
+    //! marked as available.
+    void Init(T lower, T upper);
+
+    //! Get the next available ID.
+    //!
+    //! @return 0 if no more IDs are available.
+    T GetID();
+
+    //! Mark an ID as available.
+    void ReturnID(T);
+
+    //! Mark an ID as in use.
+    //!
+    //! @return false if id already in use or out of range.
+    bool MarkAsUsed(T);
+
+    //! Check to see if an ID is in use.
+    bool IsUsed(T) const;
+
+  private:
+
+    bool ToIndex(T, size_t &) const;
+    void Clear(size_t a_index);
+    void Set(size_t a_index);
+
+  private:
+
+    T                     m_lower;
+    T                     m_upper;
+    impl::BitmapLevels    m_levels;
+    std::vector<uint64_t> m_words;
+  };
+
+  //! @ingroup DgUtility
+  //!
+  //! @class ConcurrentIDManager
+  //!
+  //! A BitmapIDManager that can be used from many threads at once without
+  //! locks. Bits are claimed and released with atomic and/or, so two threads
+  //! can never be handed the same ID. The upper levels are only hints: a
+  //! thread that finds a word empty clears its summary bit and then checks
+  //! the word again, restoring the bit if an ID was returned in the
+  //! meantime, so a free ID is never lost.
+  //!
+  //! Under contention GetID() returns a low free ID rather than the lowest.
+  //! Init() is not thread safe.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename T>
+  class ConcurrentIDManager
+  {
+  public:
+
+    //! The default range will be simply 1
+    ConcurrentIDManager();
+
+    //! Construct the manager with a lower and upper limit to the ID pool
+    ConcurrentIDManager(T lower, T upper);
+
+    ConcurrentIDManager(ConcurrentIDManager const &) = delete;
+    ConcurrentIDManager & operator=(ConcurrentIDManager const &) = delete;
+
+    //! Initialize the ID manager with a lower and upper bound. All IDs are
+    //! marked as available.
+    void Init(T lower, T upper);
+
+    //! Get the next available ID.
+    //!
+    //! @return 0 if no more IDs are available.
+    T GetID();
+
+    //! Mark an ID as available.
+    void ReturnID(T);
+
+    //! Mark an ID as in use.
+    //!
+    //! @return false if id already in use or out of range.
+    bool MarkAsUsed(T);
+
+    //! Check to see if an ID is in use.
+    bool IsUsed(T) const;
+
+  private:
+
+    bool ToIndex(T, size_t &) const;
+    std::atomic<uint64_t> & Word(unsigned a_level, size_t a_index) const;
+
+    //Word a_index of a_level has been seen empty.
+    void ClearUp(unsigned a_level, size_t a_index);
+
+    //Word a_index of a_level has just gone from empty to not empty.
+    void SetUp(unsigned a_level, size_t a_index);
+
+  private:
+
+    T                                         m_lower;
+    T                                         m_upper;
+    impl::BitmapLevels                        m_levels;
+    std::unique_ptr<std::atomic<uint64_t>[]>  m_pWords;
+  };
+
+  //-------------------------------------------------------------------------------
+  //		BitmapIDManager
+  //-------------------------------------------------------------------------------
+  template<typename T>
+  BitmapIDManager<T>::BitmapIDManager()
+  {
+    Init(static_cast<T>(1), static_cast<T>(1));
+  }
+
+  template<typename T>
+  BitmapIDManager<T>::BitmapIDManager(T a_lower, T a_upper)
+  {
+    Init(a_lower, a_upper);
+  }
+
+  template<typename T>
+  void BitmapIDManager<T>::Init(T a_lower, T a_upper)
+  {
+    if (a_lower > a_upper) a_lower = a_upper;
+    m_lower = a_lower;
+    m_upper = a_upper;
+
+    size_t nBits = static_cast<size_t>(a_upper - a_lower) + 1;
+    m_words.assign(m_levels.Init(nBits), 0);
+
+    //Level by level, set a bit for every item of the level below
+    size_t nItems = nBits;
+    for (unsigned l = 0; l <= m_levels.Top(); l++)
+    {
+      uint64_t * pWords = &m_words[m_levels.Offset(l)];
+      for (size_t i = 0; i < nItems / 64; i++)
+        pWords[i] = ~uint64_t(0);
+      if ((nItems & 63) != 0)
+        pWords[nItems / 64] = (uint64_t(1) << (nItems & 63)) - 1;
+      nItems = (nItems + 63) / 64;
+    }
+  }
+
+  template<typename T>
+  T BitmapIDManager<T>::GetID()
+  {
+    unsigned top = m_levels.Top();
+    if (m_words[m_levels.Offset(top)] == 0)
+    {
+      return static_cast<T>(0);
+    }
+
+    size_t index = 0;
+    for (unsigned l = top + 1; l > 0; l--)
+    {
+      uint64_t word = m_words[m_levels.Offset(l - 1) + index];
+      index = index * 64 + impl::CountTrailingZeros(word);
+    }
+
+    Clear(index);
+    return m_lower + static_cast<T>(index);
+  }
+
+  template<typename T>
+  void BitmapIDManager<T>::ReturnID(T a_val)
+  {
+    size_t index;
+    if (!ToIndex(a_val, index))
+    {
+      return;
+    }
+    Set(index);
+  }
+
+  template<typename T>
+  bool BitmapIDManager<T>::MarkAsUsed(T a_val)
+  {
+    size_t index;
+    if (!ToIndex(a_val, index) || IsUsed(a_val))
+    {
+      return false;
+    }
+    Clear(index);
+    return true;
+  }
+
+  template<typename T>
+  bool BitmapIDManager<T>::IsUsed(T a_val) const
+  {
+    size_t index;
+    if (!ToIndex(a_val, index))
+    {
+      return false;
+    }
+    return (m_words[impl::BitmapLevels::Word(index)] & impl::BitmapLevels::Bit(index)) == 0;
+  }
+
+  template<typename T>
+  bool BitmapIDManager<T>::ToIndex(T a_val, size_t & a_index) const
+  {
+    if (a_val < m_lower || a_val > m_upper)
+    {
+      return false;
+    }
+    a_index = static_cast<size_t>(a_val - m_lower);
+    return true;
+  }
+
+  template<typename T>
+  void BitmapIDManager<T>::Clear(size_t a_index)
+  {
+    //Clear the bit, and carry on up while words become empty
+    for (unsigned l = 0; l <= m_levels.Top(); l++)
+    {
+      uint64_t & word = m_words[m_levels.Offset(l) + impl::BitmapLevels::Word(a_index)];
+      word &= ~impl::BitmapLevels::Bit(a_index);
+      if (word != 0)
+        break;
+      a_index >>= 6;
+    }
+  }
+
+  template<typename T>
+  void BitmapIDManager<T>::Set(size_t a_index)
+  {
+    //Set the bit, and carry on up while words were empty
+    for (unsigned l = 0; l <= m_levels.Top(); l++)
+    {
+      uint64_t & word = m_words[m_levels.Offset(l) + impl::BitmapLevels::Word(a_index)];
+      uint64_t old = word;
+      word |= impl::BitmapLevels::Bit(a_index);
+      if (old != 0)
+        break;
+      a_index >>= 6;
+    }
+  }
+
+  //-------------------------------------------------------------------------------
+  //		ConcurrentIDManager
+  //-------------------------------------------------------------------------------
+  template<typename T>
+  ConcurrentIDManager<T>::ConcurrentIDManager()
+  {
+    Init(static_cast<T>(1), static_cast<T>(1));
+  }
+
+  template<typename T>
+  ConcurrentIDManager<T>::ConcurrentIDManager(T a_lower, T a_upper)
+  {
+    Init(a_lower, a_upper);
+  }
+
+  template<typename T>
+  void ConcurrentIDManager<T>::Init(T a_lower, T a_upper)
+  {
+    if (a_lower > a_upper) a_lower = a_upper;
+    m_lower = a_lower;
+    m_upper = a_upper;
+
+    size_t nBits = static_cast<size_t>(a_upper - a_lower) + 1;
+    size_t nWords = m_levels.Init(nBits);
+    m_pWords.reset(new std::atomic<uint64_t>[nWords]);
+
+    size_t nItems = nBits;
+    for (unsigned l = 0; l <= m_levels.Top(); l++)
+    {
+      size_t levelWords = (nItems + 63) / 64;
+      for (size_t i = 0; i < levelWords; i++)
+      {
+        size_t nSet = nItems - i * 64;
+        Word(l, i).store(nSet >= 64 ? ~uint64_t(0) : (uint64_t(1) << nSet) - 1, std::memory_order_relaxed);
+      }
+      nItems = levelWords;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  template<typename T>
+  T ConcurrentIDManager<T>::GetID()
+  {
+    unsigned const top = m_levels.Top();
+    while (true)
+    {
+      uint64_t word = Word(top, 0).load();
+      if (word == 0)
+      {
+        return static_cast<T>(0);
+      }
+
+      //Follow the hints down to a leaf
+      size_t index = 0;
+      unsigned l = top;
+      bool stale = false;
+      for (; l > 0; l--)
+      {
+        size_t child = index * 64 + impl::CountTrailingZeros(word);
+        word = Word(l - 1, child).load();
+        if (word == 0)
+        {
+          ClearUp(l - 1, child);
+          stale = true;
+          break;
+        }
+        index = child;
+      }
+
+      if (stale)
+      {
+        continue;
+      }
+
+      //Claim a bit in the leaf
+      std::atomic<uint64_t> & leaf = Word(0, index);
+      while (word != 0)
+      {
+        uint64_t bit = word & (~word + 1);
+        uint64_t old = leaf.fetch_and(~bit);
+        if ((old & bit) != 0)
+        {
+          if ((old & ~bit) == 0)
+            ClearUp(0, index);
+          return m_lower + static_cast<T>(index * 64 + impl::CountTrailingZeros(bit));
+        }
+        word = old;
+      }
+      ClearUp(0, index);
+    }
+  }
+
+  template<typename T>
+  void ConcurrentIDManager<T>::ReturnID(T a_val)
+  {
+    size_t index;
+    if (!ToIndex(a_val, index))
+    {
+      return;
+    }
+
+    size_t wordIndex = impl::BitmapLevels::Word(index);
+    uint64_t old = Word(0, wordIndex).fetch_or(impl::BitmapLevels::Bit(index));
+    if (old == 0)
+    {
+      SetUp(0, wordIndex);
+    }
+  }
+
+  template<typename T>
+  bool ConcurrentIDManager<T>::MarkAsUsed(T a_val)
+  {
+    size_t index;
+    if (!ToIndex(a_val, index))
+    {
+      return false;
+    }
+
+    size_t wordIndex = impl::BitmapLevels::Word(index);
+    uint64_t bit = impl::BitmapLevels::Bit(index);
+    uint64_t old = Word(0, wordIndex).fetch_and(~bit);
+    if ((old & bit) == 0)
+    {
+      return false;
+    }
+    if ((old & ~bit) == 0)
+    {
+      ClearUp(0, wordIndex);
+    }
+    return true;
+  }
+
+  template<typename T>
+  bool ConcurrentIDManager<T>::IsUsed(T a_val) const
+  {
+    size_t index;
+    if (!ToIndex(a_val, index))
+    {
+      return false;
+    }
+    return (Word(0, impl::BitmapLevels::Word(index)).load() & impl::BitmapLevels::Bit(index)) == 0;
+  }
+
+  template<typename T>
+  bool ConcurrentIDManager<T>::ToIndex(T a_val, size_t & a_index) const
+  {
+    if (a_val < m_lower || a_val > m_upper)
+    {
+      return false;
+    }
+    a_index = static_cast<size_t>(a_val - m_lower);
+    return true;
+  }
+
+  template<typename T>
+  std::atomic<uint64_t> & ConcurrentIDManager<T>::Word(unsigned a_level, size_t a_index) const
+  {
+    return m_pWords[m_levels.Offset(a_level) + a_index];
+  }
+
+  template<typename T>
+  void ConcurrentIDManager<T>::ClearUp(unsigned a_level, size_t a_index)
+  {
+    while (a_level < m_levels.Top())
+    {
+      size_t parent = impl::BitmapLevels::Word(a_index);
+      uint64_t bit = impl::BitmapLevels::Bit(a_index);
+      uint64_t old = Word(a_level + 1, parent).fetch_and(~bit);
+
+      //An ID may have been returned to this word since it was seen empty
+      if (Word(a_level, a_index).load() != 0)
+      {
+        SetUp(a_level, a_index);
+        return;
+      }
+
+      if ((old & bit) == 0 || (old & ~bit) != 0)
+      {
+        return;
+      }
+
+      a_level++;
+      a_index = parent;
+    }
+  }
+
+  template<typename T>
+  void ConcurrentIDManager<T>::SetUp(unsigned a_level, size_t a_index)
+  {
+    while (a_level < m_levels.Top())
+    {
+      size_t parent = impl::BitmapLevels::Word(a_index);
+      uint64_t old = Word(a_level + 1, parent).fetch_or(impl::BitmapLevels::Bit(a_index));
+      if (old != 0)
+      {
+        return;
+      }
+      a_level++;
+      a_index = parent;
+    }
+  }
+}
+
+#endif
@@ -3,27 +3,71 @@
 //! @author Frank Hart
 //! @date 4/8/2015
 //!
-//! Class declaration: BoundedNormal
+//! Class declaration: BoundedNormalSampler
 
 #ifndef DGBOUNDEDSND_H
 #define DGBOUNDEDSND_H
 
 #include <math.h>
+#include <stddef.h>
+#include <vector>
 
 #include "DgTypes.h"
 #include "DgMath.h"
+#include "impl/DgParallelFor.h"
 
-//TODO remove dependancy to RNG. Get() should be Get(size_t index), where
-//     index is a number between 0 and a_nValues. Better yet, this should 
-//     just be a function which fills a pre-allocated table with values.
 namespace Dg
 {
-  //! Initiate the table of values.
+  namespace impl
+  {
+    //! Inverse of the standard normal CDF, for 0 < a_p < 1.
+    //!
+    //! Starts from sqrt(2) InvErf(2p - 1), then takes a Halley step against
+    //! erfc, which takes it to near double precision. Below 1e-12, 2p - 1 is
+    //! too close to -1 to hold p accurately, so the start comes from the
+    //! tail asymptote, x^2 = t - log(2 pi t) with t = -2 log(p), and is given
+    //! a second step.
+    inline double InverseNormalCDF(double a_p)
+    {
+      double x;
+      int nSteps = 1;
+      if (a_p >= 1.0e-12)
+      {
+        x = Constants<double>::SQRT2 * InvErf(2.0 * a_p - 1.0);
+      }
+      else
+      {
+        double t = -2.0 * log(a_p);
+        x = -sqrt(t - log(2.0 * Constants<double>::PI * t));
+        nSteps = 2;
+      }
+
+      //Refine
+      for (int i = 0; i < nSteps; i++)
+      {
+        double e = 0.5 * erfc(-x * Constants<double>::INVSQRT2) - a_p;
+        double u = e * 2.5066282746310002 * exp(0.5 * x * x);
+        x = x - u / (1.0 + 0.5 * x * u);
+      }
+      return x;
+    }
+
+    //! Standard normal CDF. Uses erfc so the lower tail keeps its precision.
+    inline double NormalCDF(double a_z)
+    {
+      return 0.5 * erfc(-a_z * Constants<double>::INVSQRT2);
+    }
+  }
+
+  //! Fills a table with values of a bounded normal distribution, evenly
+  //! spaced in probability. The first value is a_lower and the last is
+  //! a_upper.
   //! @param a_mean Mean
   //! @param a_sd Standard deviation
   //! @param a_lower Lower bound on the normal distribution
   //! @param a_upper Upper bound on the normal distribution
   //! @param a_nValues Number of values in the table to generate.
+  //! @param a_out Table to fill, at least a_nValues long.
   //! @return Err_None on success.
   template<typename Real>
   ErrorCode Init(Real a_mean,
@@ -33,28 +77,187 @@ namespace Dg
                  unsigned int a_nValues,
                  Real * a_out)
   {
-    Clean();
-
     //Check input
-    if (a_lower >= a_upper || Dg::IsZero(a_sd) || a_nValues == 0)
+    if (a_lower >= a_upper || !(a_sd > static_cast<Real>(0.0)) || a_nValues < 2)
       return Err_OutOfBounds;
 
-    Real zLower = 0.5 * (1.0 + std::erf((a_lower - a_mean) / (a_sd * Dg::Constants<Real>::SQRT2)));
-    Real zUpper = 0.5 * (1.0 + std::erf((a_upper - a_mean) / (a_sd * Dg::Constants<Real>::SQRT2)));
+    double mean = static_cast<double>(a_mean);
+    double sd = static_cast<double>(a_sd);
+    double pLower = impl::NormalCDF((static_cast<double>(a_lower) - mean) / sd);
+    double pUpper = impl::NormalCDF((static_cast<double>(a_upper) - mean) / sd);
 
-    m_nValues = a_nValues;
-    m_values = new Real[m_nValues];
+    //Bounds entirely in one tail, beyond what double can resolve
+    if (!(pUpper > pLower))
+      return Err_OutOfBounds;
 
-    for (unsigned i = 0; i < a_nValues; i++)
+    a_out[0] = a_lower;
+    Real prev = a_lower;
+    for (unsigned i = 1; i < a_nValues - 1; i++)
     {
-      double c = static_cast<double>(zLower + (zUpper - zLower) * static_cast<double>(i) / static_cast<double>(m_nValues - 1));
-      c = 2.0 * c - 1.0;
-      Real inverfResult = static_cast<Real>(inverf<double, N_C_INVERF>(c));
-      a_out[i] = a_sd * Dg::Constants<Real>::SQRT2 * inverfResult + a_mean;
+      double p = pLower + (pUpper - pLower) * static_cast<double>(i) / static_cast<double>(a_nValues - 1);
+      Real val = static_cast<Real>(mean + sd * impl::InverseNormalCDF(p));
+
+      //Keep the table monotone and in bounds
+      if (val < prev) val = prev;
+      if (val > a_upper) val = a_upper;
+      a_out[i] = prev = val;
     }
+    a_out[a_nValues - 1] = a_upper;
 
     return Err_None;
   }
+
+  //! @ingroup DgMath_types
+  //!
+  //! @class BoundedNormalSampler
+  //!
+  //! Draws samples from a normal distribution truncated to [lower, upper].
+  //! The inverse CDF is tabulated once in Init(); a sample is then a table
+  //! lookup and a linear interpolation of a uniform value in [0, 1]. The
+  //! uniform values come from the caller, so any generator can be used.
+  //!
+  //! The interpolation error is largest where the inverse CDF is steepest,
+  //! at bounds far out in the tails; more entries reduce it.
+  //!
+  //! @author Frank B. Hart
+  //! @date 19/10/2026
+  template<typename Real>
+  class BoundedNormalSampler
+  {
+  public:
+
+    //! Default table size.
+    static unsigned const DefaultEntries = 1024;
+
+    //! Init() must succeed before sampling.
+    BoundedNormalSampler() : m_scale(static_cast<Real>(0.0)) {}
+
+    //! Construct and Init() in one step.
+    BoundedNormalSampler(Real a_mean, Real a_sd, Real a_lower, Real a_upper,
+                         unsigned a_nEntries = DefaultEntries)
+      : m_scale(static_cast<Real>(0.0))
+    {
+      Init(a_mean, a_sd, a_lower, a_upper, a_nEntries);
+    }
+
+    //! Builds the table.
+    //! @param a_mean Mean
+    //! @param a_sd Standard deviation
+    //! @param a_lower Lower bound on the normal distribution
+    //! @param a_upper Upper bound on the normal distribution
+    //! @param a_nEntries Number of points in the table, at least 2.
+    //! @return Err_None on success. On failure the sampler is left as it was.
+    ErrorCode Init(Real a_mean, Real a_sd, Real a_lower, Real a_upper,
+                   unsigned a_nEntries = DefaultEntries);
+
+    //! Has Init() succeeded?
+    bool IsInitialised() const { return !m_table.empty(); }
+
+    //! Maps a uniform value in [0, 1] to a sample. Values outside [0, 1]
+    //! are clamped.
+    Real Sample(Real a_u) const;
+
+    //! Maps a_count uniform values in [0, 1] to samples. a_pOut may equal
+    //! a_pUniforms. The work is split over a_nThreads threads (0 = one per
+    //! hardware thread).
+    void Sample(Real const * a_pUniforms, Real * a_pOut, size_t a_count,
+                unsigned a_nThreads = 0) const;
+
+  private:
+
+    //One interval of the table
+    struct Entry
+    {
+      Real value;
+      Real slope;
+    };
+
+    void SampleRange(Real const * a_pUniforms, Real * a_pOut, size_t a_count) const;
+
+  private:
+
+    std::vector<Entry>  m_table;   //Last entry has zero slope
+    Real                m_scale;   //Number of intervals
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //	@	BoundedNormalSampler<Real>::Init()
+  //--------------------------------------------------------------------------------
+  template<typename Real>
+  ErrorCode BoundedNormalSampler<Real>::Init(Real a_mean, Real a_sd, Real a_lower, Real a_upper,
+                                             unsigned a_nEntries)
+  {
+    std::vector<Real> values(a_nEntries < 2 ? 2 : a_nEntries);
+    ErrorCode result = Dg::Init(a_mean, a_sd, a_lower, a_upper, a_nEntries, values.data());
+    if (result != Err_None)
+      return result;
+
+    m_table.resize(a_nEntries);
+    for (unsigned i = 0; i < a_nEntries - 1; i++)
+    {
+      m_table[i].value = values[i];
+      m_table[i].slope = values[i + 1] - values[i];
+    }
+    m_table[a_nEntries - 1].value = values[a_nEntries - 1];
+    m_table[a_nEntries - 1].slope = static_cast<Real>(0.0);
+    m_scale = static_cast<Real>(a_nEntries - 1);
+
+    return Err_None;
+  }	//End: BoundedNormalSampler<Real>::Init()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	BoundedNormalSampler<Real>::Sample()
+  //--------------------------------------------------------------------------------
+  template<typename Real>
+  Real BoundedNormalSampler<Real>::Sample(Real a_u) const
+  {
+    Real t = a_u * m_scale;
+    if (!(t > static_cast<Real>(0.0)))
+      t = static_cast<Real>(0.0);
+    if (t > m_scale)
+      t = m_scale;
+
+    //At u = 1 this lands on the last entry, whose slope is zero
+    size_t i = static_cast<size_t>(t);
+    Entry const & e = m_table[i];
+    return e.value + (t - static_cast<Real>(i)) * e.slope;
+  }	//End: BoundedNormalSampler<Real>::Sample()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	BoundedNormalSampler<Real>::SampleRange()
+  //--------------------------------------------------------------------------------
+  template<typename Real>
+  void BoundedNormalSampler<Real>::SampleRange(Real const * a_pUniforms, Real * a_pOut, size_t a_count) const
+  {
+    Entry const * pTable = m_table.data();
+    Real const scale = m_scale;
+    for (size_t k = 0; k < a_count; k++)
+    {
+      Real t = a_pUniforms[k] * scale;
+      t = (t > static_cast<Real>(0.0)) ? t : static_cast<Real>(0.0);
+      t = (t < scale) ? t : scale;
+      size_t i = static_cast<size_t>(t);
+      a_pOut[k] = pTable[i].value + (t - static_cast<Real>(i)) * pTable[i].slope;
+    }
+  }	//End: BoundedNormalSampler<Real>::SampleRange()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	BoundedNormalSampler<Real>::Sample()
+  //--------------------------------------------------------------------------------
+  template<typename Real>
+  void BoundedNormalSampler<Real>::Sample(Real const * a_pUniforms, Real * a_pOut, size_t a_count,
+                                          unsigned a_nThreads) const
+  {
+    impl::ParallelFor(a_count, impl::ThreadCount(a_count, a_nThreads),
+      [=](size_t a_begin, size_t a_end, unsigned)
+    {
+      SampleRange(a_pUniforms + a_begin, a_pOut + a_begin, a_end - a_begin);
+    });
+  }	//End: BoundedNormalSampler<Real>::Sample()
 }
 
-#endif
\ No newline at end of file
+#endif
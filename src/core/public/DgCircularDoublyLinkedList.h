@@ -12,8 +12,10 @@
 #include <new>
 #include <type_traits>
 #include <exception>
+#include <utility>
 
 #include "impl/DgContainerBase.h"
+#include "impl/DgChunkedNodePool.h"
 
 namespace Dg
 {
@@ -26,9 +28,15 @@ namespace Dg
   //! size if extending CircularDoublyLinkedList past that allocated, or manually resizing. This makes
   //! for fast insertion/erasing of elements.
   //!
+  //! If Chunked is true, nodes are instead taken from fixed-size chunks (of
+  //! pool_size() nodes) which are never moved. Growing the list appends a
+  //! chunk, so it never stalls to copy the whole pool, and pointers to
+  //! elements stay valid until the element is erased. Call shrink() to free
+  //! chunks left empty after erasing.
+  //!
   //! @author Frank B. Hart
   //! @date 25/08/2016
-  template<typename T>
+  template<typename T, bool Chunked = false>
   class CircularDoublyLinkedList : public ContainerBase
   {
   private:
@@ -39,6 +47,10 @@ namespace Dg
       Node* pPrev;
     };
 
+    typedef typename std::conditional<Chunked, 
+                                      impl::ChunkedNodePool<Node, T>, 
+                                      impl::NullNodePool>::type NodePool;
+
   public:
 
     //! @class const_iterator
@@ -155,6 +167,10 @@ namespace Dg
     //! Returns if the CircularDoublyLinkedList is empty.
     bool empty() const;
 
+    //! Returns the number of elements the CircularDoublyLinkedList can hold before
+    //! it needs more memory. In chunked mode this counts every slot in every chunk.
+    size_t capacity() const;
+
     //! Add an data to the back of the CircularDoublyLinkedList
     void push_back(T const &);
 
@@ -176,10 +192,17 @@ namespace Dg
     //! Resizes the CircularDoublyLinkedList. This function also clears the CircularDoublyLinkedList.
     void resize(size_t newMemBlockSize);
 
+    //! Releases unused memory. In chunked mode, frees all chunks that no longer
+    //! hold any elements. Otherwise the pool is reduced to the smallest size
+    //! that fits the elements, which invalidates all iterators.
+    void shrink();
+
   private:
 
     // Increases the size of the underlying memory block
     void Extend();
+    void Reallocate();
+    void ReportMemory() override;
     Node * InsertNewAfter(Node * a_pNode, T const & a_data);
     void DestructAll();
     void InitMemory();
@@ -189,20 +212,21 @@ namespace Dg
     Node * Remove(Node * a_pNode);
 
     T * GetDataFromNode(Node * a_pNode);
-    T const * GetDataFromNode(Node * a_pNode) const;
+    T const * GetDataFromNode(Node const * a_pNode) const;
 
   private:
 
-    Node *    m_pNodes;      //Pre-allocated block of memory to hold items
-    T    *    m_pData;
+    Node *    m_pNodes;      //Pre-allocated block of memory to hold items. In chunked mode, the head node.
+    T    *    m_pData;       //Unused in chunked mode
     size_t    m_nItems;     //Number of items currently in the CircularDoublyLinkedList
+    NodePool  m_chunks;
   };
 
   //--------------------------------------------------------------------------------
   //		const_iterator
   //--------------------------------------------------------------------------------
-  template<typename T>
-  CircularDoublyLinkedList<T>::const_iterator::const_iterator(Node const * a_pNode, 
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::const_iterator::const_iterator(Node const * a_pNode, 
                                                               Node const * a_pOffset, 
                                                               T const * a_pData)
     : m_pNode(a_pNode)
@@ -212,8 +236,8 @@ namespace Dg
 
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::const_iterator::const_iterator()
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::const_iterator::const_iterator()
     : m_pNode(nullptr) 
     , m_pOffset(nullptr)
     , m_pData(nullptr)
@@ -221,14 +245,14 @@ namespace Dg
 
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::const_iterator::~const_iterator()
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::const_iterator::~const_iterator()
   {
 
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::const_iterator::const_iterator(const_iterator const & a_it)
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::const_iterator::const_iterator(const_iterator const & a_it)
     : m_pNode(a_it.m_pNode)
     , m_pData(a_it.m_pData)
     , m_pOffset(a_it.m_pOffset)
@@ -236,9 +260,9 @@ namespace Dg
 
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::const_iterator &
-    CircularDoublyLinkedList<T>::const_iterator::operator=(const_iterator const & a_other)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::const_iterator &
+    CircularDoublyLinkedList<T, Chunked>::const_iterator::operator=(const_iterator const & a_other)
   {
     m_pNode = a_other.m_pNode;
     m_pOffset = a_other.m_pOffset;
@@ -246,71 +270,73 @@ namespace Dg
     return *this;
   }
 
-  template<typename T>
-  bool CircularDoublyLinkedList<T>::const_iterator::operator==(const_iterator const & a_it) const 
+  template<typename T, bool Chunked>
+  bool CircularDoublyLinkedList<T, Chunked>::const_iterator::operator==(const_iterator const & a_it) const 
   {
     return m_pNode == a_it.m_pNode;
   }
 
-  template<typename T>
-  bool CircularDoublyLinkedList<T>::const_iterator::operator!=(const_iterator const & a_it) const 
+  template<typename T, bool Chunked>
+  bool CircularDoublyLinkedList<T, Chunked>::const_iterator::operator!=(const_iterator const & a_it) const 
   {
     return m_pNode != a_it.m_pNode;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::const_iterator &
-    CircularDoublyLinkedList<T>::const_iterator::operator++()
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::const_iterator &
+    CircularDoublyLinkedList<T, Chunked>::const_iterator::operator++()
   {
     m_pNode = m_pNode->pNext;
     return *this;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::const_iterator
-    CircularDoublyLinkedList<T>::const_iterator::operator++(int)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::const_iterator
+    CircularDoublyLinkedList<T, Chunked>::const_iterator::operator++(int)
   {
     const_iterator result(*this);
     ++(*this);
     return result;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::const_iterator &
-    CircularDoublyLinkedList<T>::const_iterator::operator--()
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::const_iterator &
+    CircularDoublyLinkedList<T, Chunked>::const_iterator::operator--()
   {
     m_pNode = m_pNode->pPrev;
     return *this;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::const_iterator
-    CircularDoublyLinkedList<T>::const_iterator::operator--(int)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::const_iterator
+    CircularDoublyLinkedList<T, Chunked>::const_iterator::operator--(int)
   {
     const_iterator result(*this);
     --(*this);
     return result;
   }
 
-  template<typename T>
+  template<typename T, bool Chunked>
   T const *
-    CircularDoublyLinkedList<T>::const_iterator::operator->() const 
+    CircularDoublyLinkedList<T, Chunked>::const_iterator::operator->() const 
   {
+    if constexpr (Chunked)
+      return NodePool::Data(m_pNode);
     return m_pData + (m_pNode - m_pOffset);
   }
 
-  template<typename T>
+  template<typename T, bool Chunked>
   T const &
-    CircularDoublyLinkedList<T>::const_iterator::operator*() const 
+    CircularDoublyLinkedList<T, Chunked>::const_iterator::operator*() const 
   {
-    return *(m_pData + (m_pNode - m_pOffset));
+    return *operator->();
   }
 
   //--------------------------------------------------------------------------------
   //		iterator
   //--------------------------------------------------------------------------------
-  template<typename T>
-  CircularDoublyLinkedList<T>::iterator::iterator(Node * a_pNode, 
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::iterator::iterator(Node * a_pNode, 
                                                   Node* a_pOffset, 
                                                   T * a_pData)
     : m_pNode(a_pNode)
@@ -320,8 +346,8 @@ namespace Dg
 
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::iterator::iterator()
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::iterator::iterator()
     : m_pNode(nullptr) 
     , m_pOffset(nullptr)
     , m_pData(nullptr)
@@ -329,14 +355,14 @@ namespace Dg
 
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::iterator::~iterator()
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::iterator::~iterator()
   {
 
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::iterator::iterator(iterator const & a_it)
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::iterator::iterator(iterator const & a_it)
     : m_pNode(a_it.m_pNode)
     , m_pData(a_it.m_pData)
     , m_pOffset(a_it.m_pOffset)
@@ -344,9 +370,9 @@ namespace Dg
 
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::iterator &
-    CircularDoublyLinkedList<T>::iterator::operator=(iterator const & a_other)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::iterator &
+    CircularDoublyLinkedList<T, Chunked>::iterator::operator=(iterator const & a_other)
   {
     m_pNode = a_other.m_pNode;
     m_pOffset = a_other.m_pOffset;
@@ -354,232 +380,289 @@ namespace Dg
     return *this;
   }
 
-  template<typename T>
-  bool CircularDoublyLinkedList<T>::iterator::operator==(iterator const & a_it) const 
+  template<typename T, bool Chunked>
+  bool CircularDoublyLinkedList<T, Chunked>::iterator::operator==(iterator const & a_it) const 
   {
     return m_pNode == a_it.m_pNode;
   }
 
-  template<typename T>
-  bool CircularDoublyLinkedList<T>::iterator::operator!=(iterator const & a_it) const 
+  template<typename T, bool Chunked>
+  bool CircularDoublyLinkedList<T, Chunked>::iterator::operator!=(iterator const & a_it) const 
   {
     return m_pNode != a_it.m_pNode;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::iterator &
-    CircularDoublyLinkedList<T>::iterator::operator++()
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::iterator &
+    CircularDoublyLinkedList<T, Chunked>::iterator::operator++()
   {
     m_pNode = m_pNode->pNext;
     return *this;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::iterator
-    CircularDoublyLinkedList<T>::iterator::operator++(int)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::iterator
+    CircularDoublyLinkedList<T, Chunked>::iterator::operator++(int)
   {
     iterator result(*this);
     ++(*this);
     return result;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::iterator &
-    CircularDoublyLinkedList<T>::iterator::operator--()
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::iterator &
+    CircularDoublyLinkedList<T, Chunked>::iterator::operator--()
   {
     m_pNode = m_pNode->pPrev;
     return *this;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::iterator
-    CircularDoublyLinkedList<T>::iterator::operator--(int)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::iterator
+    CircularDoublyLinkedList<T, Chunked>::iterator::operator--(int)
   {
     iterator result(*this);
     --(*this);
     return result;
   }
 
-  template<typename T>
+  template<typename T, bool Chunked>
   T *
-    CircularDoublyLinkedList<T>::iterator::operator->()
+    CircularDoublyLinkedList<T, Chunked>::iterator::operator->()
   {
+    if constexpr (Chunked)
+      return NodePool::Data(m_pNode);
     return m_pData + (m_pNode - m_pOffset);
   }
 
-  template<typename T>
+  template<typename T, bool Chunked>
   T &
-    CircularDoublyLinkedList<T>::iterator::operator*()
+    CircularDoublyLinkedList<T, Chunked>::iterator::operator*()
   {
-    return *(m_pData + (m_pNode - m_pOffset));
+    return *operator->();
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::iterator::operator
-    typename CircularDoublyLinkedList<T>::const_iterator() const
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::iterator::operator
+    typename CircularDoublyLinkedList<T, Chunked>::const_iterator() const
   {
-    return const_iterator(m_pNode);
+    return const_iterator(m_pNode, m_pOffset, m_pData);
   }
 
   //--------------------------------------------------------------------------------
   //		CircularDoublyLinkedList
   //--------------------------------------------------------------------------------
-  template<typename T>
-  CircularDoublyLinkedList<T>::CircularDoublyLinkedList()
-    : ContainerBase()
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::CircularDoublyLinkedList()
+    : ContainerBase(Chunked ? impl::defaultNodeChunkSize : 0)
     , m_nItems(0)
     , m_pNodes(nullptr)
     , m_pData(nullptr)
+    , m_chunks(pool_size())
   {
     InitMemory();
     InitHead();
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::CircularDoublyLinkedList(size_t a_size)
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::CircularDoublyLinkedList(size_t a_size)
     : ContainerBase(a_size)
     , m_nItems(0)
     , m_pNodes(nullptr)
     , m_pData(nullptr)
+    , m_chunks(pool_size())
   {
     InitMemory();
     InitHead();
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::~CircularDoublyLinkedList()
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::~CircularDoublyLinkedList()
   {
     DestructAll();
     free(m_pData);
-    free(m_pNodes);
+    if constexpr (!Chunked)
+      free(m_pNodes);
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::CircularDoublyLinkedList(CircularDoublyLinkedList const & a_other)
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::CircularDoublyLinkedList(CircularDoublyLinkedList const & a_other)
     : ContainerBase(a_other)
     , m_nItems(0)
     , m_pNodes(nullptr)
     , m_pData(nullptr)
+    , m_chunks(pool_size())
   {
     InitMemory();
     Init(a_other);
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T> & CircularDoublyLinkedList<T>::operator=(CircularDoublyLinkedList const & a_other)
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked> & CircularDoublyLinkedList<T, Chunked>::operator=(CircularDoublyLinkedList const & a_other)
   {
     if (this != &a_other)
     {
       DestructAll();
 
-      if (pool_size() < a_other.pool_size())
+      if constexpr (Chunked)
+      {
+        m_chunks.Reset();
+        m_nItems = 0;
+        InitHead();
+      }
+      else if (pool_size() < a_other.pool_size())
       {
         pool_size(a_other.pool_size());
         InitMemory();
       }
 
       Init(a_other);
+      MemoryChanged();
     }
     return *this;
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T>::CircularDoublyLinkedList(CircularDoublyLinkedList && a_other)
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked>::CircularDoublyLinkedList(CircularDoublyLinkedList && a_other)
     : ContainerBase(a_other)
     , m_nItems(a_other.m_nItems)
     , m_pNodes(a_other.m_pNodes)
     , m_pData(a_other.m_pData)
+    , m_chunks(std::move(a_other.m_chunks))
   {
     a_other.m_pNodes = nullptr;
     a_other.m_pData = nullptr;
     a_other.m_nItems = 0;
+    a_other.MemoryChanged();
   }
 
-  template<typename T>
-  CircularDoublyLinkedList<T> & CircularDoublyLinkedList<T>::operator=(CircularDoublyLinkedList && a_other)
+  template<typename T, bool Chunked>
+  CircularDoublyLinkedList<T, Chunked> & CircularDoublyLinkedList<T, Chunked>::operator=(CircularDoublyLinkedList && a_other)
   {
     if (this != &a_other)
     {
+      DestructAll();
+      free(m_pData);
+      if constexpr (!Chunked)
+        free(m_pNodes);
+
       ContainerBase::operator=(a_other);
       m_pData = a_other.m_pData;
       m_pNodes = a_other.m_pNodes;
       m_nItems = a_other.m_nItems;
+      m_chunks = std::move(a_other.m_chunks);
 
       a_other.m_pNodes = nullptr;
       a_other.m_pData = nullptr;
       a_other.m_nItems = 0;
+
+      MemoryChanged();
+      a_other.MemoryChanged();
     }
     return *this;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::iterator 
-    CircularDoublyLinkedList<T>::head() 
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::iterator 
+    CircularDoublyLinkedList<T, Chunked>::head() 
   {
     return iterator(m_pNodes, m_pNodes, m_pData);
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::const_iterator
-    CircularDoublyLinkedList<T>::chead() const 
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::const_iterator
+    CircularDoublyLinkedList<T, Chunked>::chead() const 
   {
     return const_iterator(m_pNodes, m_pNodes, m_pData);
   }
 
-  template<typename T>
-  size_t CircularDoublyLinkedList<T>::size() const 
+  template<typename T, bool Chunked>
+  size_t CircularDoublyLinkedList<T, Chunked>::size() const 
   {
     return m_nItems;
   }
 
-  template<typename T>
-  bool CircularDoublyLinkedList<T>::empty() const 
+  template<typename T, bool Chunked>
+  bool CircularDoublyLinkedList<T, Chunked>::empty() const 
   {
     return m_nItems == 0;
   }
 
-  template<typename T>
-  void CircularDoublyLinkedList<T>::push_back(T const & a_item)
+  template<typename T, bool Chunked>
+  size_t CircularDoublyLinkedList<T, Chunked>::capacity() const 
   {
-    InsertNewAfter(m_pNodes[0].pPrev, a_item);
+    if constexpr (Chunked)
+      return m_chunks.chunk_count() * m_chunks.chunk_size();
+    else
+      return pool_size() - 1;
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::iterator
-    CircularDoublyLinkedList<T>::insert(iterator const & a_position, T const & a_item)
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::push_back(T const & a_item)
+  {
+    InsertNewAfter(empty() ? m_pNodes : m_pNodes[0].pPrev, a_item);
+  }
+
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::iterator
+    CircularDoublyLinkedList<T, Chunked>::insert(iterator const & a_position, T const & a_item)
   {
     Node * pNode = InsertNewAfter(a_position.m_pNode->pPrev, a_item);
     return iterator(pNode, m_pNodes, m_pData);
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::iterator
-    CircularDoublyLinkedList<T>::erase(iterator const & a_position)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::iterator
+    CircularDoublyLinkedList<T, Chunked>::erase(iterator const & a_position)
   {
     Node * pNode = Remove(a_position.m_pNode);
     return iterator(pNode, m_pNodes, m_pData);
   }
 
-  template<typename T>
-  void CircularDoublyLinkedList<T>::clear()
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::clear()
   {
     DestructAll();
+    if constexpr (Chunked)
+      m_chunks.Reset();
     InitHead();
     m_nItems = 0;
+    MemoryChanged();
   }
 
-  template<typename T>
-  void CircularDoublyLinkedList<T>::resize(size_t a_newSize)
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::resize(size_t a_newSize)
   {
     DestructAll();
     Init(a_newSize);
   }
 
-  template<typename T>
-  void CircularDoublyLinkedList<T>::Extend()
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::shrink()
+  {
+    if constexpr (Chunked)
+      m_chunks.Shrink();
+    else
+    {
+      size_t oldSize = pool_size();
+      if (pool_size(m_nItems + 1) < oldSize)
+        Reallocate();
+    }
+    MemoryChanged();
+  }
+
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::Extend()
   {
-    Node * pOldNodes(m_pNodes);
     set_next_pool_size();
+    Reallocate();
+  }
+
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::Reallocate()
+  {
+    ReallocTimer timer(*this);
+    Node * pOldNodes(m_pNodes);
 
     m_pNodes = static_cast<Node *>(realloc(m_pNodes, (pool_size()) * sizeof(Node)));
     if (m_pNodes == nullptr)
@@ -597,23 +680,44 @@ namespace Dg
         m_pNodes[i].pNext= m_pNodes + (m_pNodes[i].pNext - pOldNodes);
       }
     }
+
+    if (m_nItems == 0)
+      InitHead();
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::Node *
-    CircularDoublyLinkedList<T>::InsertNewAfter(Node * a_pNode, T const & a_data)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::Node *
+    CircularDoublyLinkedList<T, Chunked>::InsertNewAfter(Node * a_pNode, T const & a_data)
   {
-    if (m_nItems == (pool_size() - 1))
+    Node * newNode;
+    if constexpr (Chunked)
     {
-      //Extending might invalidate a_pNode, so we need to record its index in the pool.
-      size_t index(a_pNode - m_pNodes);
-      Extend();
-      a_pNode = &m_pNodes[index]; //Reset the pointer in case we have extended.
+      newNode = m_chunks.Allocate();
+      new (NodePool::Data(newNode)) T(a_data);
+
+      //First node becomes the head and links to itself
+      if (m_pNodes == nullptr)
+      {
+        m_pNodes = newNode;
+        a_pNode = newNode;
+        newNode->pNext = newNode;
+        newNode->pPrev = newNode;
+      }
     }
+    else
+    {
+      if (m_nItems == (pool_size() - 1))
+      {
+        //Extending might invalidate a_pNode, so we need to record its index in the pool.
+        size_t index(a_pNode - m_pNodes);
+        Extend();
+        a_pNode = &m_pNodes[index]; //Reset the pointer in case we have extended.
+      }
 
-    new (&m_pData[m_nItems]) T(a_data);
+      new (&m_pData[m_nItems]) T(a_data);
+      newNode = &m_pNodes[m_nItems];
+    }
 
-    Node * newNode = &m_pNodes[m_nItems];
     Node * pNext = a_pNode->pNext;
     a_pNode->pNext->pPrev = newNode;
     a_pNode->pNext = newNode;
@@ -621,19 +725,33 @@ namespace Dg
     newNode->pNext = pNext;
     m_nItems++;
 
+    MemoryChanged();
     return newNode;
   }
 
-  template<typename T>
-  void CircularDoublyLinkedList<T>::DestructAll()
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::DestructAll()
   {
-    for (size_t i = 0; i < m_nItems; i++)
-      m_pData[i].~T();
+    if constexpr (Chunked)
+    {
+      Node * pNode = m_pNodes;
+      for (size_t i = 0; i < m_nItems; i++, pNode = pNode->pNext)
+        GetDataFromNode(pNode)->~T();
+    }
+    else
+    {
+      for (size_t i = 0; i < m_nItems; i++)
+        m_pData[i].~T();
+    }
   }
 
-  template<typename T>
-  void CircularDoublyLinkedList<T>::InitMemory()
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::InitMemory()
   {
+    //Chunks are allocated as needed
+    if constexpr (Chunked)
+      return;
+
     m_pNodes = static_cast<Node*> (realloc(m_pNodes, pool_size() * sizeof(Node)));
     if (m_pNodes == nullptr)
       throw std::bad_alloc();
@@ -643,10 +761,23 @@ namespace Dg
       throw std::bad_alloc();
   }
 
-  template<typename T>
-  void CircularDoublyLinkedList<T>::Init(CircularDoublyLinkedList const & a_other)
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::Init(CircularDoublyLinkedList const & a_other)
   {
+    if constexpr (Chunked)
+    {
+      Node const * pNode = a_other.m_pNodes;
+      for (size_t i = 0; i < a_other.m_nItems; i++, pNode = pNode->pNext)
+        push_back(*a_other.GetDataFromNode(pNode));
+      return;
+    }
+
     m_nItems = a_other.m_nItems;
+    if (m_nItems == 0)
+    {
+      InitHead();
+      return;
+    }
 
     //We might as well sort the data in list order as we copy.
     //It will cost us nothing.
@@ -668,16 +799,22 @@ namespace Dg
     m_pNodes[m_nItems - 1].pNext = m_pNodes;
   }
 
-  template<typename T>
-  void CircularDoublyLinkedList<T>::InitHead()
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::InitHead()
   {
+    if constexpr (Chunked)
+    {
+      m_pNodes = nullptr;
+      return;
+    }
+
     m_pNodes[0].pNext = &m_pNodes[0];
     m_pNodes[0].pPrev = &m_pNodes[0];
   }
 
-  template<typename T>
-  typename CircularDoublyLinkedList<T>::Node *
-    CircularDoublyLinkedList<T>::Remove(Node * a_pNode)
+  template<typename T, bool Chunked>
+  typename CircularDoublyLinkedList<T, Chunked>::Node *
+    CircularDoublyLinkedList<T, Chunked>::Remove(Node * a_pNode)
   {
     Node * pNext(a_pNode->pNext);
 
@@ -688,6 +825,18 @@ namespace Dg
     T * pData = GetDataFromNode(a_pNode);
     pData->~T();
 
+    if constexpr (Chunked)
+    {
+      m_chunks.Release(a_pNode);
+      m_nItems--;
+      MemoryChanged();
+      if (m_nItems == 0)
+        pNext = nullptr;
+      if (a_pNode == m_pNodes)
+        m_pNodes = pNext;
+      return pNext;
+    }
+
     if (&m_pNodes[m_nItems - 1] != a_pNode)
     {
       //Move last node to fill gap
@@ -701,19 +850,39 @@ namespace Dg
       pNext = a_pNode;
 
     m_nItems--;
+    MemoryChanged();
     return pNext;
   }
 
-  template<typename T>
-  T * CircularDoublyLinkedList<T>::GetDataFromNode(Node * a_pNode)
+  template<typename T, bool Chunked>
+  T * CircularDoublyLinkedList<T, Chunked>::GetDataFromNode(Node * a_pNode)
   {
+    if constexpr (Chunked)
+      return NodePool::Data(a_pNode);
     return m_pData + (a_pNode - m_pNodes);
   }
 
-  template<typename T>
-  T const * CircularDoublyLinkedList<T>::GetDataFromNode(Node * a_pNode) const
+  template<typename T, bool Chunked>
+  T const * CircularDoublyLinkedList<T, Chunked>::GetDataFromNode(Node const * a_pNode) const
   {
+    if constexpr (Chunked)
+      return NodePool::Data(a_pNode);
     return m_pData + (a_pNode - m_pNodes);
   }
+
+  template<typename T, bool Chunked>
+  void CircularDoublyLinkedList<T, Chunked>::ReportMemory()
+  {
+    if constexpr (Chunked)
+    {
+      TrackMemory(m_chunks.reserved_bytes(), m_nItems * NodePool::slot_bytes(), m_nItems);
+    }
+    else
+    {
+      size_t const nodeBytes = sizeof(Node) + sizeof(T);
+      size_t reserved = (m_pData == nullptr) ? 0 : pool_size() * nodeBytes;
+      TrackMemory(reserved, m_nItems * nodeBytes, m_nItems);
+    }
+  }
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,305 @@
+//! @file DgConcurrentHashTable.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: ConcurrentHashTable
+
+#ifndef DGCONCURRENTHASHTABLE_H
+#define DGCONCURRENTHASHTABLE_H
+
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <stdint.h>
+
+#include "DgOpenHashTable.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Default retire hook: removed values are simply destroyed.
+    template<typename V>
+    struct DestroyOnRetire
+    {
+      void operator()(V &&) const {}
+    };
+
+    //! splitmix64 finalizer. Used to pick a shard with bits that are
+    //! independent of those the shard's table uses to pick a bucket.
+    inline uint64_t MixHash(uint64_t a_hash)
+    {
+      a_hash ^= a_hash >> 30;
+      a_hash *= 0xbf58476d1ce4e5b9ull;
+      a_hash ^= a_hash >> 27;
+      a_hash *= 0x94d049bb133111ebull;
+      a_hash ^= a_hash >> 31;
+      return a_hash;
+    }
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! A hash map that is safe to use from many threads at once.
+  //!
+  //! Keys are spread over ShardCount independent OpenHashTables, each
+  //! guarded by its own reader/writer lock and padded onto its own cache
+  //! line. Lookups only take a shared lock on one shard, so readers do not
+  //! contend with each other, and writers only block the shard they touch.
+  //!
+  //! Values are copied out rather than handed back by reference, so no
+  //! lock is held once a call returns. When a value is removed (erase) or
+  //! replaced (upsert) it is moved into the Retire functor after the shard
+  //! lock has been released. The default destroys it; for values that are
+  //! pointers shared with readers, Retire is the hook for an epoch or
+  //! hazard-pointer scheme to defer the delete until no reader can
+  //! still hold it. Values still in the table are passed to Retire by
+  //! clear() and by the destructor.
+  //!
+  //! Because no lock is held, the table's one Retire object is called from
+  //! whichever threads erase or upsert, possibly several at once. Its
+  //! operator() must be thread-safe.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename K,
+           typename V,
+           typename Hasher = Hash<K>,
+           typename Retire = impl::DestroyOnRetire<V>,
+           size_t ShardCount = 64>
+  class ConcurrentHashTable
+  {
+    static_assert((ShardCount & (ShardCount - 1)) == 0, "ShardCount must be a power of 2");
+
+    typedef size_t sizeType;
+
+    struct alignas(64) Shard
+    {
+      mutable std::shared_mutex     mutex;
+      OpenHashTable<K, V, Hasher>   table;
+    };
+
+  public:
+
+    ConcurrentHashTable();
+    ConcurrentHashTable(Retire const & a_retire);
+    ~ConcurrentHashTable();
+
+    ConcurrentHashTable(ConcurrentHashTable const &) = delete;
+    ConcurrentHashTable & operator=(ConcurrentHashTable const &) = delete;
+
+    //Number of elements. Only exact if no other thread is writing.
+    sizeType size() const;
+    bool empty() const;
+
+    //Reserve space for a_nItems spread evenly over the shards.
+    void reserve(sizeType a_nItems);
+
+    //Copies the value at a_key into a_out.
+    //Returns false if the key does not exist.
+    bool find(K const & a_key, V & a_out) const;
+
+    bool contains(K const & a_key) const;
+
+    //Inserts the value if the key does not exist.
+    //Returns false if the key already exists, in which case nothing is changed.
+    bool insert(K const & a_key, V const & a_value);
+
+    //Inserts the value, or overwrites the existing value if the key exists.
+    //Returns true if the key was inserted.
+    bool upsert(K const & a_key, V const & a_value);
+
+    //Returns false if the key did not exist.
+    bool erase(K const & a_key);
+
+    //Calls a_fn(key, value) for every element. Each shard is locked for
+    //reading while it is visited, so a_fn must not write to this table.
+    template<typename Fn>
+    void ForEach(Fn a_fn) const;
+
+    void clear();
+
+  private:
+
+    Shard & GetShard(K const &);
+    Shard const & GetShard(K const &) const;
+
+  private:
+
+    Shard     m_shards[ShardCount];
+    Hasher    m_hasher;
+    Retire    m_retire;
+  };
+
+  //------------------------------------------------------------------------------------------------
+  // ConcurrentHashTable
+  //------------------------------------------------------------------------------------------------
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::ConcurrentHashTable()
+    : m_hasher()
+    , m_retire()
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::ConcurrentHashTable(Retire const & a_retire)
+    : m_hasher()
+    , m_retire(a_retire)
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::~ConcurrentHashTable()
+  {
+    clear();
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  typename ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::sizeType
+    ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::size() const
+  {
+    sizeType result = 0;
+    for (sizeType i = 0; i < ShardCount; i++)
+    {
+      std::shared_lock<std::shared_mutex> lock(m_shards[i].mutex);
+      result += m_shards[i].table.size();
+    }
+    return result;
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  bool ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::empty() const
+  {
+    return size() == 0;
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  void ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::reserve(sizeType a_nItems)
+  {
+    //Leave some room for uneven spread
+    sizeType perShard = a_nItems / ShardCount;
+    perShard += perShard / 8 + 1;
+    for (sizeType i = 0; i < ShardCount; i++)
+    {
+      std::unique_lock<std::shared_mutex> lock(m_shards[i].mutex);
+      m_shards[i].table.reserve(perShard);
+    }
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  bool ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::find(K const & a_key, V & a_out) const
+  {
+    Shard const & shard = GetShard(a_key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.table.find(a_key);
+    if (it == shard.table.cend())
+      return false;
+    a_out = it->second;
+    return true;
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  bool ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::contains(K const & a_key) const
+  {
+    Shard const & shard = GetShard(a_key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.table.find(a_key) != shard.table.cend();
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  bool ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::insert(K const & a_key, V const & a_value)
+  {
+    Shard & shard = GetShard(a_key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    sizeType oldSize = shard.table.size();
+    shard.table.insert(a_key, a_value);
+    return shard.table.size() != oldSize;
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  bool ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::upsert(K const & a_key, V const & a_value)
+  {
+    Shard & shard = GetShard(a_key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.table.find(a_key);
+    if (it == shard.table.end())
+    {
+      shard.table.insert(a_key, a_value);
+      return true;
+    }
+
+    V old(std::move(it->second));
+    it->second = a_value;
+    lock.unlock();
+
+    m_retire(std::move(old));
+    return false;
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  bool ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::erase(K const & a_key)
+  {
+    Shard & shard = GetShard(a_key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.table.find(a_key);
+    if (it == shard.table.end())
+      return false;
+
+    V old(std::move(it->second));
+    shard.table.erase(it);
+    lock.unlock();
+
+    m_retire(std::move(old));
+    return true;
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  template<typename Fn>
+  void ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::ForEach(Fn a_fn) const
+  {
+    for (sizeType i = 0; i < ShardCount; i++)
+    {
+      std::shared_lock<std::shared_mutex> lock(m_shards[i].mutex);
+      for (auto it = m_shards[i].table.cbegin(); it != m_shards[i].table.cend(); it++)
+        a_fn(it->first, it->second);
+    }
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  void ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::clear()
+  {
+    for (sizeType i = 0; i < ShardCount; i++)
+    {
+      OpenHashTable<K, V, Hasher> old;
+      {
+        std::unique_lock<std::shared_mutex> lock(m_shards[i].mutex);
+        old = std::move(m_shards[i].table);
+        m_shards[i].table = OpenHashTable<K, V, Hasher>();
+      }
+
+      for (auto it = old.begin(); it != old.end(); it++)
+        m_retire(std::move(it->second));
+    }
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  typename ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::Shard &
+    ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::GetShard(K const & a_key)
+  {
+    uint64_t hash = impl::MixHash(static_cast<uint64_t>(m_hasher(a_key)));
+    return m_shards[hash & (ShardCount - 1)];
+  }
+
+  template<typename K, typename V, typename Hasher, typename Retire, size_t ShardCount>
+  typename ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::Shard const &
+    ConcurrentHashTable<K, V, Hasher, Retire, ShardCount>::GetShard(K const & a_key) const
+  {
+    uint64_t hash = impl::MixHash(static_cast<uint64_t>(m_hasher(a_key)));
+    return m_shards[hash & (ShardCount - 1)];
+  }
+}
+
+#endif
@@ -14,8 +14,10 @@
 #include <new>
 #include <type_traits>
 #include <exception>
+#include <utility>
 
 #include "impl/DgContainerBase.h"
+#include "impl/DgChunkedNodePool.h"
 
 namespace Dg
 {
@@ -28,9 +30,15 @@ namespace Dg
   //! size if extending DoublyLinkedList past that allocated, or manually resizing. This makes
   //! for fast insertion/erasing of elements.
   //!
+  //! If Chunked is true, nodes are instead taken from fixed-size chunks (of
+  //! pool_size() nodes) which are never moved. Growing the list appends a
+  //! chunk, so it never stalls to copy the whole pool, and pointers to
+  //! elements stay valid until the element is erased. Call shrink() to free
+  //! chunks left empty after erasing.
+  //!
   //! @author Frank B. Hart
   //! @date 25/08/2016
-  template<typename T>
+  template<typename T, bool Chunked = false>
   class DoublyLinkedList : public ContainerBase
   {
   private:
@@ -41,6 +49,10 @@ namespace Dg
 		  Node* pPrev;
 	  };
 
+    typedef typename std::conditional<Chunked, 
+                                      impl::ChunkedNodePool<Node, T>, 
+                                      impl::NullNodePool>::type NodePool;
+
   public:
 
     //! @class const_iterator
@@ -169,6 +181,10 @@ namespace Dg
     //! Returns if the DoublyLinkedList is empty.
 	  bool empty() const;
 
+    //! Returns the number of elements the DoublyLinkedList can hold before it
+    //! needs more memory. In chunked mode this counts every slot in every chunk.
+    size_t capacity() const;
+
     //! Returns a reference to the last data in the DoublyLinkedList container.
     //! Calling this function on an empty container causes undefined behavior.
     //!
@@ -223,10 +239,17 @@ namespace Dg
     //! Resizes the DoublyLinkedList. This function also clears the DoublyLinkedList.
 	  void resize(size_t newMemBlockSize);
 
+    //! Releases unused memory. In chunked mode, frees all chunks that no longer
+    //! hold any elements. Otherwise the pool is reduced to the smallest size
+    //! that fits the elements, which invalidates all iterators.
+    void shrink();
+
   private:
 
     // Increases the size of the underlying memory block
     void Extend();
+    void Reallocate();
+    void ReportMemory() override;
     Node * InsertNewAfter(Node * a_pNode, T const & a_data);
     void DestructAll();
     void InitMemory();
@@ -236,20 +259,21 @@ namespace Dg
     Node * Remove(Node * a_pNode);
 
     T * GetDataFromNode(Node * a_pNode);
-    T const * GetDataFromNode(Node * a_pNode) const;
+    T const * GetDataFromNode(Node const * a_pNode) const;
 
   private:
 
-	  Node *    m_pNodes;      //Pre-allocated block of memory to hold items
-    T    *    m_pData;
+	  Node *    m_pNodes;      //Pre-allocated block of memory to hold items. In chunked mode, only the end node.
+    T    *    m_pData;       //Unused in chunked mode
 	  size_t    m_nItems;     //Number of items currently in the DoublyLinkedList
+    NodePool  m_chunks;
   };
 
   //--------------------------------------------------------------------------------
   //		const_iterator
   //--------------------------------------------------------------------------------
-  template<typename T>
-  DoublyLinkedList<T>::const_iterator::const_iterator(Node const * a_pNode, 
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::const_iterator::const_iterator(Node const * a_pNode, 
                                                       Node const * a_pNodeBegin, 
                                                       T const * a_pData)
   : m_pNode(a_pNode)
@@ -259,8 +283,8 @@ namespace Dg
 
   }
   
-  template<typename T>
-  DoublyLinkedList<T>::const_iterator::const_iterator()
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::const_iterator::const_iterator()
     : m_pNode(nullptr) 
     , m_pOffset(nullptr)
     , m_pData(nullptr)
@@ -268,14 +292,14 @@ namespace Dg
 
   }
 
-  template<typename T>
-  DoublyLinkedList<T>::const_iterator::~const_iterator()
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::const_iterator::~const_iterator()
   {
 
   }
 
-  template<typename T>
-  DoublyLinkedList<T>::const_iterator::const_iterator(const_iterator const & a_it)
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::const_iterator::const_iterator(const_iterator const & a_it)
     : m_pNode(a_it.m_pNode)
     , m_pData(a_it.m_pData)
     , m_pOffset(a_it.m_pOffset)
@@ -283,9 +307,9 @@ namespace Dg
 
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::const_iterator &
-    DoublyLinkedList<T>::const_iterator::operator=(const_iterator const & a_other)
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::const_iterator &
+    DoublyLinkedList<T, Chunked>::const_iterator::operator=(const_iterator const & a_other)
   {
     m_pNode = a_other.m_pNode;
     m_pOffset = a_other.m_pOffset;
@@ -293,71 +317,73 @@ namespace Dg
     return *this;
   }
 
-  template<typename T>
-  bool DoublyLinkedList<T>::const_iterator::operator==(const_iterator const & a_it) const 
+  template<typename T, bool Chunked>
+  bool DoublyLinkedList<T, Chunked>::const_iterator::operator==(const_iterator const & a_it) const 
   {
     return m_pNode == a_it.m_pNode;
   }
 
-  template<typename T>
-  bool DoublyLinkedList<T>::const_iterator::operator!=(const_iterator const & a_it) const 
+  template<typename T, bool Chunked>
+  bool DoublyLinkedList<T, Chunked>::const_iterator::operator!=(const_iterator const & a_it) const 
   {
     return m_pNode != a_it.m_pNode;
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::const_iterator &
-    DoublyLinkedList<T>::const_iterator::operator++()
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::const_iterator &
+    DoublyLinkedList<T, Chunked>::const_iterator::operator++()
   {
     m_pNode = m_pNode->pNext;
     return *this;
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::const_iterator
-    DoublyLinkedList<T>::const_iterator::operator++(int)
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::const_iterator
+    DoublyLinkedList<T, Chunked>::const_iterator::operator++(int)
   {
     const_iterator result(*this);
     ++(*this);
     return result;
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::const_iterator &
-    DoublyLinkedList<T>::const_iterator::operator--()
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::const_iterator &
+    DoublyLinkedList<T, Chunked>::const_iterator::operator--()
   {
     m_pNode = m_pNode->pPrev;
     return *this;
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::const_iterator
-    DoublyLinkedList<T>::const_iterator::operator--(int)
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::const_iterator
+    DoublyLinkedList<T, Chunked>::const_iterator::operator--(int)
   {
     const_iterator result(*this);
     --(*this);
     return result;
   }
 
-  template<typename T>
+  template<typename T, bool Chunked>
   T const *
-    DoublyLinkedList<T>::const_iterator::operator->() const 
+    DoublyLinkedList<T, Chunked>::const_iterator::operator->() const 
   {
+    if constexpr (Chunked)
+      return NodePool::Data(m_pNode);
     return m_pData + (m_pNode - m_pOffset);
   }
 
-  template<typename T>
+  template<typename T, bool Chunked>
   T const &
-    DoublyLinkedList<T>::const_iterator::operator*() const 
+    DoublyLinkedList<T, Chunked>::const_iterator::operator*() const 
   {
-    return *(m_pData + (m_pNode - m_pOffset));
+    return *operator->();
   }
 
   //--------------------------------------------------------------------------------
   //		iterator
   //--------------------------------------------------------------------------------
-  template<typename T>
-  DoublyLinkedList<T>::iterator::iterator(Node * a_pNode, 
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::iterator::iterator(Node * a_pNode, 
                                           Node* a_pOffset, 
                                           T * a_pData)
     : m_pNode(a_pNode)
@@ -367,8 +393,8 @@ namespace Dg
 
   }
 
-  template<typename T>
-  DoublyLinkedList<T>::iterator::iterator()
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::iterator::iterator()
     : m_pNode(nullptr) 
     , m_pOffset(nullptr)
     , m_pData(nullptr)
@@ -376,14 +402,14 @@ namespace Dg
 
   }
 
-  template<typename T>
-  DoublyLinkedList<T>::iterator::~iterator()
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::iterator::~iterator()
   {
 
   }
 
-  template<typename T>
-  DoublyLinkedList<T>::iterator::iterator(iterator const & a_it)
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::iterator::iterator(iterator const & a_it)
     : m_pNode(a_it.m_pNode)
     , m_pData(a_it.m_pData)
     , m_pOffset(a_it.m_pOffset)
@@ -391,9 +417,9 @@ namespace Dg
 
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::iterator &
-    DoublyLinkedList<T>::iterator::operator=(iterator const & a_other)
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::iterator &
+    DoublyLinkedList<T, Chunked>::iterator::operator=(iterator const & a_other)
   {
     m_pNode = a_other.m_pNode;
     m_pOffset = a_other.m_pOffset;
@@ -401,288 +427,342 @@ namespace Dg
     return *this;
   }
 
-  template<typename T>
-  bool DoublyLinkedList<T>::iterator::operator==(iterator const & a_it) const 
+  template<typename T, bool Chunked>
+  bool DoublyLinkedList<T, Chunked>::iterator::operator==(iterator const & a_it) const 
   {
     return m_pNode == a_it.m_pNode;
   }
 
-  template<typename T>
-  bool DoublyLinkedList<T>::iterator::operator!=(iterator const & a_it) const 
+  template<typename T, bool Chunked>
+  bool DoublyLinkedList<T, Chunked>::iterator::operator!=(iterator const & a_it) const 
   {
     return m_pNode != a_it.m_pNode;
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::iterator &
-    DoublyLinkedList<T>::iterator::operator++()
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::iterator &
+    DoublyLinkedList<T, Chunked>::iterator::operator++()
   {
     m_pNode = m_pNode->pNext;
     return *this;
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::iterator
-    DoublyLinkedList<T>::iterator::operator++(int)
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::iterator
+    DoublyLinkedList<T, Chunked>::iterator::operator++(int)
   {
     iterator result(*this);
     ++(*this);
     return result;
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::iterator &
-    DoublyLinkedList<T>::iterator::operator--()
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::iterator &
+    DoublyLinkedList<T, Chunked>::iterator::operator--()
   {
     m_pNode = m_pNode->pPrev;
     return *this;
   }
 
-  template<typename T>
-  typename DoublyLinkedList<T>::iterator
-    DoublyLinkedList<T>::iterator::operator--(int)
+  template<typename T, bool Chunked>
+  typename DoublyLinkedList<T, Chunked>::iterator
+    DoublyLinkedList<T, Chunked>::iterator::operator--(int)
   {
     iterator result(*this);
     --(*this);
     return result;
   }
 
-  template<typename T>
+  template<typename T, bool Chunked>
   T *
-    DoublyLinkedList<T>::iterator::operator->()
+    DoublyLinkedList<T, Chunked>::iterator::operator->()
   {
+    if constexpr (Chunked)
+      return NodePool::Data(m_pNode);
     return m_pData + (m_pNode - m_pOffset);
   }
 
-  template<typename T>
+  template<typename T, bool Chunked>
   T &
-    DoublyLinkedList<T>::iterator::operator*()
+    DoublyLinkedList<T, Chunked>::iterator::operator*()
   {
-    return *(m_pData + (m_pNode - m_pOffset));
+    return *operator->();
   }
 
-  template<typename T>
-  DoublyLinkedList<T>::iterator::operator
-    typename DoublyLinkedList<T>::const_iterator() const
+  template<typename T, bool Chunked>
+  DoublyLinkedList<T, Chunked>::iterator::operator
+    typename DoublyLinkedList<T, Chunked>::const_iterator() const
   {
-    return const_iterator(m_pNode);
+    return const_iterator(m_pNode, m_pOffset, m_pData);
   }
 
   //--------------------------------------------------------------------------------
   //		DoublyLinkedList
   //--------------------------------------------------------------------------------
-  template<typename T>
-   DoublyLinkedList<T>::DoublyLinkedList()
-    : ContainerBase()
+  template<typename T, bool Chunked>
+   DoublyLinkedList<T, Chunked>::DoublyLinkedList()
+    : ContainerBase(Chunked ? impl::defaultNodeChunkSize : 0)
     , m_nItems(0)
     , m_pNodes(nullptr)
     , m_pData(nullptr)
+    , m_chunks(pool_size())
   {
     InitMemory();
     InitEndNode();
   }
 
-   template<typename T>
-   DoublyLinkedList<T>::DoublyLinkedList(size_t a_size)
+   template<typename T, bool Chunked>
+   DoublyLinkedList<T, Chunked>::DoublyLinkedList(size_t a_size)
      : ContainerBase(a_size)
      , m_nItems(0)
      , m_pNodes(nullptr)
      , m_pData(nullptr)
+     , m_chunks(pool_size())
    {
      InitMemory();
      InitEndNode();
    }
 
-   template<typename T>
-   DoublyLinkedList<T>::~DoublyLinkedList()
+   template<typename T, bool Chunked>
+   DoublyLinkedList<T, Chunked>::~DoublyLinkedList()
    {
      DestructAll();
      free(m_pData);
      free(m_pNodes);
    }
 
-   template<typename T>
-   DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList const & a_other)
+   template<typename T, bool Chunked>
+   DoublyLinkedList<T, Chunked>::DoublyLinkedList(DoublyLinkedList const & a_other)
      : ContainerBase(a_other)
      , m_nItems(0)
      , m_pNodes(nullptr)
      , m_pData(nullptr)
+     , m_chunks(pool_size())
    {
      InitMemory();
      Init(a_other);
    }
 
-   template<typename T>
-   DoublyLinkedList<T> & DoublyLinkedList<T>::operator=(DoublyLinkedList const & a_other)
+   template<typename T, bool Chunked>
+   DoublyLinkedList<T, Chunked> & DoublyLinkedList<T, Chunked>::operator=(DoublyLinkedList const & a_other)
    {
      if (this != &a_other)
      {
        DestructAll();
 
-       if (pool_size() < a_other.pool_size())
+       if constexpr (Chunked)
+       {
+         m_chunks.Reset();
+         m_nItems = 0;
+       }
+       else if (pool_size() < a_other.pool_size())
        {
          pool_size(a_other.pool_size());
          InitMemory();
        }
 
        Init(a_other);
+       MemoryChanged();
      }
      return *this;
    }
 
-   template<typename T>
-   DoublyLinkedList<T>::DoublyLinkedList(DoublyLinkedList && a_other)
+   template<typename T, bool Chunked>
+   DoublyLinkedList<T, Chunked>::DoublyLinkedList(DoublyLinkedList && a_other)
      : ContainerBase(a_other)
      , m_nItems(a_other.m_nItems)
      , m_pNodes(a_other.m_pNodes)
      , m_pData(a_other.m_pData)
+     , m_chunks(std::move(a_other.m_chunks))
    {
      a_other.m_pNodes = nullptr;
      a_other.m_pData = nullptr;
      a_other.m_nItems = 0;
+     a_other.MemoryChanged();
    }
 
-   template<typename T>
-   DoublyLinkedList<T> & DoublyLinkedList<T>::operator=(DoublyLinkedList && a_other)
+   template<typename T, bool Chunked>
+   DoublyLinkedList<T, Chunked> & DoublyLinkedList<T, Chunked>::operator=(DoublyLinkedList && a_other)
    {
      if (this != &a_other)
      {
+       DestructAll();
+       free(m_pData);
+       free(m_pNodes);
+
        ContainerBase::operator=(a_other);
        m_pData = a_other.m_pData;
        m_pNodes = a_other.m_pNodes;
        m_nItems = a_other.m_nItems;
+       m_chunks = std::move(a_other.m_chunks);
 
        a_other.m_pNodes = nullptr;
        a_other.m_pData = nullptr;
        a_other.m_nItems = 0;
+
+       MemoryChanged();
+       a_other.MemoryChanged();
      }
      return *this;
    }
 
-   template<typename T>
-   typename DoublyLinkedList<T>::iterator 
-     DoublyLinkedList<T>::begin() 
+   template<typename T, bool Chunked>
+   typename DoublyLinkedList<T, Chunked>::iterator 
+     DoublyLinkedList<T, Chunked>::begin() 
    {
      return iterator(m_pNodes[0].pNext, m_pNodes + 1, m_pData);
    }
 
-   template<typename T>
-   typename DoublyLinkedList<T>::iterator
-     DoublyLinkedList<T>::end() 
+   template<typename T, bool Chunked>
+   typename DoublyLinkedList<T, Chunked>::iterator
+     DoublyLinkedList<T, Chunked>::end() 
    {
      return iterator(&m_pNodes[0], m_pNodes + 1, m_pData); 
    }
 
-   template<typename T>
-   typename DoublyLinkedList<T>::const_iterator
-     DoublyLinkedList<T>::cbegin() const 
+   template<typename T, bool Chunked>
+   typename DoublyLinkedList<T, Chunked>::const_iterator
+     DoublyLinkedList<T, Chunked>::cbegin() const 
    {
      return const_iterator(m_pNodes[0].pNext, m_pNodes + 1, m_pData);
    }
 
-   template<typename T>
-   typename DoublyLinkedList<T>::const_iterator
-     DoublyLinkedList<T>::cend() const 
+   template<typename T, bool Chunked>
+   typename DoublyLinkedList<T, Chunked>::const_iterator
+     DoublyLinkedList<T, Chunked>::cend() const 
    {
      return const_iterator(&m_pNodes[0], m_pNodes + 1, m_pData); 
    }
 
-   template<typename T>
-   size_t DoublyLinkedList<T>::size() const 
+   template<typename T, bool Chunked>
+   size_t DoublyLinkedList<T, Chunked>::size() const 
    {
      return m_nItems;
    }
 
-   template<typename T>
-   bool DoublyLinkedList<T>::empty() const 
+   template<typename T, bool Chunked>
+   bool DoublyLinkedList<T, Chunked>::empty() const 
    {
      return m_nItems == 0;
    }
 
-   template<typename T>
-   T & DoublyLinkedList<T>::back() 
+   template<typename T, bool Chunked>
+   size_t DoublyLinkedList<T, Chunked>::capacity() const 
+   {
+     if constexpr (Chunked)
+       return m_chunks.chunk_count() * m_chunks.chunk_size();
+     else
+       return pool_size() - 1;
+   }
+
+   template<typename T, bool Chunked>
+   T & DoublyLinkedList<T, Chunked>::back() 
    { 
      return *GetDataFromNode(m_pNodes[0].pPrev);
    }
 
-   template<typename T>
-   T & DoublyLinkedList<T>::front() 
+   template<typename T, bool Chunked>
+   T & DoublyLinkedList<T, Chunked>::front() 
    { 
      return *GetDataFromNode(m_pNodes[0].pNext); 
    }
 
-   template<typename T>
-   T const & DoublyLinkedList<T>::back() const 
+   template<typename T, bool Chunked>
+   T const & DoublyLinkedList<T, Chunked>::back() const 
    { 
-     return GetDataFromNode(m_pNodes[0].pPrev);
+     return *GetDataFromNode(m_pNodes[0].pPrev);
    }
 
-   template<typename T>
-   T const & DoublyLinkedList<T>::front() const 
+   template<typename T, bool Chunked>
+   T const & DoublyLinkedList<T, Chunked>::front() const 
    { 
-     return GetDataFromNode(m_pNodes[0].pNext); 
+     return *GetDataFromNode(m_pNodes[0].pNext); 
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::push_back(T const & a_item)
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::push_back(T const & a_item)
    {
      InsertNewAfter(m_pNodes[0].pPrev, a_item);
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::push_front(T const & a_item)
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::push_front(T const & a_item)
    {
      InsertNewAfter(&m_pNodes[0], a_item);
    }
 
-   template<typename T>
-   typename DoublyLinkedList<T>::iterator
-     DoublyLinkedList<T>::insert(iterator const & a_position, T const & a_item)
+   template<typename T, bool Chunked>
+   typename DoublyLinkedList<T, Chunked>::iterator
+     DoublyLinkedList<T, Chunked>::insert(iterator const & a_position, T const & a_item)
    {
      Node * pNode = InsertNewAfter(a_position.m_pNode->pPrev, a_item);
      return iterator(pNode, m_pNodes + 1, m_pData);
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::pop_back()
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::pop_back()
    {
      Remove(m_pNodes[0].pPrev);
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::pop_front()
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::pop_front()
    {
      Remove(m_pNodes[0].pNext);
    }
 
-   template<typename T>
-   typename DoublyLinkedList<T>::iterator
-     DoublyLinkedList<T>::erase(iterator const & a_position)
+   template<typename T, bool Chunked>
+   typename DoublyLinkedList<T, Chunked>::iterator
+     DoublyLinkedList<T, Chunked>::erase(iterator const & a_position)
    {
      Node * pNode = Remove(a_position.m_pNode);
      return iterator(pNode, m_pNodes + 1, m_pData);
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::clear()
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::clear()
    {
      DestructAll();
+     if constexpr (Chunked)
+       m_chunks.Reset();
      m_nItems = 0;
      InitEndNode();
+     MemoryChanged();
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::resize(size_t a_newSize)
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::resize(size_t a_newSize)
    {
      DestructAll();
      Init(a_newSize);
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::Extend()
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::shrink()
+   {
+     if constexpr (Chunked)
+       m_chunks.Shrink();
+     else
+     {
+       size_t oldSize = pool_size();
+       if (pool_size(m_nItems + 1) < oldSize)
+         Reallocate();
+     }
+     MemoryChanged();
+   }
+
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::Extend()
    {
-     Node * pOldNodes(m_pNodes);
      set_next_pool_size();
+     Reallocate();
+   }
+
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::Reallocate()
+   {
+     ReallocTimer timer(*this);
+     Node * pOldNodes(m_pNodes);
 
      m_pNodes = static_cast<Node *>(realloc(m_pNodes, (pool_size()) * sizeof(Node)));
      if (m_pNodes == nullptr)
@@ -702,40 +782,71 @@ namespace Dg
      }
    }
 
-   template<typename T>
-   typename DoublyLinkedList<T>::Node *
-     DoublyLinkedList<T>::InsertNewAfter(Node * a_pNode, T const & a_data)
+   template<typename T, bool Chunked>
+   typename DoublyLinkedList<T, Chunked>::Node *
+     DoublyLinkedList<T, Chunked>::InsertNewAfter(Node * a_pNode, T const & a_data)
    {
-     if (m_nItems == (pool_size() - 1))
+     Node * newNode;
+     if constexpr (Chunked)
      {
-       //Extending might invalidate a_pNode, so we need to record its index in the pool.
-       size_t index(a_pNode - m_pNodes);
-       Extend();
-       a_pNode = &m_pNodes[index]; //Reset the pointer in case we have extended.
+       newNode = m_chunks.Allocate();
+       new (NodePool::Data(newNode)) T(a_data);
      }
+     else
+     {
+       if (m_nItems == (pool_size() - 1))
+       {
+         //Extending might invalidate a_pNode, so we need to record its index in the pool.
+         size_t index(a_pNode - m_pNodes);
+         Extend();
+         a_pNode = &m_pNodes[index]; //Reset the pointer in case we have extended.
+       }
 
-     new (&m_pData[m_nItems]) T(a_data);
+       new (&m_pData[m_nItems]) T(a_data);
+       newNode = &m_pNodes[m_nItems + 1];
+     }
      m_nItems++;
 
-     Node * newNode = &m_pNodes[m_nItems];
      newNode->pPrev = a_pNode;
      newNode->pNext = a_pNode->pNext;
      a_pNode->pNext->pPrev = newNode;
      a_pNode->pNext = newNode;
 
+     MemoryChanged();
      return newNode;
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::DestructAll()
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::DestructAll()
    {
-     for (size_t i = 0; i < m_nItems; i++)
-       m_pData[i].~T();
+     if constexpr (Chunked)
+     {
+       Node * pNode = (m_nItems == 0) ? nullptr : m_pNodes[0].pNext;
+       for (size_t i = 0; i < m_nItems; i++, pNode = pNode->pNext)
+         GetDataFromNode(pNode)->~T();
+     }
+     else
+     {
+       for (size_t i = 0; i < m_nItems; i++)
+         m_pData[i].~T();
+     }
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::InitMemory()
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::InitMemory()
    {
+     if constexpr (Chunked)
+     {
+       //Only the end node lives outside the chunks
+       if (m_pNodes == nullptr)
+       {
+         m_pNodes = static_cast<Node*> (malloc(sizeof(Node)));
+         if (m_pNodes == nullptr)
+           throw std::bad_alloc();
+       }
+       return;
+     }
+
      m_pNodes = static_cast<Node*> (realloc(m_pNodes, pool_size() * sizeof(Node)));
      if (m_pNodes == nullptr)
        throw std::bad_alloc();
@@ -745,9 +856,17 @@ namespace Dg
        throw std::bad_alloc();
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::Init(DoublyLinkedList const & a_other)
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::Init(DoublyLinkedList const & a_other)
    {
+     if constexpr (Chunked)
+     {
+       InitEndNode();
+       for (Node const * pNode = a_other.m_pNodes[0].pNext; pNode != a_other.m_pNodes; pNode = pNode->pNext)
+         InsertNewAfter(m_pNodes[0].pPrev, *a_other.GetDataFromNode(pNode));
+       return;
+     }
+
      m_nItems = a_other.m_nItems;
 
      //We might as well sort the data in list order as we copy.
@@ -770,16 +889,16 @@ namespace Dg
      m_pNodes[m_nItems].pNext = m_pNodes;
    }
 
-   template<typename T>
-   void DoublyLinkedList<T>::InitEndNode()
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::InitEndNode()
    {
      m_pNodes[0].pNext = &m_pNodes[0];
      m_pNodes[0].pPrev = &m_pNodes[0];
    }
 
-   template<typename T>
-   typename DoublyLinkedList<T>::Node *
-     DoublyLinkedList<T>::Remove(Node * a_pNode)
+   template<typename T, bool Chunked>
+   typename DoublyLinkedList<T, Chunked>::Node *
+     DoublyLinkedList<T, Chunked>::Remove(Node * a_pNode)
    {
      Node * pNext(a_pNode->pNext);
 
@@ -790,6 +909,14 @@ namespace Dg
      T * pData = GetDataFromNode(a_pNode);
      pData->~T();
 
+     if constexpr (Chunked)
+     {
+       m_chunks.Release(a_pNode);
+       m_nItems--;
+       MemoryChanged();
+       return pNext;
+     }
+
      if (&m_pNodes[m_nItems] != a_pNode)
      {
        //Move last node to fill gap
@@ -803,19 +930,39 @@ namespace Dg
        pNext = a_pNode;
 
      m_nItems--;
+     MemoryChanged();
      return pNext;
    }
 
-   template<typename T>
-   T * DoublyLinkedList<T>::GetDataFromNode(Node * a_pNode)
+   template<typename T, bool Chunked>
+   T * DoublyLinkedList<T, Chunked>::GetDataFromNode(Node * a_pNode)
    {
+     if constexpr (Chunked)
+       return NodePool::Data(a_pNode);
      return m_pData + (a_pNode - m_pNodes - 1);
    }
 
-   template<typename T>
-   T const * DoublyLinkedList<T>::GetDataFromNode(Node * a_pNode) const
+   template<typename T, bool Chunked>
+   T const * DoublyLinkedList<T, Chunked>::GetDataFromNode(Node const * a_pNode) const
    {
+     if constexpr (Chunked)
+       return NodePool::Data(a_pNode);
      return m_pData + (a_pNode - m_pNodes - 1);
    }
+
+   template<typename T, bool Chunked>
+   void DoublyLinkedList<T, Chunked>::ReportMemory()
+   {
+     if constexpr (Chunked)
+     {
+       TrackMemory(m_chunks.reserved_bytes(), m_nItems * NodePool::slot_bytes(), m_nItems);
+     }
+     else
+     {
+       size_t const nodeBytes = sizeof(Node) + sizeof(T);
+       size_t reserved = (m_pData == nullptr) ? 0 : pool_size() * nodeBytes;
+       TrackMemory(reserved, m_nItems * nodeBytes, m_nItems);
+     }
+   }
 };
 #endif
\ No newline at end of file
@@ -83,6 +83,7 @@ namespace Dg
     //! Exteneds the total size of the array (current + reserve) by a factor of 2
     void extend();
     void init(DynamicArray const &);
+    void ReportMemory() override;
 
   private:
     //Data members
@@ -142,6 +143,7 @@ namespace Dg
       clear();
       ContainerBase::operator=(a_other);
       init(a_other);
+      MemoryChanged();
     }
     return *this;
   }
@@ -154,6 +156,7 @@ namespace Dg
   {
     a_other.m_pData = nullptr;
     a_other.m_nItems = 0;
+    a_other.MemoryChanged();
   }
 
   template<typename T>
@@ -161,6 +164,10 @@ namespace Dg
   {
     if (this != &a_other)
     {
+      for (size_t i = 0; i < m_nItems; i++)
+        m_pData[i].~T();
+      free(m_pData);
+
       //Assign to this
       m_nItems = a_other.m_nItems;
       m_pData = a_other.m_pData;
@@ -169,6 +176,9 @@ namespace Dg
       //Clear other
       a_other.m_pData = nullptr;
       a_other.m_nItems = 0;
+
+      MemoryChanged();
+      a_other.MemoryChanged();
     }
     return *this;
   }
@@ -229,21 +239,24 @@ namespace Dg
 
     new(&m_pData[m_nItems]) T(a_item);
     m_nItems++;
+    MemoryChanged();
   }
 
   template<typename T>
   void DynamicArray<T>::pop_back()
   {
-    m_pData[pool_size() - 1].~T();
+    m_pData[m_nItems - 1].~T();
     --m_nItems;
+    MemoryChanged();
   }
 
   template<typename T>
   void DynamicArray<T>::clear()
   {
-    for (size_t i = 0; i < pool_size(); i++)
+    for (size_t i = 0; i < m_nItems; i++)
       m_pData[i].~T();
     m_nItems = 0;
+    MemoryChanged();
   }
 
   template<typename T>
@@ -258,9 +271,13 @@ namespace Dg
       m_nItems = pool_size();
     }
 
-    m_pData = static_cast<T*>(realloc(m_pData, pool_size() * sizeof(T)));
-    if (m_pData == nullptr)
-      throw std::bad_alloc();
+    {
+      ReallocTimer timer(*this);
+      m_pData = static_cast<T*>(realloc(m_pData, pool_size() * sizeof(T)));
+      if (m_pData == nullptr)
+        throw std::bad_alloc();
+    }
+    MemoryChanged();
   }
 
   template<typename T>
@@ -269,11 +286,13 @@ namespace Dg
     m_pData[a_ind].~T();
     memmove(&m_pData[a_ind], &m_pData[m_nItems - 1], sizeof(T));
     --m_nItems;
+    MemoryChanged();
   }
 
   template<typename T>
   void DynamicArray<T>::extend()
   {
+    ReallocTimer timer(*this);
     set_next_pool_size();
     m_pData = static_cast<T*>(realloc(m_pData, pool_size() * sizeof(T)));
     if (m_pData == nullptr)
@@ -292,6 +311,13 @@ namespace Dg
     for (size_t i = 0; i < m_nItems; i++)
       new (&m_pData[i]) T(a_other.m_pData[i]);
   }
+
+  template<typename T>
+  void DynamicArray<T>::ReportMemory()
+  {
+    size_t reserved = (m_pData == nullptr) ? 0 : pool_size() * sizeof(T);
+    TrackMemory(reserved, m_nItems * sizeof(T), m_nItems);
+  }
   
   //--------------------------------------------------------------------------------
   //		Bool specialization
@@ -0,0 +1,64 @@
+//! @file DgErf.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Array versions of Erf(), Erfc() and InvErf() from DgMath.h.
+
+#ifndef DGERF_H
+#define DGERF_H
+
+#include <stddef.h>
+
+#include "DgMath.h"
+#include "impl/DgErfKernels.h"
+
+namespace Dg
+{
+  //! Computes Erf() of a_count values. a_pOut may equal a_pIn. The work is
+  //! split over a_nThreads threads (0 = one per hardware thread).
+  //!
+  //! float arrays are evaluated four at a time in single precision, with
+  //! relative error below 4.0e-7.
+  template<typename Real>
+  void Erf(Real const * a_pIn, Real * a_pOut, size_t a_count, unsigned a_nThreads = 0)
+  {
+    impl::ParallelFor(a_count, impl::ThreadCount(a_count, a_nThreads),
+      [=](size_t a_begin, size_t a_end, unsigned)
+    {
+      impl::ErfKernel<Real>::Erf(a_pIn + a_begin, a_pOut + a_begin, a_end - a_begin);
+    });
+  }
+
+  //! Computes Erfc() of a_count values. a_pOut may equal a_pIn. The work is
+  //! split over a_nThreads threads (0 = one per hardware thread).
+  //!
+  //! float arrays are evaluated four at a time in single precision, with
+  //! relative error below 4.5e-7, for inputs below 9.
+  template<typename Real>
+  void Erfc(Real const * a_pIn, Real * a_pOut, size_t a_count, unsigned a_nThreads = 0)
+  {
+    impl::ParallelFor(a_count, impl::ThreadCount(a_count, a_nThreads),
+      [=](size_t a_begin, size_t a_end, unsigned)
+    {
+      impl::ErfKernel<Real>::Erfc(a_pIn + a_begin, a_pOut + a_begin, a_end - a_begin);
+    });
+  }
+
+  //! Computes InvErf() of a_count values. a_pOut may equal a_pIn. The work
+  //! is split over a_nThreads threads (0 = one per hardware thread).
+  //!
+  //! float arrays are evaluated four at a time in single precision, with
+  //! relative error below 2.5e-7.
+  template<typename Real>
+  void InvErf(Real const * a_pIn, Real * a_pOut, size_t a_count, unsigned a_nThreads = 0)
+  {
+    impl::ParallelFor(a_count, impl::ThreadCount(a_count, a_nThreads),
+      [=](size_t a_begin, size_t a_end, unsigned)
+    {
+      impl::ErfKernel<Real>::InvErf(a_pIn + a_begin, a_pOut + a_begin, a_end - a_begin);
+    });
+  }
+}
+
+#endif
@@ -44,6 +44,8 @@
 #include <stdint.h>
 #include <limits>
 
+#include "impl/DgFixedPointKernels.h"
+
 namespace Dg
 {
   template<typename I, uint8_t F>
@@ -634,7 +636,7 @@ S & operator >> (S & a_stream, Dg::FixedPoint<I, F> & a_val)
 template<typename S, typename I, uint8_t F>
 S & operator << (S & a_stream, Dg::FixedPoint<I, F> a_val)
 {
-  doubl d = static_cast<double>(a_val);
+  double d = static_cast<double>(a_val);
   a_stream << d;
   return a_stream;
 }
@@ -682,6 +684,166 @@ Dg::FixedPoint<I, F> mod(Dg::FixedPoint<I, F> a_x, Dg::FixedPoint<I, F> a_y)
   return Dg::FixedPoint<I, F>(a_x.m_val % a_y.m_val, true);
 }
 
+//! The exp function computes e to the power of its argument.
+//!
+//! Computed in integer arithmetic only, so the result is the same on all
+//! platforms. Results too large for the type are clamped to its maximum.
+//!
+//! @return e to the power of the argument.
+template<typename I, uint8_t F>
+Dg::FixedPoint<I, F> exp(Dg::FixedPoint<I, F> a_val)
+{
+  int32_t r, y;
+  int k = Dg::impl::FPExpReduce<I, F>(a_val.m_val, r);
+  Dg::impl::FPExpCore(r, y, Dg::impl::FPParams<I, F>::ExpIterations);
+  return Dg::FixedPoint<I, F>(Dg::impl::FPExpFinish<I, F>(y, r, k), true);
+}
+
+//! The log function computes the natural logarithm of its argument.
+//!
+//! Computed in integer arithmetic only, so the result is the same on all
+//! platforms. For arguments that are not positive the lowest value of the
+//! type is returned.
+//!
+//! @return The natural logarithm of the argument.
+template<typename I, uint8_t F>
+Dg::FixedPoint<I, F> log(Dg::FixedPoint<I, F> a_val)
+{
+  int32_t m, acc;
+  int k = Dg::impl::FPLogReduce<I, F>(a_val.m_val, m);
+  Dg::impl::FPLogCore(m, acc, Dg::impl::FPParams<I, F>::LogIterations);
+  return Dg::FixedPoint<I, F>(Dg::impl::FPLogFinish<I, F>(m, acc, k), true);
+}
+
+//! The cos function computes the cosine of its argument, in radians.
+//!
+//! Computed with CORDIC in integer arithmetic only, so the result is the
+//! same on all platforms.
+//!
+//! @return The cosine of the argument.
+template<typename I, uint8_t F>
+Dg::FixedPoint<I, F> cos(Dg::FixedPoint<I, F> a_val)
+{
+  int32_t c, s;
+  Dg::impl::FPCordic(Dg::impl::FPToPhase<I, F>(a_val.m_val), Dg::impl::FPParams<I, F>::TrigIterations, c, s);
+  return Dg::FixedPoint<I, F>(Dg::impl::FPFromQ30<I, F>(c), true);
+}
+
+//! The sin function computes the sine of its argument, in radians.
+//!
+//! Computed with CORDIC in integer arithmetic only, so the result is the
+//! same on all platforms.
+//!
+//! @return The sine of the argument.
+template<typename I, uint8_t F>
+Dg::FixedPoint<I, F> sin(Dg::FixedPoint<I, F> a_val)
+{
+  int32_t c, s;
+  Dg::impl::FPCordic(Dg::impl::FPToPhase<I, F>(a_val.m_val), Dg::impl::FPParams<I, F>::TrigIterations, c, s);
+  return Dg::FixedPoint<I, F>(Dg::impl::FPFromQ30<I, F>(s), true);
+}
+
+//! The tan function computes the tangent of its argument, in radians.
+//!
+//! Computed with CORDIC in integer arithmetic only, so the result is the
+//! same on all platforms. Results too large for the type are clamped.
+//!
+//! @return The tangent of the argument.
+template<typename I, uint8_t F>
+Dg::FixedPoint<I, F> tan(Dg::FixedPoint<I, F> a_val)
+{
+  int32_t c, s;
+  Dg::impl::FPCordic(Dg::impl::FPToPhase<I, F>(a_val.m_val), Dg::impl::FPParams<I, F>::TanIterations, c, s);
+  return Dg::FixedPoint<I, F>(Dg::impl::FPTanFinish<I, F>(c, s), true);
+}
+
+//! The sqrt function computes the square root of its argument, rounded to
+//! the nearest representable value.
+//!
+//! Computed in integer arithmetic only, so the result is the same on all
+//! platforms. For arguments that are not positive 0 is returned.
+//!
+//! @return The square root of the argument.
+template<typename I, uint8_t F>
+Dg::FixedPoint<I, F> sqrt(Dg::FixedPoint<I, F> a_val)
+{
+  return Dg::FixedPoint<I, F>(Dg::impl::FPSqrt<I, F>(a_val.m_val), true);
+}
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Runs one of the FPArrayKernel functions over a_count values, split
+    //! over a_nThreads threads (0 = one per hardware thread).
+    template<typename I, uint8_t F, typename Fn>
+    void FPArrayApply(FixedPoint<I, F> const * a_pIn, FixedPoint<I, F> * a_pOut,
+                      size_t a_count, unsigned a_nThreads, Fn a_fn)
+    {
+      static_assert(sizeof(FixedPoint<I, F>) == sizeof(I), "FixedPoint must be a bare I");
+
+      I const * pIn = reinterpret_cast<I const *>(a_pIn);
+      I * pOut = reinterpret_cast<I *>(a_pOut);
+
+      ParallelFor(a_count, ThreadCount(a_count, a_nThreads),
+        [=](size_t a_begin, size_t a_end, unsigned)
+      {
+        a_fn(pIn + a_begin, pOut + a_begin, a_end - a_begin);
+      });
+    }
+  }
+
+  //! Computes exp() of a_count values. Results are identical to calling
+  //! exp() on each value. a_pOut may equal a_pIn. The work is split over
+  //! a_nThreads threads (0 = one per hardware thread).
+  template<typename I, uint8_t F>
+  void Exp(FixedPoint<I, F> const * a_pIn, FixedPoint<I, F> * a_pOut,
+           size_t a_count, unsigned a_nThreads = 0)
+  {
+    impl::FPArrayApply(a_pIn, a_pOut, a_count, a_nThreads, impl::FPArrayKernel<I, F>::Exp);
+  }
+
+  //! Computes log() of a_count values. Results are identical to calling
+  //! log() on each value. a_pOut may equal a_pIn. The work is split over
+  //! a_nThreads threads (0 = one per hardware thread).
+  template<typename I, uint8_t F>
+  void Log(FixedPoint<I, F> const * a_pIn, FixedPoint<I, F> * a_pOut,
+           size_t a_count, unsigned a_nThreads = 0)
+  {
+    impl::FPArrayApply(a_pIn, a_pOut, a_count, a_nThreads, impl::FPArrayKernel<I, F>::Log);
+  }
+
+  //! Computes cos() of a_count values. Results are identical to calling
+  //! cos() on each value. a_pOut may equal a_pIn. The work is split over
+  //! a_nThreads threads (0 = one per hardware thread).
+  template<typename I, uint8_t F>
+  void Cos(FixedPoint<I, F> const * a_pIn, FixedPoint<I, F> * a_pOut,
+           size_t a_count, unsigned a_nThreads = 0)
+  {
+    impl::FPArrayApply(a_pIn, a_pOut, a_count, a_nThreads, impl::FPArrayKernel<I, F>::Cos);
+  }
+
+  //! Computes sin() of a_count values. Results are identical to calling
+  //! sin() on each value. a_pOut may equal a_pIn. The work is split over
+  //! a_nThreads threads (0 = one per hardware thread).
+  template<typename I, uint8_t F>
+  void Sin(FixedPoint<I, F> const * a_pIn, FixedPoint<I, F> * a_pOut,
+           size_t a_count, unsigned a_nThreads = 0)
+  {
+    impl::FPArrayApply(a_pIn, a_pOut, a_count, a_nThreads, impl::FPArrayKernel<I, F>::Sin);
+  }
+
+  //! Computes tan() of a_count values. Results are identical to calling
+  //! tan() on each value. a_pOut may equal a_pIn. The work is split over
+  //! a_nThreads threads (0 = one per hardware thread).
+  template<typename I, uint8_t F>
+  void Tan(FixedPoint<I, F> const * a_pIn, FixedPoint<I, F> * a_pOut,
+           size_t a_count, unsigned a_nThreads = 0)
+  {
+    impl::FPArrayApply(a_pIn, a_pOut, a_count, a_nThreads, impl::FPArrayKernel<I, F>::Tan);
+  }
+}
+
 /// Numerical limits
 namespace std
 {
@@ -0,0 +1,836 @@
+//! @file DgFlatMap.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: FlatMap
+
+#ifndef DGFLATMAP_H
+#define DGFLATMAP_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DG_FLATMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "DgPair.h"
+#include "impl/DgBitOps.h"
+#include "impl/DgCompare.h"
+#include "impl/DgContainerBase.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Index of the first key not less than a_key. The loop has no
+    //! unpredictable branches; the comparison only picks which half to keep.
+    template<typename K, bool (*Compare)(K const &, K const &)>
+    struct FlatMapSearch
+    {
+      static size_t LowerBound(K const * a_pKeys, size_t a_nKeys, K const & a_key)
+      {
+        if (a_nKeys == 0)
+          return 0;
+
+        K const * pBase = a_pKeys;
+        size_t n = a_nKeys;
+        while (n > 1)
+        {
+          size_t half = n / 2;
+          pBase = Compare(pBase[half], a_key) ? pBase + half : pBase;
+          n -= half;
+        }
+        return static_cast<size_t>(pBase - a_pKeys) + (Compare(*pBase, a_key) ? 1 : 0);
+      }
+    };
+
+#ifdef DG_FLATMAP_SSE2
+    //! Small int maps count the keys less than a_key, 4 at a time. The keys
+    //! are sorted, so the count is the lower bound.
+    template<>
+    struct FlatMapSearch<int, Less<int>>
+    {
+      static size_t const s_linearMax = 64;
+
+      static size_t LowerBound(int const * a_pKeys, size_t a_nKeys, int const & a_key)
+      {
+        //Narrow down with a branchless binary search first
+        size_t offset = 0;
+        size_t n = a_nKeys;
+        while (n > s_linearMax)
+        {
+          size_t half = n / 2;
+          offset = (a_pKeys[offset + half] < a_key) ? offset + half : offset;
+          n -= half;
+        }
+        return offset + LinearCount(a_pKeys + offset, n, a_key);
+      }
+
+    private:
+
+      static size_t LinearCount(int const * a_pKeys, size_t a_nKeys, int a_key)
+      {
+        __m128i key = _mm_set1_epi32(a_key);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 4 <= a_nKeys; i += 4)
+        {
+          __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a_pKeys + i));
+          int less = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block, key)));
+          count += static_cast<size_t>(PopCount(static_cast<uint64_t>(less)));
+          if (less != 0xF)
+            return count;
+        }
+        for (; i < a_nKeys && a_pKeys[i] < a_key; i++)
+          count++;
+        return count;
+      }
+    };
+#endif
+
+    //! Lets iterator::operator->() hand out a pair of references.
+    template<typename Ref>
+    class FlatMapArrow
+    {
+    public:
+      FlatMapArrow(Ref const & a_ref) : m_ref(a_ref) {}
+      Ref * operator->() { return &m_ref; }
+
+    private:
+      Ref m_ref;
+    };
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! @class FlatMap
+  //!
+  //! Map with its keys and values held in two sorted, contiguous arrays.
+  //! Meant for small maps that are read far more often than they change:
+  //! iteration is a straight walk over memory, and lookups touch only the
+  //! key array. Small int maps are searched with SSE2, everything else with
+  //! a branchless binary search. insert and erase shift the elements after
+  //! the insertion point, so they are O(n).
+  //!
+  //! The interface follows AVLTreeMap, so the two can be swapped. Because
+  //! keys and values are stored apart, dereferencing an iterator gives a
+  //! Pair of references rather than a reference to a Pair.
+  //!
+  //! As with the other containers, keys and values are moved around in
+  //! memory with realloc and memmove, so they must be safe to relocate that
+  //! way.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename K, typename V, bool (*Compare)(K const &, K const &) = impl::Less<K>>
+  class FlatMap : public ContainerBase
+  {
+    typedef size_t sizeType;
+    typedef impl::FlatMapSearch<K, Compare> Search;
+
+  public:
+
+    typedef Pair<K const &, V &>        Reference;
+    typedef Pair<K const &, V const &>  ConstReference;
+
+    //! Iterates through the map in key order.
+    class const_iterator
+    {
+      friend class FlatMap;
+    public:
+
+      const_iterator() : m_pKey(nullptr), m_pValue(nullptr) {}
+
+      bool operator==(const_iterator const & a_it) const { return m_pKey == a_it.m_pKey; }
+      bool operator!=(const_iterator const & a_it) const { return m_pKey != a_it.m_pKey; }
+
+      ConstReference operator*() const { return ConstReference{*m_pKey, *m_pValue}; }
+      impl::FlatMapArrow<ConstReference> operator->() const { return impl::FlatMapArrow<ConstReference>(**this); }
+
+      const_iterator & operator++() { ++m_pKey; ++m_pValue; return *this; }
+      const_iterator operator++(int) { const_iterator result(*this); ++(*this); return result; }
+      const_iterator & operator--() { --m_pKey; --m_pValue; return *this; }
+      const_iterator operator--(int) { const_iterator result(*this); --(*this); return result; }
+
+    private:
+      const_iterator(K const * a_pKey, V const * a_pValue) : m_pKey(a_pKey), m_pValue(a_pValue) {}
+
+      K const * m_pKey;
+      V const * m_pValue;
+    };
+
+    //! Iterates through the map in key order.
+    class iterator
+    {
+      friend class FlatMap;
+    public:
+
+      iterator() : m_pKey(nullptr), m_pValue(nullptr) {}
+
+      bool operator==(iterator const & a_it) const { return m_pKey == a_it.m_pKey; }
+      bool operator!=(iterator const & a_it) const { return m_pKey != a_it.m_pKey; }
+
+      Reference operator*() const { return Reference{*m_pKey, *m_pValue}; }
+      impl::FlatMapArrow<Reference> operator->() const { return impl::FlatMapArrow<Reference>(**this); }
+
+      iterator & operator++() { ++m_pKey; ++m_pValue; return *this; }
+      iterator operator++(int) { iterator result(*this); ++(*this); return result; }
+      iterator & operator--() { --m_pKey; --m_pValue; return *this; }
+      iterator operator--(int) { iterator result(*this); --(*this); return result; }
+
+      operator const_iterator() const { return const_iterator(m_pKey, m_pValue); }
+
+    private:
+      iterator(K * a_pKey, V * a_pValue) : m_pKey(a_pKey), m_pValue(a_pValue) {}
+
+      K * m_pKey;
+      V * m_pValue;
+    };
+
+    //! Memory order is key order, so these are the same as the sorted
+    //! iterators. They exist so FlatMap can stand in for AVLTreeMap.
+    typedef iterator        iterator_rand;
+    typedef const_iterator  const_iterator_rand;
+
+  public:
+
+    FlatMap();
+    FlatMap(sizeType requestSize);
+    ~FlatMap();
+
+    FlatMap(FlatMap const &);
+    FlatMap & operator=(FlatMap const & a_other);
+
+    FlatMap(FlatMap && a_other);
+    FlatMap & operator=(FlatMap && a_other);
+
+    sizeType size() const;
+    bool empty() const;
+
+    iterator_rand begin_rand();
+    iterator_rand end_rand();
+    const_iterator_rand cbegin_rand() const;
+    const_iterator_rand cend_rand() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    //! The sorted keys, and the values in the same order.
+    K const * keys() const;
+    V * values();
+    V const * values() const;
+
+    //If the key already exists in the map, the data is
+    //inserted at this key
+    iterator insert(K const & a_key, V const & a_data);
+
+    //! Inserts the key/value pairs in [first, last), which need not be
+    //! sorted. Elements are dereferenced with ->first and ->second. Keys
+    //! already in the map keep their value, and if a key appears more than
+    //! once in the range the first occurrence is kept, as with insert().
+    //! Sorts the new elements and merges them in, in O(m log m + n).
+    template<typename ForwardIt>
+    void InsertRange(ForwardIt first, ForwardIt last);
+
+    void erase(K const &);
+
+    //Returns an iterator to the element that follows the element removed
+    //(or end(), if the last element was removed).
+    iterator erase(iterator);
+
+    //Searches the container for an element with a key equivalent to a_key and returns
+    //a handle to it if found, otherwise it returns an iterator to end().
+    const_iterator find(K const &) const;
+
+    //Searches the container for an element with a key equivalent to a_key and returns
+    //a handle to it if found, otherwise it returns an iterator to end().
+    iterator find(K const &);
+
+    //If k matches the key of an element in the container, the function returns
+    //a reference to its mapped value.
+    //If k does not match the key of any element in the container, the function
+    //inserts a new element with that key and returns a reference to its mapped value.
+    V & operator[](K const &);
+
+    //Returns a reference to the mapped value of the element identified with key k.
+    //If k does not match the key of any element in the container, the function
+    //throws an out_of_range exception.
+    V & at(K const &);
+
+    //Returns a reference to the mapped value of the element identified with key k.
+    //If k does not match the key of any element in the container, the function
+    //throws an out_of_range exception.
+    V const & at(K const &) const;
+
+    void clear();
+
+    //Clears the map and fills it from the range [first, last), which must
+    //be sorted by the criterion. If a key appears more than once, the
+    //first occurrence is kept, as with insert().
+    template<typename ForwardIt>
+    void BuildFromSorted(ForwardIt first, ForwardIt last);
+
+    //Merges a_other into this map in O(n + m). Where a key exists in
+    //both maps, the value in this map is kept, as with insert().
+    void Merge(FlatMap const & a_other);
+
+  protected:
+
+    void ReportMemory() override;
+
+  private:
+
+    void Reserve(sizeType a_nItems);
+    void Release();
+    void Init(FlatMap const &);
+    sizeType LowerBound(K const &) const;
+    bool Found(sizeType a_index, K const & a_key) const;
+
+    //Merges a_n sorted, unique elements into the map, keys already in the
+    //map are skipped. Takes ownership of the elements, unless it throws.
+    void MergeSorted(K * a_pKeys, V * a_pValues, sizeType a_n);
+
+  private:
+
+    K *       m_pKeys;
+    V *       m_pValues;
+    sizeType  m_nItems;
+    sizeType  m_capacity;
+  };
+
+  //--------------------------------------------------------------------------------
+  //		FlatMap
+  //--------------------------------------------------------------------------------
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  FlatMap<K, V, Compare>::FlatMap()
+    : FlatMap(0)
+  {
+
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  FlatMap<K, V, Compare>::FlatMap(sizeType a_requestSize)
+    : ContainerBase(a_requestSize)
+    , m_pKeys(nullptr)
+    , m_pValues(nullptr)
+    , m_nItems(0)
+    , m_capacity(0)
+  {
+
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  FlatMap<K, V, Compare>::~FlatMap()
+  {
+    Release();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  FlatMap<K, V, Compare>::FlatMap(FlatMap const & a_other)
+    : ContainerBase(a_other)
+    , m_pKeys(nullptr)
+    , m_pValues(nullptr)
+    , m_nItems(0)
+    , m_capacity(0)
+  {
+    Init(a_other);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  FlatMap<K, V, Compare> & FlatMap<K, V, Compare>::operator=(FlatMap const & a_other)
+  {
+    if (this != &a_other)
+    {
+      Release();
+      pool_size(a_other.pool_size());
+      Init(a_other);
+    }
+    return *this;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  FlatMap<K, V, Compare>::FlatMap(FlatMap && a_other)
+    : ContainerBase(std::move(a_other))
+    , m_pKeys(a_other.m_pKeys)
+    , m_pValues(a_other.m_pValues)
+    , m_nItems(a_other.m_nItems)
+    , m_capacity(a_other.m_capacity)
+  {
+    a_other.m_pKeys = nullptr;
+    a_other.m_pValues = nullptr;
+    a_other.m_nItems = 0;
+    a_other.m_capacity = 0;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  FlatMap<K, V, Compare> & FlatMap<K, V, Compare>::operator=(FlatMap && a_other)
+  {
+    if (this != &a_other)
+    {
+      Release();
+      ContainerBase::operator=(std::move(a_other));
+
+      m_pKeys = a_other.m_pKeys;
+      m_pValues = a_other.m_pValues;
+      m_nItems = a_other.m_nItems;
+      m_capacity = a_other.m_capacity;
+
+      a_other.m_pKeys = nullptr;
+      a_other.m_pValues = nullptr;
+      a_other.m_nItems = 0;
+      a_other.m_capacity = 0;
+      MemoryChanged();
+    }
+    return *this;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::sizeType FlatMap<K, V, Compare>::size() const
+  {
+    return m_nItems;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  bool FlatMap<K, V, Compare>::empty() const
+  {
+    return m_nItems == 0;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::iterator_rand FlatMap<K, V, Compare>::begin_rand()
+  {
+    return begin();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::iterator_rand FlatMap<K, V, Compare>::end_rand()
+  {
+    return end();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::const_iterator_rand FlatMap<K, V, Compare>::cbegin_rand() const
+  {
+    return cbegin();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::const_iterator_rand FlatMap<K, V, Compare>::cend_rand() const
+  {
+    return cend();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::iterator FlatMap<K, V, Compare>::begin()
+  {
+    return iterator(m_pKeys, m_pValues);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::iterator FlatMap<K, V, Compare>::end()
+  {
+    return iterator(m_pKeys + m_nItems, m_pValues + m_nItems);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::const_iterator FlatMap<K, V, Compare>::cbegin() const
+  {
+    return const_iterator(m_pKeys, m_pValues);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::const_iterator FlatMap<K, V, Compare>::cend() const
+  {
+    return const_iterator(m_pKeys + m_nItems, m_pValues + m_nItems);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  K const * FlatMap<K, V, Compare>::keys() const
+  {
+    return m_pKeys;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  V * FlatMap<K, V, Compare>::values()
+  {
+    return m_pValues;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  V const * FlatMap<K, V, Compare>::values() const
+  {
+    return m_pValues;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::iterator
+    FlatMap<K, V, Compare>::insert(K const & a_key, V const & a_data)
+  {
+    sizeType index = LowerBound(a_key);
+    if (Found(index, a_key))
+      return iterator(m_pKeys + index, m_pValues + index);
+
+    if (m_nItems == m_capacity)
+      Reserve(m_capacity == 0 ? pool_size() : m_capacity + 1);
+
+    //Open a gap, closing it again if a copy throws
+    sizeType nAfter = m_nItems - index;
+    memmove(static_cast<void*>(m_pKeys + index + 1), m_pKeys + index, nAfter * sizeof(K));
+    memmove(static_cast<void*>(m_pValues + index + 1), m_pValues + index, nAfter * sizeof(V));
+    try
+    {
+      new (&m_pKeys[index]) K(a_key);
+      try
+      {
+        new (&m_pValues[index]) V(a_data);
+      }
+      catch (...)
+      {
+        m_pKeys[index].~K();
+        throw;
+      }
+    }
+    catch (...)
+    {
+      memmove(static_cast<void*>(m_pKeys + index), m_pKeys + index + 1, nAfter * sizeof(K));
+      memmove(static_cast<void*>(m_pValues + index), m_pValues + index + 1, nAfter * sizeof(V));
+      throw;
+    }
+
+    m_nItems++;
+    MemoryChanged();
+    return iterator(m_pKeys + index, m_pValues + index);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  template<typename ForwardIt>
+  void FlatMap<K, V, Compare>::InsertRange(ForwardIt a_first, ForwardIt a_last)
+  {
+    sizeType n = static_cast<sizeType>(std::distance(a_first, a_last));
+    if (n == 0)
+      return;
+
+    //Stable sort of the positions keeps the first of any repeated key first
+    std::vector<ForwardIt> sorted;
+    sorted.reserve(n);
+    for (; a_first != a_last; ++a_first)
+      sorted.push_back(a_first);
+    std::stable_sort(sorted.begin(), sorted.end(), [](ForwardIt const & a, ForwardIt const & b)
+    {
+      return Compare(a->first, b->first);
+    });
+
+    K * pKeys = static_cast<K*>(malloc(n * sizeof(K)));
+    V * pValues = static_cast<V*>(malloc(n * sizeof(V)));
+    if (pKeys == nullptr || pValues == nullptr)
+    {
+      free(pKeys);
+      free(pValues);
+      throw std::bad_alloc();
+    }
+
+    sizeType count = 0;
+    try
+    {
+      for (sizeType i = 0; i < n; i++)
+      {
+        if (count > 0 && pKeys[count - 1] == sorted[i]->first)
+          continue;
+        new (&pKeys[count]) K(sorted[i]->first);
+        try
+        {
+          new (&pValues[count]) V(sorted[i]->second);
+        }
+        catch (...)
+        {
+          pKeys[count].~K();
+          throw;
+        }
+        count++;
+      }
+      MergeSorted(pKeys, pValues, count);
+    }
+    catch (...)
+    {
+      for (sizeType i = 0; i < count; i++)
+      {
+        pKeys[i].~K();
+        pValues[i].~V();
+      }
+      free(pKeys);
+      free(pValues);
+      throw;
+    }
+    free(pKeys);
+    free(pValues);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void FlatMap<K, V, Compare>::erase(K const & a_key)
+  {
+    sizeType index = LowerBound(a_key);
+    if (Found(index, a_key))
+      erase(iterator(m_pKeys + index, m_pValues + index));
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::iterator
+    FlatMap<K, V, Compare>::erase(iterator a_it)
+  {
+    sizeType index = static_cast<sizeType>(a_it.m_pKey - m_pKeys);
+    m_pKeys[index].~K();
+    m_pValues[index].~V();
+
+    sizeType nAfter = m_nItems - index - 1;
+    memmove(static_cast<void*>(m_pKeys + index), m_pKeys + index + 1, nAfter * sizeof(K));
+    memmove(static_cast<void*>(m_pValues + index), m_pValues + index + 1, nAfter * sizeof(V));
+    m_nItems--;
+    MemoryChanged();
+    return iterator(m_pKeys + index, m_pValues + index);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::const_iterator
+    FlatMap<K, V, Compare>::find(K const & a_key) const
+  {
+    sizeType index = LowerBound(a_key);
+    if (!Found(index, a_key))
+      return cend();
+    return const_iterator(m_pKeys + index, m_pValues + index);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::iterator
+    FlatMap<K, V, Compare>::find(K const & a_key)
+  {
+    sizeType index = LowerBound(a_key);
+    if (!Found(index, a_key))
+      return end();
+    return iterator(m_pKeys + index, m_pValues + index);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  V & FlatMap<K, V, Compare>::operator[](K const & a_key)
+  {
+    sizeType index = LowerBound(a_key);
+    if (Found(index, a_key))
+      return m_pValues[index];
+    return insert(a_key, V())->second;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  V & FlatMap<K, V, Compare>::at(K const & a_key)
+  {
+    sizeType index = LowerBound(a_key);
+    if (!Found(index, a_key))
+      throw std::out_of_range("Invalid key");
+    return m_pValues[index];
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  V const & FlatMap<K, V, Compare>::at(K const & a_key) const
+  {
+    sizeType index = LowerBound(a_key);
+    if (!Found(index, a_key))
+      throw std::out_of_range("Invalid key");
+    return m_pValues[index];
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void FlatMap<K, V, Compare>::clear()
+  {
+    for (sizeType i = 0; i < m_nItems; i++)
+    {
+      m_pKeys[i].~K();
+      m_pValues[i].~V();
+    }
+    m_nItems = 0;
+    MemoryChanged();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  template<typename ForwardIt>
+  void FlatMap<K, V, Compare>::BuildFromSorted(ForwardIt a_first, ForwardIt a_last)
+  {
+    clear();
+    Reserve(static_cast<sizeType>(std::distance(a_first, a_last)));
+
+    for (; a_first != a_last; ++a_first)
+    {
+      if (m_nItems > 0 && m_pKeys[m_nItems - 1] == a_first->first)
+        continue;
+      new (&m_pKeys[m_nItems]) K(a_first->first);
+      try
+      {
+        new (&m_pValues[m_nItems]) V(a_first->second);
+      }
+      catch (...)
+      {
+        m_pKeys[m_nItems].~K();
+        throw;
+      }
+      m_nItems++;
+    }
+    MemoryChanged();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void FlatMap<K, V, Compare>::Merge(FlatMap const & a_other)
+  {
+    if (a_other.empty())
+      return;
+
+    FlatMap copy(a_other);
+    MergeSorted(copy.m_pKeys, copy.m_pValues, copy.m_nItems);
+
+    //The elements now belong to this map
+    copy.m_nItems = 0;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void FlatMap<K, V, Compare>::MergeSorted(K * a_pKeys, V * a_pValues, sizeType a_n)
+  {
+    Reserve(m_nItems + a_n);
+
+    //Drop the keys already in the map. Walking both sorted arrays is
+    //O(n + m).
+    sizeType nNew = 0;
+    for (sizeType i = 0, j = 0; i < a_n; i++)
+    {
+      while (j < m_nItems && Compare(m_pKeys[j], a_pKeys[i]))
+        j++;
+      if (j < m_nItems && m_pKeys[j] == a_pKeys[i])
+      {
+        a_pKeys[i].~K();
+        a_pValues[i].~V();
+        continue;
+      }
+      if (nNew != i)
+      {
+        memcpy(static_cast<void*>(a_pKeys + nNew), a_pKeys + i, sizeof(K));
+        memcpy(static_cast<void*>(a_pValues + nNew), a_pValues + i, sizeof(V));
+      }
+      nNew++;
+    }
+
+    if (nNew == 0)
+      return;
+
+    //Merge from the back, so nothing is overwritten before it is moved
+    sizeType out = m_nItems + nNew;
+    sizeType i = m_nItems;
+    sizeType j = nNew;
+    while (j > 0)
+    {
+      out--;
+      if (i > 0 && Compare(a_pKeys[j - 1], m_pKeys[i - 1]))
+      {
+        i--;
+        memcpy(static_cast<void*>(m_pKeys + out), m_pKeys + i, sizeof(K));
+        memcpy(static_cast<void*>(m_pValues + out), m_pValues + i, sizeof(V));
+      }
+      else
+      {
+        j--;
+        memcpy(static_cast<void*>(m_pKeys + out), a_pKeys + j, sizeof(K));
+        memcpy(static_cast<void*>(m_pValues + out), a_pValues + j, sizeof(V));
+      }
+    }
+
+    m_nItems += nNew;
+    MemoryChanged();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void FlatMap<K, V, Compare>::Reserve(sizeType a_nItems)
+  {
+    if (a_nItems <= m_capacity)
+      return;
+
+    ReallocTimer timer(*this);
+    pool_size(a_nItems);
+
+    K * pKeys = static_cast<K*>(realloc(m_pKeys, pool_size() * sizeof(K)));
+    if (pKeys == nullptr)
+      throw std::bad_alloc();
+    m_pKeys = pKeys;
+
+    V * pValues = static_cast<V*>(realloc(m_pValues, pool_size() * sizeof(V)));
+    if (pValues == nullptr)
+      throw std::bad_alloc();
+    m_pValues = pValues;
+
+    m_capacity = pool_size();
+    MemoryChanged();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void FlatMap<K, V, Compare>::Release()
+  {
+    for (sizeType i = 0; i < m_nItems; i++)
+    {
+      m_pKeys[i].~K();
+      m_pValues[i].~V();
+    }
+    free(m_pKeys);
+    free(m_pValues);
+
+    m_pKeys = nullptr;
+    m_pValues = nullptr;
+    m_nItems = 0;
+    m_capacity = 0;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void FlatMap<K, V, Compare>::Init(FlatMap const & a_other)
+  {
+    Reserve(a_other.m_nItems);
+    for (; m_nItems < a_other.m_nItems; m_nItems++)
+    {
+      new (&m_pKeys[m_nItems]) K(a_other.m_pKeys[m_nItems]);
+      try
+      {
+        new (&m_pValues[m_nItems]) V(a_other.m_pValues[m_nItems]);
+      }
+      catch (...)
+      {
+        m_pKeys[m_nItems].~K();
+        throw;
+      }
+    }
+    MemoryChanged();
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  typename FlatMap<K, V, Compare>::sizeType FlatMap<K, V, Compare>::LowerBound(K const & a_key) const
+  {
+    return Search::LowerBound(m_pKeys, m_nItems, a_key);
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  bool FlatMap<K, V, Compare>::Found(sizeType a_index, K const & a_key) const
+  {
+    return a_index < m_nItems && m_pKeys[a_index] == a_key;
+  }
+
+  template<typename K, typename V, bool (*Compare)(K const &, K const &)>
+  void FlatMap<K, V, Compare>::ReportMemory()
+  {
+    TrackMemory(m_capacity * (sizeof(K) + sizeof(V)),
+                m_nItems * (sizeof(K) + sizeof(V)),
+                m_nItems);
+  }
+}
+
+#endif
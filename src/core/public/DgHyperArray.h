@@ -1,23 +1,22 @@
 #ifndef DGHYPERARRAY_H
 #define DGHYPERARRAY_H
 
+#include <algorithm>
 #include <array>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "DgHyperArrayLayout.h"
+#include "DgHyperArrayView.h"
+#include "impl/DgParallelFor.h"
 
 //TODO check for nullptr returns in realloc and throw
 namespace Dg
 {
   namespace impl
   {
-    /// Checks that all the template arguments are integral types using `std::is_integral`
-    template <bool... > struct bool_pack { };
-
-    template <bool... b>
-    using all_true = std::is_same<bool_pack<true, b...>, bool_pack<b..., true>>;
-
-    template <typename... T>
-    using are_all_integral = all_true<std::is_integral<T>::value...>;
-
     /// Compile-time sum
     template <typename T>
     constexpr T ct_plus(T const x, T const y)
@@ -89,12 +88,27 @@ namespace Dg
     }
   }
 
-  template<typename T, size_t Dimensions>
+  //! @ingroup DgContainers
+  //!
+  //! @class HyperArray
+  //!
+  //! An array with a fixed number of dimensions, each with a length set at
+  //! run-time. How elements are placed in memory is set by the Layout; see
+  //! DgHyperArrayLayout.h. RowMajorLayout is the plain C layout. TiledLayout
+  //! and MortonLayout keep neighbours along every dimension close in memory,
+  //! which is much kinder to the cache for stencils on large volumes.
+  //!
+  //! Indexing is the same whatever the layout.
+  template<typename T, size_t Dimensions, typename Layout = RowMajorLayout>
   class HyperArray
   {
   public:
     using SizeType  = size_t;  ///< used for measuring sizes and lengths
     using IndexType = size_t;  ///< used for indices
+    using LayoutType = Layout;
+    using ValueType = T;
+
+    static constexpr size_t Rank = Dimensions;
 
     class CompareBase
     {
@@ -112,6 +126,7 @@ namespace Dg
     //Default dimensions lengths are 1.
     HyperArray()
       : m_dataLength(0)
+      , m_storageLength(0)
       , m_pData(nullptr)
     {
       std::array<size_t, Dimensions> dim;
@@ -124,6 +139,7 @@ namespace Dg
 
     HyperArray(std::array<size_t, Dimensions> const & a_dimensions)
       : m_dataLength(0)
+      , m_storageLength(0)
       , m_pData(nullptr)
     {
       Set(a_dimensions);
@@ -132,7 +148,8 @@ namespace Dg
     HyperArray(HyperArray&& a_other)
       : m_dimensionLengths(std::move(a_other.m_dimensionLengths))
       , m_dataLength(a_other.m_dataLength)
-      , m_indexCoeffs(std::move(a_other.m_indexCoeffs))
+      , m_storageLength(a_other.m_storageLength)
+      , m_layout(std::move(a_other.m_layout))
       , m_pData(a_other.m_pData)
     {
       a_other.m_pData = nullptr;
@@ -143,8 +160,9 @@ namespace Dg
       if (this != &a_other)
       {
         m_dimensionLengths = std::move(a_other.m_dimensionLengths);
-        m_indexCoeffs = std::move(a_other.m_indexCoeffs);
+        m_layout = std::move(a_other.m_layout);
         m_dataLength = a_other.m_dataLength;
+        m_storageLength = a_other.m_storageLength;
         
         delete[] m_pData;
         m_pData = a_other.m_pData;
@@ -156,29 +174,25 @@ namespace Dg
     HyperArray(HyperArray const & a_other)
       : m_dimensionLengths(a_other.m_dimensionLengths)
       , m_dataLength(a_other.m_dataLength)
-      , m_indexCoeffs(a_other.m_indexCoeffs)
+      , m_storageLength(a_other.m_storageLength)
+      , m_layout(a_other.m_layout)
     {
-      m_pData = new T[m_dataLength];
-      for (size_t i = 0; i < m_dataLength; i++)
-      {
-        m_pData[i] = a_other.m_pData[i];
-      }
+      m_pData = new T[m_storageLength];
+      std::copy(a_other.m_pData, a_other.m_pData + m_storageLength, m_pData);
     }
     
     HyperArray & operator=(HyperArray const & a_other)
     {
-      if (this == & a_other)
+      if (this != &a_other)
       {
         m_dimensionLengths = a_other.m_dimensionLengths;
         m_dataLength = a_other.m_dataLength;
-        m_indexCoeffs = a_other.m_indexCoeffs;
+        m_storageLength = a_other.m_storageLength;
+        m_layout = a_other.m_layout;
     
         delete[] m_pData;
-        m_pData = new T[m_dataLength];
-        for (size_t i = 0; i < m_dataLength; i++)
-        {
-          m_pData[i] = a_other.m_pData[i];
-        }
+        m_pData = new T[m_storageLength];
+        std::copy(a_other.m_pData, a_other.m_pData + m_storageLength, m_pData);
       }
     
       return *this;
@@ -193,48 +207,48 @@ namespace Dg
                                          static_cast<SizeType>(1),
                                          impl::ct_prod<SizeType>);
 
-      m_indexCoeffs[Dimensions - 1] = 1;
-      for (SizeType i = 0; i < (Dimensions - 1); ++i)
-      {
-        m_indexCoeffs[i] = impl::ct_accumulate(m_dimensionLengths,
-                                               i + 1,
-                                               Dimensions - i - 1,
-                                               static_cast<SizeType>(1),
-                                               impl::ct_prod<SizeType>);
-      }
+      m_layout.Set(m_dimensionLengths);
+      m_storageLength = m_layout.StorageLength();
 
-      m_pData = new T[m_dataLength];
+      delete[] m_pData;
+      m_pData = nullptr;
+      m_pData = new T[m_storageLength];
     }
 
     void fill(T const & a_val)
     {
-      fill<0>(a_val, {});
+      //Padding in tiled layouts is set too, which does no harm
+      for (SizeType i = 0; i < m_storageLength; i++)
+      {
+        m_pData[i] = a_val;
+      }
     }
 
     template <IndexType Depth, typename = std::enable_if_t<Depth <= Dimensions>>
     void fill(T const & a_val, std::array<IndexType, Depth> const & a_index)
     {
-      for (IndexType i = 0; i < m_dimensionLengths[Depth]; i++)
+      if constexpr (Depth == Dimensions)
       {
-        std::array<IndexType, Depth + 1> index;
-
-        for (size_t j = 0; j < Depth; j++)
+        rangeCheck(a_index);
+        IndexType ind = rawIndex_noChecks(a_index);
+        m_pData[ind] = a_val;
+      }
+      else
+      {
+        for (IndexType i = 0; i < m_dimensionLengths[Depth]; i++)
         {
-          index[j] = a_index[j];
-        }
+          std::array<IndexType, Depth + 1> index;
 
-        index[Depth] = i;
+          for (size_t j = 0; j < Depth; j++)
+          {
+            index[j] = a_index[j];
+          }
 
-        fill<Depth + 1>(a_val, index);
-      }
-    }
+          index[Depth] = i;
 
-    template<>
-    void fill<Dimensions>(T const & a_val, std::array<IndexType, Dimensions> const & a_index)
-    {
-      rangeCheck(a_index);
-      IndexType ind = rawIndex_noChecks(a_index);
-      m_pData[ind] = a_val;
+          fill<Depth + 1>(a_val, index);
+        }
+      }
     }
 
     ~HyperArray()
@@ -268,6 +282,24 @@ namespace Dg
       return m_dimensionLengths[DimensionIndex];
     }
 
+    /// Number of elements
+    SizeType size() const
+    {
+      return m_dataLength;
+    }
+
+    /// Number of elements allocated. Larger than size() if the layout pads.
+    SizeType storage_length() const
+    {
+      return m_storageLength;
+    }
+
+    /// The layout mapping in use
+    typename Layout::template Mapping<Dimensions> const & layout() const
+    {
+      return m_layout;
+    }
+
     template <typename... Indices,
               typename = std::enable_if_t<impl::are_all_integral<Indices...>::value && sizeof...(Indices) == Dimensions>
              >
@@ -286,6 +318,16 @@ namespace Dg
       return m_pData[rawIndex_noChecks(a_indices...)];
     }
 
+    T & operator()(std::array<IndexType, Dimensions> const & a_index)
+    {
+      return m_pData[rawIndex_noChecks(a_index)];
+    }
+
+    T const & operator()(std::array<IndexType, Dimensions> const & a_index) const
+    {
+      return m_pData[rawIndex_noChecks(a_index)];
+    }
+
     template <typename... Indices,
               typename = std::enable_if_t<impl::are_all_integral<Indices...>::value && sizeof...(Indices) == Dimensions>
              >
@@ -304,6 +346,20 @@ namespace Dg
       return (*this)(a_indices...);
     }
 
+    /// A view of the whole array, to take sub-views and slices from without
+    /// copying. Only row-major arrays can be viewed.
+    HyperArrayView<T, Dimensions> View()
+    {
+      static_assert(std::is_same<Layout, RowMajorLayout>::value, "Only row-major arrays can be viewed");
+      return HyperArrayView<T, Dimensions>(m_pData, m_dimensionLengths, Strides());
+    }
+
+    HyperArrayView<T const, Dimensions> View() const
+    {
+      static_assert(std::is_same<Layout, RowMajorLayout>::value, "Only row-major arrays can be viewed");
+      return HyperArrayView<T const, Dimensions>(m_pData, m_dimensionLengths, Strides());
+    }
+
     /// Returns the actual index of the element in the [data](@ref data) array
     /// Usage:
     /// @code
@@ -342,30 +398,29 @@ namespace Dg
                  std::array<IndexType, Depth> const & a_index2,
                  CompareBase & a_cmp) const
     {
-      for (IndexType i = 0; i < m_dimensionLengths[Depth]; i++)
+      if constexpr (Depth == Dimensions)
       {
-        std::array<IndexType, Depth + 1> index1, index2;
-
-        for (size_t j = 0; j < Depth; j++)
+        return a_cmp(_at(a_index1), _at(a_index2));
+      }
+      else
+      {
+        for (IndexType i = 0; i < m_dimensionLengths[Depth]; i++)
         {
-          index1[j] = a_index1[j];
-          index2[j] = a_index2[j];
-        }
+          std::array<IndexType, Depth + 1> index1, index2;
 
-        index1[Depth] = i;
-        index2[Depth] = i;
+          for (size_t j = 0; j < Depth; j++)
+          {
+            index1[j] = a_index1[j];
+            index2[j] = a_index2[j];
+          }
 
-        if (!compare<Depth + 1>(index1, index2, a_cmp)) return false;
-      }
-      return true;
-    }
+          index1[Depth] = i;
+          index2[Depth] = i;
 
-    template<>
-    bool compare<Dimensions>(std::array<IndexType, Dimensions> const & a_index1, 
-                             std::array<IndexType, Dimensions> const & a_index2,
-                             CompareBase & a_cmp) const
-    {
-      return a_cmp(_at(a_index1), _at(a_index2));
+          if (!compare<Depth + 1>(index1, index2, a_cmp)) return false;
+        }
+        return true;
+      }
     }
 
   private:
@@ -403,18 +458,15 @@ namespace Dg
 
     IndexType rawIndex_noChecks(std::array<IndexType, Dimensions> const & a_indexArray) const
     {
-      // I_{actual} = \sum_{i=0}^{N-1} {C_i \cdot I_i}
-      //
-      // where I_{actual} : actual index of the data in the data array
-      //       N          : Dimensions
-      //       C_i        : indexCoeffs[i]
-      //       I_i        : indexArray[i]
-      return impl::ct_inner_product(m_indexCoeffs, 0,
-                                    a_indexArray, 0,
-                                    Dimensions,
-                                    static_cast<IndexType>(0),
-                                    impl::ct_plus<IndexType>,
-                                    impl::ct_prod<IndexType>);
+      return m_layout.Index(a_indexArray);
+    }
+
+    std::array<SizeType, Dimensions> Strides() const
+    {
+      std::array<SizeType, Dimensions> strides;
+      for (size_t i = 0; i < Dimensions; i++)
+        strides[i] = m_layout.Stride(i);
+      return strides;
     }
 
     T const & _at(std::array<IndexType, Dimensions> const & a_indexArray) const
@@ -426,11 +478,152 @@ namespace Dg
   private:
     static constexpr SizeType s_dimensions = Dimensions;
 
-    std::array<SizeType, Dimensions> m_dimensionLengths;
-    T *                              m_pData;
-    SizeType                         m_dataLength;
-    std::array<SizeType, Dimensions> m_indexCoeffs; 
+    std::array<SizeType, Dimensions>              m_dimensionLengths;
+    SizeType                                      m_dataLength;
+    SizeType                                      m_storageLength;
+    typename Layout::template Mapping<Dimensions> m_layout;
+    T *                                           m_pData;
   };
+
+  namespace impl
+  {
+    //Calls a_fn(index, element) for every element whose first index is in
+    //[a_begin, a_end), in row-major order.
+    template<typename Array, typename Fn>
+    void ForEachInSlabs(Array & a_array, size_t a_begin, size_t a_end, Fn & a_fn)
+    {
+      size_t const D = Array::Rank;
+      for (size_t d = 1; d < D; d++)
+      {
+        if (a_array.length_noChecks(d) == 0)
+          return;
+      }
+
+      std::array<size_t, D> index;
+      for (size_t i = a_begin; i < a_end; i++)
+      {
+        index.fill(0);
+        index[0] = i;
+        while (true)
+        {
+          a_fn(static_cast<std::array<size_t, D> const &>(index), a_array(index));
+
+          size_t d = D - 1;
+          for (; d > 0; d--)
+          {
+            if (++index[d] < a_array.length_noChecks(d))
+              break;
+            index[d] = 0;
+          }
+          if (d == 0)
+            break;
+        }
+      }
+    }
+
+    template<typename Array>
+    unsigned HyperArrayThreads(Array const & a_array, unsigned a_nThreads)
+    {
+      return ThreadCount(a_array.size(), a_nThreads);
+    }
+  }
+
+  //--------------------------------------------------------------------------------
+  //		Algorithms
+  //
+  //  These work on a HyperArray or HyperArrayView. Work is split into slabs
+  //  along the first dimension, one range of slabs per thread. a_nThreads of 0
+  //  means one per hardware thread; small arrays are done on the calling
+  //  thread. Functors are called from several threads at once.
+  //--------------------------------------------------------------------------------
+
+  //! @ingroup DgContainers_functions
+  //!
+  //! Calls a_fn(index, element) for every element, where index is a
+  //! std::array<size_t, Rank> const &.
+  template<typename Array, typename Fn>
+  void ForEachIndex(Array & a_array, Fn a_fn, unsigned a_nThreads = 0)
+  {
+    impl::ParallelFor(a_array.length_noChecks(0), impl::HyperArrayThreads(a_array, a_nThreads),
+      [&a_array, &a_fn](size_t a_begin, size_t a_end, unsigned)
+      {
+        impl::ForEachInSlabs(a_array, a_begin, a_end, a_fn);
+      });
+  }
+
+  //! @ingroup DgContainers_functions
+  //!
+  //! Sets every element to a_val.
+  template<typename Array>
+  void Fill(Array & a_array, typename Array::ValueType const & a_val, unsigned a_nThreads = 0)
+  {
+    ForEachIndex(a_array, [&a_val](std::array<size_t, Array::Rank> const &, typename Array::ValueType & a_elem)
+    {
+      a_elem = a_val;
+    }, a_nThreads);
+  }
+
+  //! @ingroup DgContainers_functions
+  //!
+  //! Replaces every element with a_fn(element).
+  template<typename Array, typename Fn>
+  void Transform(Array & a_array, Fn a_fn, unsigned a_nThreads = 0)
+  {
+    ForEachIndex(a_array, [&a_fn](std::array<size_t, Array::Rank> const &, typename Array::ValueType & a_elem)
+    {
+      a_elem = a_fn(a_elem);
+    }, a_nThreads);
+  }
+
+  //! @ingroup DgContainers_functions
+  //!
+  //! Sets each element of a_dest to a_fn of the element at the same index in
+  //! a_source. Throws std::out_of_range if the lengths differ.
+  template<typename SourceArray, typename DestArray, typename Fn, typename = decltype(DestArray::Rank)>
+  void Transform(SourceArray const & a_source, DestArray & a_dest, Fn a_fn, unsigned a_nThreads = 0)
+  {
+    static_assert(SourceArray::Rank == DestArray::Rank, "Source and destination must have the same number of dimensions");
+    for (size_t i = 0; i < DestArray::Rank; i++)
+    {
+      if (a_source.length_noChecks(i) != a_dest.length_noChecks(i))
+        throw std::out_of_range("Transform: source and destination lengths differ");
+    }
+
+    ForEachIndex(a_dest, [&a_source, &a_fn](std::array<size_t, DestArray::Rank> const & a_index, typename DestArray::ValueType & a_elem)
+    {
+      a_elem = a_fn(a_source(a_index));
+    }, a_nThreads);
+  }
+
+  //! @ingroup DgContainers_functions
+  //!
+  //! Combines all elements with a_op. Each thread reduces its own slabs
+  //! starting from a_identity, then the partial results are combined in
+  //! order. So a_identity must be an identity of a_op (0 for +, 1 for *), and
+  //! a_op must be associative, but need not be commutative.
+  template<typename Array, typename R, typename Op>
+  R Reduce(Array const & a_array, R a_identity, Op a_op, unsigned a_nThreads = 0)
+  {
+    unsigned nThreads = impl::HyperArrayThreads(a_array, a_nThreads);
+    std::vector<R> partials(nThreads, a_identity);
+
+    impl::ParallelFor(a_array.length_noChecks(0), nThreads,
+      [&](size_t a_begin, size_t a_end, unsigned a_t)
+      {
+        R result(a_identity);
+        auto fn = [&result, &a_op](std::array<size_t, Array::Rank> const &, typename Array::ValueType const & a_elem)
+        {
+          result = a_op(result, a_elem);
+        };
+        impl::ForEachInSlabs(a_array, a_begin, a_end, fn);
+        partials[a_t] = result;
+      });
+
+    R result(a_identity);
+    for (unsigned t = 0; t < nThreads; t++)
+      result = a_op(result, partials[t]);
+    return result;
+  }
 }
 
-#endif
\ No newline at end of file
+#endif
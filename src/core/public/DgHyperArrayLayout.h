@@ -0,0 +1,245 @@
+//! @file DgHyperArrayLayout.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Storage layouts for HyperArray
+
+#ifndef DGHYPERARRAYLAYOUT_H
+#define DGHYPERARRAYLAYOUT_H
+
+#include <array>
+#include <vector>
+#include <stddef.h>
+
+namespace Dg
+{
+  namespace impl
+  {
+    constexpr bool IsPowerOf2(size_t a_val)
+    {
+      return a_val != 0 && (a_val & (a_val - 1)) == 0;
+    }
+
+    constexpr size_t Log2(size_t a_val)
+    {
+      return (a_val <= 1) ? 0 : 1 + Log2(a_val >> 1);
+    }
+
+    //Number of bits needed to hold a_val - 1
+    inline size_t BitsToHold(size_t a_val)
+    {
+      size_t bits = 0;
+      while (bits < sizeof(size_t) * 8 && (size_t(1) << bits) < a_val)
+        bits++;
+      return bits;
+    }
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! A layout decides where an element of a HyperArray lives in memory. Each
+  //! layout provides a Mapping<Dimensions> with:
+  //!
+  //!   void Set(std::array<size_t, Dimensions> const & lengths);
+  //!   size_t StorageLength() const;  //Elements to allocate, including padding
+  //!   size_t Index(std::array<size_t, Dimensions> const & index) const;
+  //!
+  //! The layouts differ in the distance between neighbours. Only in
+  //! RowMajorLayout is that distance fixed for each dimension.
+  //!
+  //! RowMajorLayout is the plain C layout. Elements along the last dimension
+  //! are contiguous; stepping along the first dimension jumps over the whole
+  //! of the remaining dimensions.
+  struct RowMajorLayout
+  {
+    template<size_t Dimensions>
+    class Mapping
+    {
+    public:
+
+      void Set(std::array<size_t, Dimensions> const & a_lengths)
+      {
+        size_t coeff = 1;
+        for (size_t i = Dimensions; i > 0; i--)
+        {
+          m_indexCoeffs[i - 1] = coeff;
+          coeff *= a_lengths[i - 1];
+        }
+        m_storageLength = coeff;
+      }
+
+      size_t StorageLength() const
+      {
+        return m_storageLength;
+      }
+
+      size_t Index(std::array<size_t, Dimensions> const & a_index) const
+      {
+        // I_{actual} = \sum_{i=0}^{N-1} {C_i \cdot I_i}
+        size_t result = 0;
+        for (size_t i = 0; i < Dimensions; i++)
+          result += m_indexCoeffs[i] * a_index[i];
+        return result;
+      }
+
+      //! Distance in memory between neighbours along a dimension.
+      size_t Stride(size_t a_dimension) const
+      {
+        return m_indexCoeffs[a_dimension];
+      }
+
+    private:
+
+      std::array<size_t, Dimensions>  m_indexCoeffs;
+      size_t                          m_storageLength;
+    };
+  };
+
+  //! @ingroup DgContainers
+  //!
+  //! The array is cut into hypercubes with TileEdge elements a side. Each
+  //! tile is stored contiguously in row-major order, and the tiles
+  //! themselves are laid out row-major. Neighbours along any dimension are
+  //! usually in the same tile, so stencils touch a handful of cache lines
+  //! rather than one per plane. For 3D float volumes, 8 gives 2KB tiles.
+  //!
+  //! Along the last dimension, runs of TileEdge elements are contiguous,
+  //! then the next run starts in the next tile, a whole tile volume on.
+  //! Within a tile, a step along dimension d moves TileEdge to the power of
+  //! (Dimensions - 1 - d) elements. No dimension has a fixed stride.
+  //!
+  //! Lengths are padded up to a multiple of TileEdge, so storage can exceed
+  //! the number of elements.
+  template<size_t TileEdge = 8>
+  struct TiledLayout
+  {
+    static_assert(impl::IsPowerOf2(TileEdge), "TileEdge must be a power of 2");
+
+    template<size_t Dimensions>
+    class Mapping
+    {
+      static size_t const s_shift = impl::Log2(TileEdge);
+      static size_t const s_mask = TileEdge - 1;
+
+    public:
+
+      void Set(std::array<size_t, Dimensions> const & a_lengths)
+      {
+        size_t tileVolume = 1;
+        for (size_t i = 0; i < Dimensions; i++)
+          tileVolume *= TileEdge;
+
+        size_t tileCoeff = tileVolume;
+        size_t innerCoeff = 1;
+        for (size_t i = Dimensions; i > 0; i--)
+        {
+          m_tileCoeffs[i - 1] = tileCoeff;
+          m_innerCoeffs[i - 1] = innerCoeff;
+          tileCoeff *= (a_lengths[i - 1] + s_mask) >> s_shift;
+          innerCoeff *= TileEdge;
+        }
+        m_storageLength = tileCoeff;
+      }
+
+      size_t StorageLength() const
+      {
+        return m_storageLength;
+      }
+
+      size_t Index(std::array<size_t, Dimensions> const & a_index) const
+      {
+        size_t result = 0;
+        for (size_t i = 0; i < Dimensions; i++)
+        {
+          result += m_tileCoeffs[i] * (a_index[i] >> s_shift);
+          result += m_innerCoeffs[i] * (a_index[i] & s_mask);
+        }
+        return result;
+      }
+
+    private:
+
+      std::array<size_t, Dimensions>  m_tileCoeffs;   //Includes the tile volume
+      std::array<size_t, Dimensions>  m_innerCoeffs;
+      size_t                          m_storageLength;
+    };
+  };
+
+  //! @ingroup DgContainers
+  //!
+  //! Z-order (Morton) layout. The bits of the indices are interleaved, so
+  //! elements that are close in space are close in memory at every scale.
+  //! When lengths differ, the longer dimensions take the extra high bits
+  //! once the shorter ones run out.
+  //!
+  //! No dimension is contiguous and none has a fixed stride. Along the
+  //! last dimension only pairs of elements, 2k and 2k + 1, are adjacent.
+  //! Stepping from 2k + 1 to 2k + 2 jumps by an amount that grows with the
+  //! number of low bits the step carries through.
+  //!
+  //! Each dimension keeps a table of the bits it contributes for every
+  //! index along it, so an element is found with one lookup and add per
+  //! dimension. Lengths are padded up to a power of 2.
+  struct MortonLayout
+  {
+    template<size_t Dimensions>
+    class Mapping
+    {
+    public:
+
+      void Set(std::array<size_t, Dimensions> const & a_lengths)
+      {
+        std::array<size_t, Dimensions> bits;
+        size_t maxBits = 0;
+        for (size_t i = 0; i < Dimensions; i++)
+        {
+          bits[i] = impl::BitsToHold(a_lengths[i]);
+          if (bits[i] > maxBits)
+            maxBits = bits[i];
+          m_offsets[i].assign(a_lengths[i], 0);
+        }
+
+        //Hand out output bits round robin, last dimension lowest.
+        size_t outBit = 0;
+        for (size_t b = 0; b < maxBits; b++)
+        {
+          for (size_t i = Dimensions; i > 0; i--)
+          {
+            if (b >= bits[i - 1])
+              continue;
+
+            std::vector<size_t> & offsets = m_offsets[i - 1];
+            for (size_t c = 0; c < offsets.size(); c++)
+            {
+              if (((c >> b) & 1) != 0)
+                offsets[c] |= size_t(1) << outBit;
+            }
+            outBit++;
+          }
+        }
+        m_storageLength = size_t(1) << outBit;
+      }
+
+      size_t StorageLength() const
+      {
+        return m_storageLength;
+      }
+
+      size_t Index(std::array<size_t, Dimensions> const & a_index) const
+      {
+        size_t result = 0;
+        for (size_t i = 0; i < Dimensions; i++)
+          result += m_offsets[i][a_index[i]];
+        return result;
+      }
+
+    private:
+
+      std::array<std::vector<size_t>, Dimensions> m_offsets;
+      size_t                                      m_storageLength;
+    };
+  };
+}
+
+#endif
@@ -0,0 +1,261 @@
+//! @file DgHyperArrayView.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: HyperArrayView
+
+#ifndef DGHYPERARRAYVIEW_H
+#define DGHYPERARRAYVIEW_H
+
+#include <array>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Dg
+{
+  namespace impl
+  {
+    /// Checks that all the template arguments are integral types using `std::is_integral`
+    template <bool... > struct bool_pack { };
+
+    template <bool... b>
+    using all_true = std::is_same<bool_pack<true, b...>, bool_pack<b..., true>>;
+
+    template <typename... T>
+    using are_all_integral = all_true<std::is_integral<T>::value...>;
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! @class HyperArrayView
+  //!
+  //! A non-owning window onto strided data, such as a block or slice of a
+  //! row-major HyperArray. Making a view, a sub-view or a slice never copies
+  //! elements. The view must not outlive the data it refers to.
+  //!
+  //! Like a pointer, a const view still gives write access to the elements.
+  //! Use HyperArrayView<T const, Dimensions> for read-only access.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename T, size_t Dimensions>
+  class HyperArrayView
+  {
+    static_assert(Dimensions > 0, "A view needs at least one dimension");
+
+  public:
+    using SizeType  = size_t;
+    using IndexType = size_t;
+    using ValueType = T;
+
+    static constexpr size_t Rank = Dimensions;
+
+  public:
+
+    //! An empty view
+    HyperArrayView()
+      : m_pData(nullptr)
+    {
+      m_lengths.fill(0);
+      m_strides.fill(0);
+    }
+
+    //! Strides are in elements.
+    HyperArrayView(T * a_pData,
+                   std::array<SizeType, Dimensions> const & a_lengths,
+                   std::array<SizeType, Dimensions> const & a_strides)
+      : m_pData(a_pData)
+      , m_lengths(a_lengths)
+      , m_strides(a_strides)
+    {
+
+    }
+
+    //! Views onto mutable data convert to read-only views.
+    operator HyperArrayView<T const, Dimensions>() const
+    {
+      return HyperArrayView<T const, Dimensions>(m_pData, m_lengths, m_strides);
+    }
+
+    SizeType length(size_t a_dimensionIndex) const
+    {
+      if (a_dimensionIndex >= Dimensions)
+      {
+        throw std::out_of_range("The dimension index must be within [0, Dimensions-1]");
+      }
+      return m_lengths[a_dimensionIndex];
+    }
+
+    SizeType length_noChecks(size_t a_dimensionIndex) const
+    {
+      return m_lengths[a_dimensionIndex];
+    }
+
+    template <size_t DimensionIndex>
+    SizeType length() const
+    {
+      static_assert(DimensionIndex < Dimensions,
+        "The dimension index must be within [0, Dimensions-1]");
+
+      return m_lengths[DimensionIndex];
+    }
+
+    //! Distance in elements between neighbours along a dimension.
+    SizeType stride(size_t a_dimensionIndex) const
+    {
+      return m_strides[a_dimensionIndex];
+    }
+
+    //! Number of elements in the view
+    SizeType size() const
+    {
+      SizeType result = 1;
+      for (size_t i = 0; i < Dimensions; i++)
+        result *= m_lengths[i];
+      return result;
+    }
+
+    //! The element at index 0
+    T * data() const
+    {
+      return m_pData;
+    }
+
+    //! True if the elements are packed row-major with no gaps.
+    bool IsContiguous() const
+    {
+      SizeType expected = 1;
+      for (size_t i = Dimensions; i > 0; i--)
+      {
+        if (m_lengths[i - 1] > 1 && m_strides[i - 1] != expected)
+          return false;
+        expected *= m_lengths[i - 1];
+      }
+      return true;
+    }
+
+    template <typename... Indices,
+              typename = std::enable_if_t<impl::are_all_integral<Indices...>::value && sizeof...(Indices) == Dimensions>
+             >
+    T & operator()(Indices... a_indices) const
+    {
+      std::array<IndexType, Dimensions> indexArray = {{static_cast<IndexType>(a_indices)...}};
+      return (*this)(indexArray);
+    }
+
+    T & operator()(std::array<IndexType, Dimensions> const & a_index) const
+    {
+      SizeType offset = 0;
+      for (size_t i = 0; i < Dimensions; i++)
+        offset += m_strides[i] * a_index[i];
+      return m_pData[offset];
+    }
+
+    template <typename... Indices,
+              typename = std::enable_if_t<impl::are_all_integral<Indices...>::value && sizeof...(Indices) == Dimensions>
+             >
+    T & at(Indices... a_indices) const
+    {
+      std::array<IndexType, Dimensions> indexArray = {{static_cast<IndexType>(a_indices)...}};
+      rangeCheck(indexArray);
+      return (*this)(indexArray);
+    }
+
+    //! The block starting at a_origin with a_lengths elements along each
+    //! dimension. Throws std::out_of_range if the block does not fit.
+    HyperArrayView SubView(std::array<IndexType, Dimensions> const & a_origin,
+                           std::array<SizeType, Dimensions> const & a_lengths) const
+    {
+      std::array<SizeType, Dimensions> steps;
+      steps.fill(1);
+      return SubView(a_origin, a_lengths, steps);
+    }
+
+    //! As SubView(), taking every a_steps[i]th element along dimension i.
+    //! a_lengths counts the elements taken, not the span covered.
+    HyperArrayView SubView(std::array<IndexType, Dimensions> const & a_origin,
+                           std::array<SizeType, Dimensions> const & a_lengths,
+                           std::array<SizeType, Dimensions> const & a_steps) const
+    {
+      std::ostringstream oss;
+      for (size_t i = 0; i < Dimensions; i++)
+      {
+        if (a_steps[i] == 0)
+          oss << "Step #" << i << " is 0. ";
+        else if (a_lengths[i] != 0 && (a_origin[i] >= m_lengths[i]
+              || (a_lengths[i] - 1) > (m_lengths[i] - 1 - a_origin[i]) / a_steps[i]))
+          oss << "Dimension #" << i << " of the sub-view does not fit in [0, " << m_lengths[i] << "). ";
+      }
+
+      if (!oss.str().empty())
+      {
+        throw std::out_of_range(oss.str());
+      }
+
+      std::array<SizeType, Dimensions> strides;
+      T * pData = m_pData;
+      for (size_t i = 0; i < Dimensions; i++)
+      {
+        if (a_lengths[i] != 0)
+          pData += a_origin[i] * m_strides[i];
+        strides[i] = m_strides[i] * a_steps[i];
+      }
+      return HyperArrayView(pData, a_lengths, strides);
+    }
+
+    //! Fixes dimension Dim at a_index, giving a view with one less dimension.
+    template <size_t Dim>
+    HyperArrayView<T, Dimensions - 1> Slice(IndexType a_index) const
+    {
+      static_assert(Dimensions > 1, "Cannot slice a 1D view");
+      static_assert(Dim < Dimensions, "The dimension index must be within [0, Dimensions-1]");
+
+      if (a_index >= m_lengths[Dim])
+      {
+        throw std::out_of_range("Slice index out of range");
+      }
+
+      std::array<SizeType, Dimensions - 1> lengths;
+      std::array<SizeType, Dimensions - 1> strides;
+      for (size_t i = 0, j = 0; i < Dimensions; i++)
+      {
+        if (i == Dim)
+          continue;
+        lengths[j] = m_lengths[i];
+        strides[j] = m_strides[i];
+        j++;
+      }
+      return HyperArrayView<T, Dimensions - 1>(m_pData + a_index * m_strides[Dim], lengths, strides);
+    }
+
+  private:
+
+    void rangeCheck(std::array<IndexType, Dimensions> const & a_indexArray) const
+    {
+      std::ostringstream oss;
+      for (size_t i = 0; i < Dimensions; ++i)
+      {
+        if (a_indexArray[i] >= m_lengths[i])
+        {
+          oss << "Index #" << i << " [== " << a_indexArray[i] << "]"
+            << " is out of the [0, " << m_lengths[i] << ") range. ";
+        }
+      }
+
+      if (!oss.str().empty())
+      {
+        throw std::out_of_range(oss.str());
+      }
+    }
+
+  private:
+
+    T *                               m_pData;
+    std::array<SizeType, Dimensions>  m_lengths;
+    std::array<SizeType, Dimensions>  m_strides;
+  };
+}
+
+#endif
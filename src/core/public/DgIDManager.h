@@ -20,6 +20,10 @@ namespace Dg
   //! of available IDs. If an ID is taken from the a set, the set bounds may be incremented or decremented,
   //! or borken, creating a new set.
   //!
+  //! Operations walk the list of sets, so they slow down as the free IDs fragment.
+  //! BitmapIDManager and ConcurrentIDManager (DgBitmapIDManager.h) have the same
+  //! interface with constant time operations over a bounded range.
+  //!
   //! @author Frank Hart
   //! @date 23/07/2016
   template<typename T>
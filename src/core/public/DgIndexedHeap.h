@@ -0,0 +1,711 @@
+//! @file DgIndexedHeap.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: IndexedHeap
+
+#ifndef DGINDEXEDHEAP_H
+#define DGINDEXEDHEAP_H
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <stdint.h>
+
+#include "impl/DgCompare.h"
+#include "impl/DgContainerBase.h"
+
+namespace Dg
+{
+  //! @ingroup DgContainers
+  //!
+  //! @class IndexedHeap
+  //!
+  //! Priority queue of values, each with a priority and a handle. The handle
+  //! stays valid while the value is in the queue, so the value's priority can
+  //! be changed, or the value removed, in O(log n). The top of the queue is
+  //! the value whose priority comes first by Compare; with the default, the
+  //! smallest.
+  //!
+  //! The heap is 4-ary: a node's children sit side by side and the tree is
+  //! half the height of a binary heap. Heap entries hold the priority and a
+  //! slot index only; values stay put in a slot array and never move while
+  //! in the queue.
+  //!
+  //! As with SlotMap, a handle holds a slot index in its low 32 bits and the
+  //! slot's generation in the high 32 bits. The generation changes every
+  //! time the slot is filled or emptied, so once a value leaves the queue its
+  //! handle is stale: contains() returns false for it, and update() and
+  //! erase() ignore it, even after the slot is reused. A handle of 0 is
+  //! never valid.
+  //!
+  //! Priorities must be trivially copyable. As with DynamicArray, values are
+  //! moved around in memory with realloc, so T must be safe to relocate that
+  //! way.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename T,
+           typename Priority,
+           bool (*Compare)(Priority const &, Priority const &) = impl::Less<Priority>>
+  class IndexedHeap : public ContainerBase
+  {
+    static_assert(std::is_trivially_copyable<Priority>::value, "Priorities must be trivially copyable");
+
+  public:
+
+    typedef uint64_t Handle;
+    static Handle const InvalidHandle = 0;
+
+  private:
+
+    static size_t const s_arity = 4;
+    static uint32_t const s_noSlot = 0xFFFFFFFF;  //Also caps the number of slots
+    static uint32_t const s_maxGeneration = 0xFFFFFFFF;
+
+    struct Entry
+    {
+      Priority  priority;
+      uint32_t  slot;
+    };
+
+    struct Slot
+    {
+      uint32_t  generation;  //Odd while the slot holds a value
+      uint32_t  index;       //Position in the heap, or the next free slot
+    };
+
+  public:
+
+    IndexedHeap();
+    IndexedHeap(size_t a_nItems);
+    ~IndexedHeap();
+
+    IndexedHeap(IndexedHeap const &);
+    IndexedHeap & operator=(IndexedHeap const &);
+
+    IndexedHeap(IndexedHeap &&);
+    IndexedHeap & operator=(IndexedHeap &&);
+
+    size_t size() const;
+    bool empty() const;
+
+    //! Adds a value, returning its handle.
+    Handle push(Priority const &, T const &);
+
+    //! Adds a_count values. If this is a large fraction of the queue, the
+    //! heap is rebuilt in O(n) rather than sifting each value in. The
+    //! handles are written to a_pHandlesOut, if not null.
+    void PushN(Priority const * a_pPriorities, T const * a_pValues, size_t a_count,
+               Handle * a_pHandlesOut = nullptr);
+
+    //! The value at the top. The queue must not be empty.
+    T & top();
+    T const & top() const;
+    Priority const & top_priority() const;
+    Handle top_handle() const;
+
+    //! Removes the value at the top. The queue must not be empty.
+    void pop();
+
+    //! True if a_handle refers to a value in the queue.
+    bool contains(Handle) const;
+
+    //! Changes the priority of a value, moving it up or down the queue.
+    //! Returns false, doing nothing, if the handle is stale.
+    bool update(Handle, Priority const &);
+
+    //! Removes a value from anywhere in the queue. Returns false, doing
+    //! nothing, if the handle is stale.
+    bool erase(Handle);
+
+    //! The value and priority behind a handle. The handle must be valid.
+    T & operator[](Handle);
+    T const & operator[](Handle) const;
+    Priority const & priority(Handle) const;
+
+    //! As operator[], throwing std::out_of_range if the handle is not in
+    //! the queue.
+    T & at(Handle);
+    T const & at(Handle) const;
+
+    void reserve(size_t a_nItems);
+    void clear();
+
+  protected:
+
+    void ReportMemory() override;
+
+  private:
+
+    static Handle MakeHandle(uint32_t a_slot, uint32_t a_generation);
+    static uint32_t Index(Handle);
+    static uint32_t Generation(Handle);
+
+    Slot const * GetSlot(Handle) const;
+    void Place(size_t a_index, Entry const &);
+    void SiftUp(size_t a_index);
+    void SiftDown(size_t a_index);
+    void Heapify();
+    void Remove(size_t a_index);
+    uint32_t NewSlot();
+    void FreeSlot(uint32_t);
+    void Grow();
+    void Init(IndexedHeap const &);
+    void Release();
+
+  private:
+
+    Entry * m_pHeap;
+    Slot *  m_pSlots;
+    T *     m_pValues;
+    size_t  m_nItems;
+    size_t  m_nSlots;
+    size_t    m_capacity;
+    uint32_t  m_freeHead;
+  };
+
+  //--------------------------------------------------------------------------------
+  //		IndexedHeap
+  //--------------------------------------------------------------------------------
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  IndexedHeap<T, Priority, Compare>::IndexedHeap()
+    : IndexedHeap(0)
+  {
+
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  IndexedHeap<T, Priority, Compare>::IndexedHeap(size_t a_nItems)
+    : ContainerBase(a_nItems)
+    , m_pHeap(nullptr)
+    , m_pSlots(nullptr)
+    , m_pValues(nullptr)
+    , m_nItems(0)
+    , m_nSlots(0)
+    , m_capacity(0)
+    , m_freeHead(s_noSlot)
+  {
+
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  IndexedHeap<T, Priority, Compare>::~IndexedHeap()
+  {
+    Release();
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  IndexedHeap<T, Priority, Compare>::IndexedHeap(IndexedHeap const & a_other)
+    : ContainerBase(a_other)
+    , m_pHeap(nullptr)
+    , m_pSlots(nullptr)
+    , m_pValues(nullptr)
+    , m_nItems(0)
+    , m_nSlots(0)
+    , m_capacity(0)
+    , m_freeHead(s_noSlot)
+  {
+    Init(a_other);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  IndexedHeap<T, Priority, Compare> &
+    IndexedHeap<T, Priority, Compare>::operator=(IndexedHeap const & a_other)
+  {
+    if (this != &a_other)
+    {
+      Release();
+      pool_size(a_other.pool_size());
+      Init(a_other);
+    }
+    return *this;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  IndexedHeap<T, Priority, Compare>::IndexedHeap(IndexedHeap && a_other)
+    : ContainerBase(std::move(a_other))
+    , m_pHeap(a_other.m_pHeap)
+    , m_pSlots(a_other.m_pSlots)
+    , m_pValues(a_other.m_pValues)
+    , m_nItems(a_other.m_nItems)
+    , m_nSlots(a_other.m_nSlots)
+    , m_capacity(a_other.m_capacity)
+    , m_freeHead(a_other.m_freeHead)
+  {
+    a_other.m_pHeap = nullptr;
+    a_other.m_pSlots = nullptr;
+    a_other.m_pValues = nullptr;
+    a_other.m_nItems = 0;
+    a_other.Release();
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  IndexedHeap<T, Priority, Compare> &
+    IndexedHeap<T, Priority, Compare>::operator=(IndexedHeap && a_other)
+  {
+    if (this != &a_other)
+    {
+      Release();
+      ContainerBase::operator=(std::move(a_other));
+
+      m_pHeap = a_other.m_pHeap;
+      m_pSlots = a_other.m_pSlots;
+      m_pValues = a_other.m_pValues;
+      m_nItems = a_other.m_nItems;
+      m_nSlots = a_other.m_nSlots;
+      m_capacity = a_other.m_capacity;
+      m_freeHead = a_other.m_freeHead;
+
+      a_other.m_pHeap = nullptr;
+      a_other.m_pSlots = nullptr;
+      a_other.m_pValues = nullptr;
+      a_other.m_nItems = 0;
+      a_other.Release();
+      MemoryChanged();
+    }
+    return *this;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  size_t IndexedHeap<T, Priority, Compare>::size() const
+  {
+    return m_nItems;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  bool IndexedHeap<T, Priority, Compare>::empty() const
+  {
+    return m_nItems == 0;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  typename IndexedHeap<T, Priority, Compare>::Handle
+    IndexedHeap<T, Priority, Compare>::push(Priority const & a_priority, T const & a_value)
+  {
+    uint32_t slot = NewSlot();
+    try
+    {
+      new (&m_pValues[slot]) T(a_value);
+    }
+    catch (...)
+    {
+      FreeSlot(slot);
+      throw;
+    }
+
+    Entry entry = {a_priority, slot};
+    Place(m_nItems, entry);
+    m_nItems++;
+    SiftUp(m_nItems - 1);
+    MemoryChanged();
+    return MakeHandle(slot, m_pSlots[slot].generation);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::PushN(Priority const * a_pPriorities,
+                                                T const * a_pValues,
+                                                size_t a_count,
+                                                Handle * a_pHandlesOut)
+  {
+    if (a_count == 0)
+      return;
+
+    reserve(m_nItems + a_count);
+
+    //Sifting each in costs O(k log n), a rebuild O(n + k)
+    bool rebuild = a_count > m_nItems / 4;
+
+    for (size_t i = 0; i < a_count; i++)
+    {
+      uint32_t slot = NewSlot();
+      try
+      {
+        new (&m_pValues[slot]) T(a_pValues[i]);
+      }
+      catch (...)
+      {
+        FreeSlot(slot);
+        if (rebuild)
+          Heapify();
+        MemoryChanged();
+        throw;
+      }
+
+      if (a_pHandlesOut != nullptr)
+        a_pHandlesOut[i] = MakeHandle(slot, m_pSlots[slot].generation);
+
+      Entry entry = {a_pPriorities[i], slot};
+      Place(m_nItems, entry);
+      m_nItems++;
+      if (!rebuild)
+        SiftUp(m_nItems - 1);
+    }
+
+    if (rebuild)
+      Heapify();
+
+    MemoryChanged();
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  T & IndexedHeap<T, Priority, Compare>::top()
+  {
+    return m_pValues[m_pHeap[0].slot];
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  T const & IndexedHeap<T, Priority, Compare>::top() const
+  {
+    return m_pValues[m_pHeap[0].slot];
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  Priority const & IndexedHeap<T, Priority, Compare>::top_priority() const
+  {
+    return m_pHeap[0].priority;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  typename IndexedHeap<T, Priority, Compare>::Handle
+    IndexedHeap<T, Priority, Compare>::top_handle() const
+  {
+    uint32_t slot = m_pHeap[0].slot;
+    return MakeHandle(slot, m_pSlots[slot].generation);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::pop()
+  {
+    Remove(0);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  bool IndexedHeap<T, Priority, Compare>::contains(Handle a_handle) const
+  {
+    return GetSlot(a_handle) != nullptr;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  bool IndexedHeap<T, Priority, Compare>::update(Handle a_handle, Priority const & a_priority)
+  {
+    Slot const * pSlot = GetSlot(a_handle);
+    if (pSlot == nullptr)
+      return false;
+
+    size_t index = pSlot->index;
+    Priority old = m_pHeap[index].priority;
+    m_pHeap[index].priority = a_priority;
+
+    if (Compare(a_priority, old))
+      SiftUp(index);
+    else
+      SiftDown(index);
+    return true;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  bool IndexedHeap<T, Priority, Compare>::erase(Handle a_handle)
+  {
+    Slot const * pSlot = GetSlot(a_handle);
+    if (pSlot == nullptr)
+      return false;
+
+    Remove(pSlot->index);
+    return true;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  T & IndexedHeap<T, Priority, Compare>::operator[](Handle a_handle)
+  {
+    return m_pValues[Index(a_handle)];
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  T const & IndexedHeap<T, Priority, Compare>::operator[](Handle a_handle) const
+  {
+    return m_pValues[Index(a_handle)];
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  Priority const & IndexedHeap<T, Priority, Compare>::priority(Handle a_handle) const
+  {
+    return m_pHeap[m_pSlots[Index(a_handle)].index].priority;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  T & IndexedHeap<T, Priority, Compare>::at(Handle a_handle)
+  {
+    if (!contains(a_handle))
+      throw std::out_of_range("IndexedHeap: stale or invalid handle");
+    return m_pValues[Index(a_handle)];
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  T const & IndexedHeap<T, Priority, Compare>::at(Handle a_handle) const
+  {
+    if (!contains(a_handle))
+      throw std::out_of_range("IndexedHeap: stale or invalid handle");
+    return m_pValues[Index(a_handle)];
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::reserve(size_t a_nItems)
+  {
+    if (a_nItems <= m_capacity)
+      return;
+
+    if (a_nItems > s_noSlot)
+      throw std::length_error("IndexedHeap: too many items");
+
+    ReallocTimer timer(*this);
+    pool_size(a_nItems);
+    size_t capacity = pool_size();
+
+    Entry * pHeap = static_cast<Entry*>(realloc(m_pHeap, capacity * sizeof(Entry)));
+    if (pHeap == nullptr)
+      throw std::bad_alloc();
+    m_pHeap = pHeap;
+
+    Slot * pSlots = static_cast<Slot*>(realloc(m_pSlots, capacity * sizeof(Slot)));
+    if (pSlots == nullptr)
+      throw std::bad_alloc();
+    m_pSlots = pSlots;
+
+    T * pValues = static_cast<T*>(realloc(m_pValues, capacity * sizeof(T)));
+    if (pValues == nullptr)
+      throw std::bad_alloc();
+    m_pValues = pValues;
+
+    m_capacity = capacity;
+    MemoryChanged();
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::clear()
+  {
+    //Slots are freed, not forgotten, so existing handles go stale
+    for (size_t i = 0; i < m_nItems; i++)
+    {
+      m_pValues[m_pHeap[i].slot].~T();
+      FreeSlot(m_pHeap[i].slot);
+    }
+    m_nItems = 0;
+    MemoryChanged();
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  typename IndexedHeap<T, Priority, Compare>::Handle
+    IndexedHeap<T, Priority, Compare>::MakeHandle(uint32_t a_slot, uint32_t a_generation)
+  {
+    return (static_cast<Handle>(a_generation) << 32) | a_slot;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  uint32_t IndexedHeap<T, Priority, Compare>::Index(Handle a_handle)
+  {
+    return static_cast<uint32_t>(a_handle);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  uint32_t IndexedHeap<T, Priority, Compare>::Generation(Handle a_handle)
+  {
+    return static_cast<uint32_t>(a_handle >> 32);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  typename IndexedHeap<T, Priority, Compare>::Slot const *
+    IndexedHeap<T, Priority, Compare>::GetSlot(Handle a_handle) const
+  {
+    uint32_t index = Index(a_handle);
+    uint32_t generation = Generation(a_handle);
+    if (index >= m_nSlots || (generation & 1) == 0)
+      return nullptr;
+
+    Slot const * pSlot = &m_pSlots[index];
+    return (pSlot->generation == generation) ? pSlot : nullptr;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::Place(size_t a_index, Entry const & a_entry)
+  {
+    m_pHeap[a_index] = a_entry;
+    m_pSlots[a_entry.slot].index = static_cast<uint32_t>(a_index);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::SiftUp(size_t a_index)
+  {
+    Entry entry = m_pHeap[a_index];
+    while (a_index > 0)
+    {
+      size_t parent = (a_index - 1) / s_arity;
+      if (!Compare(entry.priority, m_pHeap[parent].priority))
+        break;
+      Place(a_index, m_pHeap[parent]);
+      a_index = parent;
+    }
+    Place(a_index, entry);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::SiftDown(size_t a_index)
+  {
+    Entry entry = m_pHeap[a_index];
+    while (true)
+    {
+      size_t first = a_index * s_arity + 1;
+      if (first >= m_nItems)
+        break;
+
+      size_t last = first + s_arity;
+      if (last > m_nItems)
+        last = m_nItems;
+
+      size_t best = first;
+      for (size_t c = first + 1; c < last; c++)
+      {
+        if (Compare(m_pHeap[c].priority, m_pHeap[best].priority))
+          best = c;
+      }
+
+      if (!Compare(m_pHeap[best].priority, entry.priority))
+        break;
+      Place(a_index, m_pHeap[best]);
+      a_index = best;
+    }
+    Place(a_index, entry);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::Heapify()
+  {
+    if (m_nItems < 2)
+      return;
+    for (size_t i = (m_nItems - 2) / s_arity + 1; i > 0; i--)
+      SiftDown(i - 1);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::Remove(size_t a_index)
+  {
+    Entry removed = m_pHeap[a_index];
+    m_pValues[removed.slot].~T();
+    FreeSlot(removed.slot);
+
+    m_nItems--;
+    if (a_index != m_nItems)
+    {
+      Entry last = m_pHeap[m_nItems];
+      Place(a_index, last);
+      if (a_index > 0 && Compare(last.priority, m_pHeap[(a_index - 1) / s_arity].priority))
+        SiftUp(a_index);
+      else
+        SiftDown(a_index);
+    }
+    MemoryChanged();
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  uint32_t IndexedHeap<T, Priority, Compare>::NewSlot()
+  {
+    uint32_t slot;
+    if (m_freeHead != s_noSlot)
+    {
+      slot = m_freeHead;
+      m_freeHead = m_pSlots[slot].index;
+    }
+    else
+    {
+      if (m_nSlots >= s_noSlot)
+        throw std::length_error("IndexedHeap: out of slots");
+
+      if (m_nSlots == m_capacity)
+        Grow();
+      m_pSlots[m_nSlots].generation = 0;
+      slot = static_cast<uint32_t>(m_nSlots++);
+    }
+
+    m_pSlots[slot].generation++;
+    m_pSlots[slot].index = s_noSlot;
+    return slot;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::FreeSlot(uint32_t a_slot)
+  {
+    Slot & slot = m_pSlots[a_slot];
+
+    //Retire the slot if another fill would overflow its generation
+    if (slot.generation == s_maxGeneration)
+    {
+      slot.generation = 0;
+      slot.index = s_noSlot;
+      return;
+    }
+    slot.generation++;
+
+    slot.index = m_freeHead;
+    m_freeHead = a_slot;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::Grow()
+  {
+    if (m_capacity == 0)
+      reserve(pool_size());
+    else
+      reserve(m_capacity + 1);
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::Init(IndexedHeap const & a_other)
+  {
+    reserve(a_other.m_nSlots);
+    if (a_other.m_nSlots != 0)
+      memcpy(m_pSlots, a_other.m_pSlots, a_other.m_nSlots * sizeof(Slot));
+    m_nSlots = a_other.m_nSlots;
+    m_freeHead = a_other.m_freeHead;
+
+    for (; m_nItems < a_other.m_nItems; m_nItems++)
+    {
+      Entry const & entry = a_other.m_pHeap[m_nItems];
+      new (&m_pValues[entry.slot]) T(a_other.m_pValues[entry.slot]);
+      m_pHeap[m_nItems] = entry;
+    }
+    MemoryChanged();
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::Release()
+  {
+    for (size_t i = 0; i < m_nItems; i++)
+      m_pValues[m_pHeap[i].slot].~T();
+
+    free(m_pHeap);
+    free(m_pSlots);
+    free(m_pValues);
+
+    m_pHeap = nullptr;
+    m_pSlots = nullptr;
+    m_pValues = nullptr;
+    m_nItems = 0;
+    m_nSlots = 0;
+    m_capacity = 0;
+    m_freeHead = s_noSlot;
+  }
+
+  template<typename T, typename Priority, bool (*Compare)(Priority const &, Priority const &)>
+  void IndexedHeap<T, Priority, Compare>::ReportMemory()
+  {
+    TrackMemory(m_capacity * (sizeof(Entry) + sizeof(Slot) + sizeof(T)),
+                m_nItems * (sizeof(Entry) + sizeof(T)) + m_nSlots * sizeof(Slot),
+                m_nItems);
+  }
+}
+
+#endif
@@ -3,30 +3,182 @@
 //! @author: Frank B. Hart
 //! @date 29/06/2018
 //!
-//! Class declaration: Mask
+//! Class declaration: Mask, DynamicMask
 
 #ifndef DGMASK_H
 #define DGMASK_H
 
 #include <cstring>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
 #include <stdint.h>
 #include <limits.h>
 
+#if defined(__AVX2__)
+#define DG_MASK_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DG_MASK_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "impl/DgBitOps.h"
+
 namespace Dg
 {
+  namespace impl
+  {
+    typedef uint64_t MaskWord;
+    size_t const maskWordBits = sizeof(MaskWord) * CHAR_BIT;
+
+    inline size_t MaskWordCount(size_t a_nBits)
+    {
+      return (a_nBits + (maskWordBits - 1)) / maskWordBits;
+    }
+
+    //! The valid bits of the last word of an a_nBits mask
+    inline MaskWord MaskTail(size_t a_nBits)
+    {
+      size_t rem = a_nBits % maskWordBits;
+      return (rem == 0) ? ~MaskWord(0) : ((MaskWord(1) << rem) - 1);
+    }
+
+    struct MaskAnd
+    {
+      static MaskWord Apply(MaskWord a, MaskWord b) { return a & b; }
+#ifdef DG_MASK_SSE2
+      static __m128i Apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+#ifdef DG_MASK_AVX2
+      static __m256i Apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+    };
+
+    struct MaskOr
+    {
+      static MaskWord Apply(MaskWord a, MaskWord b) { return a | b; }
+#ifdef DG_MASK_SSE2
+      static __m128i Apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+#ifdef DG_MASK_AVX2
+      static __m256i Apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+    };
+
+    struct MaskXor
+    {
+      static MaskWord Apply(MaskWord a, MaskWord b) { return a ^ b; }
+#ifdef DG_MASK_SSE2
+      static __m128i Apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif
+#ifdef DG_MASK_AVX2
+      static __m256i Apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#endif
+    };
+
+    //a & ~b
+    struct MaskAndNot
+    {
+      static MaskWord Apply(MaskWord a, MaskWord b) { return a & ~b; }
+#ifdef DG_MASK_SSE2
+      static __m128i Apply(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+#ifdef DG_MASK_AVX2
+      static __m256i Apply(__m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+#endif
+    };
+
+    //! a_pDest[i] = Op(a_pDest[i], a_pSrc[i]), 256 or 128 bits at a time
+    //! where the target supports it.
+    template<typename Op>
+    void CombineMaskWords(MaskWord * a_pDest, MaskWord const * a_pSrc, size_t a_nWords)
+    {
+      size_t i = 0;
+#ifdef DG_MASK_AVX2
+      for (; i + 4 <= a_nWords; i += 4)
+      {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a_pDest + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a_pSrc + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(a_pDest + i), Op::Apply(a, b));
+      }
+#endif
+#ifdef DG_MASK_SSE2
+      for (; i + 2 <= a_nWords; i += 2)
+      {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a_pDest + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a_pSrc + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pDest + i), Op::Apply(a, b));
+      }
+#endif
+      for (; i < a_nWords; i++)
+        a_pDest[i] = Op::Apply(a_pDest[i], a_pSrc[i]);
+    }
+
+    inline size_t CountMaskBits(MaskWord const * a_pWords, size_t a_nWords)
+    {
+      //Independent sums so the popcnts can overlap
+      size_t sum[4] = {};
+      size_t i = 0;
+      for (; i + 4 <= a_nWords; i += 4)
+      {
+        sum[0] += PopCount(a_pWords[i]);
+        sum[1] += PopCount(a_pWords[i + 1]);
+        sum[2] += PopCount(a_pWords[i + 2]);
+        sum[3] += PopCount(a_pWords[i + 3]);
+      }
+      for (; i < a_nWords; i++)
+        sum[0] += PopCount(a_pWords[i]);
+      return sum[0] + sum[1] + sum[2] + sum[3];
+    }
+
+    inline bool AnyMaskBits(MaskWord const * a_pWords, size_t a_nWords)
+    {
+      for (size_t i = 0; i < a_nWords; i++)
+      {
+        if (a_pWords[i] != 0)
+          return true;
+      }
+      return false;
+    }
+
+    template<typename Fn>
+    void ForEachSetMaskBit(MaskWord const * a_pWords, size_t a_nWords, Fn & a_fn)
+    {
+      for (size_t i = 0; i < a_nWords; i++)
+      {
+        MaskWord word = a_pWords[i];
+        while (word != 0)
+        {
+          a_fn(i * maskWordBits + static_cast<size_t>(CountTrailingZeros(word)));
+          word &= word - 1;
+        }
+      }
+    }
+  }
+
   //! @ingroup DgUtility_types
   //!
   //! @class Mask
   //!
-  //! 
+  //! A fixed number of bits, packed into 64-bit words. Bulk operations work
+  //! on whole words (and SSE2/AVX2 registers where available), and
+  //! ForEachSetBit() visits only the set bits, so iterating a sparse mask
+  //! costs little more than a scan of its words.
+  //!
+  //! Bits past Size are always off.
   //!
   //! @author Frank Hart
   //! @date 29/06/2016
   template<size_t Size>
   class Mask
   {
-    typedef uint8_t DataType;
-    static const size_t s_DataBits = sizeof(DataType) * CHAR_BIT;
+    static_assert(Size > 0, "A mask needs at least one bit");
+
+    typedef impl::MaskWord DataType;
+    static const size_t s_DataBits = impl::maskWordBits;
     static const size_t s_arraySize = (Size + (s_DataBits - 1)) / s_DataBits;
   public:
 
@@ -38,37 +190,44 @@ namespace Dg
 
     Mask(Mask const & a_other)
     {
-      memcpy(m_data, a_other.m_data, s_arraySize);
+      memcpy(m_data, a_other.m_data, sizeof(m_data));
     }
 
     Mask & operator=(Mask const & a_other)
     {
       if (this != &a_other)
       {
-        memcpy(m_data, a_other.m_data, s_arraySize);
+        memcpy(m_data, a_other.m_data, sizeof(m_data));
       }
 
-      return *this
+      return *this;
     }
 
     bool operator==(Mask const & a_other) const
     {
-      return memcmp(m_data, a_other.m_data, s_arraySize) == 0;
+      return memcmp(m_data, a_other.m_data, sizeof(m_data)) == 0;
     }
 
     bool operator!=(Mask const & a_other) const
     {
-      return memcmp(m_data, a_other.m_data, s_arraySize) != 0;
+      return memcmp(m_data, a_other.m_data, sizeof(m_data)) != 0;
+    }
+
+    //! Number of bits
+    static size_t size()
+    {
+      return Size;
     }
 
     void SetAllOn()
     {
-      memset(m_data, -1, s_arraySize);
+      memset(m_data, -1, sizeof(m_data));
+      m_data[s_arraySize - 1] &= impl::MaskTail(Size);
     }
 
     void SetAllOff()
     {
-      memset(m_data, 0, s_arraySize);
+      memset(m_data, 0, sizeof(m_data));
     }
 
     void SetOn(size_t a_index)
@@ -84,12 +243,17 @@ namespace Dg
     {
       size_t arrayIndex = a_index / s_DataBits;
       size_t bitIndex = a_index % s_DataBits;
-      DataType bitMask = ~static_cast<DataType>(1) << bitIndex;
+      DataType bitMask = ~(static_cast<DataType>(1) << bitIndex);
 
       m_data[arrayIndex] &= bitMask;
     }
 
-    bool IsOn(int a_index) const
+    void Toggle(size_t a_index)
+    {
+      m_data[a_index / s_DataBits] ^= static_cast<DataType>(1) << (a_index % s_DataBits);
+    }
+
+    bool IsOn(size_t a_index) const
     {
       size_t arrayIndex = a_index / s_DataBits;
       size_t bitIndex = a_index % s_DataBits;
@@ -98,10 +262,409 @@ namespace Dg
       return (m_data[arrayIndex] & bitMask) != 0;
     }
 
+    //! Number of bits on
+    size_t Count() const
+    {
+      return impl::CountMaskBits(m_data, s_arraySize);
+    }
+
+    bool Any() const
+    {
+      return impl::AnyMaskBits(m_data, s_arraySize);
+    }
+
+    bool None() const
+    {
+      return !Any();
+    }
+
+    //! Calls a_fn(size_t index) for each bit that is on, in increasing order.
+    template<typename Fn>
+    void ForEachSetBit(Fn a_fn) const
+    {
+      impl::ForEachSetMaskBit(m_data, s_arraySize, a_fn);
+    }
+
+    Mask & operator&=(Mask const & a_other)
+    {
+      impl::CombineMaskWords<impl::MaskAnd>(m_data, a_other.m_data, s_arraySize);
+      return *this;
+    }
+
+    Mask & operator|=(Mask const & a_other)
+    {
+      impl::CombineMaskWords<impl::MaskOr>(m_data, a_other.m_data, s_arraySize);
+      return *this;
+    }
+
+    Mask & operator^=(Mask const & a_other)
+    {
+      impl::CombineMaskWords<impl::MaskXor>(m_data, a_other.m_data, s_arraySize);
+      return *this;
+    }
+
+    //! Turns off the bits that are on in a_other
+    Mask & AndNot(Mask const & a_other)
+    {
+      impl::CombineMaskWords<impl::MaskAndNot>(m_data, a_other.m_data, s_arraySize);
+      return *this;
+    }
+
+    Mask operator&(Mask const & a_other) const { Mask result(*this); result &= a_other; return result; }
+    Mask operator|(Mask const & a_other) const { Mask result(*this); result |= a_other; return result; }
+    Mask operator^(Mask const & a_other) const { Mask result(*this); result ^= a_other; return result; }
+
+    Mask operator~() const
+    {
+      Mask result;
+      for (size_t i = 0; i < s_arraySize; i++)
+        result.m_data[i] = ~m_data[i];
+      result.m_data[s_arraySize - 1] &= impl::MaskTail(Size);
+      return result;
+    }
+
+    //! The packed words, lowest bits first
+    DataType const * data() const
+    {
+      return m_data;
+    }
+
+    static size_t word_count()
+    {
+      return s_arraySize;
+    }
+
   private:
 
     DataType m_data[s_arraySize];
   };
+
+  //! @ingroup DgUtility_types
+  //!
+  //! @class DynamicMask
+  //!
+  //! As Mask, with the number of bits set at run time. Binary operations
+  //! need both masks to be the same size and throw std::length_error if they
+  //! are not.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  class DynamicMask
+  {
+    typedef impl::MaskWord DataType;
+    static const size_t s_DataBits = impl::maskWordBits;
+  public:
+
+    DynamicMask();
+    DynamicMask(size_t a_size, bool a_on = false);
+    ~DynamicMask();
+
+    DynamicMask(DynamicMask const &);
+    DynamicMask & operator=(DynamicMask const &);
+    DynamicMask(DynamicMask &&);
+    DynamicMask & operator=(DynamicMask &&);
+
+    bool operator==(DynamicMask const &) const;
+    bool operator!=(DynamicMask const &) const;
+
+    //! Number of bits
+    size_t size() const;
+
+    //! New bits are off.
+    void resize(size_t a_size);
+
+    void SetAllOn();
+    void SetAllOff();
+    void SetOn(size_t);
+    void SetOff(size_t);
+    void Toggle(size_t);
+    bool IsOn(size_t) const;
+
+    //! Number of bits on
+    size_t Count() const;
+    bool Any() const;
+    bool None() const;
+
+    //! Calls a_fn(size_t index) for each bit that is on, in increasing order.
+    template<typename Fn>
+    void ForEachSetBit(Fn a_fn) const
+    {
+      impl::ForEachSetMaskBit(m_pData, WordCount(), a_fn);
+    }
+
+    DynamicMask & operator&=(DynamicMask const &);
+    DynamicMask & operator|=(DynamicMask const &);
+    DynamicMask & operator^=(DynamicMask const &);
+
+    //! Turns off the bits that are on in a_other
+    DynamicMask & AndNot(DynamicMask const &);
+
+    DynamicMask operator&(DynamicMask const &) const;
+    DynamicMask operator|(DynamicMask const &) const;
+    DynamicMask operator^(DynamicMask const &) const;
+    DynamicMask operator~() const;
+
+    //! The packed words, lowest bits first
+    DataType const * data() const;
+    size_t word_count() const;
+
+  private:
+
+    size_t WordCount() const;
+    void ClearTail();
+    void CheckSize(DynamicMask const &) const;
+
+    template<typename Op>
+    DynamicMask & Combine(DynamicMask const &);
+
+  private:
+
+    DataType *  m_pData;
+    size_t      m_size;
+  };
+
+  //--------------------------------------------------------------------------------
+  //		DynamicMask
+  //--------------------------------------------------------------------------------
+  inline DynamicMask::DynamicMask()
+    : m_pData(nullptr)
+    , m_size(0)
+  {
+
+  }
+
+  inline DynamicMask::DynamicMask(size_t a_size, bool a_on)
+    : m_pData(nullptr)
+    , m_size(0)
+  {
+    resize(a_size);
+    if (a_on)
+      SetAllOn();
+  }
+
+  inline DynamicMask::~DynamicMask()
+  {
+    free(m_pData);
+  }
+
+  inline DynamicMask::DynamicMask(DynamicMask const & a_other)
+    : m_pData(nullptr)
+    , m_size(0)
+  {
+    resize(a_other.m_size);
+    if (m_size != 0)
+      memcpy(m_pData, a_other.m_pData, WordCount() * sizeof(DataType));
+  }
+
+  inline DynamicMask & DynamicMask::operator=(DynamicMask const & a_other)
+  {
+    if (this != &a_other)
+    {
+      resize(a_other.m_size);
+      if (m_size != 0)
+        memcpy(m_pData, a_other.m_pData, WordCount() * sizeof(DataType));
+    }
+    return *this;
+  }
+
+  inline DynamicMask::DynamicMask(DynamicMask && a_other)
+    : m_pData(a_other.m_pData)
+    , m_size(a_other.m_size)
+  {
+    a_other.m_pData = nullptr;
+    a_other.m_size = 0;
+  }
+
+  inline DynamicMask & DynamicMask::operator=(DynamicMask && a_other)
+  {
+    if (this != &a_other)
+    {
+      free(m_pData);
+      m_pData = a_other.m_pData;
+      m_size = a_other.m_size;
+      a_other.m_pData = nullptr;
+      a_other.m_size = 0;
+    }
+    return *this;
+  }
+
+  inline bool DynamicMask::operator==(DynamicMask const & a_other) const
+  {
+    return m_size == a_other.m_size
+      && (m_size == 0 || memcmp(m_pData, a_other.m_pData, WordCount() * sizeof(DataType)) == 0);
+  }
+
+  inline bool DynamicMask::operator!=(DynamicMask const & a_other) const
+  {
+    return !(*this == a_other);
+  }
+
+  inline size_t DynamicMask::size() const
+  {
+    return m_size;
+  }
+
+  inline void DynamicMask::resize(size_t a_size)
+  {
+    size_t oldWords = WordCount();
+    size_t newWords = impl::MaskWordCount(a_size);
+
+    if (newWords != oldWords)
+    {
+      if (newWords == 0)
+      {
+        free(m_pData);
+        m_pData = nullptr;
+      }
+      else
+      {
+        DataType * pData = static_cast<DataType *>(realloc(m_pData, newWords * sizeof(DataType)));
+        if (pData == nullptr)
+          throw std::bad_alloc();
+        m_pData = pData;
+        if (newWords > oldWords)
+          memset(m_pData + oldWords, 0, (newWords - oldWords) * sizeof(DataType));
+      }
+    }
+
+    m_size = a_size;
+    ClearTail();
+  }
+
+  inline void DynamicMask::SetAllOn()
+  {
+    if (m_size == 0)
+      return;
+    memset(m_pData, -1, WordCount() * sizeof(DataType));
+    ClearTail();
+  }
+
+  inline void DynamicMask::SetAllOff()
+  {
+    if (m_size == 0)
+      return;
+    memset(m_pData, 0, WordCount() * sizeof(DataType));
+  }
+
+  inline void DynamicMask::SetOn(size_t a_index)
+  {
+    m_pData[a_index / s_DataBits] |= static_cast<DataType>(1) << (a_index % s_DataBits);
+  }
+
+  inline void DynamicMask::SetOff(size_t a_index)
+  {
+    m_pData[a_index / s_DataBits] &= ~(static_cast<DataType>(1) << (a_index % s_DataBits));
+  }
+
+  inline void DynamicMask::Toggle(size_t a_index)
+  {
+    m_pData[a_index / s_DataBits] ^= static_cast<DataType>(1) << (a_index % s_DataBits);
+  }
+
+  inline bool DynamicMask::IsOn(size_t a_index) const
+  {
+    return (m_pData[a_index / s_DataBits] & (static_cast<DataType>(1) << (a_index % s_DataBits))) != 0;
+  }
+
+  inline size_t DynamicMask::Count() const
+  {
+    return impl::CountMaskBits(m_pData, WordCount());
+  }
+
+  inline bool DynamicMask::Any() const
+  {
+    return impl::AnyMaskBits(m_pData, WordCount());
+  }
+
+  inline bool DynamicMask::None() const
+  {
+    return !Any();
+  }
+
+  inline DynamicMask & DynamicMask::operator&=(DynamicMask const & a_other)
+  {
+    return Combine<impl::MaskAnd>(a_other);
+  }
+
+  inline DynamicMask & DynamicMask::operator|=(DynamicMask const & a_other)
+  {
+    return Combine<impl::MaskOr>(a_other);
+  }
+
+  inline DynamicMask & DynamicMask::operator^=(DynamicMask const & a_other)
+  {
+    return Combine<impl::MaskXor>(a_other);
+  }
+
+  inline DynamicMask & DynamicMask::AndNot(DynamicMask const & a_other)
+  {
+    return Combine<impl::MaskAndNot>(a_other);
+  }
+
+  inline DynamicMask DynamicMask::operator&(DynamicMask const & a_other) const
+  {
+    DynamicMask result(*this);
+    result &= a_other;
+    return result;
+  }
+
+  inline DynamicMask DynamicMask::operator|(DynamicMask const & a_other) const
+  {
+    DynamicMask result(*this);
+    result |= a_other;
+    return result;
+  }
+
+  inline DynamicMask DynamicMask::operator^(DynamicMask const & a_other) const
+  {
+    DynamicMask result(*this);
+    result ^= a_other;
+    return result;
+  }
+
+  inline DynamicMask DynamicMask::operator~() const
+  {
+    DynamicMask result(m_size);
+    for (size_t i = 0; i < WordCount(); i++)
+      result.m_pData[i] = ~m_pData[i];
+    result.ClearTail();
+    return result;
+  }
+
+  inline DynamicMask::DataType const * DynamicMask::data() const
+  {
+    return m_pData;
+  }
+
+  inline size_t DynamicMask::word_count() const
+  {
+    return WordCount();
+  }
+
+  inline size_t DynamicMask::WordCount() const
+  {
+    return impl::MaskWordCount(m_size);
+  }
+
+  inline void DynamicMask::ClearTail()
+  {
+    if (m_size != 0)
+      m_pData[WordCount() - 1] &= impl::MaskTail(m_size);
+  }
+
+  inline void DynamicMask::CheckSize(DynamicMask const & a_other) const
+  {
+    if (m_size != a_other.m_size)
+      throw std::length_error("DynamicMask: masks differ in size");
+  }
+
+  template<typename Op>
+  DynamicMask & DynamicMask::Combine(DynamicMask const & a_other)
+  {
+    CheckSize(a_other);
+    impl::CombineMaskWords<Op>(m_pData, a_other.m_pData, WordCount());
+    return *this;
+  }
 }
 
-#endif
\ No newline at end of file
+#endif
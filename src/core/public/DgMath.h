@@ -167,19 +167,77 @@ namespace Dg
 	  if (a_x < static_cast<Real>(-1.0) || a_x > static_cast<Real>(1.0))
 		  return static_cast<Real>(0.0);
 
+	  double const * coeffs = impl::InverfCoefficients<N_C_INVERF>();
 	  Real x0Sq = a_x * a_x;
 	  Real x = a_x;
 	  Real result = static_cast<Real>(0.0);
 	  
 	  for (unsigned i = 0; i < nTerms; i++)
 	  {
-		  result += x * static_cast<Real>(impl::C_INVERF[i]);
+		  result += x * static_cast<Real>(coeffs[i]);
 		  x *= x0Sq;
 	  }
 
 	  return result;
   }
 
+  //! Error function. Minimax approximation, computed in double: relative
+  //! error below 1.0e-8. Use std::erf if full double precision is needed.
+  //!
+  //! @return erf(a_x)
+  template<typename Real>
+  Real Erf(Real a_x)
+  {
+    double x = static_cast<double>(a_x);
+    double ax = fabs(x);
+    if (ax < 0.5)
+      return static_cast<Real>(x * impl::Polynomial(impl::C_ERF_SMALL, x * x));
+
+    double t = 2.0 / (2.0 + ax);
+    double result = 1.0 - t * exp(impl::Polynomial(impl::C_ERFC, t - 0.5) - ax * ax);
+    return static_cast<Real>(x < 0.0 ? -result : result);
+  }
+
+  //! Complementary error function, 1 - erf(a_x). Minimax approximation,
+  //! computed in double: relative error below 1.0e-8 for a_x < 10, where
+  //! the result is above 1.0e-45.
+  //!
+  //! @return erfc(a_x)
+  template<typename Real>
+  Real Erfc(Real a_x)
+  {
+    double x = static_cast<double>(a_x);
+    if (fabs(x) < 0.5)
+      return static_cast<Real>(1.0 - x * impl::Polynomial(impl::C_ERF_SMALL, x * x));
+
+    double ax = fabs(x);
+    double t = 2.0 / (2.0 + ax);
+    double result = t * exp(impl::Polynomial(impl::C_ERFC, t - 0.5) - ax * ax);
+    return static_cast<Real>(x < 0.0 ? 2.0 - result : result);
+  }
+
+  //! Inverse error function. Minimax approximation, computed in double:
+  //! relative error below 3.0e-8. Much faster and, towards +-1, much more
+  //! accurate than the series in inverf().
+  //!
+  //! @return The x for which erf(x) = a_x. +-infinity at +-1, NaN outside [-1, 1].
+  template<typename Real>
+  Real InvErf(Real a_x)
+  {
+    double x = static_cast<double>(a_x);
+    if (!(fabs(x) < 1.0))
+    {
+      if (fabs(x) == 1.0)
+        return x * std::numeric_limits<Real>::infinity();
+      return std::numeric_limits<Real>::quiet_NaN();
+    }
+
+    double w = -log((1.0 - x) * (1.0 + x));
+    double p = (w < 5.0) ? impl::Polynomial(impl::C_INVERF_CENTRAL, w - 2.5)
+                         : impl::Polynomial(impl::C_INVERF_TAIL, sqrt(w) - 3.0);
+    return static_cast<Real>(p * x);
+  }
+
   //! Set bits within an integer type.
   template<typename T, unsigned Position, unsigned Length, typename = std::enable_if<std::is_integral<T>::value>>
   T SetBitSet(T a_input, T a_value)
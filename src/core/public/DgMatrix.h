@@ -9,6 +9,9 @@
 #define DGMATRIX_H
 
 #include "DgMath.h"
+#include "impl/DgMatrixKernels.h"
+#include "impl/DgMatrixExpr.h"
+#include "impl/DgMatrixDecomposition.h"
 
 namespace Dg
 {
@@ -31,27 +34,18 @@ namespace Dg
   template<size_t M, size_t N, typename Real>
   Real Dot(Matrix<M, N, Real> const &, Matrix<M, N, Real> const &);
 
-  //! Scalar multiplication
-  template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real> operator*(Real, Matrix<M, N, Real> const &);
-
-  namespace impl
-  {
-    //! Recursive function which finds the determinant of a matrix.
-    //! Not the most efficient algorithm O(n!).
-    //!
-    //! @return value
-    template<size_t M, size_t N, typename Real>
-    Real Determinant(Matrix<M, N, Real> const &);
-
-    //!Finds the determinant of a 2x2 matrix.
-    template<typename Real>
-    Real Determinant(Matrix<2, 2, Real> const &);
+  //! Inverse of a square matrix, by LU decomposition above 3x3.
+  //!
+  //! @return false if the matrix is singular, in which case the output is not changed.
+  template<size_t N, typename Real>
+  bool Inverse(Matrix<N, N, Real> const &, Matrix<N, N, Real> & out);
 
-    //!Finds the determinant of a 1x1 matrix.
-    template<typename Real>
-    Real Determinant(Matrix<1, 1, Real> const &);
-  }
+  //! Solves A * X = B by LU decomposition with partial pivoting.
+  //! B may have several columns.
+  //!
+  //! @return false if A is singular, in which case X is not changed.
+  template<size_t N, size_t P, typename Real>
+  bool Solve(Matrix<N, N, Real> const & A, Matrix<N, P, Real> const & B, Matrix<N, P, Real> & X);
 
   //! @ingroup DgMath_types
   //!
@@ -59,10 +53,17 @@ namespace Dg
   //!
   //! @brief Generic two dimension matrix class.
   //!
+  //! The element-wise operators (+, -, negation, scalar * and /) return
+  //! expressions which are evaluated in a single pass on assignment, so
+  //! a * s + b - c creates no temporaries. Matrix products are evaluated
+  //! straight away. The free functions (Dot(), Transpose(), Inverse(),
+  //! Solve(), ==, !=) accept expressions; member functions need a Matrix.
+  //! R2 and R3 vectors do their arithmetic eagerly and return vectors.
+  //!
   //! @author Frank B. Hart
   //! @date 4/10/2015
   template<size_t M, size_t N, typename Real>
-  class Matrix
+  class Matrix : public impl::MatrixExpr<Matrix<M, N, Real>, M, N, Real>
   {
     static_assert(M > 0 && N > 0, "Matrix cannot have a zero dimension.");
 
@@ -81,6 +82,14 @@ namespace Dg
     //! Assignment
     Matrix& operator=(Matrix const &);
 
+    //! Evaluate an expression
+    template<typename E>
+    Matrix(impl::MatrixExpr<E, M, N, Real> const &);
+
+    //! Evaluate an expression into this matrix
+    template<typename E>
+    Matrix& operator=(impl::MatrixExpr<E, M, N, Real> const &);
+
     //! Accessor m: row, n:column.
     Real& operator()(size_t m, size_t n);
 
@@ -93,12 +102,6 @@ namespace Dg
     //! Accessor element by index.
     Real operator[](size_t i) const { return m_V[i]; }
 
-    //! Comparison
-    bool operator== (Matrix const &) const;
-
-    //! Comparison
-    bool operator!= (Matrix const &) const;
-
     //! Checks if all elements are below the tolerance.
     bool IsZero() const;
 
@@ -140,49 +143,29 @@ namespace Dg
     //! Set matrix to its transpose. For square matrices only.
     Matrix& Transpose();
 
-    //! Uses recursive algorithm.
+    //! Closed form up to 3x3, LU decomposition above.
     Real Determinant() const;
 
     //! Element-wise dot product.
 	  Real Dot(Matrix const &) const;
 
-    //! Matrix-matrix addition
-    Matrix operator+ (Matrix const &) const;
-
     //! Matrix-matrix addition, assign to self
-    Matrix& operator+= (Matrix const &);
-
-    //! Matrix-matrix subtraction
-    Matrix operator- (Matrix const &) const;
+    template<typename E>
+    Matrix& operator+= (impl::MatrixExpr<E, M, N, Real> const &);
 
     //! Matrix-matrix subtraction, assign to self
-    Matrix& operator-= (Matrix const &);
-
-    //! Negate matrix.
-    Matrix operator-() const;
+    template<typename E>
+    Matrix& operator-= (impl::MatrixExpr<E, M, N, Real> const &);
 
     //! Matrix-matrix multiplication, assign to self
     Matrix& operator*= (Matrix const &);
 
-    //! Matrix-matrix multiplication
-    template<size_t _M>
-    Matrix<M, _M, Real> operator* (Matrix<N, _M, Real> const &) const;
-
     //! Matrix-scalar multiplication, assign to self
     Matrix& operator*= (Real);
 
-    //! Matrix-scalar multiplication
-    Matrix operator* (Real) const;
-
     //! Matrix-scalar division, assign to self
     Matrix& operator/= (Real);
 
-    //! Matrix-scalar division
-    Matrix operator/ (Real) const;
-
-    //! Scalar multiplication
-    friend Matrix operator*<M, N, Real> (Real, Matrix const &);
-
     //! Element-wise product
     Matrix ElementwiseProduct(Matrix const &) const;
 
@@ -253,48 +236,48 @@ namespace Dg
   //	@	Matrix::Matrix()
   //--------------------------------------------------------------------------------
   template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real>::Matrix(Matrix<M, N, Real> const & a_other)
+  template<typename E>
+  Matrix<M, N, Real>::Matrix(impl::MatrixExpr<E, M, N, Real> const & a_expr)
   {
+    E const & expr = a_expr.Derived();
     for (size_t i = 0; i < M * N; i++)
     {
-      m_V[i] = a_other.m_V[i];
+      m_V[i] = expr[i];
     }
-
   }	//End: Matrix::Matrix()
 
 
   //--------------------------------------------------------------------------------
-  //	@	Matrix::operator==()
+  //	@	Matrix::operator=()
   //--------------------------------------------------------------------------------
   template<size_t M, size_t N, typename Real>
-  bool Matrix<M, N, Real>::operator== (Matrix<M, N, Real> const & a_other) const
+  template<typename E>
+  Matrix<M, N, Real>& Matrix<M, N, Real>::operator=(impl::MatrixExpr<E, M, N, Real> const & a_expr)
   {
+    //Element i only depends on element i of the operands, so the
+    //expression may refer to this matrix.
+    E const & expr = a_expr.Derived();
     for (size_t i = 0; i < M * N; i++)
     {
-      if (!Dg::AreEqual(m_V[i], a_other.m_V[i]))
-        return false;
+      m_V[i] = expr[i];
     }
 
-    return true;
-
-  }	//End: Matrix::operator==()
+    return *this;
+  }	//End: Matrix::operator=()
 
 
   //--------------------------------------------------------------------------------
-  //	@	Matrix::operator!=()
+  //	@	Matrix::Matrix()
   //--------------------------------------------------------------------------------
   template<size_t M, size_t N, typename Real>
-  bool Matrix<M, N, Real>::operator!= (Matrix<M, N, Real> const & a_other) const
+  Matrix<M, N, Real>::Matrix(Matrix<M, N, Real> const & a_other)
   {
     for (size_t i = 0; i < M * N; i++)
     {
-      if (!Dg::AreEqual(m_V[i], a_other.m_V[i]))
-        return true;
+      m_V[i] = a_other.m_V[i];
     }
 
-    return false;
-
-  }	//End: Matrix::operator!=()
+  }	//End: Matrix::Matrix()
 
 
   //--------------------------------------------------------------------------------
@@ -393,67 +376,10 @@ namespace Dg
   //--------------------------------------------------------------------------------
   template<size_t M, size_t N, typename Real>
   Real Matrix<M, N, Real>::Determinant() const
-  {
-    return impl::Determinant(*this);
-  }	//End: Determinant()
-
-
-  //--------------------------------------------------------------------------------
-  //	@	Determinant()
-  //--------------------------------------------------------------------------------
-  template<size_t M, size_t N, typename Real>
-  Real impl::Determinant(Matrix<M, N, Real> const & a_matrix)
   {
     static_assert(M == N, "Can only find determinant of a square matrix");
 
-    Real result = 0;
-    Real sign = static_cast<Real>(1.0);
-
-    for (size_t i = 0; i < M; i++)
-    {
-      Matrix<M - 1, M - 1, Real> subMatrix;
-
-      size_t n_out = 0;
-      for (size_t n_in = 0; n_in < M; ++n_in)
-      {
-        if (n_in == i)
-        {
-          continue;
-        }
-
-        for (size_t m_out = 0; m_out + 1 < M; ++m_out)
-        {
-          subMatrix[m_out * (M - 1) + n_out] = a_matrix[(m_out + 1) * M + n_in];
-        }
-        n_out++;
-      }
-
-      result += (Determinant(subMatrix) * sign * a_matrix[i]);
-
-      sign *= static_cast<Real>(-1.0);
-    }
-
-    return result;
-  }	//End: Determinant()
-
-
-  //--------------------------------------------------------------------------------
-  //	@	Determinant()
-  //--------------------------------------------------------------------------------
-  template<typename Real>
-  Real impl::Determinant(Matrix<2, 2, Real> const & a_matrix)
-  {
-    return a_matrix[0] * a_matrix[3] - a_matrix[1] * a_matrix[2];
-  }	//End: Determinant()
-
-
-  //--------------------------------------------------------------------------------
-  //	@	Determinant()
-  //--------------------------------------------------------------------------------
-  template<typename Real>
-  Real impl::Determinant(Matrix<1, 1, Real> const & a_matrix)
-  {
-    return a_matrix[0];
+    return impl::DeterminantKernel<M, Real>::Apply(m_V);
   }	//End: Determinant()
 
 
@@ -576,15 +502,7 @@ namespace Dg
   Matrix<N, M, Real> Transpose(Matrix<M, N, Real> const & a_mat)
   {
     Matrix<N, M, Real> result;
-
-    for (size_t m = 0; m < M; ++m)
-    {
-      for (size_t n = 0; n < N; ++n)
-      {
-        result.m_V[n * M + m] = a_mat.m_V[m * N + n];
-      }
-    }
-
+    impl::MatrixTransposeKernel<M, N, Real>::Apply(a_mat.m_V, result.m_V);
     return result;
 
   }   // End: Transpose()
@@ -598,34 +516,51 @@ namespace Dg
   {
     static_assert(M == N, "Can only transpose a square matrix");
 
-    for (size_t m = 0; m < M - 1; ++m)
-    {
-      for (size_t n = m + 1; n < N; ++n)
-      {
-        Real temp;
-        temp = m_V[m * N + n];
-        m_V[m * N + n] = m_V[n * N + m];
-        m_V[n * N + m] = temp;
-      }
-    }
-
+    *this = Dg::Transpose(*this);
     return *this;
 
   }   // End: Transpose()
 
 
+  //-------------------------------------------------------------------------------
+  //	@	Inverse()
+  //-------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  bool Inverse(Matrix<N, N, Real> const & a_mat, Matrix<N, N, Real> & a_out)
+  {
+    return impl::InverseKernel<N, Real>::Apply(a_mat.GetData(), a_out.GetData());
+  }   // End: Inverse()
+
+
+  //-------------------------------------------------------------------------------
+  //	@	Solve()
+  //-------------------------------------------------------------------------------
+  template<size_t N, size_t P, typename Real>
+  bool Solve(Matrix<N, N, Real> const & a_A, Matrix<N, P, Real> const & a_B, Matrix<N, P, Real> & a_X)
+  {
+    Matrix<N, N, Real> lu(a_A);
+    size_t perm[N];
+    Real sign;
+    if (!impl::LUKernel<N, Real>::Decompose(lu.GetData(), perm, sign))
+    {
+      return false;
+    }
+
+    //a_X may be a_B
+    Matrix<N, P, Real> result;
+    impl::LUKernel<N, Real>::template Solve<P>(lu.GetData(), perm, a_B.GetData(), result.GetData());
+    a_X = result;
+    return true;
+  }   // End: Solve()
+
+
   //-------------------------------------------------------------------------------
   //	@	Dot()
   //-------------------------------------------------------------------------------
   template<size_t M, size_t N, typename Real>
   Real Matrix<M, N, Real>::Dot(Matrix<M, N, Real> const & a_mat) const
   {
-	  Real result = static_cast<Real>(0.0);
-	  for (size_t i = 0; i < M * N; i++)
-	  {
-		  result += (a_mat.m_V[i] * m_V[i]);
-	  }
-	  return result;
+	  return impl::DotKernel<M * N, Real>::Apply(m_V, a_mat.m_V);
   }	// End: Dot()
 
 
@@ -640,115 +575,87 @@ namespace Dg
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator+()
+  //	@	Dot()
   //-------------------------------------------------------------------------------
-  template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real> Matrix<M, N, Real>::operator+(Matrix<M, N, Real> const & a_other) const
+  //! Element-wise dot product where either side is an expression.
+  template<typename L, typename R, size_t M, size_t N, typename Real>
+  Real Dot(impl::MatrixExpr<L, M, N, Real> const & a_lhs, impl::MatrixExpr<R, M, N, Real> const & a_rhs)
   {
-    Matrix<M, N, Real> result;
-
-    for (size_t i = 0; i < M * N; i++)
-    {
-      result.m_V[i] = m_V[i] + a_other.m_V[i];
-    }
-
-    return result;
-
-  }   // End: Matrix::operator+()
+    impl::MatrixOperand<L, M, N, Real> lhs(a_lhs);
+    impl::MatrixOperand<R, M, N, Real> rhs(a_rhs);
+    return impl::DotKernel<M * N, Real>::Apply(lhs.Data(), rhs.Data());
+  }	// End: Dot()
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator+=()
+  //	@	Transpose()
   //-------------------------------------------------------------------------------
-  template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real>& Matrix<M, N, Real>::operator+=(Matrix<M, N, Real> const & a_other)
+  //! Transpose of an expression.
+  template<typename E, size_t M, size_t N, typename Real>
+  Matrix<N, M, Real> Transpose(impl::MatrixExpr<E, M, N, Real> const & a_expr)
   {
-    for (size_t i = 0; i < M * N; i++)
-    {
-      m_V[i] += a_other.m_V[i];
-    }
-
-    return *this;
-
-  }   // End: Matrix::operator+=()
+    return Dg::Transpose(Matrix<M, N, Real>(a_expr));
+  }   // End: Transpose()
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator-()
+  //	@	Inverse()
   //-------------------------------------------------------------------------------
-  template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real> Matrix<M, N, Real>::operator-(Matrix<M, N, Real> const & other) const
+  //! Inverse of an expression.
+  template<typename E, size_t N, typename Real>
+  bool Inverse(impl::MatrixExpr<E, N, N, Real> const & a_expr, Matrix<N, N, Real> & a_out)
   {
-    Matrix<M, N, Real> result;
-
-    for (size_t i = 0; i < M * N; i++)
-    {
-      result.m_V[i] = m_V[i] - other.m_V[i];
-    }
-
-    return result;
-
-  }   // End: Matrix::operator-()
+    impl::MatrixOperand<E, N, N, Real> mat(a_expr);
+    return impl::InverseKernel<N, Real>::Apply(mat.Data(), a_out.GetData());
+  }   // End: Inverse()
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator-=()
+  //	@	Solve()
   //-------------------------------------------------------------------------------
-  template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real>& Matrix<M, N, Real>::operator-=(Matrix<M, N, Real> const & a_other)
+  //! Solve() where either A or B is an expression.
+  template<typename EA, typename EB, size_t N, size_t P, typename Real>
+  bool Solve(impl::MatrixExpr<EA, N, N, Real> const & a_A, impl::MatrixExpr<EB, N, P, Real> const & a_B, Matrix<N, P, Real> & a_X)
   {
-    for (size_t i = 0; i < M * N; i++)
-    {
-      m_V[i] -= a_other.m_V[i];
-    }
-
-    return *this;
-
-  }   // End: Matrix::operator-=()
+    return Dg::Solve(Matrix<N, N, Real>(a_A), Matrix<N, P, Real>(a_B), a_X);
+  }   // End: Solve()
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator-()
+  //	@	Matrix::operator+=()
   //-------------------------------------------------------------------------------
   template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real> Matrix<M, N, Real>::operator-() const
+  template<typename E>
+  Matrix<M, N, Real>& Matrix<M, N, Real>::operator+=(impl::MatrixExpr<E, M, N, Real> const & a_expr)
   {
-    Matrix<M, N, Real> result;
-
+    E const & expr = a_expr.Derived();
     for (size_t i = 0; i < M * N; i++)
     {
-      result.m_V[i] = -m_V[i];
+      m_V[i] += expr[i];
     }
 
-    return result;
+    return *this;
 
-  }    // End: Matrix::operator-()
+  }   // End: Matrix::operator+=()
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator*()
+  //	@	Matrix::operator-=()
   //-------------------------------------------------------------------------------
   template<size_t M, size_t N, typename Real>
-  template<size_t _M>
-  Matrix<M, _M, Real> Matrix<M, N, Real>::operator*(Matrix<N, _M, Real> const & a_other) const
+  template<typename E>
+  Matrix<M, N, Real>& Matrix<M, N, Real>::operator-=(impl::MatrixExpr<E, M, N, Real> const & a_expr)
   {
-    Matrix<M, _M, Real> result;
-    result.Zero();
-
-    for (size_t m = 0; m < M; ++m)
+    E const & expr = a_expr.Derived();
+    for (size_t i = 0; i < M * N; i++)
     {
-      for (size_t _m = 0; _m < _M; ++_m)
-      {
-        for (size_t n = 0; n < N; ++n)
-        {
-          result.m_V[m * _M + _m] += (m_V[m * N + n] * a_other.m_V[n * _M + _m]);
-        }
-      }
+      m_V[i] -= expr[i];
     }
 
-    return result;
+    return *this;
+
+  }   // End: Matrix::operator-=()
 
-  }   // End: Matrix::operator*()
 
   //-------------------------------------------------------------------------------
   //	@	Matrix::operator*()
@@ -759,19 +666,7 @@ namespace Dg
     static_assert(M == N, "Can only assign to self if a square matrix");
 
     Matrix<M, N, Real> result;
-    result.Zero();
-
-    for (size_t m = 0; m < M; ++m)
-    {
-      for (size_t n = 0; n < N; ++n)
-      {
-        for (size_t i = 0; i < N; i++)
-        {
-          result.m_V[m * N + n] += (m_V[m * N + i] * a_other.m_V[i * N + n]);
-        }
-      }
-    }
-
+    impl::MatrixMultiplyKernel<M, N, N, Real>::Apply(m_V, a_other.m_V, result.m_V);
     Set(result.m_V);
 
     return *this;
@@ -830,73 +725,132 @@ namespace Dg
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator*()
+  //	@	Matrix::operator/=()
   //-------------------------------------------------------------------------------
   template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real> operator*(Real a_scalar, Matrix<M, N, Real> const & matrix)
+  Matrix<M, N, Real>& Matrix<M, N, Real>::operator/=(Real a_scalar)
   {
-    Matrix<M, N, Real> result;
-
     for (size_t i = 0; i < M * N; i++)
     {
-      result.m_V[i] = matrix.m_V[i] * a_scalar;
+      m_V[i] /= a_scalar;
     }
 
-    return result;
+    return *this;
 
-  }  // End: operator*()
+  }  // End: Matrix::operator/=()
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator*()
+  //	@	operator+()
   //-------------------------------------------------------------------------------
-  template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real> Matrix<M, N, Real>::operator*(Real a_scalar) const
+  template<typename L, typename R, size_t M, size_t N, typename Real>
+  impl::MatrixBinaryExpr<L, R, impl::MatrixAddOp, M, N, Real>
+    operator+(impl::MatrixExpr<L, M, N, Real> const & a_lhs, impl::MatrixExpr<R, M, N, Real> const & a_rhs)
   {
-    Matrix<M, N, Real> result;
+    return impl::MatrixBinaryExpr<L, R, impl::MatrixAddOp, M, N, Real>(a_lhs.Derived(), a_rhs.Derived());
+  }   // End: operator+()
 
-    for (size_t i = 0; i < M * N; i++)
-    {
-      result.m_V[i] = m_V[i] * a_scalar;
-    }
 
-    return result;
+  //-------------------------------------------------------------------------------
+  //	@	operator-()
+  //-------------------------------------------------------------------------------
+  template<typename L, typename R, size_t M, size_t N, typename Real>
+  impl::MatrixBinaryExpr<L, R, impl::MatrixSubtractOp, M, N, Real>
+    operator-(impl::MatrixExpr<L, M, N, Real> const & a_lhs, impl::MatrixExpr<R, M, N, Real> const & a_rhs)
+  {
+    return impl::MatrixBinaryExpr<L, R, impl::MatrixSubtractOp, M, N, Real>(a_lhs.Derived(), a_rhs.Derived());
+  }   // End: operator-()
+
 
-  }  // End: Matrix::operator*()
+  //-------------------------------------------------------------------------------
+  //	@	operator-()
+  //-------------------------------------------------------------------------------
+  template<typename E, size_t M, size_t N, typename Real>
+  impl::MatrixNegateExpr<E, M, N, Real> operator-(impl::MatrixExpr<E, M, N, Real> const & a_expr)
+  {
+    return impl::MatrixNegateExpr<E, M, N, Real>(a_expr.Derived());
+  }   // End: operator-()
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator/()
+  //	@	operator*()
   //-------------------------------------------------------------------------------
-  template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real> Matrix<M, N, Real>::operator/(Real a_scalar) const
+  template<typename E, size_t M, size_t N, typename Real>
+  impl::MatrixScalarExpr<E, impl::MatrixMultiplyOp, M, N, Real>
+    operator*(impl::MatrixExpr<E, M, N, Real> const & a_expr, typename impl::NonDeduced<Real>::type a_scalar)
   {
-    Matrix<M, N, Real> result;
+    return impl::MatrixScalarExpr<E, impl::MatrixMultiplyOp, M, N, Real>(a_expr.Derived(), a_scalar);
+  }   // End: operator*()
 
-    for (size_t i = 0; i < M * N; i++)
-    {
-      result.m_V[i] = m_V[i] / a_scalar;
-    }
 
-    return result;
+  //-------------------------------------------------------------------------------
+  //	@	operator*()
+  //-------------------------------------------------------------------------------
+  template<typename E, size_t M, size_t N, typename Real>
+  impl::MatrixScalarExpr<E, impl::MatrixMultiplyOp, M, N, Real>
+    operator*(typename impl::NonDeduced<Real>::type a_scalar, impl::MatrixExpr<E, M, N, Real> const & a_expr)
+  {
+    return impl::MatrixScalarExpr<E, impl::MatrixMultiplyOp, M, N, Real>(a_expr.Derived(), a_scalar);
+  }   // End: operator*()
 
-  }  // End: Matrix::operator/()
+
+  //-------------------------------------------------------------------------------
+  //	@	operator/()
+  //-------------------------------------------------------------------------------
+  template<typename E, size_t M, size_t N, typename Real>
+  impl::MatrixScalarExpr<E, impl::MatrixDivideOp, M, N, Real>
+    operator/(impl::MatrixExpr<E, M, N, Real> const & a_expr, typename impl::NonDeduced<Real>::type a_scalar)
+  {
+    return impl::MatrixScalarExpr<E, impl::MatrixDivideOp, M, N, Real>(a_expr.Derived(), a_scalar);
+  }   // End: operator/()
 
 
   //-------------------------------------------------------------------------------
-  //	@	Matrix::operator/=()
+  //	@	operator*()
   //-------------------------------------------------------------------------------
-  template<size_t M, size_t N, typename Real>
-  Matrix<M, N, Real>& Matrix<M, N, Real>::operator/=(Real a_scalar)
+  //! Matrix-matrix multiplication. Evaluated immediately; operands that
+  //! are expressions are evaluated once first.
+  template<typename L, typename R, size_t M, size_t N, size_t P, typename Real>
+  Matrix<M, P, Real> operator*(impl::MatrixExpr<L, M, N, Real> const & a_lhs, impl::MatrixExpr<R, N, P, Real> const & a_rhs)
   {
+    impl::MatrixOperand<L, M, N, Real> lhs(a_lhs);
+    impl::MatrixOperand<R, N, P, Real> rhs(a_rhs);
+
+    Matrix<M, P, Real> result;
+    impl::MatrixMultiplyKernel<M, N, P, Real>::Apply(lhs.Data(), rhs.Data(), result.GetData());
+    return result;
+  }   // End: operator*()
+
+
+  //-------------------------------------------------------------------------------
+  //	@	operator==()
+  //-------------------------------------------------------------------------------
+  //! Comparison, element by element, within tolerance. Either side may be
+  //! an expression.
+  template<typename L, typename R, size_t M, size_t N, typename Real>
+  bool operator==(impl::MatrixExpr<L, M, N, Real> const & a_lhs, impl::MatrixExpr<R, M, N, Real> const & a_rhs)
+  {
+    L const & lhs = a_lhs.Derived();
+    R const & rhs = a_rhs.Derived();
     for (size_t i = 0; i < M * N; i++)
     {
-      m_V[i] /= a_scalar;
+      if (!Dg::AreEqual(lhs[i], rhs[i]))
+        return false;
     }
 
-    return *this;
+    return true;
+  }   // End: operator==()
 
-  }  // End: Matrix::operator/=()
+
+  //-------------------------------------------------------------------------------
+  //	@	operator!=()
+  //-------------------------------------------------------------------------------
+  //! Comparison. Either side may be an expression.
+  template<typename L, typename R, size_t M, size_t N, typename Real>
+  bool operator!=(impl::MatrixExpr<L, M, N, Real> const & a_lhs, impl::MatrixExpr<R, M, N, Real> const & a_rhs)
+  {
+    return !(a_lhs == a_rhs);
+  }   // End: operator!=()
 
 }
 
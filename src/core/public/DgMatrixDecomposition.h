@@ -0,0 +1,387 @@
+//! @file DgMatrixDecomposition.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Class declarations: LUDecomposition, CholeskyDecomposition, QRDecomposition
+
+#ifndef DGMATRIXDECOMPOSITION_H
+#define DGMATRIXDECOMPOSITION_H
+
+#include "DgMatrix.h"
+
+namespace Dg
+{
+  //! @ingroup DgMath_types
+  //!
+  //! @class LUDecomposition
+  //!
+  //! @brief LU decomposition with partial pivoting of a square matrix.
+  //!
+  //! Decompose once, then solve for as many right hand sides as needed.
+  //!
+  //! @author Frank B. Hart
+  //! @date 19/10/2026
+  template<size_t N, typename Real>
+  class LUDecomposition
+  {
+  public:
+
+    //! The decomposition is singular until Decompose() is called.
+    LUDecomposition();
+
+    explicit LUDecomposition(Matrix<N, N, Real> const &);
+
+    //! @return false if the matrix is singular.
+    bool Decompose(Matrix<N, N, Real> const &);
+
+    bool IsSingular() const { return m_singular; }
+
+    //! @return 0 if the matrix is singular.
+    Real Determinant() const;
+
+    //! Solves A * X = B. X may be B.
+    //!
+    //! @return false if A is singular, in which case X is not changed.
+    template<size_t P>
+    bool Solve(Matrix<N, P, Real> const & B, Matrix<N, P, Real> & X) const;
+
+    //! @return false if A is singular, in which case the output is not changed.
+    bool Inverse(Matrix<N, N, Real> &) const;
+
+  private:
+
+    Matrix<N, N, Real>  m_LU;
+    size_t              m_perm[N];
+    Real                m_sign;
+    bool                m_singular;
+  };
+
+
+  //! @ingroup DgMath_types
+  //!
+  //! @class CholeskyDecomposition
+  //!
+  //! @brief A = L * L^T of a symmetric positive definite matrix.
+  //!
+  //! About twice as fast as LU for normal equations and covariance
+  //! matrices. Only the lower triangle of the input is read.
+  //!
+  //! @author Frank B. Hart
+  //! @date 19/10/2026
+  template<size_t N, typename Real>
+  class CholeskyDecomposition
+  {
+  public:
+
+    //! The decomposition is invalid until Decompose() is called.
+    CholeskyDecomposition();
+
+    explicit CholeskyDecomposition(Matrix<N, N, Real> const &);
+
+    //! @return false if the matrix is not positive definite.
+    bool Decompose(Matrix<N, N, Real> const &);
+
+    bool IsPositiveDefinite() const { return m_valid; }
+
+    //! @return 0 if the matrix is not positive definite.
+    Real Determinant() const;
+
+    //! Solves A * X = B. X may be B.
+    //!
+    //! @return false if A is not positive definite, in which case X is not changed.
+    template<size_t P>
+    bool Solve(Matrix<N, P, Real> const & B, Matrix<N, P, Real> & X) const;
+
+    //! The lower triangular factor. The upper triangle is zero.
+    Matrix<N, N, Real> const & GetL() const { return m_L; }
+
+  private:
+
+    Matrix<N, N, Real>  m_L;
+    bool                m_valid;
+  };
+
+
+  //! @ingroup DgMath_types
+  //!
+  //! @class QRDecomposition
+  //!
+  //! @brief Householder QR decomposition of an M x N matrix, M >= N.
+  //!
+  //! Solves over-determined systems in the least squares sense without
+  //! forming the normal equations.
+  //!
+  //! @author Frank B. Hart
+  //! @date 19/10/2026
+  template<size_t M, size_t N, typename Real>
+  class QRDecomposition
+  {
+    static_assert(M >= N, "QR decomposition needs at least as many rows as columns");
+
+  public:
+
+    //! The decomposition is rank deficient until Decompose() is called.
+    QRDecomposition();
+
+    explicit QRDecomposition(Matrix<M, N, Real> const &);
+
+    //! @return false if the matrix does not have full column rank.
+    bool Decompose(Matrix<M, N, Real> const &);
+
+    bool IsFullRank() const { return m_fullRank; }
+
+    //! Least squares solution of A * X = B.
+    //!
+    //! @return false if A is rank deficient, in which case X is not changed.
+    template<size_t P>
+    bool Solve(Matrix<M, P, Real> const & B, Matrix<N, P, Real> & X) const;
+
+    //! The M x N factor with orthonormal columns.
+    void GetQ(Matrix<M, N, Real> &) const;
+
+    //! The N x N upper triangular factor.
+    void GetR(Matrix<N, N, Real> &) const;
+
+  private:
+
+    Matrix<M, N, Real>  m_QR;
+    Real                m_rDiag[N];
+    bool                m_fullRank;
+  };
+
+
+  //--------------------------------------------------------------------------------
+  //	@	LUDecomposition::LUDecomposition()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  LUDecomposition<N, Real>::LUDecomposition()
+    : m_sign(static_cast<Real>(1.0))
+    , m_singular(true)
+  {
+
+  }	//End: LUDecomposition::LUDecomposition()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	LUDecomposition::LUDecomposition()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  LUDecomposition<N, Real>::LUDecomposition(Matrix<N, N, Real> const & a_mat)
+  {
+    Decompose(a_mat);
+  }	//End: LUDecomposition::LUDecomposition()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	LUDecomposition::Decompose()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  bool LUDecomposition<N, Real>::Decompose(Matrix<N, N, Real> const & a_mat)
+  {
+    m_LU = a_mat;
+    m_singular = !impl::LUKernel<N, Real>::Decompose(m_LU.GetData(), m_perm, m_sign);
+    return !m_singular;
+  }	//End: LUDecomposition::Decompose()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	LUDecomposition::Determinant()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  Real LUDecomposition<N, Real>::Determinant() const
+  {
+    if (m_singular)
+    {
+      return static_cast<Real>(0.0);
+    }
+    return impl::LUKernel<N, Real>::Determinant(m_LU.GetData(), m_sign);
+  }	//End: LUDecomposition::Determinant()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	LUDecomposition::Solve()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  template<size_t P>
+  bool LUDecomposition<N, Real>::Solve(Matrix<N, P, Real> const & a_B,
+                                       Matrix<N, P, Real> & a_X) const
+  {
+    if (m_singular)
+    {
+      return false;
+    }
+
+    Matrix<N, P, Real> result;
+    impl::LUKernel<N, Real>::template Solve<P>(m_LU.GetData(), m_perm, a_B.GetData(), result.GetData());
+    a_X = result;
+    return true;
+  }	//End: LUDecomposition::Solve()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	LUDecomposition::Inverse()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  bool LUDecomposition<N, Real>::Inverse(Matrix<N, N, Real> & a_out) const
+  {
+    Matrix<N, N, Real> identity;
+    identity.Identity();
+    return Solve(identity, a_out);
+  }	//End: LUDecomposition::Inverse()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	CholeskyDecomposition::CholeskyDecomposition()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  CholeskyDecomposition<N, Real>::CholeskyDecomposition()
+    : m_valid(false)
+  {
+
+  }	//End: CholeskyDecomposition::CholeskyDecomposition()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	CholeskyDecomposition::CholeskyDecomposition()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  CholeskyDecomposition<N, Real>::CholeskyDecomposition(Matrix<N, N, Real> const & a_mat)
+  {
+    Decompose(a_mat);
+  }	//End: CholeskyDecomposition::CholeskyDecomposition()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	CholeskyDecomposition::Decompose()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  bool CholeskyDecomposition<N, Real>::Decompose(Matrix<N, N, Real> const & a_mat)
+  {
+    m_L = a_mat;
+    m_valid = impl::CholeskyKernel<N, Real>::Decompose(m_L.GetData());
+    return m_valid;
+  }	//End: CholeskyDecomposition::Decompose()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	CholeskyDecomposition::Determinant()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  Real CholeskyDecomposition<N, Real>::Determinant() const
+  {
+    if (!m_valid)
+    {
+      return static_cast<Real>(0.0);
+    }
+
+    Real result = static_cast<Real>(1.0);
+    for (size_t i = 0; i < N; ++i)
+    {
+      result *= m_L[i * N + i];
+    }
+    return result * result;
+  }	//End: CholeskyDecomposition::Determinant()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	CholeskyDecomposition::Solve()
+  //--------------------------------------------------------------------------------
+  template<size_t N, typename Real>
+  template<size_t P>
+  bool CholeskyDecomposition<N, Real>::Solve(Matrix<N, P, Real> const & a_B,
+                                             Matrix<N, P, Real> & a_X) const
+  {
+    if (!m_valid)
+    {
+      return false;
+    }
+
+    a_X = a_B;
+    impl::CholeskyKernel<N, Real>::template Solve<P>(m_L.GetData(), a_X.GetData());
+    return true;
+  }	//End: CholeskyDecomposition::Solve()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	QRDecomposition::QRDecomposition()
+  //--------------------------------------------------------------------------------
+  template<size_t M, size_t N, typename Real>
+  QRDecomposition<M, N, Real>::QRDecomposition()
+    : m_fullRank(false)
+  {
+
+  }	//End: QRDecomposition::QRDecomposition()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	QRDecomposition::QRDecomposition()
+  //--------------------------------------------------------------------------------
+  template<size_t M, size_t N, typename Real>
+  QRDecomposition<M, N, Real>::QRDecomposition(Matrix<M, N, Real> const & a_mat)
+  {
+    Decompose(a_mat);
+  }	//End: QRDecomposition::QRDecomposition()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	QRDecomposition::Decompose()
+  //--------------------------------------------------------------------------------
+  template<size_t M, size_t N, typename Real>
+  bool QRDecomposition<M, N, Real>::Decompose(Matrix<M, N, Real> const & a_mat)
+  {
+    m_QR = a_mat;
+    m_fullRank = impl::QRKernel<M, N, Real>::Decompose(m_QR.GetData(), m_rDiag);
+    return m_fullRank;
+  }	//End: QRDecomposition::Decompose()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	QRDecomposition::Solve()
+  //--------------------------------------------------------------------------------
+  template<size_t M, size_t N, typename Real>
+  template<size_t P>
+  bool QRDecomposition<M, N, Real>::Solve(Matrix<M, P, Real> const & a_B,
+                                          Matrix<N, P, Real> & a_X) const
+  {
+    if (!m_fullRank)
+    {
+      return false;
+    }
+
+    Matrix<M, P, Real> work(a_B);
+    impl::QRKernel<M, N, Real>::template Solve<P>(m_QR.GetData(), m_rDiag, work.GetData());
+    a_X = work.template GetSubMatrix<N, P>(0, 0);
+    return true;
+  }	//End: QRDecomposition::Solve()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	QRDecomposition::GetQ()
+  //--------------------------------------------------------------------------------
+  template<size_t M, size_t N, typename Real>
+  void QRDecomposition<M, N, Real>::GetQ(Matrix<M, N, Real> & a_out) const
+  {
+    impl::QRKernel<M, N, Real>::GetQ(m_QR.GetData(), a_out.GetData());
+  }	//End: QRDecomposition::GetQ()
+
+
+  //--------------------------------------------------------------------------------
+  //	@	QRDecomposition::GetR()
+  //--------------------------------------------------------------------------------
+  template<size_t M, size_t N, typename Real>
+  void QRDecomposition<M, N, Real>::GetR(Matrix<N, N, Real> & a_out) const
+  {
+    for (size_t i = 0; i < N; ++i)
+    {
+      for (size_t j = 0; j < N; ++j)
+      {
+        if (i < j)       a_out(i, j) = m_QR(i, j);
+        else if (i == j) a_out(i, j) = m_rDiag[i];
+        else             a_out(i, j) = static_cast<Real>(0.0);
+      }
+    }
+  }	//End: QRDecomposition::GetR()
+}
+
+#endif
@@ -0,0 +1,92 @@
+//! @file DgMemoryRegistry.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: MemoryRegistry
+
+#ifndef DGMEMORYREGISTRY_H
+#define DGMEMORYREGISTRY_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "impl/DgContainerBase.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Live memory figures of one tagged container. Written by the thread
+    //! that owns the container, read by anyone querying the registry.
+    struct MemoryRecord
+    {
+      std::string             name;
+      std::atomic<size_t>     reservedBytes;
+      std::atomic<size_t>     peakReservedBytes;
+      std::atomic<size_t>     usedBytes;
+      std::atomic<size_t>     nItems;
+      std::atomic<size_t>     peakItems;
+      std::atomic<size_t>     nGrowths;
+      std::atomic<int64_t>    reallocNanoseconds;
+    };
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! A snapshot of the memory used by one container, or by all containers
+  //! sharing a tag.
+  struct ContainerMemoryStats
+  {
+    std::string name;
+    size_t      nContainers;
+    size_t      reservedBytes;      //Bytes allocated for the pool
+    size_t      peakReservedBytes;
+    size_t      usedBytes;          //Bytes taken by current elements
+    size_t      nItems;
+    size_t      peakItems;
+    size_t      nGrowths;           //Number of times the pool grew
+    double      reallocSeconds;     //Time spent reallocating the pool
+  };
+
+  //! @ingroup DgContainers
+  //!
+  //! @class MemoryRegistry
+  //!
+  //! Process wide view of all containers tagged with
+  //! ContainerBase::set_memory_tag(). Figures are updated by the containers
+  //! as they change, so the registry can be queried at any time from any
+  //! thread. Figures for a container being modified while the registry is
+  //! read may be a step behind.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  class MemoryRegistry
+  {
+  public:
+
+    //! One entry per tagged container.
+    static std::vector<ContainerMemoryStats> GetStats();
+
+    //! One entry per tag, summed over all containers with that tag. Peaks
+    //! are the sum of each container's peak.
+    static std::vector<ContainerMemoryStats> GetStatsByTag();
+
+    static size_t TotalReservedBytes();
+    static size_t TotalUsedBytes();
+
+    //! All stats by tag, largest reservation first, as a JSON document.
+    static std::string ToJSON();
+
+  private:
+
+    friend class ContainerBase;
+
+    static impl::MemoryRecord * Register(char const * a_name);
+    static void Unregister(impl::MemoryRecord *);
+  };
+}
+
+#endif
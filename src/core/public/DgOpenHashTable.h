@@ -1,1315 +1,926 @@
-////! @file Dg_HashTable.h
-////!
-////! @author Frank Hart
-////! @date 22/08/2016
-////!
-////! Class declaration: OpenHashTable
-//
-//#ifndef DGOPENHASHTABLE_H
-//#define DGOPENHASHTABLE_H
-//
-//#define DGHASHTABLE_ENABLE_OUTPUT
-//
-//#include <type_traits>
-//#include <cstdlib>
-//#include <cstring>
-//#ifdef DGHASHTABLE_ENABLE_OUTPUT
-//#include <iostream>
-//#endif
-//
-//#include "impl/DgContainerBase.h"
-//
-//#define ARRAY_SIZE(a) sizeof(a) / sizeof(*a)
-//
-////TODO check for nullptr returns in realloc and throw
-////TODO tightly pack the elements in a linked list in memory
-////TODO should the hash function be a template parameter?
-//namespace Dg
-//{
-//  template<typename K>
-//  using fHasher = size_t(*)(K);
-//
-//  //! @ingroup DgContainers_functions
-//  //!
-//  //! The default hasher simply returns the key cast to a size_t. 
-//  //! In a the table, the result will be modded against the (prime)
-//  //! number of buckets. 
-//  template<typename K>
-//  size_t DefaultHasher(K key)
-//  {
-//    return static_cast<size_t>(key);
-//  }
-//
-//  namespace impl
-//  {
-//    //! An array listing possible values for the number of buckets.
-//    //! The ith value is the highest prime number closest to but below <2^(i/2 + 4)>
-//    extern size_t const validBucketCounts[125];
-//  }
-//
-//  //! @ingroup DgContainers
-//  //! 
-//  //! Much of this documentation is taken directly from 
-//  //! http://www.cplusplus.com/reference/unordered_map/unordered_map/
-//  //! as these containers share a lot of the same functions.
-//  //!
-//  //! HashTables are associative containers that store elements formed by 
-//  //! the combination of a key value and a mapped value, and which allows for 
-//  //! fast retrieval of individual elements based on their keys.
-//  //! 
-//  //! In a OpenHashTable, the key value is generally used to uniquely identify 
-//  //! the element, while the mapped value is an object with the content 
-//  //! associated to this key. Types of key and mapped value may differ.
-//  //! 
-//  //! Internally, the elements in the OpenHashTable are not sorted in any 
-//  //! particular order with respect to either their key or mapped values, 
-//  //! but organized into buckets depending on their hash values to allow for 
-//  //! fast access to individual elements directly by their key 
-//  //! values (with a constant average time complexity on average).
-//  //!
-//  //! OpenHashTable containers are faster than map containers to access individual 
-//  //! elements by their key, although they are generally less efficient for 
-//  //! range iteration through a subset of their elements.
-//  //!
-//  //! HashTables implement the direct access operator (operator[]) which 
-//  //! allows for direct access of the mapped value using its key value as argument.
-//  //!
-//  //! @author Frank Hart
-//  //! @date 22/08/2016
-//  template
-//  <
-//    //! Key type
-//      typename K
-//    //! Data type
-//    , typename T
-//  >
-//  class OpenHashTable : public ContainerBase
-//  {
-//    struct Node
-//    {
-//      K       key;
-//      T       data;
-//      Node *  pNext;
-//    };
-//
-//    struct Bucket
-//    {
-//      Node * pBegin;
-//    };
-//
-//    static float  const   s_defaultLF;
-//    static float  const   s_minSetLF;
-//    static size_t const   s_minPoolSize;
-//    static int const      s_invalidBucketIndex;
-//
-//  public:
-//
-//    //! @class const_iterator
-//    //!
-//    //! Constant iterator for the OpenHashTable. Iterating past the last element in the OpenHashTable
-//    //! or before the first element will result in returning the OpenHashTable::CEnd() iterator.
-//    //! Incrementing past the OpenHashTable::CEnd() iterator will do nothing. Decrementing the 
-//    //! OpenHashTable::CEnd() will give the last element in the list.
-//    //!
-//    //! @author Frank Hart
-//    //! @date 22/08/2016
-//    class const_iterator
-//    {
-//      friend class OpenHashTable;
-//
-//      //! Private constructor.
-//      const_iterator(Node * a_pNode
-//        , size_t a_bucketIndex
-//        , size_t a_bucketCount
-//        , Bucket * a_pBuckets)
-//        : m_pNode(a_pNode)
-//        , m_bucketIndex(a_bucketIndex)
-//        , m_bucketCount(a_bucketCount)
-//        , m_pBuckets(a_pBuckets)
-//      {}
-//
-//    public:
-//
-//      //! Default constructor.
-//      const_iterator()
-//        : m_pNode(nullptr)
-//        , m_bucketIndex(0)
-//        , m_bucketCount(0)
-//        , m_pBuckets(nullptr)
-//      {}
-//
-//      ~const_iterator() {}
-//
-//      //! Copy constructor.
-//      const_iterator(const_iterator const & it)
-//        : m_pNode(it.m_pNode)
-//        , m_bucketIndex(it.m_bucketIndex)
-//        , m_bucketCount(it.m_bucketCount)
-//        , m_pBuckets(it.m_pBuckets)
-//      {}
-//
-//      //! Assignment.
-//      const_iterator& operator= (const_iterator const & it)
-//      {
-//        m_pNode = it.m_pNode;
-//        m_bucketIndex = it.m_bucketIndex;
-//        m_bucketCount = it.m_bucketCount;
-//        m_pBuckets = it.m_pBuckets;
-//        return *this;
-//      }
-//
-//      //! Comparison.
-//      bool operator==(const_iterator const & it) const
-//      {
-//        return m_pNode == it.m_pNode
-//          && m_pBuckets == it.m_pBuckets;
-//      }
-//
-//      //! Comparison.
-//      bool operator!=(const_iterator const & it) const
-//      {
-//        return m_pNode != it.m_pNode
-//          || m_pBuckets != it.m_pBuckets;
-//      }
-//
-//      //! Post increment. Iterating past the last element in the OpenHashTable will result in 
-//      //! returning the OpenHashTable::CEnd() iterator. Incrementing past the OpenHashTable::CEnd() 
-//      //! iterator will do nothing. 
-//      const_iterator operator++(int)
-//      {
-//        const_iterator result(*this);
-//        ++(*this);
-//        return result;
-//      }
-//
-//      //! Pre increment. Iterating past the last element in the OpenHashTable will result in 
-//      //! returning the OpenHashTable::CEnd() iterator. Incrementing past the OpenHashTable::CEnd() 
-//      //! iterator will do nothing. 
-//      const_iterator & operator++()
-//      {
-//        if (!m_pNode)
-//        {
-//          return *this;
-//        }
-//
-//        if (m_pNode->pNext)
-//        {
-//          m_pNode = m_pNode->pNext;
-//          return *this;
-//        }
-//
-//        m_bucketIndex++;
-//        for (m_bucketIndex; m_bucketIndex < m_bucketCount; m_bucketIndex++)
-//        {
-//          if (m_pBuckets[m_bucketIndex].pBegin)
-//          {
-//            m_pNode = m_pBuckets[m_bucketIndex].pBegin;
-//            return *this;
-//          }
-//        }
-//
-//        //End
-//        m_bucketIndex = m_bucketCount - 1;
-//        m_pNode = nullptr;
-//        return *this;
-//      }
-//
-//      //! Post decrement. Decrementing the OpenHashTable::cbegin() iterator will result in returning the 
-//      //! OpenHashTable::CEnd() iterator.
-//      const_iterator operator--(int)
-//      {
-//        const_iterator result(*this);
-//        --(*this);
-//        return result;
-//      }
-//
-//      //! Pre decrement. Decrementing the OpenHashTable::cbegin() iterator will result in returning the 
-//      //! OpenHashTable::CEnd() iterator.
-//      const_iterator & operator--()
-//      {
-//        Node * curNode = m_pBuckets[m_bucketIndex].pBegin;
-//        while (curNode)
-//        {
-//          if (curNode->pNext == m_pNode)
-//          {
-//            m_pNode = curNode;
-//            return *this;
-//          }
-//          curNode = curNode->pNext;
-//        }
-//
-//        for (m_bucketIndex; m_bucketIndex-- > 0;)
-//        {
-//          Node * curNode = m_pBuckets[m_bucketIndex].pBegin;
-//          while (curNode)
-//          {
-//            if (!curNode->pNext)
-//            {
-//              m_pNode = curNode;
-//              return *this;
-//            }
-//            curNode = curNode->pNext;
-//          }
-//        }
-//
-//        //End
-//        m_pNode = nullptr;
-//        m_bucketIndex = m_bucketCount - 1;
-//        return *this;
-//      }
-//
-//      //! Conversion
-//      T const * operator->() const { return &m_pNode->data; }
-//
-//      //! Conversion
-//      T const & operator*() const { return m_pNode->data; }
-//
-//    private:
-//
-//      /// The 'End' const_iterator is denoted by:
-//      ///   m_pBuckets  = a valid pointer
-//      ///   m_pNode     = nullptr
-//
-//      size_t          m_bucketIndex;
-//      size_t          m_bucketCount;
-//      Bucket const *        m_pBuckets;
-//      Node const *    m_pNode;
-//    };
-//
-//
-//    //! @class iterator
-//    //!
-//    //! Iterator for the OpenHashTable. Iterating past the last element in the OpenHashTable
-//    //! or before the first element will result in returning the OpenHashTable::End() iterator.
-//    //! Incrementing past the OpenHashTable::End() iterator will do nothing. Decrementing the 
-//    //! OpenHashTable::End() will give the last element in the list.
-//    //!
-//    //! @author Frank Hart
-//    //! @date 22/08/2016
-//    class iterator
-//    {
-//      friend class OpenHashTable;
-//
-//      //! Private constructor.
-//      iterator(Node * a_pNode
-//        , size_t a_bucketIndex
-//        , size_t a_bucketCount
-//        , Bucket * a_pBuckets)
-//        : m_pNode(a_pNode)
-//        , m_bucketIndex(a_bucketIndex)
-//        , m_bucketCount(a_bucketCount)
-//        , m_pBuckets(a_pBuckets)
-//      {}
-//
-//    public:
-//
-//      //! Default constructor.
-//      iterator()
-//        : m_pNode(nullptr)
-//        , m_bucketIndex(0)
-//        , m_bucketCount(0)
-//        , m_pBuckets(nullptr)
-//      {}
-//
-//      ~iterator() {}
-//
-//      //! Copy constructor.
-//      iterator(iterator const & it)
-//        : m_pNode(it.m_pNode)
-//        , m_bucketIndex(it.m_bucketIndex)
-//        , m_bucketCount(it.m_bucketCount)
-//        , m_pBuckets(it.m_pBuckets)
-//      {}
-//
-//      //! Assignment.
-//      iterator& operator= (iterator const & it)
-//      {
-//        m_pNode = it.m_pNode;
-//        m_bucketIndex = it.m_bucketIndex;
-//        m_bucketCount = it.m_bucketCount;
-//        m_pBuckets = it.m_pBuckets;
-//        return *this;
-//      }
-//
-//      //! Comparison.
-//      bool operator==(iterator const & it) const
-//      {
-//        return m_pNode == it.m_pNode
-//          && m_pBuckets == it.m_pBuckets;
-//      }
-//
-//      //! Comparison.
-//      bool operator!=(iterator const & it) const
-//      {
-//        return m_pNode != it.m_pNode
-//          || m_pBuckets != it.m_pBuckets;
-//      }
-//
-//      //! Post increment. Iterating past the last element in the OpenHashTable will result in 
-//      //! returning the OpenHashTable::End() iterator. Incrementing past the OpenHashTable::End() 
-//      //! iterator will do nothing. 
-//      iterator operator++(int)
-//      {
-//        iterator result(*this);
-//        ++(*this);
-//        return result;
-//      }
-//
-//      //! Pre increment. Iterating past the last element in the OpenHashTable will result in 
-//      //! returning the OpenHashTable::End() iterator. Incrementing past the OpenHashTable::End() 
-//      //! iterator will do nothing. 
-//      iterator & operator++()
-//      {
-//        if (!m_pNode)
-//        {
-//          return *this;
-//        }
-//
-//        if (m_pNode->pNext)
-//        {
-//          m_pNode = m_pNode->pNext;
-//          return *this;
-//        }
-//
-//        m_bucketIndex++;
-//        for (m_bucketIndex; m_bucketIndex < m_bucketCount; m_bucketIndex++)
-//        {
-//          if (m_pBuckets[m_bucketIndex].pBegin)
-//          {
-//            m_pNode = m_pBuckets[m_bucketIndex].pBegin;
-//            return *this;
-//          }
-//        }
-//
-//        //End
-//        m_bucketIndex = m_bucketCount - 1;
-//        m_pNode = nullptr;
-//        return *this;
-//      }
-//
-//      //! Post decrement. Decrementing the OpenHashTable::begin() iterator will result in returning the 
-//      //! OpenHashTable::End() iterator.
-//      iterator operator--(int)
-//      {
-//        iterator result(*this);
-//        --(*this);
-//        return result;
-//      }
-//
-//      //! Pre decrement. Decrementing the OpenHashTable::begin() iterator will result in returning the 
-//      //! OpenHashTable::End() iterator.
-//      iterator & operator--()
-//      {
-//        Node * curNode = m_pBuckets[m_bucketIndex].pBegin;
-//        while (curNode)
-//        {
-//          if (curNode->pNext == m_pNode)
-//          {
-//            m_pNode = curNode;
-//            return *this;
-//          }
-//          curNode = curNode->pNext;
-//        }
-//
-//        for (m_bucketIndex; m_bucketIndex-- > 0;)
-//        {
-//          Node * curNode = m_pBuckets[m_bucketIndex].pBegin;
-//          while (curNode)
-//          {
-//            if (!curNode->pNext)
-//            {
-//              m_pNode = curNode;
-//              return *this;
-//            }
-//            curNode = curNode->pNext;
-//          }
-//        }
-//
-//        //End
-//        m_pNode = nullptr;
-//        m_bucketIndex = m_bucketCount - 1;
-//        return *this;
-//      }
-//
-//      //! Conversion to const_iterator.
-//      operator const_iterator() const
-//      {
-//      return const_iterator(m_pNode
-//                          , m_bucketIndex
-//                          , m_bucketCount
-//                          , m_pBuckets);
-//      } 
-//
-//      //! Conversion
-//      T* operator->() const { return %m_pNode->data; }
-//
-//      //! Conversion
-//      T& operator*() const { return m_pNode->data ; }
-//
-//    private:
-//
-//      /// The 'End' iterator is denoted by:
-//      ///   m_pBuckets  = a valid pointer
-//      ///   m_pNode     = nullptr
-//
-//      size_t          m_bucketIndex;
-//      size_t          m_bucketCount;
-//      Bucket *        m_pBuckets;
-//      Node *          m_pNode;
-//    };
-//
-//
-//  public:
-//
-//    //! Default constructor.
-//    OpenHashTable()
-//      : ContainerBase()
-//      , m_pNodes(nullptr)
-//      , m_pBuckets(nullptr)
-//      , m_pNextFree(nullptr)
-//      , m_bucketCountIndex(s_invalidBucketIndex)
-//      , m_nItems(0)
-//      , m_fHasher(DefaultHasher)
-//      , m_maxLoadFactor(s_defaultLF)
-//    {
-//      Init(impl::validBucketCounts[0]);
-//    }
-//
-//    //! Constructor.
-//    //!
-//    //! @param[in] a_nBuckets Request the buckets to initialise the table with.
-//    //!                       The actual number will be from impl::validBucketCounts,
-//    //!                       and will be the value closest to but not below a_nBuckets.
-//    //! @param[in] a_hf       A custom hash function.
-//    OpenHashTable(size_t a_nBuckets, fHasher<K> * a_hf = DefaultHasher)
-//      : ContainerBase()
-//      , m_pNodes(nullptr)
-//      , m_pBuckets(nullptr)
-//      , m_pNextFree(nullptr)
-//      , m_bucketCountIndex(s_invalidBucketIndex)
-//      , m_nItems(0)
-//      , m_fHasher(a_hf)
-//      , m_maxLoadFactor(s_defaultLF)
-//    {
-//      Init(a_nBuckets);
-//    }
-//
-//    //! Destructor.
-//    ~OpenHashTable()
-//    {
-//      Wipe();
-//    }
-//
-//    //! Copy constructor.
-//    OpenHashTable(OpenHashTable const & a_other)
-//      : ContainerBase(a_other)
-//      , m_pNodes(nullptr)
-//      , m_pBuckets(nullptr)
-//      , m_pNextFree(nullptr)
-//      , m_bucketCountIndex(s_invalidBucketIndex)
-//      , m_nItems(0)
-//      , m_fHasher(DefaultHasher)
-//      , m_maxLoadFactor(s_defaultLF)
-//    {
-//      Init(a_other);
-//    }
-//
-//    //! Assignment.
-//    OpenHashTable & operator=(OpenHashTable const & a_other)
-//    {
-//      if (this != &a_other)
-//      {
-//        Wipe();
-//        ContainerBase::operator=(a_other);
-//        Init(a_other);
-//      }
-//      return *this;
-//    }
-//
-//    //! Copy move operator.
-//    OpenHashTable(OpenHashTable && a_other)
-//      : ContainerBase(a_other)
-//      , m_pNodes(a_other.m_pNodes)
-//      , m_pBuckets(a_other.m_pBuckets)
-//      , m_pNextFree(a_other.m_pNextFree)
-//      , m_bucketCountIndex(a_other.m_bucketCountIndex)
-//      , m_nItems(a_other.m_nItems)
-//      , m_fHasher(a_other.m_fHasher)
-//      , m_maxLoadFactor(a_other.m_maxLoadFactor)
-//    {
-//      PostMove(a_other);
-//    }
-//
-//    //! Assignment move operator.
-//    OpenHashTable & operator=(OpenHashTable && a_other)
-//    {
-//      if (this != &a_other)
-//      {
-//        Wipe();
-//
-//        ContainerBase::operator=(a_other);
-//        m_pNodes = a_other.m_pNodes;
-//        m_pBuckets = a_other.m_pBuckets;
-//        m_pNextFree = a_other.m_pNextFree;
-//        pool_size(a_other.pool_size());
-//        m_bucketCountIndex = a_other.m_bucketCountIndex;
-//        m_nItems = a_other.m_nItems;
-//        m_fHasher = a_other.m_fHasher;
-//        m_maxLoadFactor = a_other.m_maxLoadFactor;
-//
-//        PostMove(a_other);
-//      }
-//      return *this;
-//    }
-//
-//    //! Accessor. Returns element mapped to the key. Will insert element
-//    //! if the key is not present in the OpenHashTable.
-//    T & operator[](K key)
-//    {
-//      bool existed(false);
-//      Node * pNode(GetItem(key, existed));
-//      if (!existed)
-//      {
-//        new (&pNode->data) T();
-//      }
-//      return pNode->data;
-//    }
-//
-//    //! Get iterator to the first element of the OpenHashTable.
-//    //! Returns OpenHashTable::End() if the OpenHashTable is empty.
-//    iterator Begin()
-//    {
-//      for (size_t i = 0; i < BucketCount(); i++)
-//      {
-//        if (m_pBuckets[i].pBegin)
-//        {
-//          return iterator(m_pBuckets[i].pBegin, i, BucketCount(), m_pBuckets);
-//        }
-//      }
-//      return End();
-//    }
-//
-//    //! Get const_iterator to the first element of the OpenHashTable.
-//    //! Returns OpenHashTable::CEnd() if the OpenHashTable is empty.
-//    const_iterator CBegin() const
-//    {
-//      for (size_t i = 0; i < BucketCount(); i++)
-//      {
-//        if (m_pBuckets[i].pBegin)
-//        {
-//          return const_iterator(m_pBuckets[i].pBegin, i, BucketCount(), m_pBuckets);
-//        }
-//      }
-//      return CEnd();
-//    }
-//
-//    //! Get iterator to one past the last element in the OpenHashTable.
-//    iterator End()
-//    {
-//      return iterator(nullptr, BucketCount() - 1, BucketCount(), m_pBuckets);
-//    }
-//
-//    //! Get const_iterator to one past the last element in the OpenHashTable.
-//    const_iterator CEnd() const
-//    {
-//      return const_iterator(nullptr, BucketCount() - 1, BucketCount(), m_pBuckets);
-//    }
-//
-//    //! Returns a pointer to the element in the map which matches the key.
-//    //! Returns a nullptr if there is no match.
-//    T * At(K a_key)
-//    {
-//      size_t ind = m_fHasher(a_key);
-//      ind %= BucketCount();
-//
-//      Node * pItem = m_pBuckets[ind].pBegin;
-//      while (pItem)
-//      {
-//        if (pItem->key == a_key)  return &pItem->data;
-//        if (!pItem->pNext)        return nullptr;
-//        pItem = pItem->pNext;
-//      }
-//      return nullptr;
-//    }
-//
-//    //! Returns a pointer to the element in the map which matches the key.
-//    //! Returns a nullptr if there is no match.
-//    T const * At(K a_key) const
-//    {
-//      size_t ind = m_fHasher(a_key);
-//      ind %= BucketCount();
-//
-//      Node const * pItem = m_pBuckets[ind].pBegin;
-//      while (pItem)
-//      {
-//        if (pItem->key == a_key)  return &pItem->data;
-//        if (!pItem->pNext)        return nullptr;
-//        pItem = pItem->pNext;
-//      }
-//      return nullptr;
-//    }
-//
-//    //! Insert a mapped value into the OpenHashTable. This function will overwrite 
-//    //! any existing element mapped to this key.
-//    //!
-//    //! @return Pointer to the newly inserted element.
-//    T * Insert(K key, T const & val)
-//    {
-//      bool existed(false);
-//      Node * pNode(GetItem(key, existed));
-//
-//      pNode->data.~T();
-//      new (&pNode->data) T(val);
-//
-//      return &pNode->data;
-//    }
-//
-//    //! Insert a mapped value into the OpenHashTable. This function will NOT overwrite 
-//    //! any existing element mapped to this key.
-//    //!
-//    //! @return Pointer to eith  the newly inserted element, or existing.
-//    T * InsertNoOverwrite(K key, T const & val)
-//    {
-//      bool existed(false);
-//      Node * pNode(GetItem(key, existed));
-//      if (!existed)
-//      {
-//        new (&pNode->data) T(val);
-//      }
-//      return &pNode->data;
-//    }
-//
-//    //! Clear all elements. For non-pod HashTables, this function will call
-//    //! destructors of all current element items in the OpenHashTable. For pod types,
-//    //! essentially, the item counts are set to 0.
-//    void Clear()
-//    {
-//      iterator it = begin();
-//      for (it; it != End(); ++it)
-//      {
-//        *it.~T();
-//      }
-//
-//      for (size_t i = 0; i < pool_size() - 1; i++)
-//      {
-//        m_pNodes[i].pNext = &m_pNodes[i + 1];
-//      }
-//      m_pNodes[pool_size() - 1].pNext - nullptr;
-//      memset(m_pBuckets, 0, BucketCount() * sizeof(Bucket));
-//      m_nItems = 0;
-//    }
-//
-//    //! Is the OpenHashTable empty?
-//    bool Empty() const
-//    {
-//      return m_nItems == 0;
-//    }
-//
-//    //! Returns the current load factor in the unordered_map container.
-//    //!
-//    //! The load factor is the ratio between the number of elements in the 
-//    //! container(its size) and the number of buckets(BucketCount) :
-//    //!
-//    //!     load_factor = size / BucketCount
-//    //!
-//    //! The load factor influences the probability of collision in the OpenHashTable
-//    //! (i.e., the probability of two elements being located in the same bucket).
-//    //!
-//    //! The container automatically increases the number of buckets to keep the 
-//    //! load factor below a specific threshold(its max_load_factor), causing a 
-//    //! rehash each time an expansion is needed.
-//    //!
-//    //! To retrieve or change this threshold, use member function max_load_factor.
-//    float LoadFactor()
-//    {
-//      return static_cast<float>(m_nItems) / m_bucketCountIndex;
-//    }
-//
-//    //! Returns the current maximum load factor for the OpenHashTable container.
-//    //!
-//    //! The load factor is the ratio between the number of elements in the 
-//    //! container(its size) and the number of buckets(BucketCount) :
-//    //!
-//    //!     load_factor = size / BucketCount
-//    //!
-//    //! The load factor influences the probability of collision in the OpenHashTable
-//    //! (i.e., the probability of two elements being located in the same bucket).
-//    //!
-//    //! The container automatically increases the number of buckets to keep the 
-//    //! load factor below a specific threshold(its max_load_factor), causing a 
-//    //! rehash each time an expansion is needed.
-//    float MaxLoadFactor()
-//    {
-//      return m_maxLoadFactor;
-//    }
-//
-//    //! Set the maximum load factor for the OpenHashTable container. There is a minimum 
-//    //! load factor: OpenHashTable::s_minSetLF
-//    //!
-//    //! The load factor is the ratio between the number of elements in the 
-//    //! container(its size) and the number of buckets(BucketCount) :
-//    //!
-//    //!     load_factor = size / BucketCount
-//    //!
-//    //! The load factor influences the probability of collision in the OpenHashTable
-//    //! (i.e., the probability of two elements being located in the same bucket).
-//    //!
-//    //! The container automatically increases the number of buckets to keep the 
-//    //! load factor below a specific threshold(its max_load_factor), causing a 
-//    //! rehash each time an expansion is needed.
-//    void MaxLoadFactor(float a_val)
-//    {
-//      float prevLF = m_maxLoadFactor;
-//      m_maxLoadFactor = (a_val > s_minSetLF) ? a_val : s_minSetLF;
-//      if (prevLF < m_maxLoadFactor)
-//      {
-//        __Rehash();
-//      }
-//    }
-//
-//    //! Returns the maximum number of buckets that the unordered_map container can have.
-//    //!
-//    //! This is the maximum potential number of buckets the container can have due to 
-//    //! system constraints or limitations on its library implementation.
-//    size_t MaxBucketCount() const
-//    {
-//      impl::validBucketCounts[ARRAY_SIZE(impl::validBucketCounts) - 1];
-//    }
-//
-//    //! Returns the maximum number of elements that the unordered_map container can have.
-//    //!
-//    //! This is the maximum potential number of elements the container can have due to 
-//    //! system constraints or limitations on its library implementation.
-//    size_t MaxSize() const
-//    {
-//      return 0xFFFFFFFFFFFFFFFFLL / sizeof(T);
-//    }
-//
-//    //! Sets the number of buckets in the container to a_bucketCount or more.
-//    //!
-//    //! If a_bucketCount is greater than the current number of buckets in the 
-//    //! container(BucketCount), a rehash is forced. The new bucket count can 
-//    //! either be equal or greater than a_bucketCount.
-//    //!
-//    //! If a_bucketCount is lower than the current number of buckets in the 
-//    //! container(BucketCount), the function may have no effect on the bucket 
-//    //! count and may not force a rehash.
-//    //!
-//    //! A rehash is the reconstruction of the hash table : All the elements in 
-//    //! the container are rearranged according to their hash value into the new 
-//    //! set of buckets.This may alter the order of iteration of elements within 
-//    //! the container.
-//    //!
-//    //! Rehashes are automatically performed by the container whenever its load 
-//    //! factor is going to surpass its max_load_factor in an operation.
-//    void Rehash(size_t a_bucketCount)
-//    {
-//      float newLF = static_cast<float>(m_nItems) / static_cast<float>(a_bucketCount);
-//      if (newLF < m_maxLoadFactor)
-//      {
-//        __Rehash();
-//      }
-//    }
-//
-//    //! Request a capacity change.
-//    //! Sets the number of buckets in the container(BucketCount) to the most 
-//    //! appropriate to contain at least a_num elements. The memory block reserved
-//    //! for elements will also be extended to contain a_num elements.
-//    //!
-//    //! If a_num is greater than the current BucketCount multiplied by the max_load_factor, 
-//    //! the container's BucketCount is increased and a rehash is forced.
-//    //!
-//    //! If n is lower than that, the function may have no effect.
-//    void Reserve(size_t a_num)
-//    {
-//      size_t bucketCount = static_cast<size_t>(static_cast<float>(a_num) / m_maxLoadFactor);
-//      if (bucketCount > BucketCount())
-//      {
-//        __Rehash(bucketCount);
-//      }
-//      if (a_num > pool_size())
-//      {
-//        ExtendPool(a_num);
-//      }
-//    }
-//
-//    //! Removes from the OpenHashTable container a single element.
-//    //!
-//    //! This effectively reduces the container size by 1.
-//    //!
-//    //! If not a POD, the element's destructor is called.
-//    iterator Erase(iterator const & a_it)
-//    {
-//    }
-//
-//    //! Removes from the OpenHashTable container a single element.
-//    //!
-//    //! This effectively reduces the container size by 1.
-//    //!
-//    //! If not a POD, the element's destructor is called.
-//    void Erase(K a_key)
-//    {
-//      size_t ind(m_fHasher(a_key));
-//      ind %= BucketCount();
-//
-//      Node * pItem(m_pBuckets[ind].pBegin);
-//      Node * pPrev(nullptr);
-//
-//      while (pItem)
-//      {
-//        if (pItem->key == a_key)
-//        {
-//          pItem->data.~T();
-//          pItem->key.~K();
-//
-//          if (pPrev)
-//          {
-//            pPrev->pNext = pItem->pNext;
-//          }
-//          else
-//          {
-//            m_pBuckets[ind].pBegin = nullptr;
-//          }
-//          pItem->pNext = m_pNextFree;
-//          m_pNextFree = pItem;
-//          m_nItems--;
-//          break;
-//        }
-//        if (!pItem->pNext) break;
-//        pPrev = pItem;
-//        pItem = pItem->pNext;
-//      }
-//    }
-//
-//    //! Returns the number of elements in the OpenHashTable.
-//    size_t Size() const 
-//    {
-//      return m_nItems;
-//    }
-//
-//    //! Returns the number of buckets in the OpenHashTable.
-//    size_t BucketCount() const
-//    {
-//      if (m_bucketCountIndex < 0)
-//      {
-//        return 0;
-//      }
-//      return impl::validBucketCounts[m_bucketCountIndex];
-//    }
-//
-//    //! For debugging. The OpenHashTable operates over a fixed memory block.
-//    //! The memory is essentially a linked list, with elements drawn from the
-//    //! list when items are inserted into the OpenHashTable. This function returns the
-//    //! total number of used and unused elements in the linked list compared to the 
-//    //! size of the memory block. 
-//    size_t PoolSlotsWasted()
-//    {
-//      size_t total(0);
-//
-//      for (size_t i = 0; i < BucketCount(); i++)
-//      {
-//        Node * n = m_pBuckets[i].pBegin;
-//        while (n)
-//        {
-//          total++;
-//          n = n->pNext;
-//        }
-//      }
-//
-//      Node * n = m_pNextFree;
-//      while (n)
-//      {
-//        total++;
-//        n = n->pNext;
-//      }
-//
-//      return pool_size() - total;
-//    }
-//
-//#ifdef DGHASHTABLE_ENABLE_OUTPUT
-//    //! Output the OpenHashTable for debugging.
-//    friend std::ostream & operator<<(std::ostream & os
-//                                   , OpenHashTable<K, T> const & ht) 
-//    {
-//      for (size_t i = 0; i < ht.BucketCount(); i++)
-//      {
-//        os << i << ": ";
-//        Node * n = ht.m_pBuckets[i].pBegin;
-//        while (n)
-//        {
-//          os << n->key;
-//          if (n->pNext)
-//          {
-//            os << ", ";
-//          }
-//          n = n->pNext;
-//        }
-//        os << '\n';
-//      }
-//      return os;
-//    }
-//#endif
-//
-//  private:
-//
-//    //! Force a rehash.
-//    void __Rehash(size_t a_bucketCount)
-//    {
-//      int newBucketCountIndex = GetBucketCountIndex(a_bucketCount);
-//      size_t newBucketCount = impl::validBucketCounts[newBucketCountIndex];
-//      Bucket * newBuckets = static_cast<Bucket*>(calloc(newBucketCount, sizeof(Bucket*)));
-//      DG_ASSERT(newBuckets != nullptr);
-//      for (size_t bucket = 0; bucket < BucketCount(); bucket++)
-//      {
-//        Node * in = m_pBuckets[bucket].pBegin;
-//        while (in)
-//        {
-//          Node * nextNode = in->pNext;
-//
-//          //Add new node in the new bucket list
-//          size_t ind = m_fHasher(in->key) % newBucketCount;
-//          Node * prev = newBuckets[ind].pBegin;
-//          if (!prev)
-//          {
-//            newBuckets[ind].pBegin = in;
-//          }
-//          else
-//          {
-//            while (prev->pNext) prev = prev->pNext;
-//            prev->pNext = in;
-//          }
-//          in->pNext = nullptr;
-//
-//          //Update iterator nodes
-//          in = nextNode;
-//        }
-//      }
-//
-//      //Assign new bucket list and bucket count
-//      free(m_pBuckets);
-//      m_pBuckets = newBuckets;
-//      m_bucketCountIndex = newBucketCountIndex;
-//    }
-//
-//    //! Extend the memory block reserved for elements (key, value).
-//    //! The order of nodes in the memory block wil NOT be changed.
-//    //! All indices to Nodes will remain valid.
-//    //!
-//    //! @param[in] a_num The memory block will be increased to hold at least this number.
-//    void ExtendPool(size_t a_num)
-//    {
-//      Node * pOldNodes = m_pNodes;
-//      size_t oldPoolSize = pool_size();
-//      pool_size(a_num);
-//      m_pNodes = static_cast<Node*>(realloc(m_pNodes, pool_size() * sizeof(Node)));
-//      DG_ASSERT(m_pNodes != nullptr);
-//      //Reset node pointers
-//      if (m_pNodes != pOldNodes)
-//      {
-//        for (size_t i = 0; i < BucketCount(); i++)
-//        {
-//          if (m_pBuckets[i].pBegin)
-//          {
-//            m_pBuckets[i].pBegin = &m_pNodes[m_pBuckets[i].pBegin - pOldNodes];
-//            Node * n(m_pBuckets[i].pBegin);
-//            while (n->pNext)
-//            {
-//              n->pNext = &m_pNodes[n->pNext - pOldNodes];
-//              n = n->pNext;
-//            }
-//          }
-//        }
-//
-//        //Reset pointer to next free
-//        m_pNextFree = &m_pNodes[m_pNextFree - pOldNodes];
-//
-//        //Build list of free nodes
-//        Node * cur = m_pNextFree;
-//        while (cur->pNext)
-//        {
-//          cur->pNext = &m_pNodes[cur->pNext - pOldNodes];
-//          cur = cur->pNext;
-//        }
-//      }
-//
-//      //Get the tail of the free elements
-//      Node * freeTail = m_pNextFree;
-//      while (freeTail->pNext)
-//      {
-//        freeTail = freeTail->pNext;
-//      }
-//
-//      for (size_t i = oldPoolSize; i < pool_size(); i++)
-//      {
-//        freeTail->pNext = &m_pNodes[i];
-//        freeTail = freeTail->pNext;
-//      }
-//      m_pNodes[pool_size() - 1].pNext = nullptr;
-//    }
-//
-//    //! Returns true if had to rehash.
-//    bool RehashIfOver(size_t a_nItems)
-//    {
-//      float newLoadFactor = static_cast<float>(a_nItems) / BucketCount();
-//      if (newLoadFactor > m_maxLoadFactor)
-//      {
-//        if (m_bucketCountIndex != (ARRAY_SIZE(impl::validBucketCounts) - 1))
-//        {
-//          __Rehash(impl::validBucketCounts[m_bucketCountIndex + 1]);
-//          return true;
-//        }
-//      }
-//      return false;
-//    }
-//
-//    // Get the Node associated with the key, or create a new one if it
-//    //! is not in the map.
-//    Node * GetItem(K a_key, bool & a_existed)
-//    {
-//      size_t ind = m_fHasher(a_key);
-//      ind %= BucketCount();
-//
-//      //This will be the first item in this bucket.
-//      Node * pResult = m_pBuckets[ind].pBegin;
-//      if (pResult == nullptr)
-//      {
-//        //If we rehash, we need to start this function again.
-//        if (RehashIfOver(m_nItems + 1))
-//        {
-//          return GetItem(a_key, a_existed);
-//        }
-//        m_pBuckets[ind].pBegin = GetNewNode(a_key);
-//        pResult = m_pBuckets[ind].pBegin;
-//        a_existed = false;
-//        return pResult;
-//      }
-//
-//      //There are other items as well as this in the bucket
-//      while (true)
-//      {
-//        if (pResult->key == a_key)
-//        {
-//          a_existed = true;
-//          return pResult;
-//        }
-//        if (!pResult->pNext) break;
-//        pResult = pResult->pNext;
-//      }
-//
-//      //Item does not exist
-//      //If we rehash, we need to start this function again.
-//      if (RehashIfOver(m_nItems + 1))
-//      {
-//        return GetItem(a_key, a_existed);
-//      }
-//      pResult = GetNewNode(pResult, a_key);
-//      a_existed = false;
-//      return pResult;
-//    }
-//
-//    // Zero all members we have moved from.
-//    void PostMove(OpenHashTable & a_other)
-//    {
-//      a_other.m_pNodes = nullptr;
-//      a_other.pool_size(0);
-//      a_other.m_pNextFree = nullptr;
-//      a_other.m_pBuckets = nullptr;
-//      a_other.m_bucketCountIndex = s_invalidBucketIndex;
-//      a_other.m_nItems = 0;
-//    }
-//
-//    //! Returns the index to the first valid bucket count index greater than 
-//    //! a_bucketCount. Valid bucket counts are taken from impl::validBucketCounts.
-//    int GetBucketCountIndex(size_t a_bucketCount)
-//    {
-//      int result = ARRAY_SIZE(impl::validBucketCounts) - 1;
-//      for (int i = 0; i < ARRAY_SIZE(impl::validBucketCounts); i++)
-//      {
-//        if (a_bucketCount <= impl::validBucketCounts[i])
-//        {
-//          result = i;
-//          break;
-//        }
-//      }
-//      return result;
-//    }
-//
-//    // Init the HashTabe.
-//    void Init(size_t a_nBuckets)
-//    {
-//      //Update values
-//      m_bucketCountIndex = GetBucketCountIndex(a_nBuckets);
-//      m_nItems = 0;
-//
-//      InitArrays();
-//    }
-//
-//    //! Prep method for moving, assigning or deleting. Clears all memory, sets pointers to null,
-//    //! Calls destructors if not POD.
-//    void Wipe()
-//    {
-//      //Delete current items
-//      iterator it = Begin();
-//      for (it; it != End(); it++)
-//      {
-//        it.m_pNode->data.~T();
-//        it.m_pNode->key.~K();
-//      }
-//
-//      free(m_pNodes); m_pNodes = nullptr;
-//      free(m_pBuckets); m_pBuckets = nullptr;
-//      m_pNextFree = nullptr;
-//
-//      //pool_size() = 0;
-//      m_bucketCountIndex = s_invalidBucketIndex;
-//      m_nItems = 0;
-//    }
-//
-//    // Initialise all arrays based on current member values.
-//    void InitArrays()
-//    {
-//      //Update bucket pool
-//      if (pool_size() > 0)
-//      {
-//        m_pNodes = static_cast<Node*>(malloc(pool_size() * sizeof(Node)));
-//        DG_ASSERT(m_pNodes != nullptr);
-//        for (size_t i = 0; i < pool_size() - 1; i++)
-//        {
-//          m_pNodes[i].pNext = &m_pNodes[i + 1];
-//        }
-//        m_pNodes[pool_size() - 1].pNext = nullptr;
-//      }
-//      else
-//      {
-//        m_pNodes = nullptr;
-//      }
-//
-//      //Create a new hash table
-//      if (BucketCount() > 0)
-//      {
-//        m_pBuckets = static_cast<Bucket*>(calloc(BucketCount(), sizeof(Bucket)));
-//        DG_ASSERT(m_pBuckets != nullptr);
-//        //Flag the next free bucket
-//        m_pNextFree = &m_pNodes[0];
-//      }
-//      else
-//      {
-//        m_pBuckets = nullptr;
-//        m_pNextFree = nullptr;
-//      }
-//    }
-//
-//    // Get a new node form the list of unused elements.
-//    Node * GetNewNode(K a_key)
-//    {
-//      if (m_pNextFree->pNext == nullptr)
-//      {
-//        ExtendPool(pool_size() + 1);
-//      }
-//
-//      Node * pResult = m_pNextFree;
-//      m_pNextFree = m_pNextFree->pNext;
-//      pResult->pNext = nullptr;
-//      m_nItems++;
-//
-//      new (&(pResult->key)) K(a_key);
-//
-//      return pResult;
-//    }
-//
-//    // Get a new node form the list of unused elements. Places it as the 
-//    // next node to pNode.
-//    Node * GetNewNode(Node * pNode, K a_key)
-//    {
-//      if (m_pNextFree->pNext == nullptr)
-//      {
-//        //The pNode may become invalid once we extend, but it's
-//        //index will not.
-//        size_t nodeInd = pNode - m_pNodes;
-//        ExtendPool(pool_size() + 1);
-//        pNode = &m_pNodes[nodeInd];
-//      }
-//
-//      Node * pResult = m_pNextFree;
-//      m_pNextFree = m_pNextFree->pNext;
-//      pNode->pNext = pResult;
-//      pResult->pNext = nullptr;
-//      m_nItems++;
-//
-//      new (&(pResult->key)) K(a_key);
-//
-//      return pResult;
-//    }
-//
-//    // Initialise a zeroed OpenHashTable from other.
-//    void Init(OpenHashTable const & a_other)
-//    {
-//      //Assign values
-//      m_maxLoadFactor = a_other.m_maxLoadFactor;
-//      m_fHasher = a_other.m_fHasher;
-//      pool_size(a_other.pool_size());
-//      m_bucketCountIndex = a_other.m_bucketCountIndex;
-//
-//      InitArrays();
-//
-//      if (!m_pBuckets || !m_pNodes)
-//      {
-//        return;
-//      }
-//
-//      //Copy in from other
-//      for (size_t bi = 0; bi < a_other.BucketCount(); bi++)
-//      {
-//        Node const * that_node(a_other.m_pBuckets[bi].pBegin);
-//        if (that_node)
-//        {
-//          m_pBuckets[bi].pBegin = GetNewNode(that_node->key);
-//          Node * this_node(m_pBuckets[bi].pBegin);
-//          do
-//          {
-//            new(&this_node->data) T(that_node->data);
-//
-//            that_node = that_node->pNext;
-//
-//            if (that_node)
-//            {
-//              this_node = GetNewNode(this_node, that_node->key);
-//            }
-//            else
-//            {
-//              break;
-//            }
-//
-//          } while (true);
-//        }
-//      }
-//    }
-//
-//  private:
-//
-//    float       m_maxLoadFactor;
-//    fHasher<K>  m_fHasher;
-//
-//    Node *      m_pNodes;
-//    Node *      m_pNextFree;
-//
-//    Bucket *    m_pBuckets;
-//    int         m_bucketCountIndex; //Index to impl::validBucketCounts
-//    size_t      m_nItems;           //Number of curent elements
-//  };
-//
-//  template<typename K, typename T>
-//  float  const OpenHashTable<K, T>::s_defaultLF = 1.0f;
-//
-//  template<typename K, typename T>
-//  float  const OpenHashTable<K, T>::s_minSetLF = 0.5f;
-//
-//  template<typename K, typename T>
-//  size_t const OpenHashTable<K, T>::s_minPoolSize = 1;
-//
-//  template<typename K, typename T>
-//  int const OpenHashTable<K, T>::s_invalidBucketIndex = -1;
-//
-//}
-//
-//#endif
\ No newline at end of file
+//! @file DgOpenHashTable.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: OpenHashTable
+
+#ifndef DGOPENHASHTABLE_H
+#define DGOPENHASHTABLE_H
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <functional>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DG_OPENHASHTABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "DgPair.h"
+#include "impl/DgBitOps.h"
+
+namespace Dg
+{
+  //! @ingroup DgContainers_functions
+  //!
+  //! The default hasher. The table scrambles the result before use, so
+  //! hashers that return the key unchanged (as std::hash does for integers
+  //! on some platforms) are fine.
+  template<typename K>
+  struct Hash
+  {
+    size_t operator()(K const & a_key) const
+    {
+      return std::hash<K>()(a_key);
+    }
+  };
+
+  namespace impl
+  {
+    //! Offset from a_pDist to the first non-zero probe distance, scanning
+    //! 16 bytes at a time. The scan must be guaranteed to hit a non-zero value
+    //! within the allocation, plus 15 bytes of padding.
+    inline size_t NextOccupied(uint8_t const * a_pDist)
+    {
+      size_t offset = 0;
+#ifdef DG_OPENHASHTABLE_SSE2
+      __m128i const zero = _mm_setzero_si128();
+      while (true)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a_pDist + offset));
+        uint32_t empty = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+        uint32_t occupied = ~empty & 0xFFFFu;
+        if (occupied != 0)
+          return offset + CountTrailingZeros(occupied);
+        offset += 16;
+      }
+#else
+      while (a_pDist[offset] == 0)
+        offset++;
+      return offset;
+#endif
+    }
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! Open addressing hash map using Robin Hood hashing.
+  //!
+  //! Elements live directly in a flat slot array. Alongside each slot is a
+  //! byte holding its probe distance plus one (0 marks an empty slot). On
+  //! insert, elements that are closer to their home bucket give up their slot
+  //! to the new element, which keeps probe sequences short and sorted by home
+  //! bucket. Erasing shifts the following elements back one slot, so no
+  //! tombstones are ever left behind.
+  //!
+  //! Bucket counts are powers of two. The table does not wrap around; it
+  //! instead keeps a few overflow slots at the end. If a probe sequence would
+  //! run past the overflow slots, the table grows.
+  //!
+  //! Iterators and references are invalidated by insert and erase.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename K, typename V, typename Hasher = Hash<K>>
+  class OpenHashTable
+  {
+  public:
+
+    typedef Pair<K const, V> ValueType;
+
+  private:
+
+    typedef size_t    sizeType;
+    typedef uint8_t   distType;
+
+    static sizeType const s_minBucketCount = 16;
+    static sizeType const s_maxOverflow    = 255;
+    static sizeType const s_padding        = 16;
+    static sizeType const s_npos           = ~static_cast<sizeType>(0);
+
+  public:
+
+    //Iterates through the table in slot order.
+    class const_iterator
+    {
+      friend class OpenHashTable;
+      friend class iterator;
+
+    private:
+
+      const_iterator(distType const * a_pDist, ValueType const * a_pKV);
+
+    public:
+
+      const_iterator();
+      ~const_iterator();
+
+      const_iterator(const_iterator const & a_it);
+      const_iterator& operator=(const_iterator const & a_other);
+
+      bool operator==(const_iterator const & a_it) const;
+      bool operator!=(const_iterator const & a_it) const;
+
+      const_iterator& operator++();
+      const_iterator operator++(int);
+
+      ValueType const * operator->() const;
+      ValueType const & operator*() const;
+
+    private:
+      distType const *   m_pDist;
+      ValueType const *  m_pKV;
+    };
+
+    //Iterates through the table in slot order.
+    class iterator
+    {
+      friend class OpenHashTable;
+
+    private:
+
+      iterator(distType const * a_pDist, ValueType * a_pKV);
+
+    public:
+
+      iterator();
+      ~iterator();
+
+      iterator(iterator const & a_it);
+      iterator& operator=(iterator const & a_other);
+
+      bool operator==(iterator const & a_it) const;
+      bool operator!=(iterator const & a_it) const;
+
+      iterator& operator++();
+      iterator operator++(int);
+
+      operator const_iterator() const;
+
+      ValueType * operator->();
+      ValueType & operator*();
+
+    private:
+      distType const *   m_pDist;
+      ValueType *        m_pKV;
+    };
+
+  public:
+
+    OpenHashTable();
+
+    //Creates a table that can hold a_nItems without growing.
+    OpenHashTable(sizeType a_nItems);
+    ~OpenHashTable();
+
+    OpenHashTable(OpenHashTable const &);
+    OpenHashTable & operator=(OpenHashTable const &);
+
+    OpenHashTable(OpenHashTable &&);
+    OpenHashTable & operator=(OpenHashTable &&);
+
+    sizeType size() const;
+    bool empty() const;
+    sizeType bucket_count() const;
+    float load_factor() const;
+
+    //Grows the table so a_nItems can be held without rehashing.
+    void reserve(sizeType a_nItems);
+
+    iterator begin();
+    iterator end();
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+
+    //If the key already exists in the table, an iterator to the
+    //existing element is returned and a_data is discarded.
+    iterator insert(K const & a_key, V const & a_data);
+
+    void erase(K const &);
+
+    //Returns an iterator to the element that follows the element removed
+    //(or end(), if the last element was removed).
+    iterator erase(iterator);
+
+    //Searches the container for an element with a key equivalent to a_key and returns
+    //a handle to it if found, otherwise it returns an iterator to end().
+    const_iterator find(K const &) const;
+
+    //Searches the container for an element with a key equivalent to a_key and returns
+    //a handle to it if found, otherwise it returns an iterator to end().
+    iterator find(K const &);
+
+    //If k matches the key of an element in the container, the function returns
+    //a reference to its mapped value.
+    //If k does not match the key of any element in the container, the function
+    //inserts a new element with that key and returns a reference to its mapped value.
+    V & operator[](K const &);
+
+    //Returns a reference to the mapped value of the element identified with key k.
+    //If k does not match the key of any element in the container, the function
+    //throws an out_of_range exception.
+    V & at(K const &);
+
+    //Returns a reference to the mapped value of the element identified with key k.
+    //If k does not match the key of any element in the container, the function
+    //throws an out_of_range exception.
+    V const & at(K const &) const;
+
+    void clear();
+
+  private:
+
+    void DestructAll();
+    void Release();
+    void Allocate(sizeType a_nBuckets);
+    void Init(OpenHashTable const &);
+    void Rehash(sizeType a_nBuckets);
+
+    static sizeType BucketsFor(sizeType a_nItems);
+    sizeType MaxLoad() const;
+    sizeType HomeBucket(K const &) const;
+
+    //Returns the slot index of the key, or s_npos.
+    sizeType Find(K const &) const;
+
+    //Shifts elements to open a slot for a new key, growing the table
+    //if needed. The returned slot is left unconstructed.
+    sizeType MakeRoom(K const &);
+
+    //Returns true if a slot could be opened without growing.
+    bool TryMakeRoom(K const &, sizeType & a_out);
+
+    void EraseAt(sizeType);
+
+  private:
+
+    distType *    m_pDist;
+    ValueType *   m_pKVs;
+    sizeType      m_nBuckets;
+    sizeType      m_nSlots;
+    sizeType      m_nItems;
+    int           m_shift;
+    Hasher        m_hasher;
+  };
+
+  //------------------------------------------------------------------------------------------------
+  // const_iterator
+  //------------------------------------------------------------------------------------------------
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::const_iterator::const_iterator(distType const * a_pDist,
+                                                              ValueType const * a_pKV)
+    : m_pDist(a_pDist)
+    , m_pKV(a_pKV)
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::const_iterator::const_iterator()
+    : m_pDist(nullptr)
+    , m_pKV(nullptr)
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::const_iterator::~const_iterator()
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::const_iterator::const_iterator(const_iterator const & a_it)
+    : m_pDist(a_it.m_pDist)
+    , m_pKV(a_it.m_pKV)
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::const_iterator &
+    OpenHashTable<K, V, Hasher>::const_iterator::operator=(const_iterator const & a_it)
+  {
+    m_pDist = a_it.m_pDist;
+    m_pKV = a_it.m_pKV;
+    return *this;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  bool OpenHashTable<K, V, Hasher>::const_iterator::operator==(const_iterator const & a_it) const
+  {
+    return m_pDist == a_it.m_pDist;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  bool OpenHashTable<K, V, Hasher>::const_iterator::operator!=(const_iterator const & a_it) const
+  {
+    return m_pDist != a_it.m_pDist;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::const_iterator &
+    OpenHashTable<K, V, Hasher>::const_iterator::operator++()
+  {
+    sizeType offset = 1 + impl::NextOccupied(m_pDist + 1);
+    m_pDist += offset;
+    m_pKV += offset;
+    return *this;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::const_iterator
+    OpenHashTable<K, V, Hasher>::const_iterator::operator++(int)
+  {
+    const_iterator result(*this);
+    ++(*this);
+    return result;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::ValueType const *
+    OpenHashTable<K, V, Hasher>::const_iterator::operator->() const
+  {
+    return m_pKV;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::ValueType const &
+    OpenHashTable<K, V, Hasher>::const_iterator::operator*() const
+  {
+    return *m_pKV;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  // iterator
+  //------------------------------------------------------------------------------------------------
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::iterator::iterator(distType const * a_pDist, ValueType * a_pKV)
+    : m_pDist(a_pDist)
+    , m_pKV(a_pKV)
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::iterator::iterator()
+    : m_pDist(nullptr)
+    , m_pKV(nullptr)
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::iterator::~iterator()
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::iterator::iterator(iterator const & a_it)
+    : m_pDist(a_it.m_pDist)
+    , m_pKV(a_it.m_pKV)
+  {
+
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::iterator &
+    OpenHashTable<K, V, Hasher>::iterator::operator=(iterator const & a_it)
+  {
+    m_pDist = a_it.m_pDist;
+    m_pKV = a_it.m_pKV;
+    return *this;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  bool OpenHashTable<K, V, Hasher>::iterator::operator==(iterator const & a_it) const
+  {
+    return m_pDist == a_it.m_pDist;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  bool OpenHashTable<K, V, Hasher>::iterator::operator!=(iterator const & a_it) const
+  {
+    return m_pDist != a_it.m_pDist;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::iterator &
+    OpenHashTable<K, V, Hasher>::iterator::operator++()
+  {
+    sizeType offset = 1 + impl::NextOccupied(m_pDist + 1);
+    m_pDist += offset;
+    m_pKV += offset;
+    return *this;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::iterator
+    OpenHashTable<K, V, Hasher>::iterator::operator++(int)
+  {
+    iterator result(*this);
+    ++(*this);
+    return result;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::iterator::operator
+    typename OpenHashTable<K, V, Hasher>::const_iterator() const
+  {
+    return const_iterator(m_pDist, m_pKV);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::ValueType *
+    OpenHashTable<K, V, Hasher>::iterator::operator->()
+  {
+    return m_pKV;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::ValueType &
+    OpenHashTable<K, V, Hasher>::iterator::operator*()
+  {
+    return *m_pKV;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  // OpenHashTable
+  //------------------------------------------------------------------------------------------------
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::OpenHashTable()
+    : m_pDist(nullptr)
+    , m_pKVs(nullptr)
+    , m_nBuckets(0)
+    , m_nSlots(0)
+    , m_nItems(0)
+    , m_shift(0)
+    , m_hasher()
+  {
+    Allocate(s_minBucketCount);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::OpenHashTable(sizeType a_nItems)
+    : m_pDist(nullptr)
+    , m_pKVs(nullptr)
+    , m_nBuckets(0)
+    , m_nSlots(0)
+    , m_nItems(0)
+    , m_shift(0)
+    , m_hasher()
+  {
+    Allocate(BucketsFor(a_nItems));
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::~OpenHashTable()
+  {
+    DestructAll();
+    Release();
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::OpenHashTable(OpenHashTable const & a_other)
+    : m_pDist(nullptr)
+    , m_pKVs(nullptr)
+    , m_nBuckets(0)
+    , m_nSlots(0)
+    , m_nItems(0)
+    , m_shift(0)
+    , m_hasher(a_other.m_hasher)
+  {
+    Init(a_other);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher> &
+    OpenHashTable<K, V, Hasher>::operator=(OpenHashTable const & a_other)
+  {
+    if (this != &a_other)
+    {
+      DestructAll();
+      Release();
+      m_hasher = a_other.m_hasher;
+      Init(a_other);
+    }
+    return *this;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher>::OpenHashTable(OpenHashTable && a_other)
+    : m_pDist(a_other.m_pDist)
+    , m_pKVs(a_other.m_pKVs)
+    , m_nBuckets(a_other.m_nBuckets)
+    , m_nSlots(a_other.m_nSlots)
+    , m_nItems(a_other.m_nItems)
+    , m_shift(a_other.m_shift)
+    , m_hasher(std::move(a_other.m_hasher))
+  {
+    a_other.m_pDist = nullptr;
+    a_other.m_pKVs = nullptr;
+    a_other.m_nBuckets = 0;
+    a_other.m_nSlots = 0;
+    a_other.m_nItems = 0;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  OpenHashTable<K, V, Hasher> &
+    OpenHashTable<K, V, Hasher>::operator=(OpenHashTable && a_other)
+  {
+    if (this != &a_other)
+    {
+      DestructAll();
+      Release();
+
+      m_pDist = a_other.m_pDist;
+      m_pKVs = a_other.m_pKVs;
+      m_nBuckets = a_other.m_nBuckets;
+      m_nSlots = a_other.m_nSlots;
+      m_nItems = a_other.m_nItems;
+      m_shift = a_other.m_shift;
+      m_hasher = std::move(a_other.m_hasher);
+
+      a_other.m_pDist = nullptr;
+      a_other.m_pKVs = nullptr;
+      a_other.m_nBuckets = 0;
+      a_other.m_nSlots = 0;
+      a_other.m_nItems = 0;
+    }
+    return *this;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::sizeType
+    OpenHashTable<K, V, Hasher>::size() const
+  {
+    return m_nItems;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  bool OpenHashTable<K, V, Hasher>::empty() const
+  {
+    return m_nItems == 0;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::sizeType
+    OpenHashTable<K, V, Hasher>::bucket_count() const
+  {
+    return m_nBuckets;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  float OpenHashTable<K, V, Hasher>::load_factor() const
+  {
+    return static_cast<float>(m_nItems) / static_cast<float>(m_nBuckets);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::reserve(sizeType a_nItems)
+  {
+    sizeType nBuckets = BucketsFor(a_nItems);
+    if (nBuckets > m_nBuckets)
+      Rehash(nBuckets);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::iterator
+    OpenHashTable<K, V, Hasher>::begin()
+  {
+    sizeType ind = impl::NextOccupied(m_pDist);
+    return iterator(m_pDist + ind, m_pKVs + ind);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::iterator
+    OpenHashTable<K, V, Hasher>::end()
+  {
+    return iterator(m_pDist + m_nSlots, m_pKVs + m_nSlots);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::const_iterator
+    OpenHashTable<K, V, Hasher>::cbegin() const
+  {
+    sizeType ind = impl::NextOccupied(m_pDist);
+    return const_iterator(m_pDist + ind, m_pKVs + ind);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::const_iterator
+    OpenHashTable<K, V, Hasher>::cend() const
+  {
+    return const_iterator(m_pDist + m_nSlots, m_pKVs + m_nSlots);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::iterator
+    OpenHashTable<K, V, Hasher>::insert(K const & a_key, V const & a_data)
+  {
+    sizeType ind = Find(a_key);
+    if (ind == s_npos)
+    {
+      if (m_nItems + 1 > MaxLoad())
+        Rehash(m_nBuckets * 2);
+
+      ind = MakeRoom(a_key);
+      new (&m_pKVs[ind]) ValueType{a_key, a_data};
+      m_nItems++;
+    }
+    return iterator(m_pDist + ind, m_pKVs + ind);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::erase(K const & a_key)
+  {
+    sizeType ind = Find(a_key);
+    if (ind != s_npos)
+      EraseAt(ind);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::iterator
+    OpenHashTable<K, V, Hasher>::erase(iterator a_it)
+  {
+    sizeType ind = a_it.m_pDist - m_pDist;
+    EraseAt(ind);
+
+    //The following element, if any, has been shifted into this slot.
+    ind += impl::NextOccupied(m_pDist + ind);
+    return iterator(m_pDist + ind, m_pKVs + ind);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::const_iterator
+    OpenHashTable<K, V, Hasher>::find(K const & a_key) const
+  {
+    sizeType ind = Find(a_key);
+    if (ind == s_npos)
+      return cend();
+    return const_iterator(m_pDist + ind, m_pKVs + ind);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::iterator
+    OpenHashTable<K, V, Hasher>::find(K const & a_key)
+  {
+    sizeType ind = Find(a_key);
+    if (ind == s_npos)
+      return end();
+    return iterator(m_pDist + ind, m_pKVs + ind);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  V & OpenHashTable<K, V, Hasher>::operator[](K const & a_key)
+  {
+    sizeType ind = Find(a_key);
+    if (ind != s_npos)
+      return m_pKVs[ind].second;
+    iterator it = insert(a_key, V());
+    return it->second;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  V & OpenHashTable<K, V, Hasher>::at(K const & a_key)
+  {
+    sizeType ind = Find(a_key);
+    if (ind == s_npos)
+      throw std::out_of_range("Invalid key!");
+    return m_pKVs[ind].second;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  V const & OpenHashTable<K, V, Hasher>::at(K const & a_key) const
+  {
+    sizeType ind = Find(a_key);
+    if (ind == s_npos)
+      throw std::out_of_range("Invalid key!");
+    return m_pKVs[ind].second;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::clear()
+  {
+    DestructAll();
+    memset(m_pDist, 0, m_nSlots * sizeof(distType));
+    m_nItems = 0;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::DestructAll()
+  {
+    for (sizeType i = 0; i < m_nSlots; i++)
+    {
+      if (m_pDist[i] != 0)
+        m_pKVs[i].~ValueType();
+    }
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::Release()
+  {
+    free(m_pDist);
+    free(m_pKVs);
+    m_pDist = nullptr;
+    m_pKVs = nullptr;
+    m_nBuckets = 0;
+    m_nSlots = 0;
+    m_nItems = 0;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::Allocate(sizeType a_nBuckets)
+  {
+    sizeType nOverflow = a_nBuckets < s_maxOverflow ? a_nBuckets : s_maxOverflow;
+
+    m_nBuckets = a_nBuckets;
+    m_nSlots = a_nBuckets + nOverflow;
+    m_nItems = 0;
+
+    m_shift = 64;
+    for (sizeType n = a_nBuckets; n > 1; n >>= 1)
+      m_shift--;
+
+    m_pDist = static_cast<distType*> (malloc((m_nSlots + s_padding) * sizeof(distType)));
+    if (m_pDist == nullptr)
+      throw std::bad_alloc();
+
+    m_pKVs = static_cast<ValueType*> (malloc(m_nSlots * sizeof(ValueType)));
+    if (m_pKVs == nullptr)
+      throw std::bad_alloc();
+
+    //The padding is marked as occupied so scans always stop at the end.
+    memset(m_pDist, 0, m_nSlots * sizeof(distType));
+    memset(m_pDist + m_nSlots, 1, s_padding * sizeof(distType));
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::Init(OpenHashTable const & a_other)
+  {
+    Allocate(a_other.m_nBuckets);
+    memcpy(m_pDist, a_other.m_pDist, m_nSlots * sizeof(distType));
+    for (sizeType i = 0; i < m_nSlots; i++)
+    {
+      if (m_pDist[i] != 0)
+        new (&m_pKVs[i]) ValueType(a_other.m_pKVs[i]);
+    }
+    m_nItems = a_other.m_nItems;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::Rehash(sizeType a_nBuckets)
+  {
+    distType * pOldDist = m_pDist;
+    ValueType * pOldKVs = m_pKVs;
+    sizeType nOldSlots = m_nSlots;
+    sizeType nItems = m_nItems;
+
+    m_pDist = nullptr;
+    m_pKVs = nullptr;
+    Allocate(a_nBuckets);
+    m_nItems = nItems;
+
+    for (sizeType i = 0; i < nOldSlots; i++)
+    {
+      if (pOldDist[i] != 0)
+      {
+        sizeType ind = MakeRoom(pOldKVs[i].first);
+        new (&m_pKVs[ind]) ValueType(std::move(pOldKVs[i]));
+        pOldKVs[i].~ValueType();
+      }
+    }
+
+    free(pOldDist);
+    free(pOldKVs);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::sizeType
+    OpenHashTable<K, V, Hasher>::BucketsFor(sizeType a_nItems)
+  {
+    sizeType nBuckets = s_minBucketCount;
+    while (nBuckets - nBuckets / 8 < a_nItems)
+      nBuckets *= 2;
+    return nBuckets;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::sizeType
+    OpenHashTable<K, V, Hasher>::MaxLoad() const
+  {
+    //Load factor of 7/8
+    return m_nBuckets - m_nBuckets / 8;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::sizeType
+    OpenHashTable<K, V, Hasher>::HomeBucket(K const & a_key) const
+  {
+    //Fibonacci hashing: take the high bits of the product so weak
+    //hashes still spread across the table.
+    uint64_t hash = static_cast<uint64_t>(m_hasher(a_key));
+    return static_cast<sizeType>((hash * 0x9E3779B97F4A7C15ull) >> m_shift);
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::sizeType
+    OpenHashTable<K, V, Hasher>::Find(K const & a_key) const
+  {
+    sizeType ind = HomeBucket(a_key);
+    distType dist = 1;
+
+    //Elements are sorted by home bucket, so we can stop as soon as we
+    //reach an element closer to home than we would be.
+    while (m_pDist[ind] >= dist)
+    {
+      if (m_pDist[ind] == dist && m_pKVs[ind].first == a_key)
+        return ind;
+      ind++;
+      dist++;
+    }
+    return s_npos;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  typename OpenHashTable<K, V, Hasher>::sizeType
+    OpenHashTable<K, V, Hasher>::MakeRoom(K const & a_key)
+  {
+    sizeType ind;
+    while (!TryMakeRoom(a_key, ind))
+    {
+      //Growing is for long probe sequences at a sensible load. If the table
+      //is already mostly empty, the hasher is sending too many keys to the
+      //same bucket and growing will not help.
+      if (m_nBuckets > (BucketsFor(m_nItems) << 4))
+        throw std::length_error("OpenHashTable: too many collisions. Check the hasher.");
+      Rehash(m_nBuckets * 2);
+    }
+    return ind;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  bool OpenHashTable<K, V, Hasher>::TryMakeRoom(K const & a_key, sizeType & a_out)
+  {
+    sizeType maxDist = m_nSlots - m_nBuckets;
+    sizeType ind = HomeBucket(a_key);
+    sizeType dist = 1;
+
+    //Find the first slot holding an element closer to home than us.
+    while (m_pDist[ind] >= dist)
+    {
+      ind++;
+      dist++;
+    }
+
+    if (dist > maxDist)
+      return false;
+
+    //Everything from here to the next empty slot moves one slot on.
+    sizeType empty = ind;
+    while (m_pDist[empty] != 0)
+    {
+      if (empty == m_nSlots || m_pDist[empty] == maxDist)
+        return false;
+      empty++;
+    }
+
+    for (sizeType i = empty; i > ind; i--)
+    {
+      new (&m_pKVs[i]) ValueType(std::move(m_pKVs[i - 1]));
+      m_pKVs[i - 1].~ValueType();
+      m_pDist[i] = m_pDist[i - 1] + 1;
+    }
+
+    m_pDist[ind] = static_cast<distType>(dist);
+    a_out = ind;
+    return true;
+  }
+
+  template<typename K, typename V, typename Hasher>
+  void OpenHashTable<K, V, Hasher>::EraseAt(sizeType a_ind)
+  {
+    m_pKVs[a_ind].~ValueType();
+
+    //Backward shift until we hit an empty slot or an element in its
+    //home bucket. The padding has a distance of 1, so this always stops.
+    sizeType i = a_ind + 1;
+    while (m_pDist[i] > 1)
+    {
+      new (&m_pKVs[i - 1]) ValueType(std::move(m_pKVs[i]));
+      m_pKVs[i].~ValueType();
+      m_pDist[i - 1] = m_pDist[i] - 1;
+      i++;
+    }
+    m_pDist[i - 1] = 0;
+    m_nItems--;
+  }
+}
+
+#endif
@@ -1,40 +1,311 @@
 #ifndef DGR2REGRESSION_H
 #define DGR2REGRESSION_H
 
+#include <stddef.h>
+#include <cmath>
+#include <vector>
+
 #include "DgR2Vector.h"
 #include "DgR2Line.h"
+#include "impl/DgParallelFor.h"
 
 namespace Dg
 {
   namespace R2
   {
+    //! @ingroup DgMath_types
+    //!
+    //! @class LineFitAccumulator
+    //!
+    //! Accumulates the mean and the co-moments of a stream of points, in a
+    //! numerically stable way (Welford). Points can be added and removed one
+    //! at a time, for example over a sliding window, and accumulators built
+    //! over separate parts of a data set can be merged (Chan et al.).
+    //!
+    //! @author Frank B. Hart
+    //! @date 19/10/2026
     template<typename Real>
-    Line<Real> LineOfBestFit(Vector<Real> const * a_points,
-                             size_t a_nPoints)
+    class LineFitAccumulator
+    {
+    public:
+
+      LineFitAccumulator();
+
+      //! Remove all points.
+      void Clear();
+
+      //! Add a point.
+      void Add(Vector<Real> const & a_point);
+
+      //! Add a_count points. The work is split over a_nThreads threads
+      //! (0 = one per hardware thread) and the results merged.
+      void Add(Vector<Real> const * a_points, size_t a_count, unsigned a_nThreads = 0);
+
+      //! Remove a point that was added earlier. Removing a point that was
+      //! never added leaves the accumulator meaningless.
+      void Remove(Vector<Real> const & a_point);
+
+      //! Add all points from another accumulator.
+      void Merge(LineFitAccumulator const & a_other);
+
+      //! Number of points.
+      size_t Count() const { return m_count; }
+
+      //! Mean of the points.
+      Vector<Real> Centroid() const;
+
+      //! Population covariance of the points.
+      void GetCovariance(Real & a_xx, Real & a_xy, Real & a_yy) const;
+
+      //! Least squares line, minimising vertical distances, as
+      //! LineOfBestFit().
+      Line<Real> GetLine() const;
+
+      //! Line along the major axis of the points, minimising perpendicular
+      //! distances.
+      Line<Real> GetPrincipalLine() const;
+
+    private:
+
+      //The array Add() sums blocks of this many points around the block
+      //mean, then merges the blocks.
+      static size_t const BlockSize = 256;
+
+      //Adds points a block at a time, each summed around its own mean.
+      void AddBlocks(Vector<Real> const * a_points, size_t a_count);
+
+    private:
+
+      size_t  m_count;
+      Real    m_meanX;
+      Real    m_meanY;
+      Real    m_Sxx;    //Sums of products of deviations from the mean
+      Real    m_Sxy;
+      Real    m_Syy;
+    };
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::LineFitAccumulator()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    LineFitAccumulator<Real>::LineFitAccumulator()
+    {
+      Clear();
+    }	//End: LineFitAccumulator<Real>::LineFitAccumulator()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::Clear()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void LineFitAccumulator<Real>::Clear()
+    {
+      m_count = 0;
+      m_meanX = m_meanY = static_cast<Real>(0);
+      m_Sxx = m_Sxy = m_Syy = static_cast<Real>(0);
+    }	//End: LineFitAccumulator<Real>::Clear()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::Add()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void LineFitAccumulator<Real>::Add(Vector<Real> const & a_point)
+    {
+      ++m_count;
+      Real dx = a_point.x() - m_meanX;
+      Real dy = a_point.y() - m_meanY;
+      Real invN = static_cast<Real>(1) / static_cast<Real>(m_count);
+      m_meanX += dx * invN;
+      m_meanY += dy * invN;
+
+      //Deviation from the old mean times deviation from the new
+      Real dyNew = a_point.y() - m_meanY;
+      m_Sxx += dx * (a_point.x() - m_meanX);
+      m_Sxy += dx * dyNew;
+      m_Syy += dy * dyNew;
+    }	//End: LineFitAccumulator<Real>::Add()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::Remove()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void LineFitAccumulator<Real>::Remove(Vector<Real> const & a_point)
+    {
+      if (m_count <= 1)
+      {
+        Clear();
+        return;
+      }
+
+      --m_count;
+      Real dx = a_point.x() - m_meanX;
+      Real dy = a_point.y() - m_meanY;
+      Real invN = static_cast<Real>(1) / static_cast<Real>(m_count);
+      m_meanX -= dx * invN;
+      m_meanY -= dy * invN;
+
+      Real dyNew = a_point.y() - m_meanY;
+      m_Sxx -= dx * (a_point.x() - m_meanX);
+      m_Sxy -= dx * dyNew;
+      m_Syy -= dy * dyNew;
+    }	//End: LineFitAccumulator<Real>::Remove()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::Merge()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void LineFitAccumulator<Real>::Merge(LineFitAccumulator const & a_other)
+    {
+      if (a_other.m_count == 0)
+        return;
+
+      if (m_count == 0)
+      {
+        *this = a_other;
+        return;
+      }
+
+      Real na = static_cast<Real>(m_count);
+      Real nb = static_cast<Real>(a_other.m_count);
+      Real n = na + nb;
+      Real dx = a_other.m_meanX - m_meanX;
+      Real dy = a_other.m_meanY - m_meanY;
+      Real f = na * nb / n;
+
+      m_meanX += dx * (nb / n);
+      m_meanY += dy * (nb / n);
+      m_Sxx += a_other.m_Sxx + dx * dx * f;
+      m_Sxy += a_other.m_Sxy + dx * dy * f;
+      m_Syy += a_other.m_Syy + dy * dy * f;
+      m_count += a_other.m_count;
+    }	//End: LineFitAccumulator<Real>::Merge()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::AddBlocks()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void LineFitAccumulator<Real>::AddBlocks(Vector<Real> const * a_points, size_t a_count)
+    {
+      for (size_t begin = 0; begin < a_count; begin += BlockSize)
+      {
+        size_t end = begin + BlockSize;
+        if (end > a_count)
+          end = a_count;
+
+        Real sumX = static_cast<Real>(0);
+        Real sumY = static_cast<Real>(0);
+        for (size_t i = begin; i < end; i++)
+        {
+          sumX += a_points[i].x();
+          sumY += a_points[i].y();
+        }
+
+        LineFitAccumulator block;
+        block.m_count = end - begin;
+        block.m_meanX = sumX / static_cast<Real>(block.m_count);
+        block.m_meanY = sumY / static_cast<Real>(block.m_count);
+        for (size_t i = begin; i < end; i++)
+        {
+          Real dx = a_points[i].x() - block.m_meanX;
+          Real dy = a_points[i].y() - block.m_meanY;
+          block.m_Sxx += dx * dx;
+          block.m_Sxy += dx * dy;
+          block.m_Syy += dy * dy;
+        }
+        Merge(block);
+      }
+    }	//End: LineFitAccumulator<Real>::AddBlocks()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::Add()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void LineFitAccumulator<Real>::Add(Vector<Real> const * a_points, size_t a_count, unsigned a_nThreads)
+    {
+      unsigned nThreads = impl::ThreadCount(a_count, a_nThreads);
+      std::vector<LineFitAccumulator> partial(nThreads);
+      impl::ParallelFor(a_count, nThreads,
+        [&](size_t a_begin, size_t a_end, unsigned a_thread)
+      {
+        partial[a_thread].AddBlocks(a_points + a_begin, a_end - a_begin);
+      });
+
+      for (unsigned t = 0; t < nThreads; t++)
+        Merge(partial[t]);
+    }	//End: LineFitAccumulator<Real>::Add()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::Centroid()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Vector<Real> LineFitAccumulator<Real>::Centroid() const
     {
-      Real sumX(static_cast<Real>(0));
-      Real sumY(static_cast<Real>(0));
-      Real sumXY(static_cast<Real>(0));
-      Real sumXX(static_cast<Real>(0));
+      return Vector<Real>(m_meanX, m_meanY, static_cast<Real>(1));
+    }	//End: LineFitAccumulator<Real>::Centroid()
+
 
-      for (size_t i = 0; i < a_nPoints; i++)
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::GetCovariance()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void LineFitAccumulator<Real>::GetCovariance(Real & a_xx, Real & a_xy, Real & a_yy) const
+    {
+      if (m_count == 0)
       {
-        sumX += a_points[i].x();
-        sumY += a_points[i].y();
-        sumXY += (a_points[i].x() * a_points[i].y());
-        sumXX += (a_points[i].x() * a_points[i].x());
+        a_xx = a_xy = a_yy = static_cast<Real>(0);
+        return;
       }
 
-      Real x = static_cast<Real>(a_nPoints) * sumXX - sumX * sumX;
-      Real y = static_cast<Real>(a_nPoints) * sumXY - sumX * sumY;
-      Vector<Real> direction(x, y, static_cast<Real>(0));
+      Real invN = static_cast<Real>(1) / static_cast<Real>(m_count);
+      a_xx = m_Sxx * invN;
+      a_xy = m_Sxy * invN;
+      a_yy = m_Syy * invN;
+    }	//End: LineFitAccumulator<Real>::GetCovariance()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::GetLine()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Line<Real> LineFitAccumulator<Real>::GetLine() const
+    {
+      Vector<Real> direction(m_Sxx, m_Sxy, static_cast<Real>(0));
       direction.Normalize();
-      Vector<Real> centroid(sumX / static_cast<Real>(a_nPoints),
-                            sumY / static_cast<Real>(a_nPoints), 
-                            static_cast<Real>(1) );
-      return Line<Real>(centroid, direction);
+      return Line<Real>(Centroid(), direction);
+    }	//End: LineFitAccumulator<Real>::GetLine()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	LineFitAccumulator<Real>::GetPrincipalLine()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Line<Real> LineFitAccumulator<Real>::GetPrincipalLine() const
+    {
+      //Angle of the eigenvector with the larger eigenvalue
+      Real angle = static_cast<Real>(0.5) * std::atan2(static_cast<Real>(2) * m_Sxy, m_Sxx - m_Syy);
+      Vector<Real> direction(std::cos(angle), std::sin(angle), static_cast<Real>(0));
+      return Line<Real>(Centroid(), direction);
+    }	//End: LineFitAccumulator<Real>::GetPrincipalLine()
+
+
+    //! Least squares line through a set of points, minimising vertical
+    //! distances.
+    template<typename Real>
+    Line<Real> LineOfBestFit(Vector<Real> const * a_points,
+                             size_t a_nPoints)
+    {
+      LineFitAccumulator<Real> accumulator;
+      accumulator.Add(a_points, a_nPoints, 1);
+      return accumulator.GetLine();
     }
   }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,454 @@
+//! @file DgR3DualQuaternion.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: DualQuaternion
+
+#ifndef DGR3DUALQUATERNION_H
+#define DGR3DUALQUATERNION_H
+
+#include <stdint.h>
+
+#include "DgR3Vector.h"
+#include "DgR3Quaternion.h"
+#include "DgR3VQS.h"
+#include "DgMath.h"
+#include "impl/DgDualQuaternionKernels.h"
+
+namespace Dg
+{
+  namespace R3
+  {
+    template<typename Real> class DualQuaternion;
+
+    //! Up to 4 bone influences for one vertex. Unused influences should
+    //! have a weight of 0; their bone index must still be valid.
+    template<typename Real>
+    struct SkinInfluences
+    {
+      uint32_t  bones[4];
+      Real      weights[4];
+    };
+
+    //! Dual quaternion linear blend skinning. Vertex i is moved by the
+    //! weighted sum of the palette entries named in a_pInfluences[i],
+    //! normalised. a_pNormalsIn may be null, in which case a_pNormalsOut
+    //! is not touched. The w component of each vertex is carried through.
+    //! Outputs may equal the inputs. The work is split over a_nThreads
+    //! threads (0 = one per hardware thread).
+    //!
+    //! The float version transforms 4 vertices at a time.
+    //! @pre Palette entries are normalised.
+    template<typename Real>
+    void SkinVertices(DualQuaternion<Real> const * a_pPalette,
+                      SkinInfluences<Real> const * a_pInfluences,
+                      Vector<Real> const * a_pIn,
+                      Vector<Real> * a_pOut,
+                      Vector<Real> const * a_pNormalsIn,
+                      Vector<Real> * a_pNormalsOut,
+                      size_t a_count,
+                      unsigned a_nThreads = 0);
+
+    //! @ingroup DgMath_types
+    //!
+    //! @class DualQuaternion
+    //!
+    //! @brief Rigid transform stored as a dual quaternion.
+    //!
+    //! The real part holds the rotation and the dual part half the
+    //! translation times the rotation. Unlike matrices, dual quaternions can
+    //! be blended linearly and normalised without shearing or shrinking, which
+    //! makes them a good fit for skinning. Scale is not represented.
+    //!
+    //! As with VQS, dual quaternions concatenate left to right.
+    //!
+    //! @author Frank B. Hart
+    //! @date 19/10/2026
+    template<typename Real>
+    class DualQuaternion
+    {
+    public:
+      //! Default constructor set to identity
+      DualQuaternion() : m_real(), m_dual(static_cast<Real>(0.0),
+                                          static_cast<Real>(0.0),
+                                          static_cast<Real>(0.0),
+                                          static_cast<Real>(0.0)) {}
+
+      //! Construct from real and dual parts. Inputs are NOT validated.
+      DualQuaternion(Quaternion<Real> const & a_real, Quaternion<Real> const & a_dual)
+        : m_real(a_real)
+        , m_dual(a_dual)
+      {}
+
+      //! Construct from a rotation and a translation. The rotation is applied first.
+      DualQuaternion(Quaternion<Real> const & a_rotation, Vector<Real> const & a_translation);
+
+      //! Construct from a rotation only.
+      explicit DualQuaternion(Quaternion<Real> const & a_rotation);
+
+      //! Construct from a VQS. The scale is ignored.
+      explicit DualQuaternion(VQS<Real> const & a_vqs);
+
+      ~DualQuaternion() {}
+
+      //! Comparison
+      bool operator==(DualQuaternion const & a_other) const;
+
+      //! Comparison
+      bool operator!=(DualQuaternion const & a_other) const;
+
+      //! Make identity.
+      void Identity();
+
+      //! Set from real and dual parts. Inputs are NOT validated.
+      void Set(Quaternion<Real> const & a_real, Quaternion<Real> const & a_dual);
+
+      //! Set from a rotation and a translation. The rotation is applied first.
+      void Set(Quaternion<Real> const & a_rotation, Vector<Real> const & a_translation);
+
+      //! Set from a VQS. The scale is ignored.
+      void Set(VQS<Real> const & a_vqs);
+
+      //! Scales both parts so the real part has unit length.
+      void Normalize();
+
+      //! Dual quaternion addition. Used to blend.
+      DualQuaternion operator+(DualQuaternion const &) const;
+
+      //! Dual quaternion addition, assign to self
+      DualQuaternion& operator+=(DualQuaternion const &);
+
+      //! Scalar multiplication
+      DualQuaternion operator*(Real) const;
+
+      //! Concatenation. Dual quaternions concatenate left to right.
+      DualQuaternion operator*(DualQuaternion const &) const;
+
+      //! Concatenation, assign to self.
+      DualQuaternion& operator*=(DualQuaternion const &);
+
+      //! Inverse of a unit dual quaternion.
+      DualQuaternion GetInverse() const;
+
+      //! Point transformations also apply translation.
+      //! @pre Dual quaternion is normalised.
+      Vector<Real> TransformPoint(Vector<Real> const &) const;
+
+      //! Vector transformations do not apply translation.
+      //! @pre Dual quaternion is normalised.
+      Vector<Real> TransformVector(Vector<Real> const &) const;
+
+      //! Rotation part.
+      Quaternion<Real> const & GetRotation() const { return m_real; }
+
+      //! Translation part, w = 0.
+      Vector<Real> GetTranslation() const;
+
+      //! Conversion to VQS, scale = 1.
+      VQS<Real> GetVQS() const;
+
+      //! Access real part
+      Quaternion<Real> const & GetReal() const { return m_real; }
+
+      //! Access dual part
+      Quaternion<Real> const & GetDual() const { return m_dual; }
+
+    private:
+      //Data members
+      Quaternion<Real>  m_real;   //rotation
+      Quaternion<Real>  m_dual;   //half translation times rotation
+    };
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::DualQuaternion()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real>::DualQuaternion(Quaternion<Real> const & a_rotation,
+                                         Vector<Real> const & a_translation)
+    {
+      Set(a_rotation, a_translation);
+
+    }	//End: DualQuaternion<Real>::DualQuaternion()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::DualQuaternion()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real>::DualQuaternion(Quaternion<Real> const & a_rotation)
+      : m_real(a_rotation)
+      , m_dual(static_cast<Real>(0.0),
+               static_cast<Real>(0.0),
+               static_cast<Real>(0.0),
+               static_cast<Real>(0.0))
+    {
+
+    }	//End: DualQuaternion<Real>::DualQuaternion()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::DualQuaternion()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real>::DualQuaternion(VQS<Real> const & a_vqs)
+    {
+      Set(a_vqs.Q(), a_vqs.V());
+
+    }	//End: DualQuaternion<Real>::DualQuaternion()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::operator==()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    bool DualQuaternion<Real>::operator==(DualQuaternion<Real> const & a_other) const
+    {
+      return (m_real == a_other.m_real) && (m_dual == a_other.m_dual);
+
+    }	//End: DualQuaternion<Real>::operator==()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::operator!=()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    bool DualQuaternion<Real>::operator!=(DualQuaternion<Real> const & a_other) const
+    {
+      return !(*this == a_other);
+
+    }	//End: DualQuaternion<Real>::operator!=()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::Identity()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void DualQuaternion<Real>::Identity()
+    {
+      m_real.Identity();
+      m_dual.Zero();
+
+    }	//End: DualQuaternion<Real>::Identity()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::Set()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void DualQuaternion<Real>::Set(Quaternion<Real> const & a_real, Quaternion<Real> const & a_dual)
+    {
+      m_real = a_real;
+      m_dual = a_dual;
+
+    }	//End: DualQuaternion<Real>::Set()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::Set()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void DualQuaternion<Real>::Set(Quaternion<Real> const & a_rotation, Vector<Real> const & a_translation)
+    {
+      m_real = a_rotation;
+
+      //Quaternions concatenate left to right, so this is t * r in the usual notation
+      m_dual = static_cast<Real>(0.5) * (a_rotation * Quaternion<Real>(a_translation));
+
+    }	//End: DualQuaternion<Real>::Set()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::Set()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void DualQuaternion<Real>::Set(VQS<Real> const & a_vqs)
+    {
+      Set(a_vqs.Q(), a_vqs.V());
+
+    }	//End: DualQuaternion<Real>::Set()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::Normalize()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void DualQuaternion<Real>::Normalize()
+    {
+      Real lengthsq = m_real.Norm();
+
+      if (Dg::IsZero(lengthsq))
+      {
+        Identity();
+        return;
+      }
+
+      Real factor = static_cast<Real>(1.0) / sqrt(lengthsq);
+      m_real *= factor;
+      m_dual *= factor;
+
+    }	//End: DualQuaternion<Real>::Normalize()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::operator+()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real> DualQuaternion<Real>::operator+(DualQuaternion<Real> const & a_other) const
+    {
+      return DualQuaternion<Real>(m_real + a_other.m_real, m_dual + a_other.m_dual);
+
+    }	//End: DualQuaternion<Real>::operator+()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::operator+=()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real>& DualQuaternion<Real>::operator+=(DualQuaternion<Real> const & a_other)
+    {
+      m_real += a_other.m_real;
+      m_dual += a_other.m_dual;
+
+      return *this;
+
+    }	//End: DualQuaternion<Real>::operator+=()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::operator*()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real> DualQuaternion<Real>::operator*(Real a_scalar) const
+    {
+      return DualQuaternion<Real>(a_scalar * m_real, a_scalar * m_dual);
+
+    }	//End: DualQuaternion<Real>::operator*()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::operator*()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real> DualQuaternion<Real>::operator*(DualQuaternion<Real> const & a_other) const
+    {
+      return DualQuaternion<Real>(m_real * a_other.m_real,
+                                  m_dual * a_other.m_real + m_real * a_other.m_dual);
+
+    }	//End: DualQuaternion<Real>::operator*()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::operator*=()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real>& DualQuaternion<Real>::operator*=(DualQuaternion<Real> const & a_other)
+    {
+      *this = *this * a_other;
+      return *this;
+
+    }	//End: DualQuaternion<Real>::operator*=()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::GetInverse()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    DualQuaternion<Real> DualQuaternion<Real>::GetInverse() const
+    {
+      return DualQuaternion<Real>(Conjugate(m_real), Conjugate(m_dual));
+
+    }	//End: DualQuaternion<Real>::GetInverse()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::GetTranslation()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Vector<Real> DualQuaternion<Real>::GetTranslation() const
+    {
+      Quaternion<Real> t = Conjugate(m_real) * m_dual;
+      return Vector<Real>(static_cast<Real>(2.0) * t[1],
+                          static_cast<Real>(2.0) * t[2],
+                          static_cast<Real>(2.0) * t[3],
+                          static_cast<Real>(0.0));
+
+    }	//End: DualQuaternion<Real>::GetTranslation()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::GetVQS()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    VQS<Real> DualQuaternion<Real>::GetVQS() const
+    {
+      return VQS<Real>(GetTranslation(), m_real, static_cast<Real>(1.0));
+
+    }	//End: DualQuaternion<Real>::GetVQS()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::TransformPoint()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Vector<Real> DualQuaternion<Real>::TransformPoint(Vector<Real> const & a_v) const
+    {
+      Vector<Real> result = m_real.Rotate(a_v);
+      Vector<Real> t = GetTranslation();
+
+      result[0] += t[0];
+      result[1] += t[1];
+      result[2] += t[2];
+
+      return result;
+
+    }	//End: DualQuaternion<Real>::TransformPoint()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	DualQuaternion<Real>::TransformVector()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Vector<Real> DualQuaternion<Real>::TransformVector(Vector<Real> const & a_v) const
+    {
+      return m_real.Rotate(a_v);
+
+    }	//End: DualQuaternion<Real>::TransformVector()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	SkinVertices()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void SkinVertices(DualQuaternion<Real> const * a_pPalette,
+                      SkinInfluences<Real> const * a_pInfluences,
+                      Vector<Real> const * a_pIn,
+                      Vector<Real> * a_pOut,
+                      Vector<Real> const * a_pNormalsIn,
+                      Vector<Real> * a_pNormalsOut,
+                      size_t a_count,
+                      unsigned a_nThreads)
+    {
+      static_assert(sizeof(DualQuaternion<Real>) == 8 * sizeof(Real), "DualQuaternion must be 8 packed reals");
+      static_assert(sizeof(SkinInfluences<Real>) == 4 * sizeof(uint32_t) + 4 * sizeof(Real), "SkinInfluences must be packed");
+
+      if (a_count == 0)
+        return;
+
+      Real const * pPalette = reinterpret_cast<Real const *>(a_pPalette);
+      Real const * pIn = a_pIn->GetData();
+      Real * pOut = a_pOut->GetData();
+      Real const * pNormalsIn = (a_pNormalsIn != nullptr) ? a_pNormalsIn->GetData() : nullptr;
+      Real * pNormalsOut = (a_pNormalsIn != nullptr) ? a_pNormalsOut->GetData() : nullptr;
+
+      impl::ParallelFor(a_count, impl::ThreadCount(a_count, a_nThreads),
+        [=](size_t a_begin, size_t a_end, unsigned)
+      {
+        impl::SkinKernel<Real>::Apply(pPalette, a_pInfluences, pIn, pOut, pNormalsIn, pNormalsOut, a_begin, a_end);
+      });
+    }	//End: SkinVertices()
+  }
+}
+
+#endif
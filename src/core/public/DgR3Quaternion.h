@@ -8,8 +8,11 @@
 #ifndef DGR3QUATERNION_H
 #define DGR3QUATERNION_H
 
+#include <vector>
+
 #include "DgMath.h"
 #include "DgR3Vector.h"
+#include "impl/DgQuaternionKernels.h"
 
 namespace Dg
 {
@@ -79,6 +82,47 @@ namespace Dg
       Quaternion<Real> const & a_end,
       Real a_t);
 
+    //! Spherical linear interpolation of a_count pairs with the same factor,
+    //! a_pOut[i] = Slerp(a_pStart[i], a_pEnd[i], a_t). a_pOut may equal
+    //! either input. The work is split over a_nThreads threads (0 = one per
+    //! hardware thread).
+    //!
+    //! The float version does 4 quaternions at a time and gets the weights
+    //! from a polynomial in the cosine of the angle, so it has no trig
+    //! calls or branches. Components are within 3e-5 of Slerp().
+    template<typename Real>
+    void Slerp(Quaternion<Real> * a_pOut,
+      Quaternion<Real> const * a_pStart,
+      Quaternion<Real> const * a_pEnd,
+      Real a_t,
+      size_t a_count,
+      unsigned a_nThreads = 0);
+
+    //! ApproxSlerp() of a_count pairs with the same factor. a_pOut may equal
+    //! either input. The work is split over a_nThreads threads (0 = one per
+    //! hardware thread).
+    template<typename Real>
+    void ApproxSlerp(Quaternion<Real> * a_pOut,
+      Quaternion<Real> const * a_pStart,
+      Quaternion<Real> const * a_pEnd,
+      Real a_t,
+      size_t a_count,
+      unsigned a_nThreads = 0);
+
+    //! Weighted blend of a_nPoses poses of a_nBones rotations each. Bone i of
+    //! the result is the sum of a_pWeights[p] * a_ppPoses[p][i], normalised
+    //! once at the end. Each rotation is first moved onto the same hemisphere
+    //! as pose 0. Weights need not sum to 1; bones whose sum is zero are set
+    //! to the identity. a_pOut may equal any of the poses. The work is split
+    //! over a_nThreads threads (0 = one per hardware thread).
+    template<typename Real>
+    void BlendPoses(Quaternion<Real> * a_pOut,
+      Quaternion<Real> const * const * a_ppPoses,
+      Real const * a_pWeights,
+      size_t a_nPoses,
+      size_t a_nBones,
+      unsigned a_nThreads = 0);
+
 
     //! @ingroup DgMath_types
     //!
@@ -258,6 +302,14 @@ namespace Dg
       //! @pre Quaternion is normalized.
       void RotateSelf(Vector<Real>&) const;
 
+      //! Rotates a_count vectors. a_pOut may equal a_pIn. The work is split
+      //! over a_nThreads threads (0 = one per hardware thread).
+      //! @pre Quaternion is normalized.
+      void Rotate(Vector<Real> const * a_pIn,
+                  Vector<Real> * a_pOut,
+                  size_t a_count,
+                  unsigned a_nThreads = 0) const;
+
       //! Linearly interpolate two quaternions.
       //! This will always take the shorter path between them.
       //!
@@ -1148,6 +1200,47 @@ namespace Dg
     }   // End of Quaternion::RotateSelf()
 
 
+        //-------------------------------------------------------------------------------
+        //	@	Quaternion::Rotate()
+        //-------------------------------------------------------------------------------
+    template<typename Real>
+    void Quaternion<Real>::Rotate(Vector<Real> const * a_pIn,
+                                  Vector<Real> * a_pOut,
+                                  size_t a_count,
+                                  unsigned a_nThreads) const
+    {
+      if (a_count == 0)
+        return;
+
+      //Over many vectors it pays to build the rotation matrix first
+      Real xs = m_x + m_x;
+      Real ys = m_y + m_y;
+      Real zs = m_z + m_z;
+      Real wx = m_w * xs;
+      Real wy = m_w * ys;
+      Real wz = m_w * zs;
+      Real xx = m_x * xs;
+      Real xy = m_x * ys;
+      Real xz = m_x * zs;
+      Real yy = m_y * ys;
+      Real yz = m_y * zs;
+      Real zz = m_z * zs;
+
+      Real const one = static_cast<Real>(1.0);
+      Real const zero = static_cast<Real>(0.0);
+      Real const m[16] =
+      {
+        one - (yy + zz), xy + wz, xz - wy, zero,
+        xy - wz, one - (xx + zz), yz + wx, zero,
+        xz + wy, yz - wx, one - (xx + yy), zero,
+        zero, zero, zero, one
+      };
+      Real const t[4] = {};
+
+      impl::TransformVectors(m, t, a_pIn->GetData(), a_pOut->GetData(), a_count, a_nThreads);
+    }   // End of Quaternion::Rotate()
+
+
         //-------------------------------------------------------------------------------
         //	@	Quaternion::Lerp()
         //-------------------------------------------------------------------------------
@@ -1242,7 +1335,7 @@ namespace Dg
       Real cosTheta = Dot(a_start, a_end);
 
       // correct time by using cosine of angle between quaternions
-      Real factor = static_cast<Real>(1.0) - static_cast<Real>(0.7878088) * cosTheta;
+      Real factor = static_cast<Real>(1.0) - static_cast<Real>(0.7878088) * std::abs(cosTheta);
       Real k = static_cast<Real>(0.5069269);
       factor *= factor;
       k *= factor;
@@ -1251,7 +1344,7 @@ namespace Dg
       Real c = static_cast<Real>(-3.0) * k;
       Real d = static_cast<Real>(1.0) + k;
 
-      a_t = a_t * (b * a_t + c) + d;
+      a_t = a_t * (a_t * (b * a_t + c) + d);
 
       // initialize a_result
       a_result = a_t * a_end;
@@ -1269,6 +1362,90 @@ namespace Dg
       }
 
     }   // a_end of ApproxSlerp()
+
+
+        //-------------------------------------------------------------------------------
+        //	@	Quaternion::Slerp()
+        //-------------------------------------------------------------------------------
+    template<typename Real>
+    void Slerp(Quaternion<Real> * a_pOut, Quaternion<Real> const * a_pStart, Quaternion<Real> const * a_pEnd,
+               Real a_t, size_t a_count, unsigned a_nThreads)
+    {
+      static_assert(sizeof(Quaternion<Real>) == 4 * sizeof(Real), "Quaternion must be 4 packed reals");
+
+      Real const * pStart = reinterpret_cast<Real const *>(a_pStart);
+      Real const * pEnd = reinterpret_cast<Real const *>(a_pEnd);
+      Real * pOut = reinterpret_cast<Real *>(a_pOut);
+
+      impl::ParallelFor(a_count, impl::ThreadCount(a_count, a_nThreads),
+        [=](size_t a_begin, size_t a_end, unsigned)
+      {
+        impl::SlerpKernel<Real>::Apply(pStart + a_begin * 4, pEnd + a_begin * 4, a_t, pOut + a_begin * 4, a_end - a_begin);
+      });
+    }   // End of Slerp()
+
+
+        //-------------------------------------------------------------------------------
+        //	@	Quaternion::ApproxSlerp()
+        //-------------------------------------------------------------------------------
+    template<typename Real>
+    void ApproxSlerp(Quaternion<Real> * a_pOut, Quaternion<Real> const * a_pStart, Quaternion<Real> const * a_pEnd,
+                     Real a_t, size_t a_count, unsigned a_nThreads)
+    {
+      static_assert(sizeof(Quaternion<Real>) == 4 * sizeof(Real), "Quaternion must be 4 packed reals");
+
+      Real const * pStart = reinterpret_cast<Real const *>(a_pStart);
+      Real const * pEnd = reinterpret_cast<Real const *>(a_pEnd);
+      Real * pOut = reinterpret_cast<Real *>(a_pOut);
+
+      impl::ParallelFor(a_count, impl::ThreadCount(a_count, a_nThreads),
+        [=](size_t a_begin, size_t a_end, unsigned)
+      {
+        impl::ApproxSlerpKernel<Real>::Apply(pStart + a_begin * 4, pEnd + a_begin * 4, a_t, pOut + a_begin * 4, a_end - a_begin);
+      });
+    }   // End of ApproxSlerp()
+
+
+        //-------------------------------------------------------------------------------
+        //	@	Quaternion::BlendPoses()
+        //-------------------------------------------------------------------------------
+    template<typename Real>
+    void BlendPoses(Quaternion<Real> * a_pOut, Quaternion<Real> const * const * a_ppPoses, Real const * a_pWeights,
+                    size_t a_nPoses, size_t a_nBones, unsigned a_nThreads)
+    {
+      static_assert(sizeof(Quaternion<Real>) == 4 * sizeof(Real), "Quaternion must be 4 packed reals");
+
+      if (a_nPoses == 0)
+      {
+        for (size_t i = 0; i < a_nBones; ++i)
+          a_pOut[i].Identity();
+        return;
+      }
+
+      //Typical blends have a handful of poses, so avoid a heap allocation
+      //per call unless there are a lot of them.
+      size_t const maxStackPoses = 16;
+      Real const * stackPoses[maxStackPoses];
+      std::vector<Real const *> heapPoses;
+      Real const ** poses = stackPoses;
+      if (a_nPoses > maxStackPoses)
+      {
+        heapPoses.resize(a_nPoses);
+        poses = heapPoses.data();
+      }
+
+      for (size_t p = 0; p < a_nPoses; ++p)
+        poses[p] = reinterpret_cast<Real const *>(a_ppPoses[p]);
+
+      Real const * const * ppPoses = poses;
+      Real * pOut = reinterpret_cast<Real *>(a_pOut);
+
+      impl::ParallelFor(a_nBones, impl::ThreadCount(a_nBones * a_nPoses, a_nThreads),
+        [=](size_t a_begin, size_t a_end, unsigned)
+      {
+        impl::BlendKernel<Real>::Apply(ppPoses, a_pWeights, a_nPoses, a_begin, a_end, pOut);
+      });
+    }   // End of BlendPoses()
   }
 }
 
@@ -0,0 +1,417 @@
+//! @file DgR3Regression.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: PlaneFitAccumulator
+
+#ifndef DGR3REGRESSION_H
+#define DGR3REGRESSION_H
+
+#include <stddef.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "DgR3Vector.h"
+#include "DgR3Line.h"
+#include "DgR3Plane.h"
+#include "impl/DgParallelFor.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Eigen decomposition of a symmetric 3x3 matrix by cyclic Jacobi
+    //! rotations. a_A is destroyed. Eigenvalues are sorted largest first;
+    //! a_vectors[i] is the unit eigenvector of a_values[i].
+    template<typename Real>
+    void SymmetricEigen3(Real a_A[3][3], Real a_values[3], Real a_vectors[3][3])
+    {
+      Real V[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+      Real const eps = std::numeric_limits<Real>::epsilon();
+
+      for (int sweep = 0; sweep < 32; sweep++)
+      {
+        Real off = a_A[0][1] * a_A[0][1] + a_A[0][2] * a_A[0][2] + a_A[1][2] * a_A[1][2];
+        Real diag = a_A[0][0] * a_A[0][0] + a_A[1][1] * a_A[1][1] + a_A[2][2] * a_A[2][2];
+        if (off <= eps * eps * diag)
+          break;
+
+        for (int p = 0; p < 2; p++)
+        {
+          for (int q = p + 1; q < 3; q++)
+          {
+            if (a_A[p][q] == static_cast<Real>(0))
+              continue;
+
+            //Rotation that zeros a_A[p][q]
+            Real theta = (a_A[q][q] - a_A[p][p]) / (static_cast<Real>(2) * a_A[p][q]);
+            Real t = static_cast<Real>(1) / (std::abs(theta) + std::sqrt(theta * theta + static_cast<Real>(1)));
+            if (theta < static_cast<Real>(0))
+              t = -t;
+            Real c = static_cast<Real>(1) / std::sqrt(t * t + static_cast<Real>(1));
+            Real s = t * c;
+
+            for (int k = 0; k < 3; k++)
+            {
+              Real akp = a_A[k][p];
+              Real akq = a_A[k][q];
+              a_A[k][p] = c * akp - s * akq;
+              a_A[k][q] = s * akp + c * akq;
+            }
+            for (int k = 0; k < 3; k++)
+            {
+              Real apk = a_A[p][k];
+              Real aqk = a_A[q][k];
+              a_A[p][k] = c * apk - s * aqk;
+              a_A[q][k] = s * apk + c * aqk;
+            }
+            for (int k = 0; k < 3; k++)
+            {
+              Real vkp = V[k][p];
+              Real vkq = V[k][q];
+              V[k][p] = c * vkp - s * vkq;
+              V[k][q] = s * vkp + c * vkq;
+            }
+          }
+        }
+      }
+
+      int order[3] = {0, 1, 2};
+      for (int i = 0; i < 2; i++)
+      {
+        for (int j = i + 1; j < 3; j++)
+        {
+          if (a_A[order[j]][order[j]] > a_A[order[i]][order[i]])
+          {
+            int temp = order[i];
+            order[i] = order[j];
+            order[j] = temp;
+          }
+        }
+      }
+
+      for (int i = 0; i < 3; i++)
+      {
+        a_values[i] = a_A[order[i]][order[i]];
+        for (int k = 0; k < 3; k++)
+          a_vectors[i][k] = V[k][order[i]];
+      }
+    }
+  }
+
+  namespace R3
+  {
+    //! @ingroup DgMath_types
+    //!
+    //! @class PlaneFitAccumulator
+    //!
+    //! Accumulates the mean and the co-moments of a stream of points, in a
+    //! numerically stable way (Welford), for plane and line fitting and
+    //! principal component analysis. Points can be added and removed one at
+    //! a time, for example over a sliding window, and accumulators built
+    //! over separate parts of a data set can be merged (Chan et al.).
+    //!
+    //! @author Frank B. Hart
+    //! @date 19/10/2026
+    template<typename Real>
+    class PlaneFitAccumulator
+    {
+    public:
+
+      PlaneFitAccumulator();
+
+      //! Remove all points.
+      void Clear();
+
+      //! Add a point.
+      void Add(Vector<Real> const & a_point);
+
+      //! Add a_count points. The work is split over a_nThreads threads
+      //! (0 = one per hardware thread) and the results merged.
+      void Add(Vector<Real> const * a_points, size_t a_count, unsigned a_nThreads = 0);
+
+      //! Remove a point that was added earlier. Removing a point that was
+      //! never added leaves the accumulator meaningless.
+      void Remove(Vector<Real> const & a_point);
+
+      //! Add all points from another accumulator.
+      void Merge(PlaneFitAccumulator const & a_other);
+
+      //! Number of points.
+      size_t Count() const { return m_count; }
+
+      //! Mean of the points.
+      Vector<Real> Centroid() const;
+
+      //! Principal axes of the points, largest variance first, with the
+      //! population variance along each.
+      void GetPrincipalAxes(Vector<Real> a_axes[3], Real a_variances[3]) const;
+
+      //! Plane through the centroid minimising the sum of squared distances
+      //! to the points. Its normal is the axis of least variance.
+      Plane<Real> GetPlane() const;
+
+      //! Line through the centroid minimising the sum of squared distances
+      //! to the points. Its direction is the axis of greatest variance.
+      Line<Real> GetLine() const;
+
+    private:
+
+      //The array Add() sums blocks of this many points around the block
+      //mean, then merges the blocks.
+      static size_t const BlockSize = 256;
+
+      //Adds points a block at a time, each summed around its own mean.
+      void AddBlocks(Vector<Real> const * a_points, size_t a_count);
+
+      //Index into m_S of the co-moment of axes i <= j
+      static int Index(int i, int j) { return i * 3 - (i * (i + 1)) / 2 + j; }
+
+    private:
+
+      size_t  m_count;
+      Real    m_mean[3];
+      Real    m_S[6];     //Sums of products of deviations: xx, xy, xz, yy, yz, zz
+    };
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::PlaneFitAccumulator()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    PlaneFitAccumulator<Real>::PlaneFitAccumulator()
+    {
+      Clear();
+    }	//End: PlaneFitAccumulator<Real>::PlaneFitAccumulator()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::Clear()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void PlaneFitAccumulator<Real>::Clear()
+    {
+      m_count = 0;
+      for (int i = 0; i < 3; i++)
+        m_mean[i] = static_cast<Real>(0);
+      for (int i = 0; i < 6; i++)
+        m_S[i] = static_cast<Real>(0);
+    }	//End: PlaneFitAccumulator<Real>::Clear()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::Add()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void PlaneFitAccumulator<Real>::Add(Vector<Real> const & a_point)
+    {
+      ++m_count;
+      Real invN = static_cast<Real>(1) / static_cast<Real>(m_count);
+      Real dOld[3], dNew[3];
+      for (int i = 0; i < 3; i++)
+      {
+        dOld[i] = a_point[i] - m_mean[i];
+        m_mean[i] += dOld[i] * invN;
+        dNew[i] = a_point[i] - m_mean[i];
+      }
+
+      //Deviation from the old mean times deviation from the new
+      for (int i = 0; i < 3; i++)
+      {
+        for (int j = i; j < 3; j++)
+          m_S[Index(i, j)] += dOld[i] * dNew[j];
+      }
+    }	//End: PlaneFitAccumulator<Real>::Add()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::Remove()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void PlaneFitAccumulator<Real>::Remove(Vector<Real> const & a_point)
+    {
+      if (m_count <= 1)
+      {
+        Clear();
+        return;
+      }
+
+      --m_count;
+      Real invN = static_cast<Real>(1) / static_cast<Real>(m_count);
+      Real dOld[3], dNew[3];
+      for (int i = 0; i < 3; i++)
+      {
+        dOld[i] = a_point[i] - m_mean[i];
+        m_mean[i] -= dOld[i] * invN;
+        dNew[i] = a_point[i] - m_mean[i];
+      }
+
+      for (int i = 0; i < 3; i++)
+      {
+        for (int j = i; j < 3; j++)
+          m_S[Index(i, j)] -= dOld[i] * dNew[j];
+      }
+    }	//End: PlaneFitAccumulator<Real>::Remove()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::Merge()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void PlaneFitAccumulator<Real>::Merge(PlaneFitAccumulator const & a_other)
+    {
+      if (a_other.m_count == 0)
+        return;
+
+      if (m_count == 0)
+      {
+        *this = a_other;
+        return;
+      }
+
+      Real na = static_cast<Real>(m_count);
+      Real nb = static_cast<Real>(a_other.m_count);
+      Real n = na + nb;
+      Real f = na * nb / n;
+      Real d[3];
+      for (int i = 0; i < 3; i++)
+      {
+        d[i] = a_other.m_mean[i] - m_mean[i];
+        m_mean[i] += d[i] * (nb / n);
+      }
+
+      for (int i = 0; i < 3; i++)
+      {
+        for (int j = i; j < 3; j++)
+          m_S[Index(i, j)] += a_other.m_S[Index(i, j)] + d[i] * d[j] * f;
+      }
+      m_count += a_other.m_count;
+    }	//End: PlaneFitAccumulator<Real>::Merge()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::AddBlocks()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void PlaneFitAccumulator<Real>::AddBlocks(Vector<Real> const * a_points, size_t a_count)
+    {
+      for (size_t begin = 0; begin < a_count; begin += BlockSize)
+      {
+        size_t end = begin + BlockSize;
+        if (end > a_count)
+          end = a_count;
+
+        Real sum[3] = {static_cast<Real>(0), static_cast<Real>(0), static_cast<Real>(0)};
+        for (size_t i = begin; i < end; i++)
+        {
+          sum[0] += a_points[i].x();
+          sum[1] += a_points[i].y();
+          sum[2] += a_points[i].z();
+        }
+
+        PlaneFitAccumulator block;
+        block.m_count = end - begin;
+        for (int k = 0; k < 3; k++)
+          block.m_mean[k] = sum[k] / static_cast<Real>(block.m_count);
+
+        for (size_t i = begin; i < end; i++)
+        {
+          Real dx = a_points[i].x() - block.m_mean[0];
+          Real dy = a_points[i].y() - block.m_mean[1];
+          Real dz = a_points[i].z() - block.m_mean[2];
+          block.m_S[0] += dx * dx;
+          block.m_S[1] += dx * dy;
+          block.m_S[2] += dx * dz;
+          block.m_S[3] += dy * dy;
+          block.m_S[4] += dy * dz;
+          block.m_S[5] += dz * dz;
+        }
+        Merge(block);
+      }
+    }	//End: PlaneFitAccumulator<Real>::AddBlocks()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::Add()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void PlaneFitAccumulator<Real>::Add(Vector<Real> const * a_points, size_t a_count, unsigned a_nThreads)
+    {
+      unsigned nThreads = impl::ThreadCount(a_count, a_nThreads);
+      std::vector<PlaneFitAccumulator> partial(nThreads);
+      impl::ParallelFor(a_count, nThreads,
+        [&](size_t a_begin, size_t a_end, unsigned a_thread)
+      {
+        partial[a_thread].AddBlocks(a_points + a_begin, a_end - a_begin);
+      });
+
+      for (unsigned t = 0; t < nThreads; t++)
+        Merge(partial[t]);
+    }	//End: PlaneFitAccumulator<Real>::Add()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::Centroid()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Vector<Real> PlaneFitAccumulator<Real>::Centroid() const
+    {
+      return Vector<Real>(m_mean[0], m_mean[1], m_mean[2], static_cast<Real>(1));
+    }	//End: PlaneFitAccumulator<Real>::Centroid()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::GetPrincipalAxes()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    void PlaneFitAccumulator<Real>::GetPrincipalAxes(Vector<Real> a_axes[3], Real a_variances[3]) const
+    {
+      Real A[3][3];
+      for (int i = 0; i < 3; i++)
+      {
+        for (int j = i; j < 3; j++)
+          A[i][j] = A[j][i] = m_S[Index(i, j)];
+      }
+
+      Real values[3], vectors[3][3];
+      impl::SymmetricEigen3(A, values, vectors);
+
+      Real invN = m_count == 0 ? static_cast<Real>(0) : static_cast<Real>(1) / static_cast<Real>(m_count);
+      for (int i = 0; i < 3; i++)
+      {
+        a_axes[i] = Vector<Real>(vectors[i][0], vectors[i][1], vectors[i][2], static_cast<Real>(0));
+        a_variances[i] = values[i] * invN;
+      }
+    }	//End: PlaneFitAccumulator<Real>::GetPrincipalAxes()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::GetPlane()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Plane<Real> PlaneFitAccumulator<Real>::GetPlane() const
+    {
+      Vector<Real> axes[3];
+      Real variances[3];
+      GetPrincipalAxes(axes, variances);
+      return Plane<Real>(axes[2], Centroid());
+    }	//End: PlaneFitAccumulator<Real>::GetPlane()
+
+
+    //--------------------------------------------------------------------------------
+    //	@	PlaneFitAccumulator<Real>::GetLine()
+    //--------------------------------------------------------------------------------
+    template<typename Real>
+    Line<Real> PlaneFitAccumulator<Real>::GetLine() const
+    {
+      Vector<Real> axes[3];
+      Real variances[3];
+      GetPrincipalAxes(axes, variances);
+      return Line<Real>(Centroid(), axes[0]);
+    }	//End: PlaneFitAccumulator<Real>::GetLine()
+  }
+}
+
+#endif
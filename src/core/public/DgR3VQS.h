@@ -123,6 +123,22 @@ namespace Dg
       //! Vector transformations do not apply translation.
       Vector<Real> & TransformVectorSelf(Vector<Real> &) const;
 
+      //! Transforms a_count points, applying translation. a_pOut may equal
+      //! a_pIn. The work is split over a_nThreads threads (0 = one per
+      //! hardware thread).
+      void TransformPoints(Vector<Real> const * a_pIn,
+                           Vector<Real> * a_pOut,
+                           size_t a_count,
+                           unsigned a_nThreads = 0) const;
+
+      //! Transforms a_count vectors, without translation. a_pOut may equal
+      //! a_pIn. The work is split over a_nThreads threads (0 = one per
+      //! hardware thread).
+      void TransformVectors(Vector<Real> const * a_pIn,
+                            Vector<Real> * a_pOut,
+                            size_t a_count,
+                            unsigned a_nThreads = 0) const;
+
       //! Apply translation to Vector.
       Vector<Real> Translate(Vector<Real> const &) const;
 
@@ -414,6 +430,51 @@ namespace Dg
     }	//End: TransformVectorSelf()
 
 
+      //--------------------------------------------------------------------------------
+      //	@	TransformPoints()
+      //--------------------------------------------------------------------------------
+    template<typename Real>
+    void VQS<Real>::TransformPoints(Vector<Real> const * a_pIn,
+                                    Vector<Real> * a_pOut,
+                                    size_t a_count,
+                                    unsigned a_nThreads) const
+    {
+      if (a_count == 0)
+        return;
+
+      //Scale and rotation as one matrix, translation added after. As with
+      //TransformPoint(), w is carried through.
+      Matrix<Real> m;
+      GetMatrix(m);
+      m[12] = m[13] = m[14] = static_cast<Real>(0.0);
+
+      impl::TransformVectors(m.GetData(), m_v.GetData(),
+                             a_pIn->GetData(), a_pOut->GetData(), a_count, a_nThreads);
+    }	//End: TransformPoints()
+
+
+      //--------------------------------------------------------------------------------
+      //	@	TransformVectors()
+      //--------------------------------------------------------------------------------
+    template<typename Real>
+    void VQS<Real>::TransformVectors(Vector<Real> const * a_pIn,
+                                     Vector<Real> * a_pOut,
+                                     size_t a_count,
+                                     unsigned a_nThreads) const
+    {
+      if (a_count == 0)
+        return;
+
+      Matrix<Real> m;
+      GetMatrix(m);
+      m[12] = m[13] = m[14] = static_cast<Real>(0.0);
+
+      Real const t[4] = {};
+      impl::TransformVectors(m.GetData(), t,
+                             a_pIn->GetData(), a_pOut->GetData(), a_count, a_nThreads);
+    }	//End: TransformVectors()
+
+
       //--------------------------------------------------------------------------------
       //	@	VQS<Real>::Translate()
       //--------------------------------------------------------------------------------
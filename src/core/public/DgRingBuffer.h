@@ -0,0 +1,633 @@
+//! @file DgRingBuffer.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: SPSCRingBuffer, MPSCRingBuffer
+
+#ifndef DGRINGBUFFER_H
+#define DGRINGBUFFER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <stddef.h>
+
+namespace Dg
+{
+  namespace impl
+  {
+    size_t const cacheLineSize = 64;
+
+    inline size_t NextPowerOf2(size_t a_val)
+    {
+      size_t result = 1;
+      while (result < a_val)
+        result <<= 1;
+      return result;
+    }
+
+    //! Lets threads sleep until another thread signals progress. Waiters spin
+    //! for a while before sleeping on a condition variable. Notify() only
+    //! touches the mutex if someone is asleep.
+    //!
+    //! Waiters register with an RMW on the waiter count before they check
+    //! the condition, and Notify() reads the count with an RMW after the
+    //! change is published. The two RMWs are ordered, so either the waiter
+    //! sees the change or Notify() sees the waiter. With nobody waiting a
+    //! notify costs one uncontended RMW.
+    class WaitGate
+    {
+    public:
+
+      WaitGate() : m_nWaiters(0) {}
+
+      template<typename Pred>
+      void Wait(Pred a_ready)
+      {
+        for (int i = 0; i < s_spinCount; i++)
+        {
+          if (a_ready())
+            return;
+          if (i >= s_spinCount / 2)
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_nWaiters.fetch_add(1, std::memory_order_seq_cst);
+        m_cv.wait(lock, a_ready);
+        m_nWaiters.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      //! Call after publishing the change waiters are waiting on.
+      void Notify()
+      {
+        if (m_nWaiters.fetch_add(0, std::memory_order_seq_cst) != 0)
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_cv.notify_all();
+        }
+      }
+
+    private:
+
+      static int const          s_spinCount = 256;
+
+      std::atomic<unsigned>     m_nWaiters;
+      std::mutex                m_mutex;
+      std::condition_variable   m_cv;
+    };
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! @class SPSCRingBuffer
+  //!
+  //! Bounded lock-free queue for exactly one producer thread and one consumer
+  //! thread. The read and write positions sit on their own cache lines, and
+  //! each side keeps a cached copy of the other's position so it only reads
+  //! the shared one when the queue looks full (or empty).
+  //!
+  //! TryPushN()/TryPopN() move as many items as fit with a single publish,
+  //! which is much cheaper per item than one at a time. Push() and Pop()
+  //! block until they can complete.
+  //!
+  //! Capacity is rounded up to a power of 2.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename T>
+  class SPSCRingBuffer
+  {
+  public:
+
+    SPSCRingBuffer(size_t a_capacity);
+    ~SPSCRingBuffer();
+
+    SPSCRingBuffer(SPSCRingBuffer const &) = delete;
+    SPSCRingBuffer & operator=(SPSCRingBuffer const &) = delete;
+
+    //! Producer. Returns false if the queue is full.
+    bool TryPush(T const &);
+    bool TryPush(T &&);
+
+    //! Producer. Pushes up to a_count items, returns the number pushed.
+    size_t TryPushN(T const * a_pItems, size_t a_count);
+
+    //! Producer. Blocks while the queue is full.
+    void Push(T const &);
+    void Push(T &&);
+
+    //! Consumer. Returns false if the queue is empty.
+    bool TryPop(T &);
+
+    //! Consumer. Pops up to a_maxCount items, returns the number popped.
+    size_t TryPopN(T * a_pOut, size_t a_maxCount);
+
+    //! Consumer. Blocks while the queue is empty.
+    void Pop(T &);
+
+    //! Only exact when called from the producer or consumer thread while the
+    //! other is idle.
+    size_t size() const;
+    bool empty() const;
+    size_t capacity() const;
+
+  private:
+
+    template<typename U>
+    bool TryPushImpl(U &&);
+    size_t TryPopImpl(T * a_pOut, size_t a_maxCount);
+    T * Slot(size_t a_pos) const;
+
+  private:
+
+    //Consumer's line
+    alignas(impl::cacheLineSize) std::atomic<size_t> m_head;
+    size_t m_cachedTail;
+
+    //Producer's line
+    alignas(impl::cacheLineSize) std::atomic<size_t> m_tail;
+    size_t m_cachedHead;
+
+    alignas(impl::cacheLineSize) T * m_pData;
+    size_t          m_mask;
+    impl::WaitGate  m_notEmpty;
+    impl::WaitGate  m_notFull;
+  };
+
+  //! @ingroup DgContainers
+  //!
+  //! @class MPSCRingBuffer
+  //!
+  //! Bounded lock-free queue for any number of producer threads and one
+  //! consumer thread. Each slot carries a sequence number that says whether
+  //! it is free to write or ready to read, so producers only contend on the
+  //! shared write position, and never wait on each other to finish writing.
+  //!
+  //! TryPushN() claims a run of slots with a single compare-and-swap. Items
+  //! pushed by one producer are popped in the order they were pushed.
+  //!
+  //! Capacity is rounded up to a power of 2.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename T>
+  class MPSCRingBuffer
+  {
+    struct Cell
+    {
+      std::atomic<size_t>       seq;
+      alignas(T) unsigned char  data[sizeof(T)];
+    };
+
+  public:
+
+    MPSCRingBuffer(size_t a_capacity);
+    ~MPSCRingBuffer();
+
+    MPSCRingBuffer(MPSCRingBuffer const &) = delete;
+    MPSCRingBuffer & operator=(MPSCRingBuffer const &) = delete;
+
+    //! Any thread. Returns false if the queue is full.
+    bool TryPush(T const &);
+    bool TryPush(T &&);
+
+    //! Any thread. Pushes up to a_count items as one contiguous run,
+    //! returns the number pushed.
+    size_t TryPushN(T const * a_pItems, size_t a_count);
+
+    //! Any thread. Blocks while the queue is full.
+    void Push(T const &);
+    void Push(T &&);
+
+    //! Consumer. Returns false if the queue is empty.
+    bool TryPop(T &);
+
+    //! Consumer. Pops up to a_maxCount items, returns the number popped.
+    size_t TryPopN(T * a_pOut, size_t a_maxCount);
+
+    //! Consumer. Blocks while the queue is empty.
+    void Pop(T &);
+
+    //! Approximate if other threads are pushing or popping.
+    size_t size() const;
+    bool empty() const;
+    size_t capacity() const;
+
+  private:
+
+    template<typename U>
+    bool TryPushImpl(U &&);
+    size_t TryPopImpl(T * a_pOut, size_t a_maxCount);
+    T * Data(Cell &) const;
+
+  private:
+
+    alignas(impl::cacheLineSize) std::atomic<size_t> m_tail;   //Producers
+    alignas(impl::cacheLineSize) std::atomic<size_t> m_head;   //Consumer
+
+    alignas(impl::cacheLineSize) Cell * m_pCells;
+    size_t          m_mask;
+    impl::WaitGate  m_notEmpty;
+    impl::WaitGate  m_notFull;
+  };
+
+  //--------------------------------------------------------------------------------
+  //		SPSCRingBuffer
+  //--------------------------------------------------------------------------------
+  template<typename T>
+  SPSCRingBuffer<T>::SPSCRingBuffer(size_t a_capacity)
+    : m_head(0)
+    , m_cachedTail(0)
+    , m_tail(0)
+    , m_cachedHead(0)
+    , m_pData(nullptr)
+    , m_mask(impl::NextPowerOf2(a_capacity == 0 ? 1 : a_capacity) - 1)
+  {
+    m_pData = static_cast<T*>(malloc((m_mask + 1) * sizeof(T)));
+    if (m_pData == nullptr)
+      throw std::bad_alloc();
+  }
+
+  template<typename T>
+  SPSCRingBuffer<T>::~SPSCRingBuffer()
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    for (size_t pos = m_head.load(std::memory_order_relaxed); pos != tail; pos++)
+      Slot(pos)->~T();
+    free(m_pData);
+  }
+
+  template<typename T>
+  bool SPSCRingBuffer<T>::TryPush(T const & a_item)
+  {
+    if (!TryPushImpl(a_item))
+      return false;
+    m_notEmpty.Notify();
+    return true;
+  }
+
+  template<typename T>
+  bool SPSCRingBuffer<T>::TryPush(T && a_item)
+  {
+    if (!TryPushImpl(std::move(a_item)))
+      return false;
+    m_notEmpty.Notify();
+    return true;
+  }
+
+  template<typename T>
+  template<typename U>
+  bool SPSCRingBuffer<T>::TryPushImpl(U && a_item)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead > m_mask)
+    {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      if (tail - m_cachedHead > m_mask)
+        return false;
+    }
+
+    new (Slot(tail)) T(std::forward<U>(a_item));
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  template<typename T>
+  size_t SPSCRingBuffer<T>::TryPushN(T const * a_pItems, size_t a_count)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t space = m_mask + 1 - (tail - m_cachedHead);
+    if (space < a_count)
+    {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      space = m_mask + 1 - (tail - m_cachedHead);
+    }
+
+    size_t n = (space < a_count) ? space : a_count;
+    if (n == 0)
+      return 0;
+
+    for (size_t i = 0; i < n; i++)
+      new (Slot(tail + i)) T(a_pItems[i]);
+    m_tail.store(tail + n, std::memory_order_release);
+    m_notEmpty.Notify();
+    return n;
+  }
+
+  template<typename T>
+  void SPSCRingBuffer<T>::Push(T const & a_item)
+  {
+    while (!TryPushImpl(a_item))
+      m_notFull.Wait([this]() {return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire) <= m_mask;});
+    m_notEmpty.Notify();
+  }
+
+  template<typename T>
+  void SPSCRingBuffer<T>::Push(T && a_item)
+  {
+    while (!TryPushImpl(std::move(a_item)))
+      m_notFull.Wait([this]() {return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire) <= m_mask;});
+    m_notEmpty.Notify();
+  }
+
+  template<typename T>
+  bool SPSCRingBuffer<T>::TryPop(T & a_out)
+  {
+    return TryPopN(&a_out, 1) == 1;
+  }
+
+  template<typename T>
+  size_t SPSCRingBuffer<T>::TryPopN(T * a_pOut, size_t a_maxCount)
+  {
+    size_t n = TryPopImpl(a_pOut, a_maxCount);
+    if (n != 0)
+      m_notFull.Notify();
+    return n;
+  }
+
+  template<typename T>
+  size_t SPSCRingBuffer<T>::TryPopImpl(T * a_pOut, size_t a_maxCount)
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t available = m_cachedTail - head;
+    if (available < a_maxCount)
+    {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+      available = m_cachedTail - head;
+    }
+
+    size_t n = (available < a_maxCount) ? available : a_maxCount;
+    if (n == 0)
+      return 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+      T * pItem = Slot(head + i);
+      a_pOut[i] = std::move(*pItem);
+      pItem->~T();
+    }
+    m_head.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  template<typename T>
+  void SPSCRingBuffer<T>::Pop(T & a_out)
+  {
+    while (TryPopImpl(&a_out, 1) == 0)
+      m_notEmpty.Wait([this]() {return m_tail.load(std::memory_order_acquire) != m_head.load(std::memory_order_relaxed);});
+    m_notFull.Notify();
+  }
+
+  template<typename T>
+  size_t SPSCRingBuffer<T>::size() const
+  {
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+  }
+
+  template<typename T>
+  bool SPSCRingBuffer<T>::empty() const
+  {
+    return size() == 0;
+  }
+
+  template<typename T>
+  size_t SPSCRingBuffer<T>::capacity() const
+  {
+    return m_mask + 1;
+  }
+
+  template<typename T>
+  T * SPSCRingBuffer<T>::Slot(size_t a_pos) const
+  {
+    return &m_pData[a_pos & m_mask];
+  }
+
+  //--------------------------------------------------------------------------------
+  //		MPSCRingBuffer
+  //--------------------------------------------------------------------------------
+  template<typename T>
+  MPSCRingBuffer<T>::MPSCRingBuffer(size_t a_capacity)
+    : m_tail(0)
+    , m_head(0)
+    , m_pCells(nullptr)
+    , m_mask(impl::NextPowerOf2(a_capacity < 2 ? 2 : a_capacity) - 1)
+  {
+    m_pCells = static_cast<Cell*>(malloc((m_mask + 1) * sizeof(Cell)));
+    if (m_pCells == nullptr)
+      throw std::bad_alloc();
+
+    //A cell is free to write at position pos when seq == pos,
+    //and ready to read when seq == pos + 1.
+    for (size_t i = 0; i <= m_mask; i++)
+      new (&m_pCells[i].seq) std::atomic<size_t>(i);
+  }
+
+  template<typename T>
+  MPSCRingBuffer<T>::~MPSCRingBuffer()
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    for (size_t pos = m_head.load(std::memory_order_relaxed); pos != tail; pos++)
+    {
+      Cell & cell = m_pCells[pos & m_mask];
+      if (cell.seq.load(std::memory_order_relaxed) == pos + 1)
+        Data(cell)->~T();
+    }
+    free(m_pCells);
+  }
+
+  template<typename T>
+  bool MPSCRingBuffer<T>::TryPush(T const & a_item)
+  {
+    if (!TryPushImpl(a_item))
+      return false;
+    m_notEmpty.Notify();
+    return true;
+  }
+
+  template<typename T>
+  bool MPSCRingBuffer<T>::TryPush(T && a_item)
+  {
+    if (!TryPushImpl(std::move(a_item)))
+      return false;
+    m_notEmpty.Notify();
+    return true;
+  }
+
+  template<typename T>
+  template<typename U>
+  bool MPSCRingBuffer<T>::TryPushImpl(U && a_item)
+  {
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Cell & cell = m_pCells[pos & m_mask];
+      size_t seq = cell.seq.load(std::memory_order_acquire);
+      ptrdiff_t diff = static_cast<ptrdiff_t>(seq - pos);
+      if (diff == 0)
+      {
+        if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          new (Data(cell)) T(std::forward<U>(a_item));
+          cell.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template<typename T>
+  size_t MPSCRingBuffer<T>::TryPushN(T const * a_pItems, size_t a_count)
+  {
+    if (a_count == 0)
+      return 0;
+
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+      //Count the free cells from pos on
+      size_t n = 0;
+      for (; n < a_count && n <= m_mask; n++)
+      {
+        size_t seq = m_pCells[(pos + n) & m_mask].seq.load(std::memory_order_acquire);
+        if (seq != pos + n)
+          break;
+      }
+
+      if (n == 0)
+      {
+        size_t seq = m_pCells[pos & m_mask].seq.load(std::memory_order_acquire);
+        if (static_cast<ptrdiff_t>(seq - pos) < 0)
+          return 0;
+        pos = m_tail.load(std::memory_order_relaxed);
+        continue;
+      }
+
+      if (m_tail.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+      {
+        for (size_t i = 0; i < n; i++)
+        {
+          Cell & cell = m_pCells[(pos + i) & m_mask];
+          new (Data(cell)) T(a_pItems[i]);
+          cell.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        m_notEmpty.Notify();
+        return n;
+      }
+    }
+  }
+
+  template<typename T>
+  void MPSCRingBuffer<T>::Push(T const & a_item)
+  {
+    while (!TryPushImpl(a_item))
+      m_notFull.Wait([this]()
+      {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        return m_pCells[pos & m_mask].seq.load(std::memory_order_acquire) == pos;
+      });
+    m_notEmpty.Notify();
+  }
+
+  template<typename T>
+  void MPSCRingBuffer<T>::Push(T && a_item)
+  {
+    while (!TryPushImpl(std::move(a_item)))
+      m_notFull.Wait([this]()
+      {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        return m_pCells[pos & m_mask].seq.load(std::memory_order_acquire) == pos;
+      });
+    m_notEmpty.Notify();
+  }
+
+  template<typename T>
+  bool MPSCRingBuffer<T>::TryPop(T & a_out)
+  {
+    return TryPopN(&a_out, 1) == 1;
+  }
+
+  template<typename T>
+  size_t MPSCRingBuffer<T>::TryPopN(T * a_pOut, size_t a_maxCount)
+  {
+    size_t n = TryPopImpl(a_pOut, a_maxCount);
+    if (n != 0)
+      m_notFull.Notify();
+    return n;
+  }
+
+  template<typename T>
+  size_t MPSCRingBuffer<T>::TryPopImpl(T * a_pOut, size_t a_maxCount)
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t n = 0;
+    for (; n < a_maxCount; n++)
+    {
+      Cell & cell = m_pCells[(head + n) & m_mask];
+      if (cell.seq.load(std::memory_order_acquire) != head + n + 1)
+        break;
+
+      T * pItem = Data(cell);
+      a_pOut[n] = std::move(*pItem);
+      pItem->~T();
+      cell.seq.store(head + n + m_mask + 1, std::memory_order_release);
+    }
+
+    if (n != 0)
+      m_head.store(head + n, std::memory_order_relaxed);
+    return n;
+  }
+
+  template<typename T>
+  void MPSCRingBuffer<T>::Pop(T & a_out)
+  {
+    while (TryPopImpl(&a_out, 1) == 0)
+      m_notEmpty.Wait([this]()
+      {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        return m_pCells[head & m_mask].seq.load(std::memory_order_acquire) == head + 1;
+      });
+    m_notFull.Notify();
+  }
+
+  template<typename T>
+  size_t MPSCRingBuffer<T>::size() const
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    return (tail > head) ? tail - head : 0;
+  }
+
+  template<typename T>
+  bool MPSCRingBuffer<T>::empty() const
+  {
+    return size() == 0;
+  }
+
+  template<typename T>
+  size_t MPSCRingBuffer<T>::capacity() const
+  {
+    return m_mask + 1;
+  }
+
+  template<typename T>
+  T * MPSCRingBuffer<T>::Data(Cell & a_cell) const
+  {
+    return reinterpret_cast<T *>(a_cell.data);
+  }
+}
+
+#endif
@@ -0,0 +1,659 @@
+//! @file DgSlotMap.h
+//!
+//! @author Frank Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: SlotMap
+
+#ifndef DGSLOTMAP_H
+#define DGSLOTMAP_H
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <stdint.h>
+
+#include "impl/DgContainerBase.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! 32 bit handles: 1M slots, 2048 reuses of a slot.
+    //! 64 bit handles: 4G slots, 2G reuses of a slot.
+    template<typename Handle>
+    struct SlotMapIndexBits
+    {
+      static unsigned const value = (sizeof(Handle) <= 4) ? 20 : 32;
+    };
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! @class SlotMap
+  //!
+  //! Stores values behind handles that can be checked for staleness.
+  //!
+  //! A handle is an unsigned integer holding a slot index in its low
+  //! IndexBits bits and the slot's generation in the rest. The generation
+  //! changes every time the slot is filled or emptied, so a handle to an
+  //! erased value never finds the value that later reuses its slot. Freed
+  //! slots are reused oldest first, and a slot whose generation runs out
+  //! is retired rather than reused. A handle of 0 is never valid.
+  //!
+  //! Values are kept packed in a dense array, so iterating with begin()/end()
+  //! is a straight walk over memory. insert, erase and find are O(1). Erasing
+  //! moves the last value into the hole, so pointers to values and the order
+  //! of the dense array are not stable; handles are.
+  //!
+  //! As with DynamicArray, values are moved around in memory with realloc and
+  //! memcpy, so T must be safe to relocate that way.
+  //!
+  //! @author Frank Hart
+  //! @date 19/10/2026
+  template<typename T,
+           typename Handle = uint32_t,
+           unsigned IndexBits = impl::SlotMapIndexBits<Handle>::value>
+  class SlotMap : public ContainerBase
+  {
+    static_assert(std::is_unsigned<Handle>::value, "Handle must be an unsigned integer");
+    static_assert(IndexBits > 0 && IndexBits < sizeof(Handle) * 8 - 1, "Handle needs bits for both index and generation");
+
+    struct Slot
+    {
+      Handle generation;  //Odd while the slot holds a value
+      Handle index;       //Index into the dense array, or the next free slot
+    };
+
+  public:
+
+    typedef Handle HandleType;
+
+    //! Never returned by insert()
+    static Handle const InvalidHandle = 0;
+
+  public:
+
+    SlotMap();
+    SlotMap(size_t a_nItems);
+    ~SlotMap();
+
+    SlotMap(SlotMap const &);
+    SlotMap & operator=(SlotMap const &);
+
+    SlotMap(SlotMap &&);
+    SlotMap & operator=(SlotMap &&);
+
+    //! Returns the handle of the new value.
+    //! Throws std::length_error if all slots are in use.
+    Handle insert(T const &);
+
+    template<typename... Args>
+    Handle emplace(Args &&... a_args);
+
+    //! Returns false if the handle is stale or invalid.
+    bool erase(Handle);
+
+    //! Returns nullptr if the handle is stale or invalid.
+    T * find(Handle);
+    T const * find(Handle) const;
+
+    bool contains(Handle) const;
+
+    //! Throws std::out_of_range if the handle is stale or invalid.
+    T & at(Handle);
+    T const & at(Handle) const;
+
+    //! No checks.
+    T & operator[](Handle);
+    T const & operator[](Handle) const;
+
+    size_t size() const;
+    bool empty() const;
+
+    //! Make room for a_nItems values without growing.
+    void reserve(size_t a_nItems);
+
+    //! Erases all values. Every outstanding handle becomes stale.
+    void clear();
+
+    //! The dense array of values.
+    T * begin();
+    T * end();
+    T const * begin() const;
+    T const * end() const;
+    T * data();
+    T const * data() const;
+
+    //! Handle of the value at a_index in the dense array.
+    Handle handle_at(size_t a_index) const;
+
+  private:
+
+    static Handle MakeHandle(Handle a_index, Handle a_generation);
+    static Handle Index(Handle);
+    static Handle Generation(Handle);
+
+    Slot const * GetSlot(Handle) const;
+    Handle NewSlot();
+    void FreeSlot(Handle a_slot);
+
+    //! Moves the dense array to a larger block with a new value, built from
+    //! a_args, at m_nItems. The new value is built before the old values move,
+    //! so a_args may refer to one of them.
+    template<typename... Args>
+    void GrowDense(Args &&... a_args);
+
+    void GrowSlots();
+    void Init(SlotMap const &);
+    void Release();
+    void ReportMemory() override;
+
+  private:
+
+    static Handle const s_indexMask = (Handle(1) << IndexBits) - 1;
+    static Handle const s_maxGeneration = Handle(~Handle(0)) >> IndexBits;
+    static Handle const s_noSlot = s_indexMask;   //Also caps the number of slots
+
+    T *       m_pData;
+    Handle *  m_pDenseSlot;     //Slot of each value in the dense array
+    size_t    m_nItems;
+
+    Slot *    m_pSlots;
+    size_t    m_nSlots;
+    size_t    m_slotCapacity;
+    Handle    m_freeHead;
+    Handle    m_freeTail;
+  };
+
+  //--------------------------------------------------------------------------------
+  //		SlotMap
+  //--------------------------------------------------------------------------------
+  template<typename T, typename Handle, unsigned IndexBits>
+  SlotMap<T, Handle, IndexBits>::SlotMap()
+    : SlotMap(0)
+  {
+
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  SlotMap<T, Handle, IndexBits>::SlotMap(size_t a_nItems)
+    : ContainerBase(a_nItems)
+    , m_pData(nullptr)
+    , m_pDenseSlot(nullptr)
+    , m_nItems(0)
+    , m_pSlots(nullptr)
+    , m_nSlots(0)
+    , m_slotCapacity(0)
+    , m_freeHead(s_noSlot)
+    , m_freeTail(s_noSlot)
+  {
+
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  SlotMap<T, Handle, IndexBits>::~SlotMap()
+  {
+    Release();
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  SlotMap<T, Handle, IndexBits>::SlotMap(SlotMap const & a_other)
+    : ContainerBase(a_other)
+    , m_pData(nullptr)
+    , m_pDenseSlot(nullptr)
+    , m_nItems(0)
+    , m_pSlots(nullptr)
+    , m_nSlots(0)
+    , m_slotCapacity(0)
+    , m_freeHead(s_noSlot)
+    , m_freeTail(s_noSlot)
+  {
+    Init(a_other);
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  SlotMap<T, Handle, IndexBits> & SlotMap<T, Handle, IndexBits>::operator=(SlotMap const & a_other)
+  {
+    if (this != &a_other)
+    {
+      Release();
+      pool_size(a_other.pool_size());
+      Init(a_other);
+    }
+    return *this;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  SlotMap<T, Handle, IndexBits>::SlotMap(SlotMap && a_other)
+    : ContainerBase(std::move(a_other))
+    , m_pData(a_other.m_pData)
+    , m_pDenseSlot(a_other.m_pDenseSlot)
+    , m_nItems(a_other.m_nItems)
+    , m_pSlots(a_other.m_pSlots)
+    , m_nSlots(a_other.m_nSlots)
+    , m_slotCapacity(a_other.m_slotCapacity)
+    , m_freeHead(a_other.m_freeHead)
+    , m_freeTail(a_other.m_freeTail)
+  {
+    a_other.m_pData = nullptr;
+    a_other.m_pDenseSlot = nullptr;
+    a_other.m_nItems = 0;
+    a_other.m_pSlots = nullptr;
+    a_other.Release();
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  SlotMap<T, Handle, IndexBits> & SlotMap<T, Handle, IndexBits>::operator=(SlotMap && a_other)
+  {
+    if (this != &a_other)
+    {
+      Release();
+      ContainerBase::operator=(std::move(a_other));
+
+      m_pData = a_other.m_pData;
+      m_pDenseSlot = a_other.m_pDenseSlot;
+      m_nItems = a_other.m_nItems;
+      m_pSlots = a_other.m_pSlots;
+      m_nSlots = a_other.m_nSlots;
+      m_slotCapacity = a_other.m_slotCapacity;
+      m_freeHead = a_other.m_freeHead;
+      m_freeTail = a_other.m_freeTail;
+
+      a_other.m_pData = nullptr;
+      a_other.m_pDenseSlot = nullptr;
+      a_other.m_nItems = 0;
+      a_other.m_pSlots = nullptr;
+      a_other.Release();
+      MemoryChanged();
+    }
+    return *this;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  Handle SlotMap<T, Handle, IndexBits>::insert(T const & a_item)
+  {
+    return emplace(a_item);
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  template<typename... Args>
+  Handle SlotMap<T, Handle, IndexBits>::emplace(Args &&... a_args)
+  {
+    if (m_pData == nullptr)
+      reserve(pool_size());
+
+    //Construct first so nothing changes if T throws
+    if (m_nItems < pool_size())
+      new (&m_pData[m_nItems]) T(std::forward<Args>(a_args)...);
+    else
+      GrowDense(std::forward<Args>(a_args)...);
+
+    Handle slotIndex;
+    try
+    {
+      slotIndex = NewSlot();
+    }
+    catch (...)
+    {
+      m_pData[m_nItems].~T();
+      throw;
+    }
+
+    Slot & slot = m_pSlots[slotIndex];
+    slot.generation++;
+    slot.index = static_cast<Handle>(m_nItems);
+    m_pDenseSlot[m_nItems] = slotIndex;
+    m_nItems++;
+
+    MemoryChanged();
+    return MakeHandle(slotIndex, slot.generation);
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  bool SlotMap<T, Handle, IndexBits>::erase(Handle a_handle)
+  {
+    Slot const * pSlot = GetSlot(a_handle);
+    if (pSlot == nullptr)
+      return false;
+
+    size_t dense = pSlot->index;
+    size_t last = m_nItems - 1;
+    m_pData[dense].~T();
+    if (dense != last)
+    {
+      memcpy(&m_pData[dense], &m_pData[last], sizeof(T));
+      m_pDenseSlot[dense] = m_pDenseSlot[last];
+      m_pSlots[m_pDenseSlot[dense]].index = static_cast<Handle>(dense);
+    }
+    m_nItems--;
+
+    FreeSlot(Index(a_handle));
+    MemoryChanged();
+    return true;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T * SlotMap<T, Handle, IndexBits>::find(Handle a_handle)
+  {
+    Slot const * pSlot = GetSlot(a_handle);
+    return (pSlot == nullptr) ? nullptr : &m_pData[pSlot->index];
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T const * SlotMap<T, Handle, IndexBits>::find(Handle a_handle) const
+  {
+    Slot const * pSlot = GetSlot(a_handle);
+    return (pSlot == nullptr) ? nullptr : &m_pData[pSlot->index];
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  bool SlotMap<T, Handle, IndexBits>::contains(Handle a_handle) const
+  {
+    return GetSlot(a_handle) != nullptr;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T & SlotMap<T, Handle, IndexBits>::at(Handle a_handle)
+  {
+    T * pItem = find(a_handle);
+    if (pItem == nullptr)
+      throw std::out_of_range("SlotMap: stale or invalid handle");
+    return *pItem;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T const & SlotMap<T, Handle, IndexBits>::at(Handle a_handle) const
+  {
+    T const * pItem = find(a_handle);
+    if (pItem == nullptr)
+      throw std::out_of_range("SlotMap: stale or invalid handle");
+    return *pItem;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T & SlotMap<T, Handle, IndexBits>::operator[](Handle a_handle)
+  {
+    return m_pData[m_pSlots[Index(a_handle)].index];
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T const & SlotMap<T, Handle, IndexBits>::operator[](Handle a_handle) const
+  {
+    return m_pData[m_pSlots[Index(a_handle)].index];
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  size_t SlotMap<T, Handle, IndexBits>::size() const
+  {
+    return m_nItems;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  bool SlotMap<T, Handle, IndexBits>::empty() const
+  {
+    return m_nItems == 0;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  void SlotMap<T, Handle, IndexBits>::reserve(size_t a_nItems)
+  {
+    if (m_pData != nullptr && a_nItems <= pool_size())
+      return;
+
+    ReallocTimer timer(*this);
+    pool_size(a_nItems < m_nItems ? m_nItems : a_nItems);
+
+    T * pData = static_cast<T*>(realloc(m_pData, pool_size() * sizeof(T)));
+    if (pData == nullptr)
+      throw std::bad_alloc();
+    m_pData = pData;
+
+    Handle * pDenseSlot = static_cast<Handle*>(realloc(m_pDenseSlot, pool_size() * sizeof(Handle)));
+    if (pDenseSlot == nullptr)
+      throw std::bad_alloc();
+    m_pDenseSlot = pDenseSlot;
+
+    MemoryChanged();
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  void SlotMap<T, Handle, IndexBits>::clear()
+  {
+    for (size_t i = 0; i < m_nItems; i++)
+    {
+      m_pData[i].~T();
+      FreeSlot(m_pDenseSlot[i]);
+    }
+    m_nItems = 0;
+    MemoryChanged();
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T * SlotMap<T, Handle, IndexBits>::begin()
+  {
+    return m_pData;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T * SlotMap<T, Handle, IndexBits>::end()
+  {
+    return m_pData + m_nItems;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T const * SlotMap<T, Handle, IndexBits>::begin() const
+  {
+    return m_pData;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T const * SlotMap<T, Handle, IndexBits>::end() const
+  {
+    return m_pData + m_nItems;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T * SlotMap<T, Handle, IndexBits>::data()
+  {
+    return m_pData;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  T const * SlotMap<T, Handle, IndexBits>::data() const
+  {
+    return m_pData;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  Handle SlotMap<T, Handle, IndexBits>::handle_at(size_t a_index) const
+  {
+    Handle slotIndex = m_pDenseSlot[a_index];
+    return MakeHandle(slotIndex, m_pSlots[slotIndex].generation);
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  Handle SlotMap<T, Handle, IndexBits>::MakeHandle(Handle a_index, Handle a_generation)
+  {
+    return static_cast<Handle>((a_generation << IndexBits) | a_index);
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  Handle SlotMap<T, Handle, IndexBits>::Index(Handle a_handle)
+  {
+    return a_handle & s_indexMask;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  Handle SlotMap<T, Handle, IndexBits>::Generation(Handle a_handle)
+  {
+    return a_handle >> IndexBits;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  typename SlotMap<T, Handle, IndexBits>::Slot const *
+    SlotMap<T, Handle, IndexBits>::GetSlot(Handle a_handle) const
+  {
+    Handle index = Index(a_handle);
+    Handle generation = Generation(a_handle);
+    if (index >= m_nSlots || (generation & 1) == 0)
+      return nullptr;
+
+    Slot const * pSlot = &m_pSlots[index];
+    return (pSlot->generation == generation) ? pSlot : nullptr;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  Handle SlotMap<T, Handle, IndexBits>::NewSlot()
+  {
+    if (m_freeHead != s_noSlot)
+    {
+      Handle result = m_freeHead;
+      m_freeHead = m_pSlots[result].index;
+      if (m_freeHead == s_noSlot)
+        m_freeTail = s_noSlot;
+      return result;
+    }
+
+    if (m_nSlots >= s_noSlot)
+      throw std::length_error("SlotMap: out of slots");
+
+    if (m_nSlots == m_slotCapacity)
+      GrowSlots();
+
+    m_pSlots[m_nSlots].generation = 0;
+    m_pSlots[m_nSlots].index = s_noSlot;
+    return static_cast<Handle>(m_nSlots++);
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  void SlotMap<T, Handle, IndexBits>::FreeSlot(Handle a_slot)
+  {
+    Slot & slot = m_pSlots[a_slot];
+    slot.index = s_noSlot;
+
+    //Retire the slot if another fill would overflow its generation
+    if (slot.generation >= s_maxGeneration)
+    {
+      slot.generation = 0;
+      return;
+    }
+    slot.generation++;
+
+    if (m_freeTail == s_noSlot)
+      m_freeHead = a_slot;
+    else
+      m_pSlots[m_freeTail].index = a_slot;
+    m_freeTail = a_slot;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  template<typename... Args>
+  void SlotMap<T, Handle, IndexBits>::GrowDense(Args &&... a_args)
+  {
+    ReallocTimer timer(*this);
+    size_t oldPoolSize = pool_size();
+    set_next_pool_size();
+
+    //A dense slot array larger than the data is harmless if we fail below
+    Handle * pDenseSlot = static_cast<Handle*>(realloc(m_pDenseSlot, pool_size() * sizeof(Handle)));
+    if (pDenseSlot == nullptr)
+    {
+      pool_size(oldPoolSize);
+      throw std::bad_alloc();
+    }
+    m_pDenseSlot = pDenseSlot;
+
+    T * pData = static_cast<T*>(malloc(pool_size() * sizeof(T)));
+    if (pData == nullptr)
+    {
+      pool_size(oldPoolSize);
+      throw std::bad_alloc();
+    }
+
+    try
+    {
+      new (&pData[m_nItems]) T(std::forward<Args>(a_args)...);
+    }
+    catch (...)
+    {
+      free(pData);
+      pool_size(oldPoolSize);
+      throw;
+    }
+
+    memcpy(pData, m_pData, m_nItems * sizeof(T));
+    free(m_pData);
+    m_pData = pData;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  void SlotMap<T, Handle, IndexBits>::GrowSlots()
+  {
+    ReallocTimer timer(*this);
+    size_t newCapacity = (m_slotCapacity == 0) ? pool_size() : m_slotCapacity * 2;
+    Slot * pSlots = static_cast<Slot*>(realloc(m_pSlots, newCapacity * sizeof(Slot)));
+    if (pSlots == nullptr)
+      throw std::bad_alloc();
+    m_pSlots = pSlots;
+    m_slotCapacity = newCapacity;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  void SlotMap<T, Handle, IndexBits>::Init(SlotMap const & a_other)
+  {
+    reserve(a_other.m_nItems);
+    if (a_other.m_nSlots != 0)
+    {
+      m_pSlots = static_cast<Slot*>(malloc(a_other.m_nSlots * sizeof(Slot)));
+      if (m_pSlots == nullptr)
+        throw std::bad_alloc();
+      memcpy(m_pSlots, a_other.m_pSlots, a_other.m_nSlots * sizeof(Slot));
+    }
+    m_nSlots = a_other.m_nSlots;
+    m_slotCapacity = a_other.m_nSlots;
+    m_freeHead = a_other.m_freeHead;
+    m_freeTail = a_other.m_freeTail;
+
+    for (; m_nItems < a_other.m_nItems; m_nItems++)
+    {
+      new (&m_pData[m_nItems]) T(a_other.m_pData[m_nItems]);
+      m_pDenseSlot[m_nItems] = a_other.m_pDenseSlot[m_nItems];
+    }
+    MemoryChanged();
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  void SlotMap<T, Handle, IndexBits>::Release()
+  {
+    for (size_t i = 0; i < m_nItems; i++)
+      m_pData[i].~T();
+
+    free(m_pData);
+    free(m_pDenseSlot);
+    free(m_pSlots);
+
+    m_pData = nullptr;
+    m_pDenseSlot = nullptr;
+    m_nItems = 0;
+    m_pSlots = nullptr;
+    m_nSlots = 0;
+    m_slotCapacity = 0;
+    m_freeHead = s_noSlot;
+    m_freeTail = s_noSlot;
+  }
+
+  template<typename T, typename Handle, unsigned IndexBits>
+  void SlotMap<T, Handle, IndexBits>::ReportMemory()
+  {
+    size_t reserved = (m_pData == nullptr) ? 0 : pool_size() * (sizeof(T) + sizeof(Handle));
+    reserved += m_slotCapacity * sizeof(Slot);
+    size_t used = m_nItems * (sizeof(T) + sizeof(Handle)) + m_nSlots * sizeof(Slot);
+    TrackMemory(reserved, used, m_nItems);
+  }
+}
+
+#endif
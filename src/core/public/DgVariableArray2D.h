@@ -8,23 +8,30 @@
 #ifndef DGVARIABLEARRAY2D_H
 #define DGVARIABLEARRAY2D_H
 
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <sstream>
+#include <stdexcept>
+#include <vector>
 
-#include "DgDynamicArray.h"
+#include "impl/DgContainerBase.h"
+#include "impl/DgParallelFor.h"
 
-//TODO check for nullptr returns in realloc and throw
 namespace Dg
 {
   //! @ingroup DgContainers
   //!
   //! @class VariableArray2D
   //!
-  //! @brief Contiguous array, similar to std::vector.
+  //! @brief A 2D array where each row can have a different number of elements.
   //!
-  //! http://www.cplusplus.com/reference/VariableArray2D/VariableArray2D/
-  //!
-  //! Similar to std::vector. Constructors/destructors are not called, so use for pod types only.
+  //! All elements live in one buffer, each row being a contiguous run given
+  //! by a start and count. After BuildFromPairs() or compact() the rows are
+  //! packed back to back in row order, so data() together with the row starts
+  //! is a compressed sparse row (CSR) layout.
   //!
+  //! Constructors/destructors are not called, so use for pod types only.
   //!
   //! @author Frank Hart
   //! @date 7/01/2014
@@ -62,21 +69,65 @@ namespace Dg
     //! Accessor
     T const & at(size_t row, size_t element) const;
 
+    //! Pointer to the first element of a row.
+    T * row(size_t a_row);
+
+    //! Pointer to the first element of a row.
+    T const * row(size_t a_row) const;
+
     //! Current size of the array
     size_t rows() const
     {
-      return m_indices.size();
+      return m_nRows;
     }
 
     size_t elements(size_t a_row) const
     {
       rangeCheckRow(a_row);
-      return m_indices.size();
+      return m_pIndices[a_row].count;
+    }
+
+    //! Total number of elements over all rows.
+    size_t elements() const
+    {
+      return m_nData - m_nHoles;
     }
 
+    //! Start of the element buffer. Only packed in row order after
+    //! BuildFromPairs() or compact().
+    T * data();
+    T const * data() const;
+
     //! Add element to the back of the array.
     void push_back(T const * pItems, size_t count);
 
+    //! Replaces the contents with a_nRows rows built from a_nValues
+    //! (row, value) pairs. a_pValues[i] is appended to row a_pRows[i]; values
+    //! within a row keep the order they were given in.
+    //!
+    //! This is a counting sort: one pass counts the elements per row, the
+    //! counts are prefix summed into the row starts, and a second pass
+    //! scatters the values into place. Large inputs are split over
+    //! a_nThreads threads (0 = one per hardware thread).
+    //!
+    //! Throws std::out_of_range, leaving the array unchanged, if any row is
+    //! >= a_nRows.
+    void BuildFromPairs(size_t a_nRows,
+                        size_t const * a_pRows,
+                        T const * a_pValues,
+                        size_t a_nValues,
+                        unsigned a_nThreads = 0);
+
+    //! Sets the number of elements in a row. New elements are set to a_fill.
+    //! Shrinking, or growing the last row in the buffer, is done in place.
+    //! Otherwise the row is moved to the end of the buffer. The space it
+    //! leaves is reclaimed by compact(), which is called automatically once
+    //! more than half the buffer is unused.
+    void resize_row(size_t a_row, size_t a_count, T const & a_fill = T());
+
+    //! Packs the rows back to back in row order.
+    void compact();
+
     void clear();
 
   private:
@@ -84,6 +135,11 @@ namespace Dg
     void rangeCheck(size_t a_row, size_t a_element) const;
     void rangeCheckRow(size_t a_row) const;
 
+    void ReserveData(size_t a_nItems);
+    void ReserveRows(size_t a_nRows);
+    void ReportMemory() override;
+    void Release();
+
     //Data members
     struct Index
     {
@@ -91,12 +147,25 @@ namespace Dg
       size_t count;
     };
 
-    DynamicArray<T>     m_data;
-    DynamicArray<Index> m_indices;
+    T *       m_pData;
+    size_t    m_nData;        //End of the used part of m_pData, including holes
+    size_t    m_nHoles;       //Elements left behind by rows that were moved
+    Index *   m_pIndices;
+    size_t    m_nRows;
+    size_t    m_rowCapacity;
   };
 
+  //--------------------------------------------------------------------------------
+  //		VariableArray2D
+  //--------------------------------------------------------------------------------
   template<class T>
-  VariableArray2D<T>::VariableArray2D() 
+  VariableArray2D<T>::VariableArray2D()
+    : m_pData(nullptr)
+    , m_nData(0)
+    , m_nHoles(0)
+    , m_pIndices(nullptr)
+    , m_nRows(0)
+    , m_rowCapacity(0)
   {
 
   }
@@ -104,23 +173,39 @@ namespace Dg
   template<class T>
   VariableArray2D<T>::~VariableArray2D()
   {
-
+    Release();
   }
 
   template<class T>
   VariableArray2D<T>::VariableArray2D(VariableArray2D<T> const & a_other)
-    : m_data(a_other.m_data)
-    , m_indices(a_other.m_indices)
+    : ContainerBase(a_other)
+    , m_pData(nullptr)
+    , m_nData(0)
+    , m_nHoles(0)
+    , m_pIndices(nullptr)
+    , m_nRows(0)
+    , m_rowCapacity(0)
   {
-
+    *this = a_other;
   }
 
   template<class T>
-  VariableArray2D<T>::VariableArray2D(VariableArray2D<T> && a_other) 
-    : m_data(std::move(a_other.m_data))
-    , m_indices(std::move(a_other.m_indices))
+  VariableArray2D<T>::VariableArray2D(VariableArray2D<T> && a_other)
+    : ContainerBase(std::move(a_other))
+    , m_pData(a_other.m_pData)
+    , m_nData(a_other.m_nData)
+    , m_nHoles(a_other.m_nHoles)
+    , m_pIndices(a_other.m_pIndices)
+    , m_nRows(a_other.m_nRows)
+    , m_rowCapacity(a_other.m_rowCapacity)
   {
-
+    a_other.m_pData = nullptr;
+    a_other.m_nData = 0;
+    a_other.m_nHoles = 0;
+    a_other.m_pIndices = nullptr;
+    a_other.m_nRows = 0;
+    a_other.m_rowCapacity = 0;
+    a_other.MemoryChanged();
   }
 
   template<class T>
@@ -128,8 +213,25 @@ namespace Dg
   {
     if (this != &a_other)
     {
-      m_data = std::move(a_other.m_data);
-      m_indices = std::move(a_other.m_indices);
+      Release();
+      ContainerBase::operator=(std::move(a_other));
+
+      m_pData = a_other.m_pData;
+      m_nData = a_other.m_nData;
+      m_nHoles = a_other.m_nHoles;
+      m_pIndices = a_other.m_pIndices;
+      m_nRows = a_other.m_nRows;
+      m_rowCapacity = a_other.m_rowCapacity;
+
+      a_other.m_pData = nullptr;
+      a_other.m_nData = 0;
+      a_other.m_nHoles = 0;
+      a_other.m_pIndices = nullptr;
+      a_other.m_nRows = 0;
+      a_other.m_rowCapacity = 0;
+
+      MemoryChanged();
+      a_other.MemoryChanged();
     }
     return *this;
   }
@@ -139,8 +241,17 @@ namespace Dg
   {
     if (this != &a_other)
     {
-      m_data = a_other.m_data;
-      m_indices = a_other.m_indices;
+      clear();
+      ReserveData(a_other.m_nData);
+      ReserveRows(a_other.m_nRows);
+      if (a_other.m_nData != 0)
+        memcpy(m_pData, a_other.m_pData, a_other.m_nData * sizeof(T));
+      if (a_other.m_nRows != 0)
+        memcpy(m_pIndices, a_other.m_pIndices, a_other.m_nRows * sizeof(Index));
+      m_nData = a_other.m_nData;
+      m_nHoles = a_other.m_nHoles;
+      m_nRows = a_other.m_nRows;
+      MemoryChanged();
     }
     return *this;
   }
@@ -148,63 +259,263 @@ namespace Dg
   template<class T>
   void VariableArray2D<T>::push_back(T const * a_pItems, size_t a_count)
   {
-    Index ind;
-    ind.start = m_data.size();
-    ind.count = a_count;
+    ReserveData(m_nData + a_count);
+    ReserveRows(m_nRows + 1);
 
-    m_indices.push_back(ind);
+    Index & ind = m_pIndices[m_nRows];
+    ind.start = m_nData;
+    ind.count = a_count;
 
     for (size_t i = 0; i < a_count; i++)
-      m_data.push_back(a_pItems[i]);
+      m_pData[m_nData + i] = a_pItems[i];
+
+    m_nData += a_count;
+    m_nRows++;
+    MemoryChanged();
+  }
+
+  template<class T>
+  void VariableArray2D<T>::BuildFromPairs(size_t a_nRows,
+                                          size_t const * a_pRows,
+                                          T const * a_pValues,
+                                          size_t a_nValues,
+                                          unsigned a_nThreads)
+  {
+    unsigned nThreads = impl::ThreadCount(a_nValues, a_nThreads);
+
+    //Each thread keeps a count per row. Don't let these tables outgrow the input.
+    if (a_nRows != 0 && a_nValues / a_nRows < nThreads)
+      nThreads = (a_nValues / a_nRows == 0) ? 1 : static_cast<unsigned>(a_nValues / a_nRows);
+
+    //counts[t * a_nRows + r] : elements of row r in the range of thread t
+    std::vector<size_t> counts(nThreads * a_nRows, 0);
+    std::vector<char> outOfRange(nThreads, 0);
+
+    impl::ParallelFor(a_nValues, nThreads, [&](size_t a_begin, size_t a_end, unsigned a_t)
+    {
+      size_t * pCounts = counts.data() + a_t * a_nRows;
+      for (size_t i = a_begin; i < a_end; i++)
+      {
+        if (a_pRows[i] >= a_nRows)
+        {
+          outOfRange[a_t] = 1;
+          return;
+        }
+        pCounts[a_pRows[i]]++;
+      }
+    });
+
+    for (unsigned t = 0; t < nThreads; t++)
+    {
+      if (outOfRange[t] != 0)
+        throw std::out_of_range("VariableArray2D::BuildFromPairs: row out of range");
+    }
+
+    clear();
+    ReserveData(a_nValues);
+    ReserveRows(a_nRows);
+
+    //Prefix sum, over ranges of rows. First turn each thread's count into its
+    //offset within the row and total the rows in each range...
+    unsigned nRowThreads = impl::ThreadCount(a_nRows, nThreads);
+    std::vector<size_t> rangeTotals(nRowThreads, 0);
+    impl::ParallelFor(a_nRows, nRowThreads, [&](size_t a_begin, size_t a_end, unsigned a_t)
+    {
+      size_t total = 0;
+      for (size_t r = a_begin; r < a_end; r++)
+      {
+        size_t rowCount = 0;
+        for (unsigned t = 0; t < nThreads; t++)
+        {
+          size_t & count = counts[t * a_nRows + r];
+          size_t offset = rowCount;
+          rowCount += count;
+          count = offset;
+        }
+        m_pIndices[r].count = rowCount;
+        total += rowCount;
+      }
+      rangeTotals[a_t] = total;
+    });
+
+    //...then offset each range by the totals of the ranges before it.
+    size_t start = 0;
+    for (unsigned t = 0; t < nRowThreads; t++)
+    {
+      size_t total = rangeTotals[t];
+      rangeTotals[t] = start;
+      start += total;
+    }
+
+    impl::ParallelFor(a_nRows, nRowThreads, [&](size_t a_begin, size_t a_end, unsigned a_t)
+    {
+      size_t rowStart = rangeTotals[a_t];
+      for (size_t r = a_begin; r < a_end; r++)
+      {
+        m_pIndices[r].start = rowStart;
+        for (unsigned t = 0; t < nThreads; t++)
+          counts[t * a_nRows + r] += rowStart;
+        rowStart += m_pIndices[r].count;
+      }
+    });
+
+    //Scatter. Threads get the same ranges as the counting pass, so each
+    //writes to its own slots and row order is kept.
+    impl::ParallelFor(a_nValues, nThreads, [&](size_t a_begin, size_t a_end, unsigned a_t)
+    {
+      size_t * pNext = counts.data() + a_t * a_nRows;
+      for (size_t i = a_begin; i < a_end; i++)
+        m_pData[pNext[a_pRows[i]]++] = a_pValues[i];
+    });
+
+    m_nData = a_nValues;
+    m_nRows = a_nRows;
+    MemoryChanged();
+  }
+
+  template<class T>
+  void VariableArray2D<T>::resize_row(size_t a_row, size_t a_count, T const & a_fill)
+  {
+    rangeCheckRow(a_row);
+    T fill(a_fill); //a_fill may live in our buffer, which can move
+
+    Index & ind = m_pIndices[a_row];
+    bool isLast = (ind.start + ind.count == m_nData);
+
+    if (a_count <= ind.count)
+    {
+      if (isLast)
+        m_nData = ind.start + a_count;
+      else
+        m_nHoles += ind.count - a_count;
+    }
+    else if (isLast)
+    {
+      ReserveData(ind.start + a_count);
+      for (size_t i = ind.count; i < a_count; i++)
+        m_pData[ind.start + i] = fill;
+      m_nData = ind.start + a_count;
+    }
+    else
+    {
+      ReserveData(m_nData + a_count);
+      memcpy(&m_pData[m_nData], &m_pData[ind.start], ind.count * sizeof(T));
+      for (size_t i = ind.count; i < a_count; i++)
+        m_pData[m_nData + i] = fill;
+      m_nHoles += ind.count;
+      ind.start = m_nData;
+      m_nData += a_count;
+    }
+    ind.count = a_count;
+
+    if (m_nHoles > m_nData - m_nHoles)
+      compact();
+    else
+      MemoryChanged();
+  }
+
+  template<class T>
+  void VariableArray2D<T>::compact()
+  {
+    if (m_nHoles == 0)
+      return;
+
+    size_t nItems = m_nData - m_nHoles;
+    T * pData = nullptr;
+    if (nItems != 0)
+    {
+      pool_size(nItems);
+      pData = static_cast<T*>(malloc(pool_size() * sizeof(T)));
+      if (pData == nullptr)
+        throw std::bad_alloc();
+    }
+
+    size_t start = 0;
+    for (size_t r = 0; r < m_nRows; r++)
+    {
+      Index & ind = m_pIndices[r];
+      if (ind.count != 0)
+        memcpy(&pData[start], &m_pData[ind.start], ind.count * sizeof(T));
+      ind.start = start;
+      start += ind.count;
+    }
+
+    free(m_pData);
+    m_pData = pData;
+    m_nData = nItems;
+    m_nHoles = 0;
+    MemoryChanged();
   }
 
   template<class T>
   void VariableArray2D<T>::clear()
   {
-    m_data.clear();
-    m_indices.clear();
+    m_nData = 0;
+    m_nHoles = 0;
+    m_nRows = 0;
+    MemoryChanged();
   }
 
   template<class T>
   T & VariableArray2D<T>::operator()(size_t a_row, size_t a_element)
   {
-    Index ind = m_indices[a_row];
-    return m_data[ind.start + a_element];
+    return m_pData[m_pIndices[a_row].start + a_element];
   }
 
   template<class T>
   T const & VariableArray2D<T>::operator()(size_t a_row, size_t a_element) const
   {
-    Index ind = m_indices[a_row];
-    return m_data[ind.start + a_element];
+    return m_pData[m_pIndices[a_row].start + a_element];
   }
 
   template<class T>
   T & VariableArray2D<T>::at(size_t a_row, size_t a_element)
   {
     rangeCheck(a_row, a_element);
-    Index ind = m_indices[a_row];
-    return m_data[ind.start + a_element];
+    return m_pData[m_pIndices[a_row].start + a_element];
   }
 
   template<class T>
   T const & VariableArray2D<T>::at(size_t a_row, size_t a_element) const
   {
     rangeCheck(a_row, a_element);
-    Index ind = m_indices[a_row];
-    return m_data[ind.start + a_element];
+    return m_pData[m_pIndices[a_row].start + a_element];
+  }
+
+  template<class T>
+  T * VariableArray2D<T>::row(size_t a_row)
+  {
+    return m_pData + m_pIndices[a_row].start;
+  }
+
+  template<class T>
+  T const * VariableArray2D<T>::row(size_t a_row) const
+  {
+    return m_pData + m_pIndices[a_row].start;
+  }
+
+  template<class T>
+  T * VariableArray2D<T>::data()
+  {
+    return m_pData;
+  }
+
+  template<class T>
+  T const * VariableArray2D<T>::data() const
+  {
+    return m_pData;
   }
 
   template<class T>
   void VariableArray2D<T>::rangeCheck(size_t a_row, size_t a_element) const
   {
     std::ostringstream oss;
-    if (a_row >= m_indices.size())
+    if (a_row >= m_nRows)
       oss << "Row '" << a_row << "' out of range. ";
-    else if (a_element >= m_indices[a_row].count)
+    else if (a_element >= m_pIndices[a_row].count)
     {
-      oss << "Element '" << a_element << "' out of range for row " << a_row 
-        << ". This row has " a_indices[a_row].count << " elements. ";
+      oss << "Element '" << a_element << "' out of range for row " << a_row
+        << ". This row has " << m_pIndices[a_row].count << " elements. ";
     }
 
     // if nothing has been written to oss then all indices are valid
@@ -216,12 +527,66 @@ namespace Dg
   void VariableArray2D<T>::rangeCheckRow(size_t a_row) const
   {
     std::ostringstream oss;
-    if (a_row >= m_indices.size())
+    if (a_row >= m_nRows)
       oss << "Row '" << a_row << "' out of range. ";
 
     // if nothing has been written to oss then all indices are valid
     if (!oss.str().empty())
       throw std::out_of_range(oss.str());
   }
+
+  template<class T>
+  void VariableArray2D<T>::ReserveData(size_t a_nItems)
+  {
+    if (m_pData != nullptr && a_nItems <= pool_size())
+      return;
+
+    ReallocTimer timer(*this);
+    pool_size(a_nItems);
+    T * pData = static_cast<T*>(realloc(m_pData, pool_size() * sizeof(T)));
+    if (pData == nullptr)
+      throw std::bad_alloc();
+    m_pData = pData;
+  }
+
+  template<class T>
+  void VariableArray2D<T>::ReserveRows(size_t a_nRows)
+  {
+    if (a_nRows <= m_rowCapacity)
+      return;
+
+    size_t newCapacity = (m_rowCapacity == 0) ? 16 : m_rowCapacity * 2;
+    if (newCapacity < a_nRows)
+      newCapacity = a_nRows;
+
+    ReallocTimer timer(*this);
+    Index * pIndices = static_cast<Index*>(realloc(m_pIndices, newCapacity * sizeof(Index)));
+    if (pIndices == nullptr)
+      throw std::bad_alloc();
+    m_pIndices = pIndices;
+    m_rowCapacity = newCapacity;
+  }
+
+  template<class T>
+  void VariableArray2D<T>::ReportMemory()
+  {
+    size_t reserved = (m_pData == nullptr) ? 0 : pool_size() * sizeof(T);
+    reserved += m_rowCapacity * sizeof(Index);
+    size_t nItems = m_nData - m_nHoles;
+    TrackMemory(reserved, nItems * sizeof(T) + m_nRows * sizeof(Index), nItems);
+  }
+
+  template<class T>
+  void VariableArray2D<T>::Release()
+  {
+    free(m_pData);
+    free(m_pIndices);
+    m_pData = nullptr;
+    m_pIndices = nullptr;
+    m_nData = 0;
+    m_nHoles = 0;
+    m_nRows = 0;
+    m_rowCapacity = 0;
+  }
 }
-#endif
\ No newline at end of file
+#endif
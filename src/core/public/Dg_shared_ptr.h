@@ -8,6 +8,12 @@
 #ifndef DG_SHARED_PTR_H
 #define DG_SHARED_PTR_H
 
+#include <atomic>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <stddef.h>
+
 namespace Dg
 {
   //! @ingroup DgContainers
@@ -25,48 +31,210 @@ namespace Dg
     void operator()(T * a_obj) const { delete a_obj; }
   };
 
+  //! @ingroup DgContainers
+  //!
+  //! Reference count policy for pointers used by one thread at a time.
+  struct SingleThreadedRefCount
+  {
+    typedef size_t CountType;
+
+    static void Init(CountType & a_count, size_t a_val) { a_count = a_val; }
+    static void Increment(CountType & a_count) { ++a_count; }
+
+    //! Returns true if the count reached 0
+    static bool Decrement(CountType & a_count) { return --a_count == 0; }
+    static size_t Load(CountType const & a_count) { return a_count; }
+  };
+
+  //! @ingroup DgContainers
+  //!
+  //! Reference count policy for pointers shared between threads. Copies can
+  //! be made and destroyed on any thread; the object itself is not made
+  //! thread safe.
+  struct AtomicRefCount
+  {
+    typedef std::atomic<size_t> CountType;
+
+    static void Init(CountType & a_count, size_t a_val) { a_count.store(a_val, std::memory_order_relaxed); }
+    static void Increment(CountType & a_count) { a_count.fetch_add(1, std::memory_order_relaxed); }
+
+    //! Returns true if the count reached 0. The last owner sees every write
+    //! made through the other owners before it destroys the object.
+    static bool Decrement(CountType & a_count) { return a_count.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+    static size_t Load(CountType const & a_count) { return a_count.load(std::memory_order_relaxed); }
+  };
+
+  namespace impl
+  {
+    //! Holds the count. Destroy() is only called when the count reaches 0,
+    //! so the cost of the virtual call is paid once per object.
+    template<typename RefCount>
+    class SharedControlBlock
+    {
+    public:
+
+      SharedControlBlock() { RefCount::Init(m_count, 1); }
+      virtual ~SharedControlBlock() {}
+
+      void AddRef() { RefCount::Increment(m_count); }
+      size_t UseCount() const { return RefCount::Load(m_count); }
+
+      void Release()
+      {
+        if (RefCount::Decrement(m_count))
+          Destroy();
+      }
+
+    protected:
+
+      //Destroy the object and free the block
+      virtual void Destroy() = 0;
+
+    private:
+
+      typename RefCount::CountType m_count;
+    };
+
+    //! Block for an object allocated elsewhere.
+    template<typename T, typename Deleter, typename RefCount>
+    class SharedPointerBlock : public SharedControlBlock<RefCount>
+    {
+    public:
+
+      SharedPointerBlock(T * a_pData, Deleter const & a_deleter)
+        : m_pData(a_pData)
+        , m_deleter(a_deleter)
+      {
+
+      }
+
+    protected:
+
+      void Destroy() override
+      {
+        m_deleter(m_pData);
+        delete this;
+      }
+
+    private:
+
+      T *     m_pData;
+      Deleter m_deleter;
+    };
+
+    //! Block with the object stored inline, as made by make_shared().
+    template<typename T, typename RefCount>
+    class SharedInlineBlock : public SharedControlBlock<RefCount>
+    {
+    public:
+
+      template<typename... Args>
+      SharedInlineBlock(Args &&... a_args)
+      {
+        new (m_data) T(std::forward<Args>(a_args)...);
+      }
+
+      T * Get() { return reinterpret_cast<T *>(m_data); }
+
+    protected:
+
+      void Destroy() override
+      {
+        Get()->~T();
+        delete this;
+      }
+
+    private:
+
+      alignas(T) unsigned char m_data[sizeof(T)];
+    };
+  }
+
   //! @ingroup DgContainers
   //!
   //! @class shared_ptr
   //!
-  //! Reference counted pointer
+  //! Reference counted pointer. The count lives in a control block shared by
+  //! all copies. An empty shared_ptr holds no block and allocates nothing.
+  //!
+  //! Constructing from a raw pointer allocates a block beside the object. Use
+  //! make_shared() to allocate the object and block together in one go.
+  //!
+  //! The count is only safe to share between threads with the AtomicRefCount
+  //! policy.
   //!
   //! @author Frank B. Hart
   //! @date 22/05/2016
-  template < typename T, typename Deleter = DefaultDeleter<T> > 
+  template < typename T,
+             typename Deleter = DefaultDeleter<T>,
+             typename RefCount = SingleThreadedRefCount >
   class shared_ptr
   {
+    template<typename U, typename D, typename R> friend class shared_ptr;
+
+    template<typename U, typename R, typename... Args>
+    friend shared_ptr<U, DefaultDeleter<U>, R> make_shared(Args &&...);
+
+    typedef impl::SharedControlBlock<RefCount> ControlBlock;
+
   public:
 
     //! Default constructor
-    shared_ptr() : m_pData(nullptr), m_pRefCount(nullptr)
+    shared_ptr() : m_pData(nullptr), m_pBlock(nullptr)
     {
-      m_pRefCount = new size_t(1);
+
     }
 
     //! Construct from pointer to object. The shared_point then assumes ownership.
     //!
     //! @param[in] pValue Pointer to object.
-    shared_ptr(T* pValue) : m_pData(pValue), m_pRefCount(nullptr)
+    shared_ptr(T* pValue, Deleter const & a_deleter = Deleter())
+      : m_pData(pValue)
+      , m_pBlock(nullptr)
     {
-      m_pRefCount = new size_t(1);
+      if (pValue != nullptr)
+      {
+        try
+        {
+          m_pBlock = new impl::SharedPointerBlock<T, Deleter, RefCount>(pValue, a_deleter);
+        }
+        catch (...)
+        {
+          a_deleter(pValue);
+          throw;
+        }
+      }
     }
 
     //! Copy constructor
-    shared_ptr(shared_ptr<T> const & sp) : m_pData(sp.m_pData), m_pRefCount(sp.m_pRefCount)
+    shared_ptr(shared_ptr const & sp) : m_pData(sp.m_pData), m_pBlock(sp.m_pBlock)
     {
-      (*m_pRefCount)++;
+      if (m_pBlock != nullptr)
+        m_pBlock->AddRef();
+    }
+
+    //! Construct from a shared_ptr to a derived type
+    template<typename U, typename D,
+             typename = std::enable_if_t<std::is_convertible<U *, T *>::value>>
+    shared_ptr(shared_ptr<U, D, RefCount> const & sp) : m_pData(sp.m_pData), m_pBlock(sp.m_pBlock)
+    {
+      if (m_pBlock != nullptr)
+        m_pBlock->AddRef();
+    }
+
+    //! Move constructor
+    shared_ptr(shared_ptr && sp) : m_pData(sp.m_pData), m_pBlock(sp.m_pBlock)
+    {
+      sp.m_pData = nullptr;
+      sp.m_pBlock = nullptr;
     }
 
     //! Destructor. If no other shared_ptr's are pointing to the object,
     //! the object is destroyed.
     ~shared_ptr()
     {
-      if (--(*m_pRefCount) == 0)
-      {
-        s_deleter(m_pData);
-        delete m_pRefCount;
-      }
+      if (m_pBlock != nullptr)
+        m_pBlock->Release();
     }
 
     //! Conversion
@@ -101,36 +269,202 @@ namespace Dg
       return m_pData;
     }
 
+    T * get() const
+    {
+      return m_pData;
+    }
+
+    //! Number of shared_ptrs owning the object, 0 if empty.
+    size_t use_count() const
+    {
+      return (m_pBlock == nullptr) ? 0 : m_pBlock->UseCount();
+    }
+
+    explicit operator bool() const
+    {
+      return m_pData != nullptr;
+    }
+
+    bool operator==(shared_ptr const & sp) const
+    {
+      return m_pData == sp.m_pData;
+    }
+
+    bool operator!=(shared_ptr const & sp) const
+    {
+      return m_pData != sp.m_pData;
+    }
+
     //! Assignment
     shared_ptr& operator = (shared_ptr const & sp)
     {
-      if (this != &sp)
-      {
-        if (--(*m_pRefCount) == 0)
-        {
-          s_deleter(m_pData);
-          delete m_pRefCount;
-        }
+      shared_ptr(sp).swap(*this);
+      return *this;
+    }
 
-        m_pData = sp.m_pData;
-        m_pRefCount = sp.m_pRefCount;
-        (*m_pRefCount)++;
-      }
+    //! Move assignment
+    shared_ptr& operator = (shared_ptr && sp)
+    {
+      shared_ptr(std::move(sp)).swap(*this);
       return *this;
     }
 
+    //! Release ownership, leaving this empty.
+    void reset()
+    {
+      shared_ptr().swap(*this);
+    }
+
+    void swap(shared_ptr & sp)
+    {
+      std::swap(m_pData, sp.m_pData);
+      std::swap(m_pBlock, sp.m_pBlock);
+    }
+
+  private:
+
+    shared_ptr(T * a_pData, ControlBlock * a_pBlock) : m_pData(a_pData), m_pBlock(a_pBlock)
+    {
+
+    }
+
   private:
+    T *             m_pData;       // pointer
+    ControlBlock *  m_pBlock;
+  };
+
+  //! @ingroup DgContainers_functions
+  //!
+  //! Creates an object owned by a shared_ptr, with the object and its count
+  //! in a single allocation. Pass AtomicRefCount as the second template
+  //! argument for pointers shared between threads:
+  //!
+  //! @code
+  //!     auto p = Dg::make_shared<Resource, Dg::AtomicRefCount>(a_key);
+  //! @endcode
+  template<typename T, typename RefCount = SingleThreadedRefCount, typename... Args>
+  shared_ptr<T, DefaultDeleter<T>, RefCount> make_shared(Args &&... a_args)
+  {
+    impl::SharedInlineBlock<T, RefCount> * pBlock =
+      new impl::SharedInlineBlock<T, RefCount>(std::forward<Args>(a_args)...);
+    return shared_ptr<T, DefaultDeleter<T>, RefCount>(pBlock->Get(), pBlock);
+  }
+
+  //! @ingroup DgContainers
+  //!
+  //! @class RefCounted
+  //!
+  //! Base for types that carry their own reference count, for use with
+  //! intrusive_ptr. Derived is the type being counted; it is deleted when the
+  //! last reference is released.
+  //!
+  //! @author Frank B. Hart
+  //! @date 19/10/2026
+  template<typename Derived, typename RefCount = SingleThreadedRefCount>
+  class RefCounted
+  {
+  public:
+
+    RefCounted() { RefCount::Init(m_count, 0); }
+
+    //A copy is a new object, with no references yet
+    RefCounted(RefCounted const &) { RefCount::Init(m_count, 0); }
+    RefCounted & operator=(RefCounted const &) { return *this; }
+
+    void AddRef() const { RefCount::Increment(m_count); }
+
+    void Release() const
+    {
+      if (RefCount::Decrement(m_count))
+        delete static_cast<Derived const *>(this);
+    }
+
+    size_t ref_count() const { return RefCount::Load(m_count); }
 
-    static Deleter const s_deleter;
+  protected:
+
+    ~RefCounted() {}
 
   private:
-    T *          m_pData;       // pointer
-    size_t *     m_pRefCount;
+
+    mutable typename RefCount::CountType m_count;
   };
 
+  //! @ingroup DgContainers
+  //!
+  //! @class intrusive_ptr
+  //!
+  //! Reference counted pointer to an object that holds its own count, so
+  //! sharing needs no allocation at all. T must have AddRef() and Release()
+  //! members, Release() destroying the object when the count reaches 0.
+  //! RefCounted provides these.
+  //!
+  //! @author Frank B. Hart
+  //! @date 19/10/2026
+  template<typename T>
+  class intrusive_ptr
+  {
+  public:
+
+    intrusive_ptr() : m_pData(nullptr) {}
+
+    intrusive_ptr(T * a_pData) : m_pData(a_pData)
+    {
+      if (m_pData != nullptr)
+        m_pData->AddRef();
+    }
+
+    intrusive_ptr(intrusive_ptr const & a_other) : m_pData(a_other.m_pData)
+    {
+      if (m_pData != nullptr)
+        m_pData->AddRef();
+    }
+
+    intrusive_ptr(intrusive_ptr && a_other) : m_pData(a_other.m_pData)
+    {
+      a_other.m_pData = nullptr;
+    }
+
+    ~intrusive_ptr()
+    {
+      if (m_pData != nullptr)
+        m_pData->Release();
+    }
+
+    intrusive_ptr & operator=(intrusive_ptr const & a_other)
+    {
+      intrusive_ptr(a_other).swap(*this);
+      return *this;
+    }
+
+    intrusive_ptr & operator=(intrusive_ptr && a_other)
+    {
+      intrusive_ptr(std::move(a_other)).swap(*this);
+      return *this;
+    }
+
+    T & operator*() const { return *m_pData; }
+    T * operator->() const { return m_pData; }
+    T * get() const { return m_pData; }
 
-  template <typename T, typename Deleter>
-  Deleter const shared_ptr<T, Deleter>::s_deleter;
+    explicit operator bool() const { return m_pData != nullptr; }
 
+    bool operator==(intrusive_ptr const & a_other) const { return m_pData == a_other.m_pData; }
+    bool operator!=(intrusive_ptr const & a_other) const { return m_pData != a_other.m_pData; }
+
+    void reset()
+    {
+      intrusive_ptr().swap(*this);
+    }
+
+    void swap(intrusive_ptr & a_other)
+    {
+      std::swap(m_pData, a_other.m_pData);
+    }
+
+  private:
+
+    T * m_pData;
+  };
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,87 @@
+//! @file DgBitOps.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Portable wrappers around bit scan and population count intrinsics.
+
+#ifndef DGBITOPS_H
+#define DGBITOPS_H
+
+#include <stdint.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Index of the lowest set bit. a_val must not be 0.
+    inline int CountTrailingZeros(uint32_t a_val)
+    {
+#ifdef _MSC_VER
+      unsigned long index;
+      _BitScanForward(&index, a_val);
+      return static_cast<int>(index);
+#else
+      return __builtin_ctz(a_val);
+#endif
+    }
+
+    //! Index of the lowest set bit. a_val must not be 0.
+    inline int CountTrailingZeros(uint64_t a_val)
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+      unsigned long index;
+      _BitScanForward64(&index, a_val);
+      return static_cast<int>(index);
+#elif defined(_MSC_VER)
+      uint32_t lo = static_cast<uint32_t>(a_val);
+      if (lo != 0)
+        return CountTrailingZeros(lo);
+      return 32 + CountTrailingZeros(static_cast<uint32_t>(a_val >> 32));
+#else
+      return __builtin_ctzll(a_val);
+#endif
+    }
+
+    //! Index of the highest set bit. a_val must not be 0.
+    inline int BitScanReverse(uint64_t a_val)
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+      unsigned long index;
+      _BitScanReverse64(&index, a_val);
+      return static_cast<int>(index);
+#elif defined(_MSC_VER)
+      unsigned long index;
+      uint32_t hi = static_cast<uint32_t>(a_val >> 32);
+      if (hi != 0)
+      {
+        _BitScanReverse(&index, hi);
+        return 32 + static_cast<int>(index);
+      }
+      _BitScanReverse(&index, static_cast<uint32_t>(a_val));
+      return static_cast<int>(index);
+#else
+      return 63 - __builtin_clzll(a_val);
+#endif
+    }
+
+    //! Number of set bits.
+    inline int PopCount(uint64_t a_val)
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+      return static_cast<int>(__popcnt64(a_val));
+#elif defined(_MSC_VER)
+      return static_cast<int>(__popcnt(static_cast<uint32_t>(a_val))
+                            + __popcnt(static_cast<uint32_t>(a_val >> 32)));
+#else
+      return __builtin_popcountll(a_val);
+#endif
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,360 @@
+//! @file DgChunkedNodePool.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Class declaration: ChunkedNodePool
+
+#ifndef DGCHUNKEDNODEPOOL_H
+#define DGCHUNKEDNODEPOOL_H
+
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Number of nodes in a chunk if none is given.
+    size_t const defaultNodeChunkSize = 256;
+
+    //! Stand-in for the node pool of containers not in chunked mode.
+    struct NullNodePool
+    {
+      NullNodePool(size_t = 0) {}
+    };
+
+    //! @ingroup DgContainers
+    //!
+    //! @class ChunkedNodePool
+    //!
+    //! Node storage for the linked lists in chunked mode. Nodes are handed out
+    //! from fixed-size chunks. A chunk is never moved once allocated, so a node
+    //! and its data keep their address for as long as they are in use, and
+    //! growing the pool appends a chunk rather than copying what is there.
+    //!
+    //! Each chunk keeps its own free list and the chunks that have free slots
+    //! are kept on a stack, so released slots are reused before a new chunk is
+    //! allocated. Shrink() hands chunks with no live nodes back to the system.
+    //!
+    //! The pool only manages memory. Constructing and destroying the T in a
+    //! slot is left to the owner.
+    //!
+    //! @author Frank B. Hart
+    //! @date 19/10/2026
+    template<typename Node, typename T>
+    class ChunkedNodePool
+    {
+      struct Chunk;
+
+      struct Slot
+      {
+        Node    node;     //Must be first, we cast between Node* and Slot*
+        Chunk * pChunk;
+        alignas(T) unsigned char data[sizeof(T)];
+      };
+
+      struct Chunk
+      {
+        Chunk * pNextPartial;   //Next chunk on the stack of chunks with free slots
+        Slot *  pFree;          //Released slots, linked through node.pNext
+        Slot *  pSlots;
+        size_t  nLive;
+        size_t  nUsed;          //Slots from here on have never been handed out
+        bool    isPartial;
+      };
+
+    public:
+
+      ChunkedNodePool(size_t a_chunkSize = defaultNodeChunkSize);
+      ~ChunkedNodePool();
+
+      ChunkedNodePool(ChunkedNodePool const &) = delete;
+      ChunkedNodePool & operator=(ChunkedNodePool const &) = delete;
+
+      ChunkedNodePool(ChunkedNodePool &&);
+      ChunkedNodePool & operator=(ChunkedNodePool &&);
+
+      //Returns a node with uninitialised data.
+      Node * Allocate();
+
+      //Returns a node to its chunk. The data must already be destroyed.
+      void Release(Node *);
+
+      //Marks every slot as free. Chunks are kept.
+      void Reset();
+
+      //Frees all chunks with no live nodes.
+      //Returns the number of chunks freed.
+      size_t Shrink();
+
+      size_t chunk_size() const;
+      size_t chunk_count() const;
+
+      //Total bytes held by the chunks
+      size_t reserved_bytes() const;
+
+      //Bytes taken by one node and its data
+      static size_t slot_bytes();
+
+      static T * Data(Node *);
+      static T const * Data(Node const *);
+
+    private:
+
+      void NewChunk();
+      void Push(Chunk *);
+      void RebuildPartialStack();
+      void FreeAll();
+      static size_t HeaderBytes();
+
+    private:
+
+      Chunk **  m_ppChunks;
+      size_t    m_nChunks;
+      size_t    m_tableSize;
+      Chunk *   m_pPartial;
+      size_t    m_chunkSize;
+    };
+
+    //--------------------------------------------------------------------------------
+    //		ChunkedNodePool
+    //--------------------------------------------------------------------------------
+    template<typename Node, typename T>
+    ChunkedNodePool<Node, T>::ChunkedNodePool(size_t a_chunkSize)
+      : m_ppChunks(nullptr)
+      , m_nChunks(0)
+      , m_tableSize(0)
+      , m_pPartial(nullptr)
+      , m_chunkSize(a_chunkSize == 0 ? 1 : a_chunkSize)
+    {
+
+    }
+
+    template<typename Node, typename T>
+    ChunkedNodePool<Node, T>::~ChunkedNodePool()
+    {
+      FreeAll();
+    }
+
+    template<typename Node, typename T>
+    ChunkedNodePool<Node, T>::ChunkedNodePool(ChunkedNodePool && a_other)
+      : m_ppChunks(a_other.m_ppChunks)
+      , m_nChunks(a_other.m_nChunks)
+      , m_tableSize(a_other.m_tableSize)
+      , m_pPartial(a_other.m_pPartial)
+      , m_chunkSize(a_other.m_chunkSize)
+    {
+      a_other.m_ppChunks = nullptr;
+      a_other.m_nChunks = 0;
+      a_other.m_tableSize = 0;
+      a_other.m_pPartial = nullptr;
+    }
+
+    template<typename Node, typename T>
+    ChunkedNodePool<Node, T> & ChunkedNodePool<Node, T>::operator=(ChunkedNodePool && a_other)
+    {
+      if (this != &a_other)
+      {
+        FreeAll();
+        m_ppChunks = a_other.m_ppChunks;
+        m_nChunks = a_other.m_nChunks;
+        m_tableSize = a_other.m_tableSize;
+        m_pPartial = a_other.m_pPartial;
+        m_chunkSize = a_other.m_chunkSize;
+
+        a_other.m_ppChunks = nullptr;
+        a_other.m_nChunks = 0;
+        a_other.m_tableSize = 0;
+        a_other.m_pPartial = nullptr;
+      }
+      return *this;
+    }
+
+    template<typename Node, typename T>
+    Node * ChunkedNodePool<Node, T>::Allocate()
+    {
+      if (m_pPartial == nullptr)
+        NewChunk();
+
+      Chunk * pChunk = m_pPartial;
+      Slot * pSlot;
+      if (pChunk->pFree != nullptr)
+      {
+        pSlot = pChunk->pFree;
+        pChunk->pFree = reinterpret_cast<Slot *>(pSlot->node.pNext);
+      }
+      else
+      {
+        pSlot = &pChunk->pSlots[pChunk->nUsed];
+        pChunk->nUsed++;
+      }
+
+      pChunk->nLive++;
+      if (pChunk->nLive == m_chunkSize)
+      {
+        m_pPartial = pChunk->pNextPartial;
+        pChunk->isPartial = false;
+      }
+
+      pSlot->pChunk = pChunk;
+      return &pSlot->node;
+    }
+
+    template<typename Node, typename T>
+    void ChunkedNodePool<Node, T>::Release(Node * a_pNode)
+    {
+      Slot * pSlot = reinterpret_cast<Slot *>(a_pNode);
+      Chunk * pChunk = pSlot->pChunk;
+
+      pSlot->node.pNext = reinterpret_cast<Node *>(pChunk->pFree);
+      pChunk->pFree = pSlot;
+      pChunk->nLive--;
+
+      if (!pChunk->isPartial)
+        Push(pChunk);
+    }
+
+    template<typename Node, typename T>
+    void ChunkedNodePool<Node, T>::Reset()
+    {
+      for (size_t i = 0; i < m_nChunks; i++)
+      {
+        m_ppChunks[i]->pFree = nullptr;
+        m_ppChunks[i]->nLive = 0;
+        m_ppChunks[i]->nUsed = 0;
+      }
+      RebuildPartialStack();
+    }
+
+    template<typename Node, typename T>
+    size_t ChunkedNodePool<Node, T>::Shrink()
+    {
+      size_t nKept = 0;
+      for (size_t i = 0; i < m_nChunks; i++)
+      {
+        if (m_ppChunks[i]->nLive == 0)
+          free(m_ppChunks[i]);
+        else
+          m_ppChunks[nKept++] = m_ppChunks[i];
+      }
+
+      size_t nFreed = m_nChunks - nKept;
+      m_nChunks = nKept;
+      RebuildPartialStack();
+      return nFreed;
+    }
+
+    template<typename Node, typename T>
+    size_t ChunkedNodePool<Node, T>::chunk_size() const
+    {
+      return m_chunkSize;
+    }
+
+    template<typename Node, typename T>
+    size_t ChunkedNodePool<Node, T>::chunk_count() const
+    {
+      return m_nChunks;
+    }
+
+    template<typename Node, typename T>
+    size_t ChunkedNodePool<Node, T>::reserved_bytes() const
+    {
+      return m_nChunks * (HeaderBytes() + m_chunkSize * sizeof(Slot));
+    }
+
+    template<typename Node, typename T>
+    size_t ChunkedNodePool<Node, T>::slot_bytes()
+    {
+      return sizeof(Slot);
+    }
+
+    template<typename Node, typename T>
+    T * ChunkedNodePool<Node, T>::Data(Node * a_pNode)
+    {
+      return reinterpret_cast<T *>(reinterpret_cast<Slot *>(a_pNode)->data);
+    }
+
+    template<typename Node, typename T>
+    T const * ChunkedNodePool<Node, T>::Data(Node const * a_pNode)
+    {
+      return reinterpret_cast<T const *>(reinterpret_cast<Slot const *>(a_pNode)->data);
+    }
+
+    template<typename Node, typename T>
+    void ChunkedNodePool<Node, T>::NewChunk()
+    {
+      if (m_nChunks == m_tableSize)
+      {
+        size_t newSize = (m_tableSize == 0) ? 16 : m_tableSize * 2;
+        Chunk ** ppChunks = static_cast<Chunk **>(realloc(m_ppChunks, newSize * sizeof(Chunk *)));
+        if (ppChunks == nullptr)
+          throw std::bad_alloc();
+        m_ppChunks = ppChunks;
+        m_tableSize = newSize;
+      }
+
+      //Header and slots share one allocation
+      size_t const offset = HeaderBytes();
+      unsigned char * pMem = static_cast<unsigned char *>(malloc(offset + m_chunkSize * sizeof(Slot)));
+      if (pMem == nullptr)
+        throw std::bad_alloc();
+
+      Chunk * pChunk = reinterpret_cast<Chunk *>(pMem);
+      pChunk->pFree = nullptr;
+      pChunk->pSlots = reinterpret_cast<Slot *>(pMem + offset);
+      pChunk->nLive = 0;
+      pChunk->nUsed = 0;
+
+      m_ppChunks[m_nChunks] = pChunk;
+      m_nChunks++;
+      Push(pChunk);
+    }
+
+    template<typename Node, typename T>
+    void ChunkedNodePool<Node, T>::Push(Chunk * a_pChunk)
+    {
+      a_pChunk->pNextPartial = m_pPartial;
+      a_pChunk->isPartial = true;
+      m_pPartial = a_pChunk;
+    }
+
+    template<typename Node, typename T>
+    void ChunkedNodePool<Node, T>::RebuildPartialStack()
+    {
+      m_pPartial = nullptr;
+
+      //Push in reverse so the oldest chunks are filled first
+      for (size_t i = m_nChunks; i > 0; i--)
+      {
+        Chunk * pChunk = m_ppChunks[i - 1];
+        if (pChunk->nLive < m_chunkSize)
+          Push(pChunk);
+        else
+          pChunk->isPartial = false;
+      }
+    }
+
+    template<typename Node, typename T>
+    size_t ChunkedNodePool<Node, T>::HeaderBytes()
+    {
+      return (sizeof(Chunk) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+    }
+
+    template<typename Node, typename T>
+    void ChunkedNodePool<Node, T>::FreeAll()
+    {
+      for (size_t i = 0; i < m_nChunks; i++)
+        free(m_ppChunks[i]);
+      free(m_ppChunks);
+
+      m_ppChunks = nullptr;
+      m_nChunks = 0;
+      m_tableSize = 0;
+      m_pPartial = nullptr;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,23 @@
+//! @file DgCompare.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Default ordering for the sorted containers.
+
+#ifndef DGCOMPARE_H
+#define DGCOMPARE_H
+
+namespace Dg
+{
+  namespace impl
+  {
+    template<typename T>
+    bool Less(T const & t0, T const & t1)
+    {
+      return t0 < t1;
+    }
+  }
+}
+
+#endif
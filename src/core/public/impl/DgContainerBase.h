@@ -8,8 +8,17 @@
 #ifndef DG_CONTAINERBASE_H
 #define DG_CONTAINERBASE_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 namespace Dg
 {
+  namespace impl
+  {
+    struct MemoryRecord;
+    void UpdateMemoryRecord(MemoryRecord *, size_t a_reservedBytes, size_t a_usedBytes, size_t a_nItems);
+  }
+
   //! @ingroup DgContainers
   //!
   //! @class ContainerBase
@@ -17,6 +26,12 @@ namespace Dg
   //! Base class for containers. Contains a method of obtaining 
   //! a valid data pool size.
   //!
+  //! Containers can be tagged with a name with set_memory_tag(). Tagged
+  //! containers report their reserved and used memory to the MemoryRegistry
+  //! (see DgMemoryRegistry.h). Untagged containers are not tracked and pay
+  //! only a null check when they grow or change size. A copy of a container
+  //! is not tagged, and a tag stays with the object it was set on.
+  //!
   //! @author Frank B. Hart
   //! @date 24/08/2016
   class ContainerBase
@@ -59,8 +74,50 @@ namespace Dg
     //! next value in the table of valid memory pool sizes.
     size_t set_next_pool_size();
 
+    //! Start tracking the memory of this container under a_name.
+    //! Tagging a container again renames it.
+    void set_memory_tag(char const * a_name);
+
+    //! Stop tracking the memory of this container.
+    void clear_memory_tag();
+
+    //! Returns nullptr if the container is not tagged.
+    char const * memory_tag() const;
+
+  protected:
+
+    //! Containers override this to report their memory with TrackMemory().
+    virtual void ReportMemory() {}
+
+    //! Containers call this whenever their pool or number of elements changes.
+    void MemoryChanged()
+    {
+      if (m_pMemoryRecord != nullptr)
+        ReportMemory();
+    }
+
+    void TrackMemory(size_t a_reservedBytes, size_t a_usedBytes, size_t a_nItems)
+    {
+      if (m_pMemoryRecord != nullptr)
+        impl::UpdateMemoryRecord(m_pMemoryRecord, a_reservedBytes, a_usedBytes, a_nItems);
+    }
+
+    //! Times a pool reallocation for a tagged container. Construct one on the
+    //! stack around the realloc.
+    class ReallocTimer
+    {
+    public:
+      ReallocTimer(ContainerBase const &);
+      ~ReallocTimer();
+
+    private:
+      impl::MemoryRecord *  m_pRecord;
+      int64_t               m_start;
+    };
+
   private:
-    int   m_poolSizeIndex;
+    int                   m_poolSizeIndex;
+    impl::MemoryRecord *  m_pMemoryRecord;
   };
 }
 
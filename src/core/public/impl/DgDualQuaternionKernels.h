@@ -0,0 +1,274 @@
+//! @file DgDualQuaternionKernels.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Dual quaternion linear blend skinning. A dual quaternion is stored as 8
+//! consecutive reals, the real part (w, x, y, z) then the dual part. Vectors
+//! are 4 reals, (x, y, z, w).
+//!
+//! For each vertex the bone dual quaternions are summed with their weights,
+//! each flipped onto the hemisphere of the first influence, then divided by
+//! the length of the real part r. With d the dual part, a point moves to
+//!   p + 2 r.xyz x (r.xyz x p + r.w p) + 2 (r.w d.xyz - d.w r.xyz + r.xyz x d.xyz)
+//! and a normal to n + 2 r.xyz x (r.xyz x n + r.w n). A vertex whose
+//! weighted sum is zero is left where it is.
+
+#ifndef DGDUALQUATERNIONKERNELS_H
+#define DGDUALQUATERNIONKERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cmath>
+
+#include "DgMatrixKernels.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Skins vertices [a_begin, a_end). a_pInfluences[v].bones[k] and
+    //! a_pInfluences[v].weights[k] are influence k of vertex v. The normal
+    //! arrays may be null. Outputs may alias the inputs.
+    template<typename Real, typename Influence>
+    void SkinRange(Real const * a_pPalette, Influence const * a_pInfluences,
+                   Real const * a_pIn, Real * a_pOut,
+                   Real const * a_pNormalsIn, Real * a_pNormalsOut,
+                   size_t a_begin, size_t a_end)
+    {
+      for (size_t v = a_begin; v < a_end; ++v)
+      {
+        Influence const & inf = a_pInfluences[v];
+        Real const * q0 = a_pPalette + inf.bones[0] * 8;
+        Real b[8];
+        for (int j = 0; j < 8; ++j)
+        {
+          b[j] = inf.weights[0] * q0[j];
+        }
+
+        for (int k = 1; k < 4; ++k)
+        {
+          Real const * q = a_pPalette + inf.bones[k] * 8;
+          Real w = inf.weights[k];
+          if (q0[0] * q[0] + q0[1] * q[1] + q0[2] * q[2] + q0[3] * q[3] < static_cast<Real>(0.0))
+          {
+            w = -w;
+          }
+          for (int j = 0; j < 8; ++j)
+          {
+            b[j] += w * q[j];
+          }
+        }
+
+        Real lenSq = b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3];
+        Real const * p = a_pIn + v * 4;
+        Real * out = a_pOut + v * 4;
+        if (!(lenSq > static_cast<Real>(0.0)))
+        {
+          for (int j = 0; j < 4; ++j)
+          {
+            out[j] = p[j];
+          }
+          if (a_pNormalsIn != nullptr)
+          {
+            for (int j = 0; j < 4; ++j)
+            {
+              a_pNormalsOut[v * 4 + j] = a_pNormalsIn[v * 4 + j];
+            }
+          }
+          continue;
+        }
+
+        Real inv = static_cast<Real>(1.0) / std::sqrt(lenSq);
+        Real rw = b[0] * inv, rx = b[1] * inv, ry = b[2] * inv, rz = b[3] * inv;
+        Real dw = b[4] * inv, dx = b[5] * inv, dy = b[6] * inv, dz = b[7] * inv;
+
+        Real tx = static_cast<Real>(2.0) * (rw * dx - dw * rx + ry * dz - rz * dy);
+        Real ty = static_cast<Real>(2.0) * (rw * dy - dw * ry + rz * dx - rx * dz);
+        Real tz = static_cast<Real>(2.0) * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+        Real cx = ry * p[2] - rz * p[1] + rw * p[0];
+        Real cy = rz * p[0] - rx * p[2] + rw * p[1];
+        Real cz = rx * p[1] - ry * p[0] + rw * p[2];
+        Real px = p[0] + static_cast<Real>(2.0) * (ry * cz - rz * cy) + tx;
+        Real py = p[1] + static_cast<Real>(2.0) * (rz * cx - rx * cz) + ty;
+        Real pz = p[2] + static_cast<Real>(2.0) * (rx * cy - ry * cx) + tz;
+        out[3] = p[3];
+        out[0] = px;
+        out[1] = py;
+        out[2] = pz;
+
+        if (a_pNormalsIn != nullptr)
+        {
+          Real const * n = a_pNormalsIn + v * 4;
+          Real * nOut = a_pNormalsOut + v * 4;
+          cx = ry * n[2] - rz * n[1] + rw * n[0];
+          cy = rz * n[0] - rx * n[2] + rw * n[1];
+          cz = rx * n[1] - ry * n[0] + rw * n[2];
+          Real nx = n[0] + static_cast<Real>(2.0) * (ry * cz - rz * cy);
+          Real ny = n[1] + static_cast<Real>(2.0) * (rz * cx - rx * cz);
+          Real nz = n[2] + static_cast<Real>(2.0) * (rx * cy - ry * cx);
+          nOut[3] = n[3];
+          nOut[0] = nx;
+          nOut[1] = ny;
+          nOut[2] = nz;
+        }
+      }
+    }
+
+    template<typename Real>
+    struct SkinKernel
+    {
+      template<typename Influence>
+      static void Apply(Real const * a_pPalette, Influence const * a_pInfluences,
+                        Real const * a_pIn, Real * a_pOut,
+                        Real const * a_pNormalsIn, Real * a_pNormalsOut,
+                        size_t a_begin, size_t a_end)
+      {
+        SkinRange(a_pPalette, a_pInfluences, a_pIn, a_pOut, a_pNormalsIn, a_pNormalsOut, a_begin, a_end);
+      }
+    };
+
+#ifdef DG_MATRIX_SSE2
+    //! Loads 4 consecutive reals from each of a_p0..a_p3 and transposes them,
+    //! so a_out[j] holds component j with one source per lane.
+    inline void SSE_Gather4(float const * a_p0, float const * a_p1,
+                            float const * a_p2, float const * a_p3, __m128 * a_out)
+    {
+      a_out[0] = _mm_loadu_ps(a_p0);
+      a_out[1] = _mm_loadu_ps(a_p1);
+      a_out[2] = _mm_loadu_ps(a_p2);
+      a_out[3] = _mm_loadu_ps(a_p3);
+      _MM_TRANSPOSE4_PS(a_out[0], a_out[1], a_out[2], a_out[3]);
+    }
+
+    //! a_v + a_s (2 r x (r x a_v + rw a_v) + a_t), on 4 vectors held by
+    //! component.
+    inline void SSE_TransformSoA(__m128 a_rw, __m128 a_rx, __m128 a_ry, __m128 a_rz, __m128 a_s,
+                                 __m128 a_tx, __m128 a_ty, __m128 a_tz,
+                                 __m128 & a_x, __m128 & a_y, __m128 & a_z)
+    {
+      __m128 cx = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a_ry, a_z), _mm_mul_ps(a_rz, a_y)), _mm_mul_ps(a_rw, a_x));
+      __m128 cy = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a_rz, a_x), _mm_mul_ps(a_rx, a_z)), _mm_mul_ps(a_rw, a_y));
+      __m128 cz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(a_rx, a_y), _mm_mul_ps(a_ry, a_x)), _mm_mul_ps(a_rw, a_z));
+      __m128 ux = _mm_sub_ps(_mm_mul_ps(a_ry, cz), _mm_mul_ps(a_rz, cy));
+      __m128 uy = _mm_sub_ps(_mm_mul_ps(a_rz, cx), _mm_mul_ps(a_rx, cz));
+      __m128 uz = _mm_sub_ps(_mm_mul_ps(a_rx, cy), _mm_mul_ps(a_ry, cx));
+      a_x = _mm_add_ps(a_x, _mm_mul_ps(a_s, _mm_add_ps(_mm_add_ps(ux, ux), a_tx)));
+      a_y = _mm_add_ps(a_y, _mm_mul_ps(a_s, _mm_add_ps(_mm_add_ps(uy, uy), a_ty)));
+      a_z = _mm_add_ps(a_z, _mm_mul_ps(a_s, _mm_add_ps(_mm_add_ps(uz, uz), a_tz)));
+    }
+
+    //! Works on 4 vertices at a time, one per lane. The palette entries of
+    //! each influence are gathered into registers by component, so the
+    //! hemisphere test and blend need no horizontal operations. Real parts
+    //! are blended before dual parts to keep fewer registers live.
+    //!
+    //! Both the rotation and translation terms are quadratic in the blended
+    //! dual quaternion, so instead of normalising it the terms are scaled
+    //! once by 1 / |r|^2. A zero sum gets a scale of zero, leaving the
+    //! vertex alone.
+    template<>
+    struct SkinKernel<float>
+    {
+      template<typename Influence>
+      static void Apply(float const * a_pPalette, Influence const * a_pInfluences,
+                        float const * a_pIn, float * a_pOut,
+                        float const * a_pNormalsIn, float * a_pNormalsOut,
+                        size_t a_begin, size_t a_end)
+      {
+        __m128 const zero = _mm_setzero_ps();
+        __m128 const one = _mm_set1_ps(1.0f);
+        __m128 const signBit = _mm_set1_ps(-0.0f);
+
+        size_t v = a_begin;
+        for (; v + 4 <= a_end; v += 4)
+        {
+          Influence const * inf = a_pInfluences + v;
+          float const * q[4][4];
+          for (int k = 0; k < 4; ++k)
+          {
+            for (int i = 0; i < 4; ++i)
+            {
+              q[k][i] = a_pPalette + inf[i].bones[k] * 8;
+            }
+          }
+
+          __m128 w[4];
+          SSE_Gather4(inf[0].weights, inf[1].weights, inf[2].weights, inf[3].weights, w);
+
+          __m128 r0[4];
+          SSE_Gather4(q[0][0], q[0][1], q[0][2], q[0][3], r0);
+          __m128 rw = _mm_mul_ps(w[0], r0[0]);
+          __m128 rx = _mm_mul_ps(w[0], r0[1]);
+          __m128 ry = _mm_mul_ps(w[0], r0[2]);
+          __m128 rz = _mm_mul_ps(w[0], r0[3]);
+          for (int k = 1; k < 4; ++k)
+          {
+            __m128 r[4];
+            SSE_Gather4(q[k][0], q[k][1], q[k][2], q[k][3], r);
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0[0], r[0]), _mm_mul_ps(r0[1], r[1])),
+                                    _mm_add_ps(_mm_mul_ps(r0[2], r[2]), _mm_mul_ps(r0[3], r[3])));
+            w[k] = _mm_xor_ps(w[k], _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit));
+            rw = _mm_add_ps(rw, _mm_mul_ps(w[k], r[0]));
+            rx = _mm_add_ps(rx, _mm_mul_ps(w[k], r[1]));
+            ry = _mm_add_ps(ry, _mm_mul_ps(w[k], r[2]));
+            rz = _mm_add_ps(rz, _mm_mul_ps(w[k], r[3]));
+          }
+
+          __m128 dw = zero, dx = zero, dy = zero, dz = zero;
+          for (int k = 0; k < 4; ++k)
+          {
+            __m128 d[4];
+            SSE_Gather4(q[k][0] + 4, q[k][1] + 4, q[k][2] + 4, q[k][3] + 4, d);
+            dw = _mm_add_ps(dw, _mm_mul_ps(w[k], d[0]));
+            dx = _mm_add_ps(dx, _mm_mul_ps(w[k], d[1]));
+            dy = _mm_add_ps(dy, _mm_mul_ps(w[k], d[2]));
+            dz = _mm_add_ps(dz, _mm_mul_ps(w[k], d[3]));
+          }
+
+          __m128 lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rw, rw), _mm_mul_ps(rx, rx)),
+                                    _mm_add_ps(_mm_mul_ps(ry, ry), _mm_mul_ps(rz, rz)));
+          __m128 valid = _mm_cmpgt_ps(lenSq, zero);
+          __m128 s = _mm_and_ps(valid, _mm_div_ps(one, _mm_or_ps(lenSq, _mm_andnot_ps(valid, one))));
+
+          __m128 tx = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dx), _mm_mul_ps(dw, rx)),
+                                 _mm_sub_ps(_mm_mul_ps(ry, dz), _mm_mul_ps(rz, dy)));
+          __m128 ty = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dy), _mm_mul_ps(dw, ry)),
+                                 _mm_sub_ps(_mm_mul_ps(rz, dx), _mm_mul_ps(rx, dz)));
+          __m128 tz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dz), _mm_mul_ps(dw, rz)),
+                                 _mm_sub_ps(_mm_mul_ps(rx, dy), _mm_mul_ps(ry, dx)));
+          tx = _mm_add_ps(tx, tx);
+          ty = _mm_add_ps(ty, ty);
+          tz = _mm_add_ps(tz, tz);
+
+          __m128 p[4];
+          SSE_Gather4(a_pIn + v * 4, a_pIn + v * 4 + 4, a_pIn + v * 4 + 8, a_pIn + v * 4 + 12, p);
+          SSE_TransformSoA(rw, rx, ry, rz, s, tx, ty, tz, p[0], p[1], p[2]);
+          _MM_TRANSPOSE4_PS(p[0], p[1], p[2], p[3]);
+          _mm_storeu_ps(a_pOut + v * 4, p[0]);
+          _mm_storeu_ps(a_pOut + v * 4 + 4, p[1]);
+          _mm_storeu_ps(a_pOut + v * 4 + 8, p[2]);
+          _mm_storeu_ps(a_pOut + v * 4 + 12, p[3]);
+
+          if (a_pNormalsIn != nullptr)
+          {
+            __m128 n[4];
+            SSE_Gather4(a_pNormalsIn + v * 4, a_pNormalsIn + v * 4 + 4, a_pNormalsIn + v * 4 + 8, a_pNormalsIn + v * 4 + 12, n);
+            SSE_TransformSoA(rw, rx, ry, rz, s, zero, zero, zero, n[0], n[1], n[2]);
+            _MM_TRANSPOSE4_PS(n[0], n[1], n[2], n[3]);
+            _mm_storeu_ps(a_pNormalsOut + v * 4, n[0]);
+            _mm_storeu_ps(a_pNormalsOut + v * 4 + 4, n[1]);
+            _mm_storeu_ps(a_pNormalsOut + v * 4 + 8, n[2]);
+            _mm_storeu_ps(a_pNormalsOut + v * 4 + 12, n[3]);
+          }
+        }
+
+        SkinRange(a_pPalette, a_pInfluences, a_pIn, a_pOut, a_pNormalsIn, a_pNormalsOut, v, a_end);
+      }
+    };
+#endif
+  }
+}
+
+#endif
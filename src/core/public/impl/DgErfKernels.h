@@ -0,0 +1,207 @@
+//! @file DgErfKernels.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Kernels behind the array versions of Erf(), Erfc() and InvErf(). The
+//! generic versions call the scalar functions; float arrays get an SSE2
+//! specialisation, four values at a time, evaluating the same minimax
+//! polynomials in single precision.
+
+#ifndef DGERFKERNELS_H
+#define DGERFKERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../DgMath.h"
+#include "DgMatrixKernels.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    template<typename Real>
+    struct ErfKernel
+    {
+      static void Erf(Real const * a_pIn, Real * a_pOut, size_t a_count)
+      {
+        for (size_t i = 0; i < a_count; ++i)
+          a_pOut[i] = Dg::Erf(a_pIn[i]);
+      }
+
+      static void Erfc(Real const * a_pIn, Real * a_pOut, size_t a_count)
+      {
+        for (size_t i = 0; i < a_count; ++i)
+          a_pOut[i] = Dg::Erfc(a_pIn[i]);
+      }
+
+      static void InvErf(Real const * a_pIn, Real * a_pOut, size_t a_count)
+      {
+        for (size_t i = 0; i < a_count; ++i)
+          a_pOut[i] = Dg::InvErf(a_pIn[i]);
+      }
+    };
+
+#ifdef DG_MATRIX_SSE2
+
+    //! Polynomial with coefficients highest degree first.
+    template<size_t N>
+    inline __m128 SSE_Polynomial(double const (&a_c)[N], __m128 a_x)
+    {
+      __m128 result = _mm_set1_ps(static_cast<float>(a_c[0]));
+      for (size_t i = 1; i < N; ++i)
+        result = _mm_add_ps(_mm_mul_ps(result, a_x), _mm_set1_ps(static_cast<float>(a_c[i])));
+      return result;
+    }
+
+    //! e^x, relative error about 1 ulp. Underflows to 0 below -87.3.
+    inline __m128 SSE_Exp(__m128 a_x)
+    {
+      __m128 x = _mm_min_ps(_mm_set1_ps(88.3762626647949f), _mm_max_ps(_mm_set1_ps(-87.3365478515625f), a_x));
+
+      //x = n ln2 + r, ln2 split in two so n ln2 is exact
+      __m128i n = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)));
+      __m128 fn = _mm_cvtepi32_ps(n);
+      x = _mm_sub_ps(x, _mm_mul_ps(fn, _mm_set1_ps(0.693359375f)));
+      x = _mm_sub_ps(x, _mm_mul_ps(fn, _mm_set1_ps(-2.12194440e-4f)));
+
+      __m128 y = _mm_set1_ps(1.9875691500e-4f);
+      y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+      y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+      y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+      y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+      y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+      y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, _mm_mul_ps(x, x)), x), _mm_set1_ps(1.0f));
+
+      __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+      y = _mm_mul_ps(y, scale);
+      return _mm_andnot_ps(_mm_cmplt_ps(a_x, _mm_set1_ps(-87.3365478515625f)), y);
+    }
+
+    //! Natural log of a positive, normal a_x. Relative error about 1 ulp.
+    inline __m128 SSE_Log(__m128 a_x)
+    {
+      //a_x = m 2^e, m in [sqrt(1/2), sqrt(2))
+      __m128i bits = _mm_castps_si128(a_x);
+      __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126));
+      __m128 m = _mm_or_ps(_mm_and_ps(a_x, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF))), _mm_set1_ps(0.5f));
+
+      __m128 small = _mm_cmplt_ps(m, _mm_set1_ps(0.707106781186547524f));
+      e = _mm_add_epi32(e, _mm_castps_si128(small));
+      m = _mm_add_ps(_mm_sub_ps(m, _mm_set1_ps(1.0f)), _mm_and_ps(small, m));
+      __m128 fe = _mm_cvtepi32_ps(e);
+
+      __m128 z = _mm_mul_ps(m, m);
+      __m128 y = _mm_set1_ps(7.0376836292e-2f);
+      y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.1514610310e-1f));
+      y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.1676998740e-1f));
+      y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.2420140846e-1f));
+      y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.4249322787e-1f));
+      y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.6668057665e-1f));
+      y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(2.0000714765e-1f));
+      y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-2.4999993993e-1f));
+      y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(3.3333331174e-1f));
+      y = _mm_mul_ps(_mm_mul_ps(y, m), z);
+
+      y = _mm_add_ps(y, _mm_mul_ps(fe, _mm_set1_ps(-2.12194440e-4f)));
+      y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+      m = _mm_add_ps(m, y);
+      return _mm_add_ps(m, _mm_mul_ps(fe, _mm_set1_ps(0.693359375f)));
+    }
+
+    //! erfc(a_x) for a_x >= 0. x^2 is split so its rounding does not end
+    //! up in the exponent.
+    inline __m128 SSE_ErfcPositive(__m128 a_x)
+    {
+      __m128 t = _mm_div_ps(_mm_set1_ps(2.0f), _mm_add_ps(_mm_set1_ps(2.0f), a_x));
+      __m128 xh = _mm_and_ps(a_x, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0xFFFFF000))));
+      __m128 xl = _mm_sub_ps(a_x, xh);
+      __m128 e0 = SSE_Exp(_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(xh, xh)));
+      __m128 e1 = SSE_Exp(_mm_sub_ps(SSE_Polynomial(C_ERFC, _mm_sub_ps(t, _mm_set1_ps(0.5f))), _mm_mul_ps(xl, _mm_add_ps(a_x, xh))));
+      __m128 result = _mm_mul_ps(_mm_mul_ps(t, e0), e1);
+
+      //Below the smallest float from here; also takes care of infinity
+      return _mm_andnot_ps(_mm_cmpgt_ps(a_x, _mm_set1_ps(10.0f)), result);
+    }
+
+    inline __m128 SSE_Select(__m128 a_mask, __m128 a_true, __m128 a_false)
+    {
+      return _mm_or_ps(_mm_and_ps(a_mask, a_true), _mm_andnot_ps(a_mask, a_false));
+    }
+
+    template<>
+    struct ErfKernel<float>
+    {
+      static void Erf(float const * a_pIn, float * a_pOut, size_t a_count)
+      {
+        __m128 const signMask = _mm_set1_ps(-0.0f);
+        size_t i = 0;
+        for (; i + 4 <= a_count; i += 4)
+        {
+          __m128 x = _mm_loadu_ps(a_pIn + i);
+          __m128 ax = _mm_andnot_ps(signMask, x);
+          __m128 small = _mm_mul_ps(x, SSE_Polynomial(C_ERF_SMALL, _mm_mul_ps(x, x)));
+          __m128 large = _mm_sub_ps(_mm_set1_ps(1.0f), SSE_ErfcPositive(ax));
+          large = _mm_or_ps(large, _mm_and_ps(signMask, x));
+          _mm_storeu_ps(a_pOut + i, SSE_Select(_mm_cmplt_ps(ax, _mm_set1_ps(0.5f)), small, large));
+        }
+
+        for (; i < a_count; ++i)
+          a_pOut[i] = Dg::Erf(a_pIn[i]);
+      }
+
+      static void Erfc(float const * a_pIn, float * a_pOut, size_t a_count)
+      {
+        __m128 const signMask = _mm_set1_ps(-0.0f);
+        size_t i = 0;
+        for (; i + 4 <= a_count; i += 4)
+        {
+          __m128 x = _mm_loadu_ps(a_pIn + i);
+          __m128 ax = _mm_andnot_ps(signMask, x);
+          __m128 small = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(x, SSE_Polynomial(C_ERF_SMALL, _mm_mul_ps(x, x))));
+          __m128 large = SSE_ErfcPositive(ax);
+          large = SSE_Select(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(2.0f), large), large);
+          _mm_storeu_ps(a_pOut + i, SSE_Select(_mm_cmplt_ps(ax, _mm_set1_ps(0.5f)), small, large));
+        }
+
+        for (; i < a_count; ++i)
+          a_pOut[i] = Dg::Erfc(a_pIn[i]);
+      }
+
+      static void InvErf(float const * a_pIn, float * a_pOut, size_t a_count)
+      {
+        __m128 const signMask = _mm_set1_ps(-0.0f);
+        __m128 const one = _mm_set1_ps(1.0f);
+        size_t i = 0;
+        for (; i + 4 <= a_count; i += 4)
+        {
+          __m128 x = _mm_loadu_ps(a_pIn + i);
+          __m128 ax = _mm_andnot_ps(signMask, x);
+
+          //Out of range, or NaN, get a harmless argument for the log
+          __m128 outside = _mm_cmpnlt_ps(ax, one);
+          __m128 q = _mm_mul_ps(_mm_sub_ps(one, x), _mm_add_ps(one, x));
+          q = SSE_Select(outside, one, q);
+
+          __m128 w = _mm_sub_ps(_mm_setzero_ps(), SSE_Log(q));
+          __m128 central = SSE_Polynomial(C_INVERF_CENTRAL, _mm_sub_ps(w, _mm_set1_ps(2.5f)));
+          __m128 tail = SSE_Polynomial(C_INVERF_TAIL, _mm_sub_ps(_mm_sqrt_ps(w), _mm_set1_ps(3.0f)));
+          __m128 result = _mm_mul_ps(SSE_Select(_mm_cmplt_ps(w, _mm_set1_ps(5.0f)), central, tail), x);
+
+          //+-infinity at +-1, NaN beyond
+          __m128 edge = _mm_or_ps(_mm_and_ps(signMask, x), _mm_set1_ps(std::numeric_limits<float>::infinity()));
+          edge = SSE_Select(_mm_cmpeq_ps(ax, one), edge, _mm_set1_ps(std::numeric_limits<float>::quiet_NaN()));
+          _mm_storeu_ps(a_pOut + i, SSE_Select(outside, edge, result));
+        }
+
+        for (; i < a_count; ++i)
+          a_pOut[i] = Dg::InvErf(a_pIn[i]);
+      }
+    };
+
+#endif
+  }
+}
+
+#endif
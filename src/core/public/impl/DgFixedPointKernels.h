@@ -0,0 +1,539 @@
+//! @file DgFixedPointKernels.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Integer-only kernels behind the FixedPoint transcendental functions.
+//!
+//! Each function is split into a reduction from the FixedPoint value to a
+//! 32 bit working value, an iterative core, and a finish back to the
+//! FixedPoint type. The cores are shift-and-add loops: CORDIC for sin and
+//! cos, and multiplicative normalisation with a table of ln(1 + 2^-i) for
+//! exp and log. Iteration counts come from FPParams<I, F>, so each type
+//! only does the work its precision needs.
+//!
+//! Nothing here uses floating point, so results are the same on every
+//! platform. The SSE2 cores run the same integer steps 4 values at a
+//! time and give bit-identical results to the scalar ones. This relies on
+//! two's complement integers with arithmetic right shifts of negative
+//! values, which every supported compiler provides.
+//!
+//! Angles are held as phases, an unsigned 32 bit fraction of a full turn,
+//! so reduction modulo 2pi is just integer wrap-around. Other working
+//! values are Q30 (Q29 for the log mantissa).
+
+#ifndef DGFIXEDPOINTKERNELS_H
+#define DGFIXEDPOINTKERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <climits>
+#include <limits>
+#include <type_traits>
+
+#include "DgMatrixKernels.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! atan(2^-i) as a phase, in units of 2^-32 turns.
+    int32_t const FPCordicAngles[31] =
+    {
+      536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838, 5340245,
+      2670163, 1335087, 667544, 333772, 166886, 83443, 41722, 20861,
+      10430, 5215, 2608, 1304, 652, 326, 163, 81,
+      41, 20, 10, 5, 3, 1, 1
+    };
+
+    //! ln(1 + 2^-i) in Q30.
+    int32_t const FPLogTable[31] =
+    {
+      744261118, 435364845, 239598564, 126468572, 65095192, 33040817, 16647494, 8356010,
+      4186133, 2095107, 1048064, 524160, 262112, 131064, 65534, 32768,
+      16384, 8192, 4096, 2048, 1024, 512, 256, 128,
+      64, 32, 16, 8, 4, 2, 1
+    };
+
+    //! Product of cos(atan(2^-i)) over all i, in Q30.
+    int32_t const FPCordicGain = 652032874;
+
+    //! ln(2) in Q30.
+    int32_t const FPLn2 = 744261118;
+
+    //! 1 / ln(2) in Q29.
+    int64_t const FPInvLn2 = 774541002;
+
+    //! 2^33 / 2pi. A value x in Q F is (x * FPTurnsPerRadian) >> (F + 1)
+    //! in 2^-32 turns.
+    int64_t const FPTurnsPerRadian = 1367130551;
+
+    //! Marks a log reduction whose input was not positive.
+    int const FPLogUndefined = (std::numeric_limits<int>::min)();
+
+    //! Values are reduced, run through a core and finished in blocks of
+    //! this size, so the cores can work on arrays.
+    size_t const FPBlockSize = 64;
+
+    template<typename I, uint8_t F>
+    struct FPParams
+    {
+      static int const nIntegerBits = static_cast<int>(sizeof(I) * CHAR_BIT) - F - (std::numeric_limits<I>::is_signed ? 1 : 0);
+
+      //! Each CORDIC step adds about one bit.
+      static int const TrigIterations = (F + 2 < 30) ? F + 2 : 30;
+
+      //! sin / cos magnifies errors in cos near the poles, so tan always
+      //! takes every step.
+      static int const TanIterations = 30;
+
+      //! The finish applies a first order correction, which doubles the
+      //! bits per step. exp must be accurate relative to its result,
+      //! which can have nIntegerBits bits above the point.
+      static int const ExpIterations = ((F + nIntegerBits) / 2 + 2 < 30) ? (F + nIntegerBits) / 2 + 2 : 30;
+
+      //! log also has a first order correction.
+      static int const LogIterations = ((F + 1) / 2 + 2 < 30) ? (F + 1) / 2 + 2 : 30;
+
+      static int64_t const Min = static_cast<int64_t>((std::numeric_limits<I>::min)());
+      static int64_t const Max = static_cast<int64_t>((std::numeric_limits<I>::max)());
+    };
+
+    //! Clamps to the range of I.
+    template<typename I, uint8_t F>
+    I FPSaturate(int64_t a_val)
+    {
+      if (a_val < FPParams<I, F>::Min)
+        return static_cast<I>(FPParams<I, F>::Min);
+      if (a_val > FPParams<I, F>::Max)
+        return static_cast<I>(FPParams<I, F>::Max);
+      return static_cast<I>(a_val);
+    }
+
+    //! Q30 to Q F, rounded to nearest and clamped to the range of I.
+    template<typename I, uint8_t F>
+    I FPFromQ30(int64_t a_val)
+    {
+      int const down = (F < 30) ? 30 - F : 0;
+      int const up = (F > 30) ? F - 30 : 0;
+      int64_t const half = (int64_t(1) << down) >> 1;
+      return FPSaturate<I, F>(((a_val + half) >> down) * (int64_t(1) << up));
+    }
+
+    //! Q F to Q30, truncating any bits below 2^-30.
+    template<typename I, uint8_t F>
+    int64_t FPToQ30(I a_val)
+    {
+      int const down = (F > 30) ? F - 30 : 0;
+      int const up = (F < 30) ? 30 - F : 0;
+      return (static_cast<int64_t>(a_val) >> down) * (int64_t(1) << up);
+    }
+
+    //! Index of the highest set bit. a_val must not be 0.
+    inline int FPHighestBit(uint64_t a_val)
+    {
+      int result = 0;
+      for (int shift = 32; shift > 0; shift >>= 1)
+      {
+        if ((a_val >> shift) != 0)
+        {
+          a_val >>= shift;
+          result += shift;
+        }
+      }
+      return result;
+    }
+
+    //--------------------------------------------------------------------------------
+    //	Trigonometry
+    //--------------------------------------------------------------------------------
+
+    //! Angle in radians, Q F, to a phase.
+    template<typename I, uint8_t F>
+    uint32_t FPToPhase(I a_val)
+    {
+      return static_cast<uint32_t>((static_cast<int64_t>(a_val) * FPTurnsPerRadian) >> (F + 1));
+    }
+
+    //! CORDIC in rotation mode. Rotates (gain, 0) by the phase reduced to
+    //! [-pi/4, pi/4), then moves the result to the right quadrant.
+    //! Outputs are Q30.
+    inline void FPCordic(uint32_t a_phase, int a_iterations, int32_t & a_cos, int32_t & a_sin)
+    {
+      uint32_t quadrant = (a_phase + 0x20000000u) >> 30;
+      int32_t z = static_cast<int32_t>(a_phase - (quadrant << 30));
+      int32_t x = FPCordicGain;
+      int32_t y = 0;
+
+      for (int i = 0; i < a_iterations; ++i)
+      {
+        //0 to rotate anticlockwise, -1 for clockwise. (v ^ m) - m is v or -v.
+        int32_t m = z >> 31;
+        int32_t dx = ((y >> i) ^ m) - m;
+        int32_t dy = ((x >> i) ^ m) - m;
+        x -= dx;
+        y += dy;
+        z -= (FPCordicAngles[i] ^ m) - m;
+      }
+
+      switch (quadrant)
+      {
+        case 0: a_cos = x; a_sin = y; break;
+        case 1: a_cos = -y; a_sin = x; break;
+        case 2: a_cos = -x; a_sin = -y; break;
+        default: a_cos = y; a_sin = -x; break;
+      }
+    }
+
+    //! FPCordic() over arrays.
+    inline void FPCordic(uint32_t const * a_pPhase, int32_t * a_pCos, int32_t * a_pSin,
+                         size_t a_count, int a_iterations)
+    {
+      size_t i = 0;
+
+#ifdef DG_MATRIX_SSE2
+      __m128i const quarter = _mm_set1_epi32(0x20000000);
+      __m128i const one = _mm_set1_epi32(1);
+      for (; i + 4 <= a_count; i += 4)
+      {
+        __m128i phase = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a_pPhase + i));
+        __m128i quadrant = _mm_srli_epi32(_mm_add_epi32(phase, quarter), 30);
+        __m128i z = _mm_sub_epi32(phase, _mm_slli_epi32(quadrant, 30));
+        __m128i x = _mm_set1_epi32(FPCordicGain);
+        __m128i y = _mm_setzero_si128();
+
+        for (int k = 0; k < a_iterations; ++k)
+        {
+          __m128i shift = _mm_cvtsi32_si128(k);
+          __m128i m = _mm_srai_epi32(z, 31);
+          __m128i dx = _mm_sub_epi32(_mm_xor_si128(_mm_sra_epi32(y, shift), m), m);
+          __m128i dy = _mm_sub_epi32(_mm_xor_si128(_mm_sra_epi32(x, shift), m), m);
+          __m128i dz = _mm_sub_epi32(_mm_xor_si128(_mm_set1_epi32(FPCordicAngles[k]), m), m);
+          x = _mm_sub_epi32(x, dx);
+          y = _mm_add_epi32(y, dy);
+          z = _mm_sub_epi32(z, dz);
+        }
+
+        //Odd quadrants swap to (-y, x), the upper two negate
+        __m128i odd = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(quadrant, one));
+        __m128i upper = _mm_sub_epi32(_mm_setzero_si128(), _mm_srli_epi32(quadrant, 1));
+        __m128i c = _mm_or_si128(_mm_andnot_si128(odd, x), _mm_and_si128(odd, _mm_sub_epi32(_mm_setzero_si128(), y)));
+        __m128i s = _mm_or_si128(_mm_andnot_si128(odd, y), _mm_and_si128(odd, x));
+        c = _mm_sub_epi32(_mm_xor_si128(c, upper), upper);
+        s = _mm_sub_epi32(_mm_xor_si128(s, upper), upper);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pCos + i), c);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pSin + i), s);
+      }
+#endif
+
+      for (; i < a_count; ++i)
+      {
+        FPCordic(a_pPhase[i], a_iterations, a_pCos[i], a_pSin[i]);
+      }
+    }
+
+    //! sin / cos, Q30 in, Q F out. Clamped to the range of I when cos is 0.
+    template<typename I, uint8_t F>
+    I FPTanFinish(int32_t a_cos, int32_t a_sin)
+    {
+      if (a_cos == 0)
+        return static_cast<I>((a_sin < 0) ? FPParams<I, F>::Min : FPParams<I, F>::Max);
+      return FPSaturate<I, F>((static_cast<int64_t>(a_sin) * (int64_t(1) << F)) / a_cos);
+    }
+
+    //--------------------------------------------------------------------------------
+    //	Exponential
+    //--------------------------------------------------------------------------------
+
+    //! Splits a_val into k * ln(2) + r, r in [0, ln(2)) as Q30. Returns k.
+    template<typename I, uint8_t F>
+    int FPExpReduce(I a_val, int32_t & a_r)
+    {
+      int64_t x = FPToQ30<I, F>(a_val);
+      int64_t k = (static_cast<int64_t>(a_val) * FPInvLn2) >> (F + 29);
+      int64_t r = x - k * FPLn2;
+
+      //The estimate of k can be one out either way
+      if (r < 0)
+      {
+        --k;
+        r += FPLn2;
+      }
+      else if (r >= FPLn2)
+      {
+        ++k;
+        r -= FPLn2;
+      }
+
+      //Past this the result is 0 or out of range anyway
+      if (k > 64)
+        k = 64;
+      else if (k < -64)
+        k = -64;
+
+      a_r = static_cast<int32_t>(r);
+      return static_cast<int>(k);
+    }
+
+    //! e^r for r in [0, ln(2)), as Q30 in a_y. r is used up greedily by
+    //! the factors (1 + 2^-i); what is left is returned in a_r.
+    inline void FPExpCore(int32_t & a_r, int32_t & a_y, int a_iterations)
+    {
+      int32_t r = a_r;
+      int32_t y = int32_t(1) << 30;
+      for (int i = 1; i <= a_iterations; ++i)
+      {
+        int32_t t = r - FPLogTable[i];
+        if (t >= 0)
+        {
+          r = t;
+          y += y >> i;
+        }
+      }
+      a_r = r;
+      a_y = y;
+    }
+
+    //! FPExpCore() over arrays.
+    inline void FPExpCore(int32_t * a_pR, int32_t * a_pY, size_t a_count, int a_iterations)
+    {
+      size_t i = 0;
+
+#ifdef DG_MATRIX_SSE2
+      __m128i const minusOne = _mm_set1_epi32(-1);
+      for (; i + 4 <= a_count; i += 4)
+      {
+        __m128i r = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a_pR + i));
+        __m128i y = _mm_set1_epi32(int32_t(1) << 30);
+        for (int k = 1; k <= a_iterations; ++k)
+        {
+          __m128i t = _mm_sub_epi32(r, _mm_set1_epi32(FPLogTable[k]));
+          __m128i take = _mm_cmpgt_epi32(t, minusOne);
+          r = _mm_or_si128(_mm_and_si128(take, t), _mm_andnot_si128(take, r));
+          y = _mm_add_epi32(y, _mm_and_si128(take, _mm_sra_epi32(y, _mm_cvtsi32_si128(k))));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pR + i), r);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pY + i), y);
+      }
+#endif
+
+      for (; i < a_count; ++i)
+      {
+        FPExpCore(a_pR[i], a_pY[i], a_iterations);
+      }
+    }
+
+    //! y * (1 + r) * 2^k, Q F out. Clamped to the range of I.
+    template<typename I, uint8_t F>
+    I FPExpFinish(int32_t a_y, int32_t a_r, int a_k)
+    {
+      int64_t v = a_y + ((static_cast<int64_t>(a_y) * a_r) >> 30);
+      int shift = 30 - F - a_k;
+      if (shift > 62)
+        return FPSaturate<I, F>(0);
+      if (shift > 0)
+        return FPSaturate<I, F>((v + (int64_t(1) << (shift - 1))) >> shift);
+      if (-shift > 31)
+        return static_cast<I>(FPParams<I, F>::Max);
+      return FPSaturate<I, F>(v * (int64_t(1) << -shift));
+    }
+
+    //--------------------------------------------------------------------------------
+    //	Logarithm
+    //--------------------------------------------------------------------------------
+
+    //! Splits a_val into m * 2^k, m in [1, 2) as Q29. Returns k, or
+    //! FPLogUndefined if a_val is not positive.
+    template<typename I, uint8_t F>
+    int FPLogReduce(I a_val, int32_t & a_m)
+    {
+      if (!(a_val > 0))
+      {
+        a_m = int32_t(1) << 29;
+        return FPLogUndefined;
+      }
+
+      uint64_t u = static_cast<uint64_t>(a_val);
+      int p = FPHighestBit(u);
+      a_m = static_cast<int32_t>((p <= 29) ? (u << (29 - p)) : (u >> (p - 29)));
+      return p - F;
+    }
+
+    //! Multiplies m by factors (1 + 2^-i) while it stays at most 2, summing
+    //! their logs in a_acc. m is left close to 2.
+    inline void FPLogCore(int32_t & a_m, int32_t & a_acc, int a_iterations)
+    {
+      int32_t m = a_m;
+      int32_t acc = 0;
+      for (int i = 1; i <= a_iterations; ++i)
+      {
+        int32_t t = m + (m >> i);
+        if (t <= (int32_t(1) << 30))
+        {
+          m = t;
+          acc += FPLogTable[i];
+        }
+      }
+      a_m = m;
+      a_acc = acc;
+    }
+
+    //! FPLogCore() over arrays.
+    inline void FPLogCore(int32_t * a_pM, int32_t * a_pAcc, size_t a_count, int a_iterations)
+    {
+      size_t i = 0;
+
+#ifdef DG_MATRIX_SSE2
+      __m128i const limit = _mm_set1_epi32((int32_t(1) << 30) + 1);
+      for (; i + 4 <= a_count; i += 4)
+      {
+        __m128i m = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a_pM + i));
+        __m128i acc = _mm_setzero_si128();
+        for (int k = 1; k <= a_iterations; ++k)
+        {
+          __m128i t = _mm_add_epi32(m, _mm_sra_epi32(m, _mm_cvtsi32_si128(k)));
+          __m128i take = _mm_cmplt_epi32(t, limit);
+          m = _mm_or_si128(_mm_and_si128(take, t), _mm_andnot_si128(take, m));
+          acc = _mm_add_epi32(acc, _mm_and_si128(take, _mm_set1_epi32(FPLogTable[k])));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pM + i), m);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a_pAcc + i), acc);
+      }
+#endif
+
+      for (; i < a_count; ++i)
+      {
+        FPLogCore(a_pM[i], a_pAcc[i], a_iterations);
+      }
+    }
+
+    //! k * ln(2) + ln(2) - acc - ln(2 / m), Q F out. ln(2 / m) is taken as
+    //! (2 - m) / 2. Gives the lowest value of I if the input was not positive.
+    template<typename I, uint8_t F>
+    I FPLogFinish(int32_t a_m, int32_t a_acc, int a_k)
+    {
+      if (a_k == FPLogUndefined)
+        return static_cast<I>(FPParams<I, F>::Min);
+
+      int64_t lnm = static_cast<int64_t>(FPLn2) - a_acc - ((int64_t(1) << 30) - a_m);
+      return FPFromQ30<I, F>(static_cast<int64_t>(a_k) * FPLn2 + lnm);
+    }
+
+    //--------------------------------------------------------------------------------
+    //	Square root
+    //--------------------------------------------------------------------------------
+
+    //! Square root of a_val * 2^F, digit by digit, rounded to nearest. This
+    //! is the square root in Q F. The radicand is 32 bits when that is
+    //! enough for the type. Gives 0 for inputs that are not positive.
+    template<typename I, uint8_t F>
+    I FPSqrt(I a_val)
+    {
+      typedef typename std::conditional<(sizeof(I) * CHAR_BIT + F <= 32), uint32_t, uint64_t>::type Radicand;
+
+      if (!(a_val > 0))
+        return static_cast<I>(0);
+
+      Radicand n = static_cast<Radicand>(a_val) << F;
+      Radicand result = 0;
+      Radicand bit = Radicand(1) << (sizeof(Radicand) * CHAR_BIT - 2);
+      while (bit > n)
+        bit >>= 2;
+
+      //Branch free, as the digits of neighbouring values are uncorrelated
+      while (bit != 0)
+      {
+        Radicand trial = result + bit;
+        Radicand mask = Radicand(0) - static_cast<Radicand>(n >= trial);
+        n -= trial & mask;
+        result = (result >> 1) + (bit & mask);
+        bit >>= 2;
+      }
+
+      //n is now the remainder
+      if (n > result)
+        ++result;
+
+      return FPSaturate<I, F>(static_cast<int64_t>(result));
+    }
+
+    //--------------------------------------------------------------------------------
+    //	Arrays
+    //--------------------------------------------------------------------------------
+
+    //! Array versions of the functions. Values go through in blocks of
+    //! FPBlockSize: reduced, run through the array cores, then finished.
+    //! a_pOut may equal a_pIn.
+    template<typename I, uint8_t F>
+    struct FPArrayKernel
+    {
+      typedef FPParams<I, F> Params;
+
+      template<typename Finish>
+      static void Trig(I const * a_pIn, I * a_pOut, size_t a_count, int a_iterations, Finish a_finish)
+      {
+        uint32_t phase[FPBlockSize];
+        int32_t c[FPBlockSize];
+        int32_t s[FPBlockSize];
+        for (size_t b = 0; b < a_count; b += FPBlockSize)
+        {
+          size_t n = (a_count - b < FPBlockSize) ? a_count - b : FPBlockSize;
+          for (size_t i = 0; i < n; ++i)
+            phase[i] = FPToPhase<I, F>(a_pIn[b + i]);
+          FPCordic(phase, c, s, n, a_iterations);
+          for (size_t i = 0; i < n; ++i)
+            a_pOut[b + i] = a_finish(c[i], s[i]);
+        }
+      }
+
+      static void Sin(I const * a_pIn, I * a_pOut, size_t a_count)
+      {
+        Trig(a_pIn, a_pOut, a_count, Params::TrigIterations, [](int32_t, int32_t a_sin) { return FPFromQ30<I, F>(a_sin); });
+      }
+
+      static void Cos(I const * a_pIn, I * a_pOut, size_t a_count)
+      {
+        Trig(a_pIn, a_pOut, a_count, Params::TrigIterations, [](int32_t a_cos, int32_t) { return FPFromQ30<I, F>(a_cos); });
+      }
+
+      static void Tan(I const * a_pIn, I * a_pOut, size_t a_count)
+      {
+        Trig(a_pIn, a_pOut, a_count, Params::TanIterations, [](int32_t a_cos, int32_t a_sin) { return FPTanFinish<I, F>(a_cos, a_sin); });
+      }
+
+      static void Exp(I const * a_pIn, I * a_pOut, size_t a_count)
+      {
+        int32_t r[FPBlockSize];
+        int32_t y[FPBlockSize];
+        int k[FPBlockSize];
+        for (size_t b = 0; b < a_count; b += FPBlockSize)
+        {
+          size_t n = (a_count - b < FPBlockSize) ? a_count - b : FPBlockSize;
+          for (size_t i = 0; i < n; ++i)
+            k[i] = FPExpReduce<I, F>(a_pIn[b + i], r[i]);
+          FPExpCore(r, y, n, Params::ExpIterations);
+          for (size_t i = 0; i < n; ++i)
+            a_pOut[b + i] = FPExpFinish<I, F>(y[i], r[i], k[i]);
+        }
+      }
+
+      static void Log(I const * a_pIn, I * a_pOut, size_t a_count)
+      {
+        int32_t m[FPBlockSize];
+        int32_t acc[FPBlockSize];
+        int k[FPBlockSize];
+        for (size_t b = 0; b < a_count; b += FPBlockSize)
+        {
+          size_t n = (a_count - b < FPBlockSize) ? a_count - b : FPBlockSize;
+          for (size_t i = 0; i < n; ++i)
+            k[i] = FPLogReduce<I, F>(a_pIn[b + i], m[i]);
+          FPLogCore(m, acc, n, Params::LogIterations);
+          for (size_t i = 0; i < n; ++i)
+            a_pOut[b + i] = FPLogFinish<I, F>(m[i], acc[i], k[i]);
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,569 @@
+//! @file DgMatrixDecomposition.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! LU, Cholesky and QR kernels on row-major arrays with compile-time
+//! dimensions. Trip counts are constants, so small sizes are fully
+//! unrolled by the compiler. Determinant and inverse have closed forms
+//! for sizes up to 3.
+//!
+//! A pivot is treated as zero if it is within N * epsilon of the largest
+//! element of the input, so the test scales with the matrix.
+
+#ifndef DGMATRIXDECOMPOSITION_IMPL_H
+#define DGMATRIXDECOMPOSITION_IMPL_H
+
+#include <stddef.h>
+#include <cmath>
+#include <limits>
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Largest absolute value in a_in[0, Size).
+    template<size_t Size, typename Real>
+    Real MaxAbs(Real const * a_in)
+    {
+      Real result = static_cast<Real>(0.0);
+      for (size_t i = 0; i < Size; ++i)
+      {
+        Real v = std::abs(a_in[i]);
+        if (v > result) result = v;
+      }
+      return result;
+    }
+
+    //! Pivots at or below this are treated as zero.
+    template<size_t N, typename Real>
+    Real PivotTolerance(Real a_maxAbs)
+    {
+      return a_maxAbs * static_cast<Real>(N) * std::numeric_limits<Real>::epsilon();
+    }
+
+    //! In-place LU decomposition with partial pivoting, P * A = L * U.
+    //! L has a unit diagonal and is stored below it; U is stored on and
+    //! above the diagonal. Row i of the factorisation is row a_perm[i] of A.
+    template<size_t N, typename Real>
+    struct LUKernel
+    {
+      //! @return false if the matrix is singular. a_lu is left part way
+      //!         through the elimination.
+      static bool Decompose(Real * a_lu, size_t * a_perm, Real & a_sign)
+      {
+        Real const tol = PivotTolerance<N>(MaxAbs<N * N>(a_lu));
+
+        a_sign = static_cast<Real>(1.0);
+        for (size_t i = 0; i < N; ++i)
+        {
+          a_perm[i] = i;
+        }
+
+        for (size_t k = 0; k < N; ++k)
+        {
+          size_t p = k;
+          Real pMax = std::abs(a_lu[k * N + k]);
+          for (size_t i = k + 1; i < N; ++i)
+          {
+            Real v = std::abs(a_lu[i * N + k]);
+            if (v > pMax)
+            {
+              pMax = v;
+              p = i;
+            }
+          }
+
+          if (pMax <= tol)
+          {
+            return false;
+          }
+
+          if (p != k)
+          {
+            for (size_t j = 0; j < N; ++j)
+            {
+              Real temp = a_lu[k * N + j];
+              a_lu[k * N + j] = a_lu[p * N + j];
+              a_lu[p * N + j] = temp;
+            }
+            size_t temp = a_perm[k];
+            a_perm[k] = a_perm[p];
+            a_perm[p] = temp;
+            a_sign = -a_sign;
+          }
+
+          Real inv = static_cast<Real>(1.0) / a_lu[k * N + k];
+          for (size_t i = k + 1; i < N; ++i)
+          {
+            Real f = a_lu[i * N + k] * inv;
+            a_lu[i * N + k] = f;
+            for (size_t j = k + 1; j < N; ++j)
+            {
+              a_lu[i * N + j] -= f * a_lu[k * N + j];
+            }
+          }
+        }
+        return true;
+      }
+
+      //! Solves A * X = B for a decomposition of A. B and X are N x P.
+      //! a_x may not alias a_b.
+      template<size_t P>
+      static void Solve(Real const * a_lu, size_t const * a_perm,
+                        Real const * a_b, Real * a_x)
+      {
+        for (size_t i = 0; i < N; ++i)
+        {
+          for (size_t c = 0; c < P; ++c)
+          {
+            a_x[i * P + c] = a_b[a_perm[i] * P + c];
+          }
+        }
+
+        //L * Y = P * B
+        for (size_t i = 1; i < N; ++i)
+        {
+          for (size_t k = 0; k < i; ++k)
+          {
+            Real f = a_lu[i * N + k];
+            for (size_t c = 0; c < P; ++c)
+            {
+              a_x[i * P + c] -= f * a_x[k * P + c];
+            }
+          }
+        }
+
+        //U * X = Y
+        for (size_t ii = N; ii > 0; --ii)
+        {
+          size_t i = ii - 1;
+          for (size_t k = i + 1; k < N; ++k)
+          {
+            Real f = a_lu[i * N + k];
+            for (size_t c = 0; c < P; ++c)
+            {
+              a_x[i * P + c] -= f * a_x[k * P + c];
+            }
+          }
+          Real inv = static_cast<Real>(1.0) / a_lu[i * N + i];
+          for (size_t c = 0; c < P; ++c)
+          {
+            a_x[i * P + c] *= inv;
+          }
+        }
+      }
+
+      static Real Determinant(Real const * a_lu, Real a_sign)
+      {
+        Real result = a_sign;
+        for (size_t i = 0; i < N; ++i)
+        {
+          result *= a_lu[i * N + i];
+        }
+        return result;
+      }
+    };
+
+    //! In-place Cholesky decomposition A = L * L^T of a symmetric positive
+    //! definite matrix. Only the lower triangle of A is read. On return L
+    //! is in the lower triangle and the upper triangle is zero.
+    template<size_t N, typename Real>
+    struct CholeskyKernel
+    {
+      //! @return false if the matrix is not positive definite.
+      static bool Decompose(Real * a_l)
+      {
+        //The largest element of a positive definite matrix is on the diagonal
+        Real maxDiag = static_cast<Real>(0.0);
+        for (size_t i = 0; i < N; ++i)
+        {
+          Real v = std::abs(a_l[i * N + i]);
+          if (v > maxDiag) maxDiag = v;
+        }
+        Real const tol = PivotTolerance<N>(maxDiag);
+
+        for (size_t j = 0; j < N; ++j)
+        {
+          Real d = a_l[j * N + j];
+          for (size_t k = 0; k < j; ++k)
+          {
+            d -= a_l[j * N + k] * a_l[j * N + k];
+          }
+
+          if (d <= tol)
+          {
+            return false;
+          }
+
+          d = std::sqrt(d);
+          a_l[j * N + j] = d;
+          Real inv = static_cast<Real>(1.0) / d;
+
+          for (size_t i = j + 1; i < N; ++i)
+          {
+            Real s = a_l[i * N + j];
+            for (size_t k = 0; k < j; ++k)
+            {
+              s -= a_l[i * N + k] * a_l[j * N + k];
+            }
+            a_l[i * N + j] = s * inv;
+            a_l[j * N + i] = static_cast<Real>(0.0);
+          }
+        }
+        return true;
+      }
+
+      //! Solves A * X = B in place, where a_x holds B (N x P) on entry.
+      template<size_t P>
+      static void Solve(Real const * a_l, Real * a_x)
+      {
+        //L * Y = B
+        for (size_t i = 0; i < N; ++i)
+        {
+          for (size_t k = 0; k < i; ++k)
+          {
+            Real f = a_l[i * N + k];
+            for (size_t c = 0; c < P; ++c)
+            {
+              a_x[i * P + c] -= f * a_x[k * P + c];
+            }
+          }
+          Real inv = static_cast<Real>(1.0) / a_l[i * N + i];
+          for (size_t c = 0; c < P; ++c)
+          {
+            a_x[i * P + c] *= inv;
+          }
+        }
+
+        //L^T * X = Y
+        for (size_t ii = N; ii > 0; --ii)
+        {
+          size_t i = ii - 1;
+          for (size_t k = i + 1; k < N; ++k)
+          {
+            Real f = a_l[k * N + i];
+            for (size_t c = 0; c < P; ++c)
+            {
+              a_x[i * P + c] -= f * a_x[k * P + c];
+            }
+          }
+          Real inv = static_cast<Real>(1.0) / a_l[i * N + i];
+          for (size_t c = 0; c < P; ++c)
+          {
+            a_x[i * P + c] *= inv;
+          }
+        }
+      }
+    };
+
+    //! In-place Householder QR decomposition of an M x N matrix, M >= N.
+    //! The Householder vectors are stored on and below the diagonal and the
+    //! strict upper triangle of R above it. The diagonal of R goes in a_rDiag.
+    template<size_t M, size_t N, typename Real>
+    struct QRKernel
+    {
+      static_assert(M >= N, "QR decomposition needs at least as many rows as columns");
+
+      //! @return false if A does not have full column rank.
+      static bool Decompose(Real * a_qr, Real * a_rDiag)
+      {
+        Real const tol = PivotTolerance<M>(MaxAbs<M * N>(a_qr));
+        bool fullRank = true;
+
+        for (size_t k = 0; k < N; ++k)
+        {
+          Real nrm = static_cast<Real>(0.0);
+          for (size_t i = k; i < M; ++i)
+          {
+            nrm += a_qr[i * N + k] * a_qr[i * N + k];
+          }
+          nrm = std::sqrt(nrm);
+
+          if (nrm > tol)
+          {
+            if (a_qr[k * N + k] < static_cast<Real>(0.0))
+            {
+              nrm = -nrm;
+            }
+
+            Real inv = static_cast<Real>(1.0) / nrm;
+            for (size_t i = k; i < M; ++i)
+            {
+              a_qr[i * N + k] *= inv;
+            }
+            a_qr[k * N + k] += static_cast<Real>(1.0);
+
+            for (size_t j = k + 1; j < N; ++j)
+            {
+              Real s = static_cast<Real>(0.0);
+              for (size_t i = k; i < M; ++i)
+              {
+                s += a_qr[i * N + k] * a_qr[i * N + j];
+              }
+              s = -s / a_qr[k * N + k];
+              for (size_t i = k; i < M; ++i)
+              {
+                a_qr[i * N + j] += s * a_qr[i * N + k];
+              }
+            }
+          }
+          else
+          {
+            //No reflection for this column
+            for (size_t i = k; i < M; ++i)
+            {
+              a_qr[i * N + k] = static_cast<Real>(0.0);
+            }
+            nrm = static_cast<Real>(0.0);
+            fullRank = false;
+          }
+          a_rDiag[k] = -nrm;
+        }
+        return fullRank;
+      }
+
+      //! Applies Q^T to a_x (M x P) in place.
+      template<size_t P>
+      static void ApplyQt(Real const * a_qr, Real * a_x)
+      {
+        for (size_t k = 0; k < N; ++k)
+        {
+          Real d = a_qr[k * N + k];
+          if (d == static_cast<Real>(0.0))
+          {
+            continue;
+          }
+
+          for (size_t c = 0; c < P; ++c)
+          {
+            Real s = static_cast<Real>(0.0);
+            for (size_t i = k; i < M; ++i)
+            {
+              s += a_qr[i * N + k] * a_x[i * P + c];
+            }
+            s = -s / d;
+            for (size_t i = k; i < M; ++i)
+            {
+              a_x[i * P + c] += s * a_qr[i * N + k];
+            }
+          }
+        }
+      }
+
+      //! Least squares solution of A * X = B. a_b (M x P) is overwritten;
+      //! the first N rows hold X on return. Needs full rank.
+      template<size_t P>
+      static void Solve(Real const * a_qr, Real const * a_rDiag, Real * a_b)
+      {
+        ApplyQt<P>(a_qr, a_b);
+
+        for (size_t kk = N; kk > 0; --kk)
+        {
+          size_t k = kk - 1;
+          Real inv = static_cast<Real>(1.0) / a_rDiag[k];
+          for (size_t c = 0; c < P; ++c)
+          {
+            a_b[k * P + c] *= inv;
+          }
+          for (size_t i = 0; i < k; ++i)
+          {
+            Real f = a_qr[i * N + k];
+            for (size_t c = 0; c < P; ++c)
+            {
+              a_b[i * P + c] -= f * a_b[k * P + c];
+            }
+          }
+        }
+      }
+
+      //! The M x N matrix Q with orthonormal columns.
+      static void GetQ(Real const * a_qr, Real * a_q)
+      {
+        for (size_t kk = N; kk > 0; --kk)
+        {
+          size_t k = kk - 1;
+          for (size_t i = 0; i < M; ++i)
+          {
+            a_q[i * N + k] = static_cast<Real>(0.0);
+          }
+          a_q[k * N + k] = static_cast<Real>(1.0);
+
+          Real d = a_qr[k * N + k];
+          if (d == static_cast<Real>(0.0))
+          {
+            continue;
+          }
+
+          for (size_t j = k; j < N; ++j)
+          {
+            Real s = static_cast<Real>(0.0);
+            for (size_t i = k; i < M; ++i)
+            {
+              s += a_qr[i * N + k] * a_q[i * N + j];
+            }
+            s = -s / d;
+            for (size_t i = k; i < M; ++i)
+            {
+              a_q[i * N + j] += s * a_qr[i * N + k];
+            }
+          }
+        }
+      }
+    };
+
+    //! Determinant of a_in[N x N]. LU for N > 3.
+    template<size_t N, typename Real>
+    struct DeterminantKernel
+    {
+      static Real Apply(Real const * a_in)
+      {
+        Real lu[N * N];
+        size_t perm[N];
+        Real sign;
+        for (size_t i = 0; i < N * N; ++i)
+        {
+          lu[i] = a_in[i];
+        }
+
+        if (!LUKernel<N, Real>::Decompose(lu, perm, sign))
+        {
+          return static_cast<Real>(0.0);
+        }
+        return LUKernel<N, Real>::Determinant(lu, sign);
+      }
+    };
+
+    template<typename Real>
+    struct DeterminantKernel<1, Real>
+    {
+      static Real Apply(Real const * a_in)
+      {
+        return a_in[0];
+      }
+    };
+
+    template<typename Real>
+    struct DeterminantKernel<2, Real>
+    {
+      static Real Apply(Real const * a_in)
+      {
+        return a_in[0] * a_in[3] - a_in[1] * a_in[2];
+      }
+    };
+
+    template<typename Real>
+    struct DeterminantKernel<3, Real>
+    {
+      static Real Apply(Real const * a_in)
+      {
+        return a_in[0] * (a_in[4] * a_in[8] - a_in[5] * a_in[7])
+             + a_in[1] * (a_in[5] * a_in[6] - a_in[3] * a_in[8])
+             + a_in[2] * (a_in[3] * a_in[7] - a_in[4] * a_in[6]);
+      }
+    };
+
+    //! a_out = inverse of a_in[N x N]. LU for N > 3. a_out may alias a_in.
+    //!
+    //! @return false if singular, in which case a_out is not written.
+    template<size_t N, typename Real>
+    struct InverseKernel
+    {
+      static bool Apply(Real const * a_in, Real * a_out)
+      {
+        Real lu[N * N];
+        Real identity[N * N];
+        size_t perm[N];
+        Real sign;
+        for (size_t i = 0; i < N * N; ++i)
+        {
+          lu[i] = a_in[i];
+          identity[i] = static_cast<Real>(0.0);
+        }
+        for (size_t i = 0; i < N; ++i)
+        {
+          identity[i * N + i] = static_cast<Real>(1.0);
+        }
+
+        if (!LUKernel<N, Real>::Decompose(lu, perm, sign))
+        {
+          return false;
+        }
+        LUKernel<N, Real>::template Solve<N>(lu, perm, identity, a_out);
+        return true;
+      }
+    };
+
+    template<typename Real>
+    struct InverseKernel<1, Real>
+    {
+      static bool Apply(Real const * a_in, Real * a_out)
+      {
+        if (a_in[0] == static_cast<Real>(0.0))
+        {
+          return false;
+        }
+        a_out[0] = static_cast<Real>(1.0) / a_in[0];
+        return true;
+      }
+    };
+
+    template<typename Real>
+    struct InverseKernel<2, Real>
+    {
+      static bool Apply(Real const * a_in, Real * a_out)
+      {
+        Real det = DeterminantKernel<2, Real>::Apply(a_in);
+        Real scale = MaxAbs<4>(a_in);
+        if (std::abs(det) <= PivotTolerance<2>(scale) * scale)
+        {
+          return false;
+        }
+
+        Real inv = static_cast<Real>(1.0) / det;
+        Real a = a_in[0];
+        a_out[0] = a_in[3] * inv;
+        a_out[1] = -a_in[1] * inv;
+        a_out[2] = -a_in[2] * inv;
+        a_out[3] = a * inv;
+        return true;
+      }
+    };
+
+    template<typename Real>
+    struct InverseKernel<3, Real>
+    {
+      static bool Apply(Real const * a_in, Real * a_out)
+      {
+        Real c0 = a_in[4] * a_in[8] - a_in[5] * a_in[7];
+        Real c1 = a_in[5] * a_in[6] - a_in[3] * a_in[8];
+        Real c2 = a_in[3] * a_in[7] - a_in[4] * a_in[6];
+        Real det = a_in[0] * c0 + a_in[1] * c1 + a_in[2] * c2;
+        Real scale = MaxAbs<9>(a_in);
+        if (std::abs(det) <= PivotTolerance<3>(scale) * scale * scale)
+        {
+          return false;
+        }
+
+        Real inv = static_cast<Real>(1.0) / det;
+        Real out[9];
+        out[0] = c0 * inv;
+        out[3] = c1 * inv;
+        out[6] = c2 * inv;
+        out[1] = (a_in[2] * a_in[7] - a_in[1] * a_in[8]) * inv;
+        out[4] = (a_in[0] * a_in[8] - a_in[2] * a_in[6]) * inv;
+        out[7] = (a_in[1] * a_in[6] - a_in[0] * a_in[7]) * inv;
+        out[2] = (a_in[1] * a_in[5] - a_in[2] * a_in[4]) * inv;
+        out[5] = (a_in[2] * a_in[3] - a_in[0] * a_in[5]) * inv;
+        out[8] = (a_in[0] * a_in[4] - a_in[1] * a_in[3]) * inv;
+        for (size_t i = 0; i < 9; ++i)
+        {
+          a_out[i] = out[i];
+        }
+        return true;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,171 @@
+//! @file DgMatrixExpr.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Expression types behind the element-wise Matrix operators. An expression
+//! such as a * s + b - c builds a small tree of these, which is evaluated
+//! in one loop when it is assigned to a Matrix. Nothing is computed before
+//! then.
+//!
+//! Leaf matrices are held by reference, so an expression must not outlive
+//! its operands. Don't store one in an auto variable; assign it to a Matrix.
+
+#ifndef DGMATRIXEXPR_H
+#define DGMATRIXEXPR_H
+
+#include <stddef.h>
+
+namespace Dg
+{
+  template<size_t M, size_t N, typename Real> class Matrix;
+
+  namespace impl
+  {
+    //! Base of Matrix and every matrix expression. E is the most derived
+    //! expression type, which must provide Real operator[](size_t) const.
+    template<typename E, size_t M, size_t N, typename Real>
+    class MatrixExpr
+    {
+    public:
+
+      E const & Derived() const { return static_cast<E const &>(*this); }
+    };
+
+    //! Matrices are held by reference, expressions by value.
+    template<typename E>
+    struct MatrixExprStorage
+    {
+      typedef E const type;
+    };
+
+    template<size_t M, size_t N, typename Real>
+    struct MatrixExprStorage<Matrix<M, N, Real>>
+    {
+      typedef Matrix<M, N, Real> const & type;
+    };
+
+    //! Stops a scalar argument taking part in template deduction, so
+    //! v * 2.0 works on a float matrix.
+    template<typename T>
+    struct NonDeduced
+    {
+      typedef T type;
+    };
+
+    struct MatrixAddOp
+    {
+      template<typename Real>
+      static Real Apply(Real a_lhs, Real a_rhs) { return a_lhs + a_rhs; }
+    };
+
+    struct MatrixSubtractOp
+    {
+      template<typename Real>
+      static Real Apply(Real a_lhs, Real a_rhs) { return a_lhs - a_rhs; }
+    };
+
+    struct MatrixMultiplyOp
+    {
+      template<typename Real>
+      static Real Apply(Real a_lhs, Real a_rhs) { return a_lhs * a_rhs; }
+    };
+
+    struct MatrixDivideOp
+    {
+      template<typename Real>
+      static Real Apply(Real a_lhs, Real a_rhs) { return a_lhs / a_rhs; }
+    };
+
+    //! Element-wise combination of two expressions of the same size.
+    template<typename L, typename R, typename Op, size_t M, size_t N, typename Real>
+    class MatrixBinaryExpr : public MatrixExpr<MatrixBinaryExpr<L, R, Op, M, N, Real>, M, N, Real>
+    {
+    public:
+
+      MatrixBinaryExpr(L const & a_lhs, R const & a_rhs)
+        : m_lhs(a_lhs)
+        , m_rhs(a_rhs)
+      {
+
+      }
+
+      Real operator[](size_t i) const { return Op::Apply(m_lhs[i], m_rhs[i]); }
+
+    private:
+
+      typename MatrixExprStorage<L>::type m_lhs;
+      typename MatrixExprStorage<R>::type m_rhs;
+    };
+
+    //! Every element combined with a scalar, which is on the right.
+    template<typename E, typename Op, size_t M, size_t N, typename Real>
+    class MatrixScalarExpr : public MatrixExpr<MatrixScalarExpr<E, Op, M, N, Real>, M, N, Real>
+    {
+    public:
+
+      MatrixScalarExpr(E const & a_expr, Real a_scalar)
+        : m_expr(a_expr)
+        , m_scalar(a_scalar)
+      {
+
+      }
+
+      Real operator[](size_t i) const { return Op::Apply(m_expr[i], m_scalar); }
+
+    private:
+
+      typename MatrixExprStorage<E>::type m_expr;
+      Real                                m_scalar;
+    };
+
+    template<typename E, size_t M, size_t N, typename Real>
+    class MatrixNegateExpr : public MatrixExpr<MatrixNegateExpr<E, M, N, Real>, M, N, Real>
+    {
+    public:
+
+      explicit MatrixNegateExpr(E const & a_expr)
+        : m_expr(a_expr)
+      {
+
+      }
+
+      Real operator[](size_t i) const { return -m_expr[i]; }
+
+    private:
+
+      typename MatrixExprStorage<E>::type m_expr;
+    };
+
+    //! Operand of a matrix product. Products need random access to whole
+    //! rows and columns, so an expression is evaluated once up front; a
+    //! Matrix is used in place.
+    template<typename E, size_t M, size_t N, typename Real>
+    class MatrixOperand
+    {
+    public:
+
+      explicit MatrixOperand(MatrixExpr<E, M, N, Real> const & a_expr) : m_value(a_expr) {}
+      Real const * Data() const { return m_value.GetData(); }
+
+    private:
+
+      Matrix<M, N, Real> m_value;
+    };
+
+    template<size_t M, size_t N, typename Real>
+    class MatrixOperand<Matrix<M, N, Real>, M, N, Real>
+    {
+    public:
+
+      explicit MatrixOperand(MatrixExpr<Matrix<M, N, Real>, M, N, Real> const & a_expr) : m_value(a_expr.Derived()) {}
+      Real const * Data() const { return m_value.GetData(); }
+
+    private:
+
+      Matrix<M, N, Real> const & m_value;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,434 @@
+//! @file DgMatrixKernels.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Kernels behind the Matrix and R3 vector/matrix operations. The generic
+//! versions are plain loops; Matrix<4, 4, float> and 4-wide float vectors
+//! get SSE (and AVX for 4x4 multiply) specialisations when available.
+//!
+//! Unless stated otherwise, output arrays must not alias the inputs.
+
+#ifndef DGMATRIXKERNELS_H
+#define DGMATRIXKERNELS_H
+
+#include <stddef.h>
+#include <cmath>
+
+#include "../DgMath.h"
+#include "DgParallelFor.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DG_MATRIX_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define DG_MATRIX_AVX
+#include <immintrin.h>
+#endif
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! a_out[M x P] = a_A[M x N] * a_B[N x P], all row major.
+    template<size_t M, size_t N, size_t P, typename Real>
+    struct MatrixMultiplyKernel
+    {
+      static void Apply(Real const * a_A, Real const * a_B, Real * a_out)
+      {
+        for (size_t m = 0; m < M; ++m)
+        {
+          for (size_t p = 0; p < P; ++p)
+          {
+            Real sum = static_cast<Real>(0.0);
+            for (size_t n = 0; n < N; ++n)
+            {
+              sum += a_A[m * N + n] * a_B[n * P + p];
+            }
+            a_out[m * P + p] = sum;
+          }
+        }
+      }
+    };
+
+    //! a_out[N x M] = transpose of a_in[M x N].
+    template<size_t M, size_t N, typename Real>
+    struct MatrixTransposeKernel
+    {
+      static void Apply(Real const * a_in, Real * a_out)
+      {
+        for (size_t m = 0; m < M; ++m)
+        {
+          for (size_t n = 0; n < N; ++n)
+          {
+            a_out[n * M + m] = a_in[m * N + n];
+          }
+        }
+      }
+    };
+
+    //! Sum of the element-wise product of two arrays.
+    template<size_t Size, typename Real>
+    struct DotKernel
+    {
+      static Real Apply(Real const * a_A, Real const * a_B)
+      {
+        Real result = static_cast<Real>(0.0);
+        for (size_t i = 0; i < Size; i++)
+        {
+          result += a_A[i] * a_B[i];
+        }
+        return result;
+      }
+    };
+
+    //! Cross product of the xyz part of two 4-wide vectors. w is set to 0.
+    template<typename Real>
+    struct Cross4Kernel
+    {
+      static void Apply(Real const * a_A, Real const * a_B, Real * a_out)
+      {
+        a_out[0] = a_A[1] * a_B[2] - a_A[2] * a_B[1];
+        a_out[1] = a_A[2] * a_B[0] - a_A[0] * a_B[2];
+        a_out[2] = a_A[0] * a_B[1] - a_A[1] * a_B[0];
+        a_out[3] = static_cast<Real>(0.0);
+      }
+    };
+
+    //! Scales a 4-wide vector in place to unit length. Returns false, leaving
+    //! the vector untouched, if its length is zero.
+    template<typename Real>
+    struct Normalize4Kernel
+    {
+      static bool Apply(Real * a_v)
+      {
+        Real lengthsq = DotKernel<4, Real>::Apply(a_v, a_v);
+        if (Dg::IsZero(lengthsq))
+          return false;
+
+        Real factor = static_cast<Real>(1.0) / std::sqrt(lengthsq);
+        a_v[0] *= factor;
+        a_v[1] *= factor;
+        a_v[2] *= factor;
+        a_v[3] *= factor;
+        return true;
+      }
+    };
+
+    //! Inverse of a row major affine 4x4 matrix, translation in the bottom
+    //! row. Returns false if the upper 3x3 is singular, in which case
+    //! a_out is not written.
+    template<typename Real>
+    struct AffineInverseKernel
+    {
+      static bool Apply(Real const * a_in, Real * a_out)
+      {
+        //compute upper left 3x3 matrix determinant
+        Real cofactor0 = a_in[5] * a_in[10] - a_in[9] * a_in[6];
+        Real cofactor1 = a_in[6] * a_in[8] - a_in[4] * a_in[10];
+        Real cofactor2 = a_in[4] * a_in[9] - a_in[8] * a_in[5];
+        Real det = a_in[0] * cofactor0 + a_in[1] * cofactor1 + a_in[2] * cofactor2;
+        if (Dg::IsZero(det))
+          return false;
+
+        // create adjunct matrix and multiply by 1/det to get upper 3x3
+        Real invDet = static_cast<Real>(1.0) / det;
+        a_out[0] = invDet * cofactor0;
+        a_out[4] = invDet * cofactor1;
+        a_out[8] = invDet * cofactor2;
+
+        a_out[1] = invDet * (a_in[2] * a_in[9] - a_in[1] * a_in[10]);
+        a_out[5] = invDet * (a_in[0] * a_in[10] - a_in[2] * a_in[8]);
+        a_out[9] = invDet * (a_in[1] * a_in[8] - a_in[0] * a_in[9]);
+
+        a_out[2] = invDet * (a_in[1] * a_in[6] - a_in[2] * a_in[5]);
+        a_out[6] = invDet * (a_in[2] * a_in[4] - a_in[0] * a_in[6]);
+        a_out[10] = invDet * (a_in[0] * a_in[5] - a_in[1] * a_in[4]);
+
+        // multiply -translation by inverted 3x3 to get its inverse
+        a_out[12] = -a_in[12] * a_out[0] - a_in[13] * a_out[4] - a_in[14] * a_out[8];
+        a_out[13] = -a_in[12] * a_out[1] - a_in[13] * a_out[5] - a_in[14] * a_out[9];
+        a_out[14] = -a_in[12] * a_out[2] - a_in[13] * a_out[6] - a_in[14] * a_out[10];
+
+        a_out[3] = a_out[7] = a_out[11] = static_cast<Real>(0.0);
+        a_out[15] = static_cast<Real>(1.0);
+        return true;
+      }
+    };
+
+    //! a_out[i] = a_in[i] * a_M + a_t over a_count 4-wide row vectors, where
+    //! a_M is a row major 4x4 matrix and a_t a 4-wide vector. a_out may
+    //! equal a_in.
+    template<typename Real>
+    struct TransformVectorsKernel
+    {
+      static void Apply(Real const * a_M, Real const * a_t, Real const * a_in, Real * a_out, size_t a_count)
+      {
+        for (size_t i = 0; i < a_count; i++)
+        {
+          Real x = a_in[0];
+          Real y = a_in[1];
+          Real z = a_in[2];
+          Real w = a_in[3];
+          a_out[0] = x * a_M[0] + y * a_M[4] + z * a_M[8] + w * a_M[12] + a_t[0];
+          a_out[1] = x * a_M[1] + y * a_M[5] + z * a_M[9] + w * a_M[13] + a_t[1];
+          a_out[2] = x * a_M[2] + y * a_M[6] + z * a_M[10] + w * a_M[14] + a_t[2];
+          a_out[3] = x * a_M[3] + y * a_M[7] + z * a_M[11] + w * a_M[15] + a_t[3];
+          a_in += 4;
+          a_out += 4;
+        }
+      }
+    };
+
+#ifdef DG_MATRIX_SSE2
+
+    //! [x y z w] -> [y z x w]
+#define DG_MATRIX_YZX(v) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(3, 0, 2, 1))
+
+    //! Row vector times a 4x4 matrix held as four rows.
+    inline __m128 SSE_RowTimesMatrix(__m128 a_row, __m128 a_b0, __m128 a_b1, __m128 a_b2, __m128 a_b3)
+    {
+      __m128 result = _mm_mul_ps(_mm_shuffle_ps(a_row, a_row, _MM_SHUFFLE(0, 0, 0, 0)), a_b0);
+      result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a_row, a_row, _MM_SHUFFLE(1, 1, 1, 1)), a_b1));
+      result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a_row, a_row, _MM_SHUFFLE(2, 2, 2, 2)), a_b2));
+      result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(a_row, a_row, _MM_SHUFFLE(3, 3, 3, 3)), a_b3));
+      return result;
+    }
+
+    //! Sum of all four lanes, broadcast to every lane.
+    inline __m128 SSE_HorizontalSum(__m128 a_v)
+    {
+      __m128 shuf = _mm_shuffle_ps(a_v, a_v, _MM_SHUFFLE(2, 3, 0, 1));
+      __m128 sums = _mm_add_ps(a_v, shuf);
+      shuf = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2));
+      return _mm_add_ps(sums, shuf);
+    }
+
+    inline __m128 SSE_Cross(__m128 a_A, __m128 a_B)
+    {
+      //(a * b.yzx - a.yzx * b).yzx
+      __m128 result = _mm_sub_ps(_mm_mul_ps(a_A, DG_MATRIX_YZX(a_B)),
+                                 _mm_mul_ps(DG_MATRIX_YZX(a_A), a_B));
+      return DG_MATRIX_YZX(result);
+    }
+
+    //! The SSE versions load both inputs before storing, so a_out may alias
+    //! either input.
+    template<>
+    struct MatrixMultiplyKernel<4, 4, 4, float>
+    {
+      static void Apply(float const * a_A, float const * a_B, float * a_out)
+      {
+#ifdef DG_MATRIX_AVX
+        //Two rows of A per pass; each 128-bit lane broadcasts its own row.
+        __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_B));
+        __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_B + 4));
+        __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_B + 8));
+        __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_B + 12));
+        __m256 a01 = _mm256_loadu_ps(a_A);
+        __m256 a23 = _mm256_loadu_ps(a_A + 8);
+
+        __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+
+        __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+
+        _mm256_storeu_ps(a_out, r01);
+        _mm256_storeu_ps(a_out + 8, r23);
+#else
+        __m128 b0 = _mm_loadu_ps(a_B);
+        __m128 b1 = _mm_loadu_ps(a_B + 4);
+        __m128 b2 = _mm_loadu_ps(a_B + 8);
+        __m128 b3 = _mm_loadu_ps(a_B + 12);
+        __m128 a0 = _mm_loadu_ps(a_A);
+        __m128 a1 = _mm_loadu_ps(a_A + 4);
+        __m128 a2 = _mm_loadu_ps(a_A + 8);
+        __m128 a3 = _mm_loadu_ps(a_A + 12);
+
+        _mm_storeu_ps(a_out, SSE_RowTimesMatrix(a0, b0, b1, b2, b3));
+        _mm_storeu_ps(a_out + 4, SSE_RowTimesMatrix(a1, b0, b1, b2, b3));
+        _mm_storeu_ps(a_out + 8, SSE_RowTimesMatrix(a2, b0, b1, b2, b3));
+        _mm_storeu_ps(a_out + 12, SSE_RowTimesMatrix(a3, b0, b1, b2, b3));
+#endif
+      }
+    };
+
+    //! Vector-matrix transform.
+    template<>
+    struct MatrixMultiplyKernel<1, 4, 4, float>
+    {
+      static void Apply(float const * a_A, float const * a_B, float * a_out)
+      {
+        __m128 result = SSE_RowTimesMatrix(_mm_loadu_ps(a_A),
+                                           _mm_loadu_ps(a_B),
+                                           _mm_loadu_ps(a_B + 4),
+                                           _mm_loadu_ps(a_B + 8),
+                                           _mm_loadu_ps(a_B + 12));
+        _mm_storeu_ps(a_out, result);
+      }
+    };
+
+    //! a_out may alias a_in.
+    template<>
+    struct MatrixTransposeKernel<4, 4, float>
+    {
+      static void Apply(float const * a_in, float * a_out)
+      {
+        __m128 r0 = _mm_loadu_ps(a_in);
+        __m128 r1 = _mm_loadu_ps(a_in + 4);
+        __m128 r2 = _mm_loadu_ps(a_in + 8);
+        __m128 r3 = _mm_loadu_ps(a_in + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(a_out, r0);
+        _mm_storeu_ps(a_out + 4, r1);
+        _mm_storeu_ps(a_out + 8, r2);
+        _mm_storeu_ps(a_out + 12, r3);
+      }
+    };
+
+    template<>
+    struct DotKernel<4, float>
+    {
+      static float Apply(float const * a_A, float const * a_B)
+      {
+        __m128 prod = _mm_mul_ps(_mm_loadu_ps(a_A), _mm_loadu_ps(a_B));
+        return _mm_cvtss_f32(SSE_HorizontalSum(prod));
+      }
+    };
+
+    template<>
+    struct Cross4Kernel<float>
+    {
+      static void Apply(float const * a_A, float const * a_B, float * a_out)
+      {
+        //w comes out as a.w * b.w - a.w * b.w, which is exactly 0
+        _mm_storeu_ps(a_out, SSE_Cross(_mm_loadu_ps(a_A), _mm_loadu_ps(a_B)));
+      }
+    };
+
+    template<>
+    struct Normalize4Kernel<float>
+    {
+      static bool Apply(float * a_v)
+      {
+        __m128 v = _mm_loadu_ps(a_v);
+        __m128 lengthsq = SSE_HorizontalSum(_mm_mul_ps(v, v));
+        if (Dg::IsZero(_mm_cvtss_f32(lengthsq)))
+          return false;
+
+        _mm_storeu_ps(a_v, _mm_div_ps(v, _mm_sqrt_ps(lengthsq)));
+        return true;
+      }
+    };
+
+    //! Rows of the inverse 3x3 are the columns of [y^z, z^x, x^y] / det,
+    //! where x, y, z are the basis rows of the input.
+    template<>
+    struct AffineInverseKernel<float>
+    {
+      static bool Apply(float const * a_in, float * a_out)
+      {
+        __m128 wMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        __m128 x = _mm_and_ps(_mm_loadu_ps(a_in), wMask);
+        __m128 y = _mm_and_ps(_mm_loadu_ps(a_in + 4), wMask);
+        __m128 z = _mm_and_ps(_mm_loadu_ps(a_in + 8), wMask);
+        __m128 p = _mm_loadu_ps(a_in + 12);
+
+        __m128 c0 = SSE_Cross(y, z);
+        __m128 c1 = SSE_Cross(z, x);
+        __m128 c2 = SSE_Cross(x, y);
+
+        float det = _mm_cvtss_f32(SSE_HorizontalSum(_mm_mul_ps(x, c0)));
+        if (Dg::IsZero(det))
+          return false;
+
+        __m128 invDet = _mm_set1_ps(1.0f / det);
+        c0 = _mm_mul_ps(c0, invDet);
+        c1 = _mm_mul_ps(c1, invDet);
+        c2 = _mm_mul_ps(c2, invDet);
+        __m128 c3 = _mm_setzero_ps();
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        //translation = -(p.x * row0 + p.y * row1 + p.z * row2)
+        __m128 t = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0)), c0);
+        t = _mm_add_ps(t, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)), c1));
+        t = _mm_add_ps(t, _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)), c2));
+        t = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), t);
+
+        _mm_storeu_ps(a_out, c0);
+        _mm_storeu_ps(a_out + 4, c1);
+        _mm_storeu_ps(a_out + 8, c2);
+        _mm_storeu_ps(a_out + 12, t);
+        return true;
+      }
+    };
+
+    //! Each output is a sum of matrix rows scaled by the input components,
+    //! so the rows stay in registers for the whole array. Under AVX two
+    //! vectors share a register, one per 128-bit lane.
+    template<>
+    struct TransformVectorsKernel<float>
+    {
+      static void Apply(float const * a_M, float const * a_t, float const * a_in, float * a_out, size_t a_count)
+      {
+        size_t i = 0;
+
+#ifdef DG_MATRIX_AVX
+        __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_M));
+        __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_M + 4));
+        __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_M + 8));
+        __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_M + 12));
+        __m256 t = _mm256_broadcast_ps(reinterpret_cast<__m128 const *>(a_t));
+
+        for (; i + 2 <= a_count; i += 2)
+        {
+          __m256 v = _mm256_loadu_ps(a_in + i * 4);
+          __m256 result = _mm256_add_ps(t, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), b0));
+          result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+          result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+          result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+          _mm256_storeu_ps(a_out + i * 4, result);
+        }
+#endif
+
+        __m128 r0 = _mm_loadu_ps(a_M);
+        __m128 r1 = _mm_loadu_ps(a_M + 4);
+        __m128 r2 = _mm_loadu_ps(a_M + 8);
+        __m128 r3 = _mm_loadu_ps(a_M + 12);
+        __m128 tv = _mm_loadu_ps(a_t);
+        for (; i < a_count; i++)
+        {
+          __m128 v = SSE_RowTimesMatrix(_mm_loadu_ps(a_in + i * 4), r0, r1, r2, r3);
+          _mm_storeu_ps(a_out + i * 4, _mm_add_ps(v, tv));
+        }
+      }
+    };
+
+#undef DG_MATRIX_YZX
+
+#endif
+
+    //! TransformVectorsKernel split over a_nThreads threads (0 = one per
+    //! hardware thread).
+    template<typename Real>
+    void TransformVectors(Real const * a_M, Real const * a_t,
+                          Real const * a_in, Real * a_out,
+                          size_t a_count, unsigned a_nThreads)
+    {
+      ParallelFor(a_count, ThreadCount(a_count, a_nThreads),
+        [=](size_t a_begin, size_t a_end, unsigned)
+      {
+        TransformVectorsKernel<Real>::Apply(a_M, a_t, a_in + a_begin * 4, a_out + a_begin * 4, a_end - a_begin);
+      });
+    }
+  }
+}
+
+#endif
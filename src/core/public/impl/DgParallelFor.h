@@ -0,0 +1,63 @@
+//! @file DgParallelFor.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Splitting a range of work over a number of threads.
+
+#ifndef DGPARALLELFOR_H
+#define DGPARALLELFOR_H
+
+#include <stddef.h>
+#include <thread>
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Below this, spawning threads costs more than it saves.
+    size_t const defaultMinItemsPerThread = 0x4000;
+
+    //! Number of threads to use for a_nItems. A request of 0 means one per
+    //! hardware thread. Never returns less than 1.
+    inline unsigned ThreadCount(size_t a_nItems,
+                                unsigned a_requested,
+                                size_t a_minItemsPerThread = defaultMinItemsPerThread)
+    {
+      if (a_requested == 0)
+        a_requested = std::thread::hardware_concurrency();
+      if (a_minItemsPerThread == 0)
+        a_minItemsPerThread = 1;
+      if (a_requested > a_nItems / a_minItemsPerThread)
+        a_requested = static_cast<unsigned>(a_nItems / a_minItemsPerThread);
+      return a_requested == 0 ? 1 : a_requested;
+    }
+
+    //! Splits [0, a_nItems) into a_nThreads contiguous ranges and calls
+    //! a_fn(begin, end, threadIndex) on each, one per thread. The calling
+    //! thread does the last range. Returns once all ranges are done.
+    template<typename Fn>
+    void ParallelFor(size_t a_nItems, unsigned a_nThreads, Fn a_fn)
+    {
+      if (a_nThreads < 2 || a_nItems < 2)
+      {
+        a_fn(size_t(0), a_nItems, 0u);
+        return;
+      }
+
+      if (a_nThreads > a_nItems)
+        a_nThreads = static_cast<unsigned>(a_nItems);
+
+      size_t chunk = a_nItems / a_nThreads;
+      std::thread * pThreads = new std::thread[a_nThreads - 1];
+      for (unsigned t = 0; t < a_nThreads - 1; t++)
+        pThreads[t] = std::thread(a_fn, t * chunk, (t + 1) * chunk, t);
+      a_fn((a_nThreads - 1) * chunk, a_nItems, a_nThreads - 1);
+      for (unsigned t = 0; t < a_nThreads - 1; t++)
+        pThreads[t].join();
+      delete[] pThreads;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,409 @@
+//! @file DgQuaternionKernels.h
+//!
+//! @author: Frank B. Hart
+//! @date 19/10/2026
+//!
+//! Kernels behind the batched quaternion interpolation and pose blending.
+//! Quaternions are stored as 4 consecutive reals, w first. The float
+//! versions transpose blocks of 4 quaternions into registers holding one
+//! component each, so every lane works on a different quaternion.
+//!
+//! Outputs may alias the inputs.
+
+#ifndef DGQUATERNIONKERNELS_H
+#define DGQUATERNIONKERNELS_H
+
+#include <stddef.h>
+#include <cmath>
+
+#include "DgMatrixKernels.h"
+
+namespace Dg
+{
+  namespace impl
+  {
+    //! Cosine below which interpolation takes the shorter path by negating
+    //! the start quaternion. Matches the scalar functions.
+    template<typename Real>
+    Real ShortPathThreshold() { return Dg::Constants<Real>::EPSILON; }
+
+    //! a_out[i] = Slerp(a_q0[i], a_q1[i], a_t), exactly as the scalar Slerp().
+    template<typename Real>
+    struct SlerpKernel
+    {
+      static void Apply(Real const * a_q0, Real const * a_q1, Real a_t, Real * a_out, size_t a_count)
+      {
+        Real const one = static_cast<Real>(1.0);
+        for (size_t i = 0; i < a_count; ++i)
+        {
+          Real const * q0 = a_q0 + i * 4;
+          Real const * q1 = a_q1 + i * 4;
+          Real cs = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+
+          Real flip = one;
+          if (cs < ShortPathThreshold<Real>())
+          {
+            flip = -one;
+            cs = -cs;
+          }
+
+          Real c0 = one - a_t;
+          Real c1 = a_t;
+          if ((one - cs) > Dg::Constants<Real>::EPSILON)
+          {
+            Real theta = std::acos(cs);
+            Real recipSinTheta = one / std::sin(theta);
+            c0 = std::sin(c0 * theta) * recipSinTheta;
+            c1 = std::sin(c1 * theta) * recipSinTheta;
+          }
+          c0 *= flip;
+
+          for (int j = 0; j < 4; ++j)
+          {
+            a_out[i * 4 + j] = c0 * q0[j] + c1 * q1[j];
+          }
+        }
+      }
+    };
+
+    //! One ApproxSlerp(). The time is corrected with
+    //! t' = t * (t * (2k * t - 3k) + 1 + k), k = 0.5069269 * (1 - 0.7878088 * |cos|)^2.
+    template<typename Real>
+    void ApproxSlerpOne(Real const * a_q0, Real const * a_q1, Real a_t, Real * a_out)
+    {
+      Real const one = static_cast<Real>(1.0);
+      Real cs = a_q0[0] * a_q1[0] + a_q0[1] * a_q1[1] + a_q0[2] * a_q1[2] + a_q0[3] * a_q1[3];
+
+      Real factor = one - static_cast<Real>(0.7878088) * std::abs(cs);
+      Real k = static_cast<Real>(0.5069269) * factor * factor;
+      Real t = a_t * (a_t * (static_cast<Real>(2.0) * k * a_t - static_cast<Real>(3.0) * k) + one + k);
+
+      Real c0 = (cs < ShortPathThreshold<Real>()) ? t - one : one - t;
+      for (int j = 0; j < 4; ++j)
+      {
+        a_out[j] = c0 * a_q0[j] + t * a_q1[j];
+      }
+    }
+
+    //! a_out[i] = ApproxSlerp(a_q0[i], a_q1[i], a_t).
+    template<typename Real>
+    struct ApproxSlerpKernel
+    {
+      static void Apply(Real const * a_q0, Real const * a_q1, Real a_t, Real * a_out, size_t a_count)
+      {
+        for (size_t i = 0; i < a_count; ++i)
+        {
+          ApproxSlerpOne(a_q0 + i * 4, a_q1 + i * 4, a_t, a_out + i * 4);
+        }
+      }
+    };
+
+    //! Weighted sum of a_nPoses quaternions per element in [a_begin, a_end),
+    //! normalised. Each pose is flipped onto the hemisphere of the first.
+    //! Elements whose sum is zero are set to the identity.
+    template<typename Real>
+    void BlendOne(Real const * const * a_ppPoses, Real const * a_pWeights, size_t a_nPoses,
+                  size_t a_begin, size_t a_end, Real * a_out)
+    {
+      for (size_t i = a_begin; i < a_end; ++i)
+      {
+        Real const * ref = a_ppPoses[0] + i * 4;
+        Real acc[4];
+        for (int j = 0; j < 4; ++j)
+        {
+          acc[j] = a_pWeights[0] * ref[j];
+        }
+
+        for (size_t p = 1; p < a_nPoses; ++p)
+        {
+          Real const * q = a_ppPoses[p] + i * 4;
+          Real cs = ref[0] * q[0] + ref[1] * q[1] + ref[2] * q[2] + ref[3] * q[3];
+          Real w = (cs < static_cast<Real>(0.0)) ? -a_pWeights[p] : a_pWeights[p];
+          for (int j = 0; j < 4; ++j)
+          {
+            acc[j] += w * q[j];
+          }
+        }
+
+        Real lenSq = acc[0] * acc[0] + acc[1] * acc[1] + acc[2] * acc[2] + acc[3] * acc[3];
+        Real * out = a_out + i * 4;
+        if (lenSq > static_cast<Real>(0.0))
+        {
+          Real inv = static_cast<Real>(1.0) / std::sqrt(lenSq);
+          for (int j = 0; j < 4; ++j)
+          {
+            out[j] = acc[j] * inv;
+          }
+        }
+        else
+        {
+          out[0] = static_cast<Real>(1.0);
+          out[1] = out[2] = out[3] = static_cast<Real>(0.0);
+        }
+      }
+    }
+
+    template<typename Real>
+    struct BlendKernel
+    {
+      static void Apply(Real const * const * a_ppPoses, Real const * a_pWeights, size_t a_nPoses,
+                        size_t a_begin, size_t a_end, Real * a_out)
+      {
+        BlendOne(a_ppPoses, a_pWeights, a_nPoses, a_begin, a_end, a_out);
+      }
+    };
+
+    //! Terms in the float slerp polynomial.
+    size_t const slerpPolyTerms = 8;
+
+    //! Coefficients of the float slerp. sin(t * a) / sin(a) is expanded as
+    //! t * (1 + b0 * (1 + b1 * (1 + ... ))), bi = (ui * t^2 - vi) * (cos(a) - 1),
+    //! ui = 1 / (i * (2i + 1)), vi = i / (2i + 1). Truncating after 8 terms and
+    //! scaling the last by 1.85298 keeps the weights within 2e-5 for
+    //! cos(a) in [0, 1]. There are no branches or trig calls. Since t is the
+    //! same for the whole batch, ui * t^2 - vi is computed once.
+    struct SlerpPolyCoefficients
+    {
+      SlerpPolyCoefficients(float a_t)
+      {
+        float const lastTermScale = 1.85298f;
+        float d = 1.0f - a_t;
+        t = a_t;
+        s = d;
+        for (size_t i = 0; i < slerpPolyTerms; ++i)
+        {
+          float n = static_cast<float>(i + 1);
+          float u = 1.0f / (n * (2.0f * n + 1.0f));
+          float v = n / (2.0f * n + 1.0f);
+          if (i + 1 == slerpPolyTerms)
+          {
+            u *= lastTermScale;
+            v *= lastTermScale;
+          }
+          aT[i] = u * a_t * a_t - v;
+          aS[i] = u * d * d - v;
+        }
+      }
+
+      float t, s;
+      float aT[slerpPolyTerms];
+      float aS[slerpPolyTerms];
+    };
+
+    //! Scalar version of the float slerp, for the tail of a batch.
+    inline void SlerpPoly(SlerpPolyCoefficients const & a_c, float const * a_q0, float const * a_q1, float * a_out)
+    {
+      float cs = a_q0[0] * a_q1[0] + a_q0[1] * a_q1[1] + a_q0[2] * a_q1[2] + a_q0[3] * a_q1[3];
+      float flip = 1.0f;
+      if (cs < ShortPathThreshold<float>())
+      {
+        flip = -1.0f;
+        cs = -cs;
+      }
+
+      float xm1 = cs - 1.0f;
+      float accT = 1.0f;
+      float accS = 1.0f;
+      for (size_t i = slerpPolyTerms; i > 0; --i)
+      {
+        accT = 1.0f + a_c.aT[i - 1] * xm1 * accT;
+        accS = 1.0f + a_c.aS[i - 1] * xm1 * accS;
+      }
+      float c0 = flip * a_c.s * accS;
+      float c1 = a_c.t * accT;
+
+      for (int j = 0; j < 4; ++j)
+      {
+        a_out[j] = c0 * a_q0[j] + c1 * a_q1[j];
+      }
+    }
+
+    template<>
+    struct SlerpKernel<float>
+    {
+      static void Apply(float const * a_q0, float const * a_q1, float a_t, float * a_out, size_t a_count)
+      {
+        SlerpPolyCoefficients const c(a_t);
+        size_t i = 0;
+
+#ifdef DG_MATRIX_SSE2
+        __m128 const one = _mm_set1_ps(1.0f);
+        __m128 const signBit = _mm_set1_ps(-0.0f);
+        __m128 const threshold = _mm_set1_ps(ShortPathThreshold<float>());
+        __m128 const t = _mm_set1_ps(c.t);
+        __m128 const s = _mm_set1_ps(c.s);
+
+        for (; i + 4 <= a_count; i += 4)
+        {
+          __m128 w0 = _mm_loadu_ps(a_q0 + i * 4);
+          __m128 x0 = _mm_loadu_ps(a_q0 + i * 4 + 4);
+          __m128 y0 = _mm_loadu_ps(a_q0 + i * 4 + 8);
+          __m128 z0 = _mm_loadu_ps(a_q0 + i * 4 + 12);
+          __m128 w1 = _mm_loadu_ps(a_q1 + i * 4);
+          __m128 x1 = _mm_loadu_ps(a_q1 + i * 4 + 4);
+          __m128 y1 = _mm_loadu_ps(a_q1 + i * 4 + 8);
+          __m128 z1 = _mm_loadu_ps(a_q1 + i * 4 + 12);
+          _MM_TRANSPOSE4_PS(w0, x0, y0, z0);
+          _MM_TRANSPOSE4_PS(w1, x1, y1, z1);
+
+          __m128 cs = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, w1), _mm_mul_ps(x0, x1)),
+                                 _mm_add_ps(_mm_mul_ps(y0, y1), _mm_mul_ps(z0, z1)));
+          __m128 flip = _mm_and_ps(_mm_cmplt_ps(cs, threshold), signBit);
+          cs = _mm_xor_ps(cs, flip);
+
+          __m128 xm1 = _mm_sub_ps(cs, one);
+          __m128 accT = one;
+          __m128 accS = one;
+          for (size_t k = slerpPolyTerms; k > 0; --k)
+          {
+            accT = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(c.aT[k - 1]), xm1), accT));
+            accS = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(c.aS[k - 1]), xm1), accS));
+          }
+          __m128 c0 = _mm_xor_ps(_mm_mul_ps(s, accS), flip);
+          __m128 c1 = _mm_mul_ps(t, accT);
+
+          __m128 w = _mm_add_ps(_mm_mul_ps(c0, w0), _mm_mul_ps(c1, w1));
+          __m128 x = _mm_add_ps(_mm_mul_ps(c0, x0), _mm_mul_ps(c1, x1));
+          __m128 y = _mm_add_ps(_mm_mul_ps(c0, y0), _mm_mul_ps(c1, y1));
+          __m128 z = _mm_add_ps(_mm_mul_ps(c0, z0), _mm_mul_ps(c1, z1));
+          _MM_TRANSPOSE4_PS(w, x, y, z);
+          _mm_storeu_ps(a_out + i * 4, w);
+          _mm_storeu_ps(a_out + i * 4 + 4, x);
+          _mm_storeu_ps(a_out + i * 4 + 8, y);
+          _mm_storeu_ps(a_out + i * 4 + 12, z);
+        }
+#endif
+
+        for (; i < a_count; ++i)
+        {
+          SlerpPoly(c, a_q0 + i * 4, a_q1 + i * 4, a_out + i * 4);
+        }
+      }
+    };
+
+#ifdef DG_MATRIX_SSE2
+    template<>
+    struct ApproxSlerpKernel<float>
+    {
+      static void Apply(float const * a_q0, float const * a_q1, float a_t, float * a_out, size_t a_count)
+      {
+        __m128 const one = _mm_set1_ps(1.0f);
+        __m128 const absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        __m128 const threshold = _mm_set1_ps(ShortPathThreshold<float>());
+        __m128 const attenuation = _mm_set1_ps(0.7878088f);
+        __m128 const kScale = _mm_set1_ps(0.5069269f);
+        __m128 const t = _mm_set1_ps(a_t);
+        __m128 const t2 = _mm_set1_ps(2.0f * a_t);
+
+        size_t i = 0;
+        for (; i + 4 <= a_count; i += 4)
+        {
+          __m128 w0 = _mm_loadu_ps(a_q0 + i * 4);
+          __m128 x0 = _mm_loadu_ps(a_q0 + i * 4 + 4);
+          __m128 y0 = _mm_loadu_ps(a_q0 + i * 4 + 8);
+          __m128 z0 = _mm_loadu_ps(a_q0 + i * 4 + 12);
+          __m128 w1 = _mm_loadu_ps(a_q1 + i * 4);
+          __m128 x1 = _mm_loadu_ps(a_q1 + i * 4 + 4);
+          __m128 y1 = _mm_loadu_ps(a_q1 + i * 4 + 8);
+          __m128 z1 = _mm_loadu_ps(a_q1 + i * 4 + 12);
+          _MM_TRANSPOSE4_PS(w0, x0, y0, z0);
+          _MM_TRANSPOSE4_PS(w1, x1, y1, z1);
+
+          __m128 cs = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, w1), _mm_mul_ps(x0, x1)),
+                                 _mm_add_ps(_mm_mul_ps(y0, y1), _mm_mul_ps(z0, z1)));
+
+          //t' = t * (t * (2k * t - 3k) + 1 + k)
+          __m128 factor = _mm_sub_ps(one, _mm_mul_ps(attenuation, _mm_and_ps(cs, absMask)));
+          __m128 k = _mm_mul_ps(kScale, _mm_mul_ps(factor, factor));
+          __m128 inner = _mm_mul_ps(k, _mm_sub_ps(t2, _mm_set1_ps(3.0f)));
+          __m128 c1 = _mm_mul_ps(t, _mm_add_ps(_mm_mul_ps(t, inner), _mm_add_ps(one, k)));
+
+          //1 - t', or t' - 1 on the short path
+          __m128 flip = _mm_and_ps(_mm_cmplt_ps(cs, threshold), _mm_set1_ps(-0.0f));
+          __m128 c0 = _mm_xor_ps(_mm_sub_ps(one, c1), flip);
+
+          __m128 w = _mm_add_ps(_mm_mul_ps(c0, w0), _mm_mul_ps(c1, w1));
+          __m128 x = _mm_add_ps(_mm_mul_ps(c0, x0), _mm_mul_ps(c1, x1));
+          __m128 y = _mm_add_ps(_mm_mul_ps(c0, y0), _mm_mul_ps(c1, y1));
+          __m128 z = _mm_add_ps(_mm_mul_ps(c0, z0), _mm_mul_ps(c1, z1));
+          _MM_TRANSPOSE4_PS(w, x, y, z);
+          _mm_storeu_ps(a_out + i * 4, w);
+          _mm_storeu_ps(a_out + i * 4 + 4, x);
+          _mm_storeu_ps(a_out + i * 4 + 8, y);
+          _mm_storeu_ps(a_out + i * 4 + 12, z);
+        }
+
+        for (; i < a_count; ++i)
+        {
+          ApproxSlerpOne(a_q0 + i * 4, a_q1 + i * 4, a_t, a_out + i * 4);
+        }
+      }
+    };
+
+    template<>
+    struct BlendKernel<float>
+    {
+      static void Apply(float const * const * a_ppPoses, float const * a_pWeights, size_t a_nPoses,
+                        size_t a_begin, size_t a_end, float * a_out)
+      {
+        __m128 const zero = _mm_setzero_ps();
+        __m128 const one = _mm_set1_ps(1.0f);
+        __m128 const signBit = _mm_set1_ps(-0.0f);
+
+        size_t i = a_begin;
+        for (; i + 4 <= a_end; i += 4)
+        {
+          __m128 rw = _mm_loadu_ps(a_ppPoses[0] + i * 4);
+          __m128 rx = _mm_loadu_ps(a_ppPoses[0] + i * 4 + 4);
+          __m128 ry = _mm_loadu_ps(a_ppPoses[0] + i * 4 + 8);
+          __m128 rz = _mm_loadu_ps(a_ppPoses[0] + i * 4 + 12);
+          _MM_TRANSPOSE4_PS(rw, rx, ry, rz);
+
+          __m128 weight = _mm_set1_ps(a_pWeights[0]);
+          __m128 w = _mm_mul_ps(weight, rw);
+          __m128 x = _mm_mul_ps(weight, rx);
+          __m128 y = _mm_mul_ps(weight, ry);
+          __m128 z = _mm_mul_ps(weight, rz);
+
+          for (size_t p = 1; p < a_nPoses; ++p)
+          {
+            __m128 qw = _mm_loadu_ps(a_ppPoses[p] + i * 4);
+            __m128 qx = _mm_loadu_ps(a_ppPoses[p] + i * 4 + 4);
+            __m128 qy = _mm_loadu_ps(a_ppPoses[p] + i * 4 + 8);
+            __m128 qz = _mm_loadu_ps(a_ppPoses[p] + i * 4 + 12);
+            _MM_TRANSPOSE4_PS(qw, qx, qy, qz);
+
+            __m128 cs = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rw, qw), _mm_mul_ps(rx, qx)),
+                                   _mm_add_ps(_mm_mul_ps(ry, qy), _mm_mul_ps(rz, qz)));
+            weight = _mm_xor_ps(_mm_set1_ps(a_pWeights[p]), _mm_and_ps(_mm_cmplt_ps(cs, zero), signBit));
+            w = _mm_add_ps(w, _mm_mul_ps(weight, qw));
+            x = _mm_add_ps(x, _mm_mul_ps(weight, qx));
+            y = _mm_add_ps(y, _mm_mul_ps(weight, qy));
+            z = _mm_add_ps(z, _mm_mul_ps(weight, qz));
+          }
+
+          __m128 lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)),
+                                    _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z)));
+          __m128 valid = _mm_cmpgt_ps(lenSq, zero);
+          __m128 inv = _mm_and_ps(valid, _mm_div_ps(one, _mm_sqrt_ps(_mm_or_ps(lenSq, _mm_andnot_ps(valid, one)))));
+
+          //Zero sums become the identity
+          w = _mm_or_ps(_mm_mul_ps(w, inv), _mm_andnot_ps(valid, one));
+          x = _mm_mul_ps(x, inv);
+          y = _mm_mul_ps(y, inv);
+          z = _mm_mul_ps(z, inv);
+          _MM_TRANSPOSE4_PS(w, x, y, z);
+          _mm_storeu_ps(a_out + i * 4, w);
+          _mm_storeu_ps(a_out + i * 4 + 4, x);
+          _mm_storeu_ps(a_out + i * 4 + 8, y);
+          _mm_storeu_ps(a_out + i * 4 + 12, z);
+        }
+
+        BlendOne(a_ppPoses, a_pWeights, a_nPoses, i, a_end, a_out);
+      }
+    };
+#endif
+  }
+}
+
+#endif
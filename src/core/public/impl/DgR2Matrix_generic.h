@@ -52,6 +52,18 @@ namespace Dg
       //! Assignment
       Matrix_generic & operator=(Matrix <3, 3, Real> const &);
 
+      //! Evaluate a matrix expression
+      template<typename E>
+      Matrix_generic(impl::MatrixExpr<E, 3, 3, Real> const & a_expr) : Matrix<3, 3, Real>(a_expr) {}
+
+      //! Assign a matrix expression
+      template<typename E>
+      Matrix_generic & operator=(impl::MatrixExpr<E, 3, 3, Real> const & a_expr)
+      {
+        Matrix<3, 3, Real>::operator=(a_expr);
+        return *this;
+      }
+
       //! Set matrix by rows
       void SetRows(Matrix<1, 3, Real> const & row0, 
                    Matrix<1, 3, Real> const & row1,
@@ -28,6 +28,18 @@ namespace Dg
       //! Assignment
       Vector_generic& operator=(Matrix<1, 3, Real> const &);
 
+      //! Evaluate a matrix expression
+      template<typename E>
+      Vector_generic(impl::MatrixExpr<E, 1, 3, Real> const & a_expr) : Matrix<1, 3, Real>(a_expr) {}
+
+      //! Assign a matrix expression
+      template<typename E>
+      Vector_generic & operator=(impl::MatrixExpr<E, 1, 3, Real> const & a_expr)
+      {
+        Matrix<1, 3, Real>::operator=(a_expr);
+        return *this;
+      }
+
       //! Determines if the vector is the unit vector within some tolerance.
       bool IsUnit() const;
 
@@ -57,6 +57,18 @@ namespace Dg
       //! Assignment
       Matrix_generic& operator=(Matrix<4, 4, Real> const &);
 
+      //! Evaluate a matrix expression
+      template<typename E>
+      Matrix_generic(impl::MatrixExpr<E, 4, 4, Real> const & a_expr) : Matrix<4, 4, Real>(a_expr) {}
+
+      //! Assign a matrix expression
+      template<typename E>
+      Matrix_generic & operator=(impl::MatrixExpr<E, 4, 4, Real> const & a_expr)
+      {
+        Matrix<4, 4, Real>::operator=(a_expr);
+        return *this;
+      }
+
       //! Set matrix by rows
       void SetRows(Matrix<1, 4, Real> const & row0, 
                    Matrix<1, 4, Real> const & row1,
@@ -85,7 +97,7 @@ namespace Dg
       Matrix_generic & SetAffineInverse();
 
       //! Get matrix inverse, assuming a standard affine matrix (bottom row is 0 0 0 1).
-      Matrix_generic GetAffineInverse();
+      Matrix_generic GetAffineInverse() const;
 
       //! Set as translation matrix based on vector
       Matrix_generic & Translation(Matrix<1, 4, Real> const &);
@@ -126,6 +138,14 @@ namespace Dg
       Matrix_generic & LookAt(Vector_generic<Real, 3> const & a_origin,
                               Vector_generic<Real, 3> const & a_target,
                               Vector_generic<Real, 3> const & a_up);
+
+      //! Multiplies a_count row vectors by this matrix, a_pOut[i] = a_pIn[i] * M.
+      //! a_pOut may equal a_pIn. The work is split over a_nThreads threads
+      //! (0 = one per hardware thread).
+      void Transform(Vector_generic<Real, 3> const * a_pIn,
+                     Vector_generic<Real, 3> * a_pOut,
+                     size_t a_count,
+                     unsigned a_nThreads = 0) const;
     };
 
 
@@ -209,7 +229,7 @@ namespace Dg
     template<typename Real>
     Matrix_generic<Real, 3>& Matrix_generic<Real, 3>::SetAffineInverse()
     {
-      *this = GetAffineInverse(*this);
+      *this = GetAffineInverse();
       return *this;
     }	//End: Matrix_generic::SetAffineInverse
 
@@ -218,40 +238,11 @@ namespace Dg
     //	@	GetAffineInverse()
     //--------------------------------------------------------------------------------
     template<typename Real>
-    Matrix_generic<Real, 3> Matrix_generic<Real, 3>::GetAffineInverse()
+    Matrix_generic<Real, 3> Matrix_generic<Real, 3>::GetAffineInverse() const
     {
+      //Identity if the matrix is singular
       Matrix_generic<Real, 3> result;
-
-      //compute upper left 3x3 matrix determinant
-      Real cofactor0 = m_V[5] * m_V[10] - m_V[9] * m_V[6];
-      Real cofactor1 = m_V[6] * m_V[8] - m_V[4] * m_V[10];
-      Real cofactor2 = m_V[4] * m_V[9] - m_V[8] * m_V[5];
-      Real det = m_V[0] * cofactor0 + m_V[1] * cofactor1 + m_V[2] * cofactor2;
-      if (Dg::IsZero(det))
-      {
-        return result;
-      }
-
-      // create adjunct matrix and multiply by 1/det to get upper 3x3
-      Real invDet = static_cast<Real>(1.0) / det;
-      result.m_V[0] = invDet*cofactor0;
-      result.m_V[4] = invDet*cofactor1;
-      result.m_V[8] = invDet*cofactor2;
-
-      result.m_V[1] = invDet*(m_V[2] * m_V[9] - m_V[1] * m_V[10]);
-      result.m_V[5] = invDet*(m_V[0] * m_V[10] - m_V[2] * m_V[8]);
-      result.m_V[9] = invDet*(m_V[1] * m_V[8] - m_V[0] * m_V[9]);
-
-      result.m_V[2] = invDet*(m_V[1] * m_V[6] - m_V[2] * m_V[5]);
-      result.m_V[6] = invDet*(m_V[2] * m_V[4] - m_V[0] * m_V[6]);
-      result.m_V[10] = invDet*(m_V[0] * m_V[5] - m_V[1] * m_V[4]);
-
-      // multiply -translation by inverted 3x3 to get its inverse
-
-      result.m_V[12] = -result.m_V[0] * m_V[12] - result.m_V[1] * m_V[13] - result.m_V[2] * m_V[14];
-      result.m_V[13] = -result.m_V[4] * m_V[12] - result.m_V[5] * m_V[13] - result.m_V[6] * m_V[14];
-      result.m_V[14] = -result.m_V[8] * m_V[12] - result.m_V[9] * m_V[13] - result.m_V[10] * m_V[14];
-
+      AffineInverseKernel<Real>::Apply(m_V, result.m_V);
       return result;
     }	//End: Matrix_generic::GetAffineInverse()
 
@@ -795,6 +786,23 @@ namespace Dg
     }   // End: LookAt()
 
 
+    //-------------------------------------------------------------------------------
+    //	@	Matrix_generic::Transform()
+    //-------------------------------------------------------------------------------
+    template<typename Real>
+    void Matrix_generic<Real, 3>::Transform(Vector_generic<Real, 3> const * a_pIn,
+                                            Vector_generic<Real, 3> * a_pOut,
+                                            size_t a_count,
+                                            unsigned a_nThreads) const
+    {
+      if (a_count == 0)
+        return;
+
+      Real const zero[4] = {};
+      TransformVectors(m_V, zero, a_pIn->GetData(), a_pOut->GetData(), a_count, a_nThreads);
+    }   // End: Matrix_generic::Transform()
+
+
     //! Get perspctive projection matrix
     template<typename Real>
     Matrix_generic<Real, 3> & Matrix_generic<Real, 3>::Perspective(
@@ -42,6 +42,18 @@ namespace Dg
       //! Assignment
       Vector_generic& operator=(Dg::Matrix<1, 4, Real> const &);
 
+      //! Evaluate a matrix expression
+      template<typename E>
+      Vector_generic(impl::MatrixExpr<E, 1, 4, Real> const & a_expr) : Dg::Matrix<1, 4, Real>(a_expr) {}
+
+      //! Assign a matrix expression
+      template<typename E>
+      Vector_generic & operator=(impl::MatrixExpr<E, 1, 4, Real> const & a_expr)
+      {
+        Dg::Matrix<1, 4, Real>::operator=(a_expr);
+        return *this;
+      }
+
       //! Determines if the vector is the unit vector within some tolerance.
       bool IsUnit() const;
 
@@ -232,10 +244,7 @@ namespace Dg
     template<typename Real>
     Real Vector_generic<Real, 3>::Length() const
     {
-      return sqrt(m_V[0] * m_V[0] +
-                  m_V[1] * m_V[1] +
-                  m_V[2] * m_V[2] +
-                  m_V[3] * m_V[3]);
+      return sqrt(LengthSquared());
     }   // End:  Vector_generic::Length()
 
 
@@ -245,10 +254,7 @@ namespace Dg
     template<typename Real>
     Real Vector_generic<Real, 3>::LengthSquared() const
     {
-      return (m_V[0] * m_V[0] +
-              m_V[1] * m_V[1] +
-              m_V[2] * m_V[2] +
-              m_V[3] * m_V[3]);
+      return DotKernel<4, Real>::Apply(m_V, m_V);
     }   // End:  Vector_generic::LengthSquared()
 
 
@@ -268,23 +274,13 @@ namespace Dg
     template<typename Real>
     void Vector_generic<Real, 3>::Normalize()
     {
-      Real lengthsq = LengthSquared();
-
-      if (Dg::IsZero(lengthsq))
+      if (!Normalize4Kernel<Real>::Apply(m_V))
       {
         m_V[0] = static_cast<Real>(1.0);
         m_V[1] = static_cast<Real>(0.0);
         m_V[2] = static_cast<Real>(0.0);
         m_V[3] = static_cast<Real>(0.0);
       }
-      else
-      {
-        Real factor = static_cast<Real>(1.0) / sqrt(lengthsq);
-        m_V[0] *= factor;
-        m_V[1] *= factor;
-        m_V[2] *= factor;
-        m_V[3] *= factor;
-      }
     }   // End:  Vector_generic::Normalize()
 
 
@@ -293,11 +289,7 @@ namespace Dg
     Vector_generic<Real, 3> Vector_generic<Real, 3>::Cross(Vector_generic<Real, 3> const & a_v) const
     {
       Vector_generic<Real, 3> result;
-      result[0] = m_V[1] * a_v[2] - m_V[2] * a_v[1];
-      result[1] = m_V[2] * a_v[0] - m_V[0] * a_v[2];
-      result[2] = m_V[0] * a_v[1] - m_V[1] * a_v[0];
-      result[3] = static_cast<Real>(0.0);
-
+      Cross4Kernel<Real>::Apply(m_V, a_v.m_V, result.m_V);
       return result;
     }	//End: Cross()
 
@@ -1,7 +1,8 @@
-
 #ifndef DGVECTOR_GENERIC_H
 #define DGVECTOR_GENERIC_H
 
+#include "DgMatrixExpr.h"
+
 namespace Dg
 {
   namespace impl
@@ -11,6 +12,94 @@ namespace Dg
     {
 
     };
+
+    //Vector arithmetic returns a vector, not a matrix expression, so the
+    //result can be passed on to Dot(), Cross(), Length() and the like. A
+    //vector in R dimensions holds R + 1 elements, the last being w.
+
+    //-------------------------------------------------------------------------------
+    //	@	operator+()
+    //-------------------------------------------------------------------------------
+    template<typename Real, int R>
+    Vector_generic<Real, R> operator+(Vector_generic<Real, R> const & a_lhs, Vector_generic<Real, R> const & a_rhs)
+    {
+      Vector_generic<Real, R> result;
+      for (int i = 0; i < R + 1; i++)
+      {
+        result[i] = a_lhs[i] + a_rhs[i];
+      }
+      return result;
+    }   // End: operator+()
+
+
+    //-------------------------------------------------------------------------------
+    //	@	operator-()
+    //-------------------------------------------------------------------------------
+    template<typename Real, int R>
+    Vector_generic<Real, R> operator-(Vector_generic<Real, R> const & a_lhs, Vector_generic<Real, R> const & a_rhs)
+    {
+      Vector_generic<Real, R> result;
+      for (int i = 0; i < R + 1; i++)
+      {
+        result[i] = a_lhs[i] - a_rhs[i];
+      }
+      return result;
+    }   // End: operator-()
+
+
+    //-------------------------------------------------------------------------------
+    //	@	operator-()
+    //-------------------------------------------------------------------------------
+    template<typename Real, int R>
+    Vector_generic<Real, R> operator-(Vector_generic<Real, R> const & a_v)
+    {
+      Vector_generic<Real, R> result;
+      for (int i = 0; i < R + 1; i++)
+      {
+        result[i] = -a_v[i];
+      }
+      return result;
+    }   // End: operator-()
+
+
+    //-------------------------------------------------------------------------------
+    //	@	operator*()
+    //-------------------------------------------------------------------------------
+    template<typename Real, int R>
+    Vector_generic<Real, R> operator*(Vector_generic<Real, R> const & a_v, typename NonDeduced<Real>::type a_scalar)
+    {
+      Vector_generic<Real, R> result;
+      for (int i = 0; i < R + 1; i++)
+      {
+        result[i] = a_v[i] * a_scalar;
+      }
+      return result;
+    }   // End: operator*()
+
+
+    //-------------------------------------------------------------------------------
+    //	@	operator*()
+    //-------------------------------------------------------------------------------
+    template<typename Real, int R>
+    Vector_generic<Real, R> operator*(typename NonDeduced<Real>::type a_scalar, Vector_generic<Real, R> const & a_v)
+    {
+      return a_v * a_scalar;
+    }   // End: operator*()
+
+
+    //-------------------------------------------------------------------------------
+    //	@	operator/()
+    //-------------------------------------------------------------------------------
+    template<typename Real, int R>
+    Vector_generic<Real, R> operator/(Vector_generic<Real, R> const & a_v, typename NonDeduced<Real>::type a_scalar)
+    {
+      Vector_generic<Real, R> result;
+      for (int i = 0; i < R + 1; i++)
+      {
+        result[i] = a_v[i] / a_scalar;
+      }
+      return result;
+    }   // End: operator/()
   }
 }
 
@@ -8,7 +8,7 @@
 #ifndef DGPARTICLEEMITTER_H
 #define DGPARTICLEEMITTER_H
 
-#include "DgAVLTreeMap.h"
+#include "DgFlatMap.h"
 #include "DgObjectWrapper.h"
 #include "DgParticleGenerator.h"
 
@@ -83,7 +83,7 @@ namespace Dg
     virtual ParticleEmitter<Real> * Clone() const { return new ParticleEmitter<Real>(*this); }
 
   protected:
-    Dg::AVLTreeMap<int, ObjectWrapper<ParticleGenerator<Real>>>   m_generators;
+    Dg::FlatMap<int, ObjectWrapper<ParticleGenerator<Real>>>   m_generators;
 
   private:
     bool m_isOn;
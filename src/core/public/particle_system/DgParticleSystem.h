@@ -90,9 +90,9 @@ namespace Dg
     void Clear();
 
   private:
-    Dg::AVLTreeMap<int, ObjectWrapper<ParticleEmitter<Real>>>   m_emitters;
+    Dg::FlatMap<int, ObjectWrapper<ParticleEmitter<Real>>>   m_emitters;
     ParticleData<Real>                                   m_particleData;
-    Dg::AVLTreeMap<int, ObjectWrapper<ParticleUpdater<Real>>>   m_updaters;
+    Dg::FlatMap<int, ObjectWrapper<ParticleUpdater<Real>>>   m_updaters;
   };
 
 
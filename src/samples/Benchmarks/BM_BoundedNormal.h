@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <random>
+
+#include "Benchmark.h"
+#include "DgBoundedSND.h"
+
+//Draws samples from a normal distribution bounded to [-1, 3] sd. Uniforms
+//are generated up front; the rejection sampler draws its own.
+inline void BM_BoundedNormal(size_t a_count, int a_nPasses)
+{
+  float const mean = 2.0f, sd = 0.5f, lower = 1.5f, upper = 3.5f;
+
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  std::vector<float> uniforms(a_count), out(a_count);
+  for (size_t i = 0; i < a_count; i++)
+    uniforms[i] = uniform(gen);
+
+  Dg::BoundedNormalSampler<float> sampler(mean, sd, lower, upper);
+
+  char const * columns[1] = {"Msamples/s"};
+  PrintHeader("Bounded normal, " + std::to_string(a_count) + " samples", columns, 1);
+
+  auto rate = [&](auto a_fn)
+  {
+    double t = TimeIt([&]()
+    {
+      for (int p = 0; p < a_nPasses; p++)
+        a_fn();
+    }, 3);
+
+    //Keep the results from being optimised away
+    if (out[a_count / 2] == 1.2345f)
+      std::cout << "";
+
+    return static_cast<double>(a_count) * a_nPasses / t * 1.0e-6;
+  };
+
+  double r;
+
+  r = rate([&]()
+  {
+    std::normal_distribution<float> normal(mean, sd);
+    for (size_t i = 0; i < a_count; i++)
+    {
+      float x;
+      do
+      {
+        x = normal(gen);
+      } while (x < lower || x > upper);
+      out[i] = x;
+    }
+  });
+  PrintRow("Rejection", &r, 1);
+
+  r = rate([&]()
+  {
+    double pl = Dg::impl::NormalCDF((lower - mean) / sd);
+    double pu = Dg::impl::NormalCDF((upper - mean) / sd);
+    for (size_t i = 0; i < a_count; i++)
+      out[i] = float(mean + sd * Dg::impl::InverseNormalCDF(pl + uniforms[i] * (pu - pl)));
+  });
+  PrintRow("Inverse CDF", &r, 1);
+
+  r = rate([&]()
+  {
+    for (size_t i = 0; i < a_count; i++)
+      out[i] = sampler.Sample(uniforms[i]);
+  });
+  PrintRow("Sampler", &r, 1);
+
+  r = rate([&]() {sampler.Sample(uniforms.data(), out.data(), a_count, 1);});
+  PrintRow("Sampler batch", &r, 1);
+
+  r = rate([&]() {sampler.Sample(uniforms.data(), out.data(), a_count, 0);});
+  PrintRow("Sampler batch, MT", &r, 1);
+
+  double t = TimeIt([&]() {sampler.Init(mean, sd, lower, upper);}, 3);
+  double tSeries = TimeIt([&]()
+  {
+    //What the table used to cost, one 512-term series per entry
+    double pl = Dg::impl::NormalCDF((lower - mean) / sd);
+    double pu = Dg::impl::NormalCDF((upper - mean) / sd);
+    for (unsigned i = 0; i < Dg::BoundedNormalSampler<float>::DefaultEntries; i++)
+    {
+      double c = 2.0 * (pl + (pu - pl) * double(i) / double(Dg::BoundedNormalSampler<float>::DefaultEntries - 1)) - 1.0;
+      out[i] = float(Dg::inverf<double, Dg::N_C_INVERF>(c));
+    }
+  }, 3);
+  std::cout << "Table build, " << Dg::BoundedNormalSampler<float>::DefaultEntries << " entries: "
+            << t * 1.0e6 << " us (series: " << tSeries * 1.0e6 << " us)\n";
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+#include "Benchmark.h"
+#include "DgMath.h"
+#include "DgErf.h"
+
+//Compares Erf(), Erfc() and InvErf(), per call and over arrays, against
+//std::erf, std::erfc and the inverf() series.
+inline void BM_Erf(size_t a_count, int a_nPasses)
+{
+  std::vector<float> in(a_count), inUnit(a_count), out(a_count);
+  for (size_t i = 0; i < a_count; i++)
+  {
+    in[i] = -4.0f + 8.0f * float(i % 4093) / 4093.0f;
+    inUnit[i] = -0.999f + 1.998f * float(i % 4091) / 4091.0f;
+  }
+
+  char const * columns[4] = {"reference", "per call", "array", "array, MT"};
+  PrintHeader("float, " + std::to_string(a_count) + " values (Mvals/s)", columns, 4);
+
+  auto rate = [&](auto a_fn)
+  {
+    double t = TimeIt([&]()
+    {
+      for (int p = 0; p < a_nPasses; p++)
+        a_fn();
+    }, 3);
+
+    //Keep the results from being optimised away
+    if (out[a_count / 2] == 1.2345f)
+      std::cout << "";
+
+    return static_cast<double>(a_count) * a_nPasses / t * 1.0e-6;
+  };
+
+  double r[4];
+
+  r[0] = rate([&]() {for (size_t i = 0; i < a_count; i++) out[i] = std::erf(in[i]);});
+  r[1] = rate([&]() {for (size_t i = 0; i < a_count; i++) out[i] = Dg::Erf(in[i]);});
+  r[2] = rate([&]() {Dg::Erf(in.data(), out.data(), a_count, 1);});
+  r[3] = rate([&]() {Dg::Erf(in.data(), out.data(), a_count, 0);});
+  PrintRow("erf", r, 4);
+
+  r[0] = rate([&]() {for (size_t i = 0; i < a_count; i++) out[i] = std::erfc(in[i]);});
+  r[1] = rate([&]() {for (size_t i = 0; i < a_count; i++) out[i] = Dg::Erfc(in[i]);});
+  r[2] = rate([&]() {Dg::Erfc(in.data(), out.data(), a_count, 1);});
+  r[3] = rate([&]() {Dg::Erfc(in.data(), out.data(), a_count, 0);});
+  PrintRow("erfc", r, 4);
+
+  r[0] = rate([&]() {for (size_t i = 0; i < a_count; i++) out[i] = Dg::inverf<float, Dg::N_C_INVERF>(inUnit[i]);});
+  r[1] = rate([&]() {for (size_t i = 0; i < a_count; i++) out[i] = Dg::InvErf(inUnit[i]);});
+  r[2] = rate([&]() {Dg::InvErf(inUnit.data(), out.data(), a_count, 1);});
+  r[3] = rate([&]() {Dg::InvErf(inUnit.data(), out.data(), a_count, 0);});
+  PrintRow("inverf (series, 512)", r, 4);
+}
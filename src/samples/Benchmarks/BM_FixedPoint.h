@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+#include "Benchmark.h"
+#include "DgFixedPoint.h"
+
+typedef Dg::FixedPoint<int32_t, 16> BM_FP;
+
+//Compares the FixedPoint transcendental functions, per call and batched,
+//against the float std:: equivalents.
+inline void BM_FixedPoint(size_t a_count, int a_nPasses)
+{
+  std::vector<float> fIn(a_count), fOut(a_count), fInPos(a_count);
+  std::vector<BM_FP> xIn(a_count), xOut(a_count), xInPos(a_count);
+  for (size_t i = 0; i < a_count; i++)
+  {
+    float x = -8.0f + 16.0f * float(i % 4093) / 4093.0f;
+    float xp = 0.01f + 100.0f * float(i % 4091) / 4091.0f;
+    fIn[i] = x;
+    fInPos[i] = xp;
+    xIn[i] = BM_FP(x);
+    xInPos[i] = BM_FP(xp);
+  }
+
+  char const * columns[4] = {"std float", "FP per call", "FP batch", "FP batch, MT"};
+  PrintHeader("FixedPoint<int32_t, 16>, " + std::to_string(a_count) + " values (Mvals/s)", columns, 4);
+
+  auto rate = [&](auto a_fn)
+  {
+    double t = TimeIt([&]()
+    {
+      for (int p = 0; p < a_nPasses; p++)
+        a_fn();
+    }, 3);
+
+    //Keep the results from being optimised away
+    if (fOut[a_count / 2] == 1.2345f || xOut[a_count / 2] == BM_FP(1.2345))
+      std::cout << "";
+
+    return static_cast<double>(a_count) * a_nPasses / t * 1.0e-6;
+  };
+
+  auto row = [&](char const * a_name,
+                 std::vector<float> const & a_fIn,
+                 std::vector<BM_FP> const & a_xIn,
+                 float (*a_fFn)(float),
+                 BM_FP (*a_xFn)(BM_FP),
+                 void (*a_xBatch)(BM_FP const *, BM_FP *, size_t, unsigned))
+  {
+    double r[4];
+    r[0] = rate([&]()
+    {
+      for (size_t i = 0; i < a_count; i++)
+        fOut[i] = a_fFn(a_fIn[i]);
+    });
+    r[1] = rate([&]()
+    {
+      for (size_t i = 0; i < a_count; i++)
+        xOut[i] = a_xFn(a_xIn[i]);
+    });
+    r[2] = rate([&]() {a_xBatch(a_xIn.data(), xOut.data(), a_count, 1);});
+    r[3] = rate([&]() {a_xBatch(a_xIn.data(), xOut.data(), a_count, 0);});
+    PrintRow(a_name, r, 4);
+  };
+
+  row("sin", fIn, xIn, [](float x) {return std::sin(x);}, [](BM_FP x) {return sin(x);}, Dg::Sin<int32_t, 16>);
+  row("cos", fIn, xIn, [](float x) {return std::cos(x);}, [](BM_FP x) {return cos(x);}, Dg::Cos<int32_t, 16>);
+  row("tan", fIn, xIn, [](float x) {return std::tan(x);}, [](BM_FP x) {return tan(x);}, Dg::Tan<int32_t, 16>);
+  row("exp", fIn, xIn, [](float x) {return std::exp(x);}, [](BM_FP x) {return exp(x);}, Dg::Exp<int32_t, 16>);
+  row("log", fInPos, xInPos, [](float x) {return std::log(x);}, [](BM_FP x) {return log(x);}, Dg::Log<int32_t, 16>);
+}
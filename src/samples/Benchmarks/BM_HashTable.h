@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <random>
+#include <algorithm>
+
+#include "Benchmark.h"
+#include "DgOpenHashTable.h"
+#include "DgAVLTreeMap.h"
+
+template<typename K>
+K MakeKey(uint32_t a_val);
+
+template<>
+inline int MakeKey<int>(uint32_t a_val)
+{
+  return static_cast<int>(a_val);
+}
+
+template<>
+inline std::string MakeKey<std::string>(uint32_t a_val)
+{
+  return "entity_" + std::to_string(a_val);
+}
+
+//Times insert, find (hit), find (miss) and erase, in ns per operation.
+template<typename Map, typename K>
+void BM_Map(std::string const & a_name, std::vector<K> const & a_keys, std::vector<K> const & a_missing)
+{
+  double ns[4] = {};
+  size_t found = 0;
+
+  ns[0] = TimeIt([&]()
+  {
+    Map map;
+    for (size_t i = 0; i < a_keys.size(); i++)
+      map[a_keys[i]] = static_cast<int>(i);
+  });
+
+  Map map;
+  for (size_t i = 0; i < a_keys.size(); i++)
+    map[a_keys[i]] = static_cast<int>(i);
+
+  ns[1] = TimeIt([&]()
+  {
+    for (size_t i = 0; i < a_keys.size(); i++)
+      found += (map.find(a_keys[i]) != map.end());
+  });
+
+  ns[2] = TimeIt([&]()
+  {
+    for (size_t i = 0; i < a_missing.size(); i++)
+      found += (map.find(a_missing[i]) != map.end());
+  });
+
+  ns[3] = TimeIt([&]()
+  {
+    for (size_t i = 0; i < a_keys.size(); i++)
+      map.erase(a_keys[i]);
+  }, 1);
+
+  for (int i = 0; i < 4; i++)
+    ns[i] *= 1.0e9 / static_cast<double>(a_keys.size());
+
+  //Keep the lookups from being optimised away
+  if (found == 0)
+    std::cout << "";
+
+  PrintRow(a_name, ns, 4);
+}
+
+template<typename K>
+void BM_HashTable(std::string const & a_keyName, size_t a_nItems)
+{
+  std::vector<K> keys, missing;
+  std::mt19937 rng(42);
+  for (size_t i = 0; i < a_nItems; i++)
+  {
+    keys.push_back(MakeKey<K>(static_cast<uint32_t>(2 * i)));
+    missing.push_back(MakeKey<K>(static_cast<uint32_t>(2 * i + 1)));
+  }
+  std::shuffle(keys.begin(), keys.end(), rng);
+  std::shuffle(missing.begin(), missing.end(), rng);
+
+  char const * columns[4] = {"insert", "find hit", "find miss", "erase"};
+  PrintHeader(a_keyName + " keys, " + std::to_string(a_nItems) + " items (ns/op)", columns, 4);
+
+  BM_Map<Dg::OpenHashTable<K, int>>("Dg::OpenHashTable", keys, missing);
+
+  //AVLTreeMap moves its pools with realloc, so string keys rely on
+  //std::string being relocatable with memcpy, as it is with MSVC.
+  BM_Map<Dg::AVLTreeMap<K, int>>("Dg::AVLTreeMap", keys, missing);
+  BM_Map<std::unordered_map<K, int>>("std::unordered_map", keys, missing);
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+#include "Benchmark.h"
+#include "DgR2Regression.h"
+#include "DgR3Regression.h"
+
+//Accumulates the moments of a point set for a line or plane fit: naive
+//running sums of squares, the Welford Add() per point, and the array Add().
+//Also prints the float variance each method recovers for points far from
+//the origin, where the naive sums break down.
+inline void BM_Regression(size_t a_count, int a_nPasses)
+{
+  std::vector<Dg::R2::Vector<float>> points2(a_count);
+  std::vector<Dg::R3::Vector<float>> points3(a_count);
+  for (size_t i = 0; i < a_count; i++)
+  {
+    float t = float(i % 100) * 0.01f;
+    float s = float(i % 37) * 0.03f;
+    points2[i] = Dg::R2::Vector<float>(1000.0f + t, 1000.0f + 2.0f * t, 1.0f);
+    points3[i] = Dg::R3::Vector<float>(1000.0f + t, 1000.0f + s, 1000.0f + t - s, 1.0f);
+  }
+
+  char const * columns[4] = {"naive sums", "per point", "array", "array, MT"};
+  PrintHeader("float, " + std::to_string(a_count) + " points (Mpoints/s)", columns, 4);
+
+  float sink = 0.0f;
+  auto rate = [&](auto a_fn)
+  {
+    double t = TimeIt([&]()
+    {
+      for (int p = 0; p < a_nPasses; p++)
+        sink += a_fn();
+    }, 3);
+    return static_cast<double>(a_count) * a_nPasses / t * 1.0e-6;
+  };
+
+  double r[4];
+  float varX[3];
+
+  auto naive2 = [&]()
+  {
+    float sx = 0.0f, sy = 0.0f, sxx = 0.0f, sxy = 0.0f, syy = 0.0f;
+    for (size_t i = 0; i < a_count; i++)
+    {
+      float x = points2[i].x(), y = points2[i].y();
+      sx += x; sy += y;
+      sxx += x * x; sxy += x * y; syy += y * y;
+    }
+    float n = float(a_count);
+    varX[0] = sxx / n - (sx / n) * (sx / n);
+    return varX[0] + sxy + syy;
+  };
+
+  r[0] = rate(naive2);
+  r[1] = rate([&]()
+  {
+    Dg::R2::LineFitAccumulator<float> acc;
+    for (size_t i = 0; i < a_count; i++)
+      acc.Add(points2[i]);
+    float xy, yy;
+    acc.GetCovariance(varX[1], xy, yy);
+    return varX[1];
+  });
+  r[2] = rate([&]()
+  {
+    Dg::R2::LineFitAccumulator<float> acc;
+    acc.Add(points2.data(), a_count, 1);
+    float xy, yy;
+    acc.GetCovariance(varX[2], xy, yy);
+    return varX[2];
+  });
+  r[3] = rate([&]()
+  {
+    Dg::R2::LineFitAccumulator<float> acc;
+    acc.Add(points2.data(), a_count, 0);
+    return acc.Centroid().x();
+  });
+  PrintRow("R2 line", r, 4);
+  float varX2[3] = {varX[0], varX[1], varX[2]};
+
+  auto naive3 = [&]()
+  {
+    float s[3] = {}, ss[6] = {};
+    for (size_t i = 0; i < a_count; i++)
+    {
+      float x = points3[i].x(), y = points3[i].y(), z = points3[i].z();
+      s[0] += x; s[1] += y; s[2] += z;
+      ss[0] += x * x; ss[1] += x * y; ss[2] += x * z;
+      ss[3] += y * y; ss[4] += y * z; ss[5] += z * z;
+    }
+    float n = float(a_count);
+    varX[0] = ss[0] / n - (s[0] / n) * (s[0] / n);
+    return varX[0] + ss[1] + ss[2] + ss[3] + ss[4] + ss[5] + s[1] + s[2];
+  };
+
+  auto variance3 = [](Dg::R3::PlaneFitAccumulator<float> const & a_acc)
+  {
+    Dg::R3::Vector<float> axes[3];
+    float variances[3];
+    a_acc.GetPrincipalAxes(axes, variances);
+    return variances[0] + variances[1] + variances[2];
+  };
+
+  r[0] = rate(naive3);
+  r[1] = rate([&]()
+  {
+    Dg::R3::PlaneFitAccumulator<float> acc;
+    for (size_t i = 0; i < a_count; i++)
+      acc.Add(points3[i]);
+    return acc.Centroid().x();
+  });
+  r[2] = rate([&]()
+  {
+    Dg::R3::PlaneFitAccumulator<float> acc;
+    acc.Add(points3.data(), a_count, 1);
+    return acc.Centroid().x();
+  });
+  r[3] = rate([&]()
+  {
+    Dg::R3::PlaneFitAccumulator<float> acc;
+    acc.Add(points3.data(), a_count, 0);
+    return acc.Centroid().x();
+  });
+  PrintRow("R3 plane", r, 4);
+
+  double t = TimeIt([&]()
+  {
+    Dg::R3::PlaneFitAccumulator<float> acc;
+    acc.Add(points3[0]);
+    acc.Add(points3[1]);
+    acc.Add(points3[2]);
+    for (int i = 0; i < 1000; i++)
+      sink += variance3(acc);
+  }, 3);
+
+  if (sink == 1.2345f)
+    std::cout << "";
+
+  //Var of (i % 100) * 0.01
+  std::cout << "R2 float var(x), expected " << (100.0 * 100.0 - 1.0) / 12.0 * 1.0e-4
+            << ": naive " << varX2[0] << ", Add(point) " << varX2[1] << ", Add(array) " << varX2[2] << "\n";
+  std::cout << "R3 principal axes: " << t * 1.0e6 << " ns\n";
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Benchmark.h"
+#include "DgRingBuffer.h"
+
+//Baseline queue for comparison
+template<typename T>
+class LockedQueue
+{
+public:
+
+  LockedQueue(size_t) {}
+
+  bool TryPush(T const & a_item)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(a_item);
+    return true;
+  }
+
+  size_t TryPushN(T const * a_pItems, size_t a_count)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.insert(m_queue.end(), a_pItems, a_pItems + a_count);
+    return a_count;
+  }
+
+  size_t TryPopN(T * a_pOut, size_t a_maxCount)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t n = (m_queue.size() < a_maxCount) ? m_queue.size() : a_maxCount;
+    for (size_t i = 0; i < n; i++)
+      a_pOut[i] = m_queue[i];
+    m_queue.erase(m_queue.begin(), m_queue.begin() + n);
+    return n;
+  }
+
+private:
+
+  std::mutex    m_mutex;
+  std::deque<T> m_queue;
+};
+
+//Sends a_nMessages split over a_nProducers threads to one consumer, in
+//batches of a_batch (1 = TryPush). Returns millions of messages per second.
+template<typename Queue>
+double BM_QueueThroughput(unsigned a_nProducers, size_t a_nMessages, size_t a_batch)
+{
+  size_t perProducer = a_nMessages / a_nProducers;
+  size_t total = perProducer * a_nProducers;
+  size_t checksum = 0;
+
+  double t = TimeIt([&]()
+  {
+    Queue queue(1024);
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < a_nProducers; p++)
+    {
+      producers.push_back(std::thread([&queue, perProducer, a_batch]()
+      {
+        std::vector<size_t> batch(a_batch);
+        for (size_t sent = 0; sent < perProducer;)
+        {
+          size_t n = (perProducer - sent < a_batch) ? perProducer - sent : a_batch;
+          for (size_t i = 0; i < n; i++)
+            batch[i] = sent + i;
+
+          size_t pushed = (n == 1) ? (queue.TryPush(batch[0]) ? 1 : 0) : queue.TryPushN(batch.data(), n);
+          if (pushed == 0)
+            std::this_thread::yield();
+          sent += pushed;
+        }
+      }));
+    }
+
+    size_t out[64];
+    for (size_t received = 0; received < total;)
+    {
+      size_t n = queue.TryPopN(out, 64);
+      if (n == 0)
+        std::this_thread::yield();
+      for (size_t i = 0; i < n; i++)
+        checksum += out[i];
+      received += n;
+    }
+
+    for (auto & thread : producers)
+      thread.join();
+  }, 3);
+
+  //Keep the consumer from being optimised away
+  if (checksum == 0)
+    std::cout << "";
+
+  return static_cast<double>(total) / t * 1.0e-6;
+}
+
+inline void BM_RingBuffer(size_t a_nMessages)
+{
+  unsigned const producerCounts[4] = {1, 2, 4, 8};
+  char const * columns[4] = {"1", "2", "4", "8"};
+  PrintHeader("Queue throughput, " + std::to_string(a_nMessages) + " messages (Mmsg/s vs producers)", columns, 4);
+
+  double rate[4];
+  for (int i = 0; i < 4; i++)
+    rate[i] = BM_QueueThroughput<Dg::MPSCRingBuffer<size_t>>(producerCounts[i], a_nMessages, 1);
+  PrintRow("Dg::MPSCRingBuffer", rate, 4);
+
+  for (int i = 0; i < 4; i++)
+    rate[i] = BM_QueueThroughput<Dg::MPSCRingBuffer<size_t>>(producerCounts[i], a_nMessages, 32);
+  PrintRow("Dg::MPSCRingBuffer x32", rate, 4);
+
+  for (int i = 0; i < 4; i++)
+    rate[i] = BM_QueueThroughput<LockedQueue<size_t>>(producerCounts[i], a_nMessages, 1);
+  PrintRow("mutex + std::deque", rate, 4);
+
+  for (int i = 0; i < 4; i++)
+    rate[i] = BM_QueueThroughput<LockedQueue<size_t>>(producerCounts[i], a_nMessages, 32);
+  PrintRow("mutex + std::deque x32", rate, 4);
+
+  //Single producer only
+  char const * spscColumns[2] = {"single", "batch 32"};
+  PrintHeader("Single producer (Mmsg/s)", spscColumns, 2);
+
+  rate[0] = BM_QueueThroughput<Dg::SPSCRingBuffer<size_t>>(1, a_nMessages, 1);
+  rate[1] = BM_QueueThroughput<Dg::SPSCRingBuffer<size_t>>(1, a_nMessages, 32);
+  PrintRow("Dg::SPSCRingBuffer", rate, 2);
+
+  rate[0] = BM_QueueThroughput<Dg::MPSCRingBuffer<size_t>>(1, a_nMessages, 1);
+  rate[1] = BM_QueueThroughput<Dg::MPSCRingBuffer<size_t>>(1, a_nMessages, 32);
+  PrintRow("Dg::MPSCRingBuffer", rate, 2);
+}
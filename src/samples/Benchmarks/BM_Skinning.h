@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "Benchmark.h"
+#include "DgR3Matrix.h"
+#include "DgR3DualQuaternion.h"
+
+typedef Dg::R3::Vector<float>          BM_SkinVec4;
+typedef Dg::R3::DualQuaternion<float>  BM_SkinDQ;
+typedef Dg::R3::SkinInfluences<float>  BM_SkinInfluences;
+
+//Skins positions and normals with 4 influences per vertex, comparing a blended
+//matrix palette against dual quaternion skinning. Each pass is timed on its
+//own and the best kept. Run with a vertex count that fits in cache to see
+//the kernels, and with a large one to see memory traffic.
+inline void BM_Skinning(size_t a_nVertices, size_t a_nBones, int a_nPasses)
+{
+  std::vector<BM_SkinDQ> dqPalette(a_nBones);
+  std::vector<Dg::R3::Matrix<float>> mPalette(a_nBones);
+  for (size_t i = 0; i < a_nBones; i++)
+  {
+    Dg::R3::Quaternion<float> q;
+    q.SetRotation(0.1f * float(i), -0.07f * float(i), 0.3f, Dg::EulerOrder::ZYX);
+    dqPalette[i].Set(q, BM_SkinVec4(float(i % 7), -0.5f * float(i % 5), 0.25f * float(i), 0.0f));
+    dqPalette[i].GetVQS().GetMatrix(mPalette[i]);
+  }
+
+  std::vector<BM_SkinInfluences> influences(a_nVertices);
+  std::vector<BM_SkinVec4> pIn(a_nVertices), nIn(a_nVertices), pOut(a_nVertices), nOut(a_nVertices);
+  for (size_t i = 0; i < a_nVertices; i++)
+  {
+    for (int k = 0; k < 4; k++)
+    {
+      influences[i].bones[k] = uint32_t((i / 16 + k * 3) % a_nBones);
+      influences[i].weights[k] = 0.25f;
+    }
+    pIn[i].Set(float(i % 101) * 0.1f, float(i % 37) - 18.0f, float(i % 13) * -0.5f, 1.0f);
+    nIn[i].Set(0.0f, 0.6f, 0.8f, 0.0f);
+  }
+
+  char const * columns[1] = {"Mvert/s"};
+  PrintHeader("Skin " + std::to_string(a_nVertices) + " vertices, " + std::to_string(a_nBones) + " bones, 4 influences",
+              columns, 1);
+
+  auto rate = [&](auto a_fn)
+  {
+    double t = TimeIt(a_fn, a_nPasses);
+
+    //Keep the results from being optimised away
+    if (pOut[a_nVertices / 2][0] == 1.2345f || nOut[a_nVertices / 2][0] == 1.2345f)
+      std::cout << "";
+
+    return static_cast<double>(a_nVertices) / t * 1.0e-6;
+  };
+
+  double r;
+
+  r = rate([&]()
+  {
+    for (size_t i = 0; i < a_nVertices; i++)
+    {
+      BM_SkinInfluences const & inf = influences[i];
+      Dg::R3::Matrix<float> m = mPalette[inf.bones[0]] * inf.weights[0]
+                              + mPalette[inf.bones[1]] * inf.weights[1]
+                              + mPalette[inf.bones[2]] * inf.weights[2]
+                              + mPalette[inf.bones[3]] * inf.weights[3];
+      pOut[i] = pIn[i] * m;
+      nOut[i] = nIn[i] * m;
+    }
+  });
+  PrintRow("Matrix palette", &r, 1);
+
+  r = rate([&]()
+  {
+    for (size_t i = 0; i < a_nVertices; i++)
+    {
+      BM_SkinInfluences const & inf = influences[i];
+      BM_SkinDQ const & dq0 = dqPalette[inf.bones[0]];
+      BM_SkinDQ dq = dq0 * inf.weights[0];
+      for (int k = 1; k < 4; k++)
+      {
+        BM_SkinDQ const & dqk = dqPalette[inf.bones[k]];
+        float w = inf.weights[k];
+        if (Dg::R3::Dot(dq0.GetReal(), dqk.GetReal()) < 0.0f)
+          w = -w;
+        dq += dqk * w;
+      }
+      dq.Normalize();
+      pOut[i] = dq.TransformPoint(pIn[i]);
+      nOut[i] = dq.TransformVector(nIn[i]);
+    }
+  });
+  PrintRow("DualQuaternion", &r, 1);
+
+  r = rate([&]()
+  {
+    Dg::R3::SkinVertices(dqPalette.data(), influences.data(), pIn.data(), pOut.data(),
+                         nIn.data(), nOut.data(), a_nVertices, 1);
+  });
+  PrintRow("SkinVertices", &r, 1);
+
+  r = rate([&]()
+  {
+    Dg::R3::SkinVertices(dqPalette.data(), influences.data(), pIn.data(), pOut.data(),
+                         nIn.data(), nOut.data(), a_nVertices, 0);
+  });
+  PrintRow("SkinVertices, MT", &r, 1);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "Benchmark.h"
+#include "DgR3VQS.h"
+
+typedef Dg::R3::Vector<float> BM_Vec4;
+
+//Transforms a_in with a_fn, a_nPasses times. Returns millions of vertices per second.
+template<typename Fn>
+double BM_TransformRate(std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out, int a_nPasses, Fn a_fn)
+{
+  double t = TimeIt([&]()
+  {
+    for (int p = 0; p < a_nPasses; p++)
+      a_fn(a_in, a_out);
+  }, 3);
+
+  //Keep the results from being optimised away
+  if (a_out[a_out.size() / 2][0] == 1.2345f)
+    std::cout << "";
+
+  return static_cast<double>(a_in.size()) * a_nPasses / t * 1.0e-6;
+}
+
+inline void BM_Transform(size_t a_nVertices, int a_nPasses)
+{
+  std::vector<BM_Vec4> in(a_nVertices), out(a_nVertices);
+  for (size_t i = 0; i < a_nVertices; i++)
+    in[i].Set(float(i % 101) * 0.1f, float(i % 37) - 18.0f, float(i % 13) * -0.5f, 1.0f);
+
+  Dg::R3::Quaternion<float> q;
+  q.SetRotation(0.45f, -1.2f, 2.1f, Dg::EulerOrder::ZYX);
+  Dg::R3::VQS<float> vqs(BM_Vec4(4.0f, -2.5f, 1.9f, 0.0f), q, 1.5f);
+  Dg::R3::Matrix<float> m;
+  vqs.GetMatrix(m);
+
+  char const * columns[3] = {"per call", "batch", "batch, MT"};
+  PrintHeader("Transform " + std::to_string(a_nVertices) + " vertices (Mvert/s)", columns, 3);
+
+  double rate[3];
+
+  rate[0] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    for (size_t i = 0; i < a_in.size(); i++)
+      a_out[i] = vqs.TransformPoint(a_in[i]);
+  });
+  rate[1] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    vqs.TransformPoints(a_in.data(), a_out.data(), a_in.size(), 1);
+  });
+  rate[2] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    vqs.TransformPoints(a_in.data(), a_out.data(), a_in.size(), 0);
+  });
+  PrintRow("VQS::TransformPoints", rate, 3);
+
+  rate[0] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    for (size_t i = 0; i < a_in.size(); i++)
+      a_out[i] = q.Rotate(a_in[i]);
+  });
+  rate[1] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    q.Rotate(a_in.data(), a_out.data(), a_in.size(), 1);
+  });
+  rate[2] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    q.Rotate(a_in.data(), a_out.data(), a_in.size(), 0);
+  });
+  PrintRow("Quaternion::Rotate", rate, 3);
+
+  rate[0] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    for (size_t i = 0; i < a_in.size(); i++)
+      a_out[i] = a_in[i] * m;
+  });
+  rate[1] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    m.Transform(a_in.data(), a_out.data(), a_in.size(), 1);
+  });
+  rate[2] = BM_TransformRate(in, out, a_nPasses, [&](std::vector<BM_Vec4> const & a_in, std::vector<BM_Vec4> & a_out)
+  {
+    m.Transform(a_in.data(), a_out.data(), a_in.size(), 0);
+  });
+  PrintRow("Matrix::Transform", rate, 3);
+}
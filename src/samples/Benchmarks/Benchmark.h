@@ -0,0 +1,41 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "DgTimer.h"
+
+//Runs a_fn a_nRuns times and returns the fastest run, in seconds.
+template<typename Fn>
+double TimeIt(Fn a_fn, int a_nRuns = 3)
+{
+  double best = 1.0e30;
+  for (int i = 0; i < a_nRuns; i++)
+  {
+    Dg::Timer timer;
+    timer.Start();
+    a_fn();
+    double t = timer.GetTime();
+    if (t < best)
+      best = t;
+  }
+  return best;
+}
+
+inline void PrintHeader(std::string const & a_title, char const * const * a_columns, int a_nColumns)
+{
+  std::cout << '\n' << a_title << '\n';
+  std::cout << std::left << std::setw(24) << "";
+  for (int i = 0; i < a_nColumns; i++)
+    std::cout << std::right << std::setw(14) << a_columns[i];
+  std::cout << '\n';
+}
+
+inline void PrintRow(std::string const & a_name, double const * a_values, int a_nValues)
+{
+  std::cout << std::left << std::setw(24) << a_name << std::fixed << std::setprecision(2);
+  for (int i = 0; i < a_nValues; i++)
+    std::cout << std::right << std::setw(14) << a_values[i];
+  std::cout << '\n';
+}
@@ -0,0 +1,24 @@
+#include "BM_HashTable.h"
+#include "BM_RingBuffer.h"
+#include "BM_Transform.h"
+#include "BM_Skinning.h"
+#include "BM_FixedPoint.h"
+#include "BM_BoundedNormal.h"
+#include "BM_Erf.h"
+#include "BM_Regression.h"
+
+int main()
+{
+  BM_HashTable<int>("int", 1000);
+  BM_HashTable<int>("int", 1000000);
+  BM_HashTable<std::string>("string", 1000);
+  BM_HashTable<std::string>("string", 1000000);
+  BM_RingBuffer(4000000);
+  BM_Transform(100000, 20);
+  BM_Skinning(4000, 64, 500);
+  BM_Skinning(100000, 64, 20);
+  BM_FixedPoint(100000, 20);
+  BM_BoundedNormal(1000000, 10);
+  BM_Erf(100000, 20);
+  BM_Regression(100000, 20);
+}
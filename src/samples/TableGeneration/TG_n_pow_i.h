@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+
 #include "TableGenerator.h"
 
 template<typename T>
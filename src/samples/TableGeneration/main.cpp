@@ -2,9 +2,6 @@
 #include <fstream>
 #include <iomanip>
 
-#include "TG_erf.h"
-#include "TG_inverf.h"
-#include "TG_HashTableBucketCounts.h"
 #include "TG_n_pow_i.h"
 
 int main()